@@ -0,0 +1,333 @@
+/* 
+ * @HEADER
+ *
+ * ***********************************************************************
+ *
+ *  Zoltan Toolkit for Load-balancing, Partitioning, Ordering and Coloring
+ *                  Copyright 2012 Sandia Corporation
+ *
+ * Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ * the U.S. Government retains certain rights in this software.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the Corporation nor the names of the
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Questions? Contact Karen Devine	kddevin@sandia.gov
+ *                    Erik Boman	egboman@sandia.gov
+ *
+ * ***********************************************************************
+ *
+ * @HEADER
+ */
+/***************************************************************
+** Compare the time taken by Zoltan_LB_Point_PP_Assign and
+** Zoltan_LB_Box_PP_Assign called once per point or box with the
+** batched Zoltan_LB_Point_PP_Assign_Multi and 
+** Zoltan_LB_Box_PP_Assign_Multi, and check that both give the
+** same answers.
+**
+** usage: benchASSIGN [method [objects per process [queries]]]
+**        method defaults to RCB; it may also be RIB or HSFC.
+***************************************************************/
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "zoltan.h"
+
+typedef struct{
+  int numMyPoints;
+  ZOLTAN_ID_PTR myGlobalIDs;
+  double *xyz;
+} POINT_DATA;
+
+static int get_number_of_objects(void *data, int *ierr);
+static void get_object_list(void *data, int sizeGID, int sizeLID,
+            ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
+                  int wgt_dim, float *obj_wgts, int *ierr);
+static int get_num_geometry(void *data, int *ierr);
+static void get_geometry_list(void *data, int sizeGID, int sizeLID,
+             int num_obj, ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
+             int num_dim, double *geom_vec, int *ierr);
+
+/* Uniform random points in the unit cube, with a cluster near the
+ * origin so that the cut tree is not balanced in space. */
+
+static double random_coordinate(int i)
+{
+  double x = (double)rand() / RAND_MAX;
+  return (i % 4 == 0) ? 0.1 * x : x;
+}
+
+int main(int argc, char *argv[])
+{
+  int rc, i, j, myRank, numProcs;
+  float ver;
+  struct Zoltan_Struct *zz;
+  int changes, numGidEntries, numLidEntries, numImport, numExport;
+  ZOLTAN_ID_PTR importGlobalGids, importLocalGids, exportGlobalGids, exportLocalGids; 
+  int *importProcs, *importToPart, *exportProcs, *exportToPart;
+  char *method = "RCB";
+  int numQueries = 200000;
+  int numParts, nbad = 0, gbad = 0;
+  double *qxyz, *qbox, t;
+  double tpoint, tpointmulti, tbox, tboxmulti;
+  int *procs1, *parts1, *procs2, *parts2;
+  int np, npart, *bprocs, *bparts;
+  int *proc_start, *part_start, *mprocs = NULL, *mparts = NULL;
+  char str[32];
+  POINT_DATA myPoints;
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+
+  rc = Zoltan_Initialize(argc, argv, &ver);
+
+  if (rc != ZOLTAN_OK){
+    printf("sorry...\n");
+    MPI_Finalize();
+    exit(0);
+  }
+
+  myPoints.numMyPoints = 20000;
+  if (argc > 1) method = argv[1];
+  if (argc > 2) myPoints.numMyPoints = atoi(argv[2]);
+  if (argc > 3) numQueries = atoi(argv[3]);
+
+  /******************************************************************
+  ** Create random points and partition them into 16 parts per
+  ** process, keeping the cuts for the point and box queries.
+  ******************************************************************/
+
+  srand(1 + myRank);
+  myPoints.myGlobalIDs = (ZOLTAN_ID_PTR)
+    malloc(sizeof(ZOLTAN_ID_TYPE) * myPoints.numMyPoints);
+  myPoints.xyz = (double *) malloc(sizeof(double) * 3 * myPoints.numMyPoints);
+  for (i = 0; i < myPoints.numMyPoints; i++){
+    myPoints.myGlobalIDs[i] = (ZOLTAN_ID_TYPE)
+                              (myRank * myPoints.numMyPoints + i + 1);
+    for (j = 0; j < 3; j++)
+      myPoints.xyz[3*i+j] = random_coordinate(i);
+  }
+
+  numParts = 16 * numProcs;
+  sprintf(str, "%d", numParts);
+
+  zz = Zoltan_Create(MPI_COMM_WORLD);
+
+  Zoltan_Set_Param(zz, "DEBUG_LEVEL", "0");
+  Zoltan_Set_Param(zz, "LB_METHOD", method);
+  Zoltan_Set_Param(zz, "NUM_GID_ENTRIES", "1"); 
+  Zoltan_Set_Param(zz, "NUM_LID_ENTRIES", "1");
+  Zoltan_Set_Param(zz, "OBJ_WEIGHT_DIM", "0");
+  Zoltan_Set_Param(zz, "RETURN_LISTS", "ALL");
+  Zoltan_Set_Param(zz, "NUM_GLOBAL_PARTS", str);
+  Zoltan_Set_Param(zz, "KEEP_CUTS", "1");
+
+  Zoltan_Set_Num_Obj_Fn(zz, get_number_of_objects, &myPoints);
+  Zoltan_Set_Obj_List_Fn(zz, get_object_list, &myPoints);
+  Zoltan_Set_Num_Geom_Fn(zz, get_num_geometry, &myPoints);
+  Zoltan_Set_Geom_Multi_Fn(zz, get_geometry_list, &myPoints);
+
+  rc = Zoltan_LB_Partition(zz, &changes, &numGidEntries, &numLidEntries,
+        &numImport, &importGlobalGids, &importLocalGids,
+        &importProcs, &importToPart,
+        &numExport, &exportGlobalGids, &exportLocalGids,
+        &exportProcs, &exportToPart);
+
+  if (rc != ZOLTAN_OK){
+    printf("sorry...\n");
+    MPI_Finalize();
+    Zoltan_Destroy(&zz);
+    exit(0);
+  }
+
+  /******************************************************************
+  ** Queries: random points, and boxes of width 0.05 around them.
+  ******************************************************************/
+
+  srand(12345 + myRank);
+  qxyz = (double *) malloc(sizeof(double) * 3 * numQueries);
+  qbox = (double *) malloc(sizeof(double) * 6 * numQueries);
+  for (i = 0; i < numQueries; i++){
+    for (j = 0; j < 3; j++){
+      qxyz[3*i+j] = random_coordinate(i);
+      qbox[6*i+j] = qxyz[3*i+j] - 0.025;
+      qbox[6*i+3+j] = qxyz[3*i+j] + 0.025;
+    }
+  }
+
+  procs1 = (int *) malloc(sizeof(int) * numQueries);
+  parts1 = (int *) malloc(sizeof(int) * numQueries);
+  procs2 = (int *) malloc(sizeof(int) * numQueries);
+  parts2 = (int *) malloc(sizeof(int) * numQueries);
+  bprocs = (int *) malloc(sizeof(int) * numProcs);
+  bparts = (int *) malloc(sizeof(int) * numParts);
+  proc_start = (int *) malloc(sizeof(int) * (numQueries + 1));
+  part_start = (int *) malloc(sizeof(int) * (numQueries + 1));
+
+  /* Points */
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  t = MPI_Wtime();
+  for (i = 0; i < numQueries; i++)
+    Zoltan_LB_Point_PP_Assign(zz, qxyz + 3*i, procs1 + i, parts1 + i);
+  tpoint = MPI_Wtime() - t;
+
+  t = MPI_Wtime();
+  Zoltan_LB_Point_PP_Assign_Multi(zz, numQueries, qxyz, procs2, parts2);
+  tpointmulti = MPI_Wtime() - t;
+
+  for (i = 0; i < numQueries; i++)
+    if (procs1[i] != procs2[i] || parts1[i] != parts2[i]) nbad++;
+
+  /* Boxes */
+
+  t = MPI_Wtime();
+  for (i = 0; i < numQueries; i++)
+    Zoltan_LB_Box_PP_Assign(zz, qbox[6*i], qbox[6*i+1], qbox[6*i+2],
+                            qbox[6*i+3], qbox[6*i+4], qbox[6*i+5],
+                            bprocs, &np, bparts, &npart);
+  tbox = MPI_Wtime() - t;
+
+  t = MPI_Wtime();
+  Zoltan_LB_Box_PP_Assign_Multi(zz, numQueries, qbox, 
+                                proc_start, &mprocs, part_start, &mparts);
+  tboxmulti = MPI_Wtime() - t;
+
+  for (i = 0; i < numQueries; i++){
+    Zoltan_LB_Box_PP_Assign(zz, qbox[6*i], qbox[6*i+1], qbox[6*i+2],
+                            qbox[6*i+3], qbox[6*i+4], qbox[6*i+5],
+                            bprocs, &np, bparts, &npart);
+    if (mprocs == NULL || mparts == NULL ||
+        np != proc_start[i+1] - proc_start[i] ||
+        npart != part_start[i+1] - part_start[i]){
+      nbad++;
+      continue;
+    }
+    /* Both lists hold the same set; the order may differ. */
+    for (j = 0; j < np; j++){
+      int k;
+      for (k = proc_start[i]; k < proc_start[i+1]; k++)
+        if (mprocs[k] == bprocs[j]) break;
+      if (k == proc_start[i+1]) nbad++;
+    }
+    for (j = 0; j < npart; j++){
+      int k;
+      for (k = part_start[i]; k < part_start[i+1]; k++)
+        if (mparts[k] == bparts[j]) break;
+      if (k == part_start[i+1]) nbad++;
+    }
+  }
+
+  MPI_Allreduce(&nbad, &gbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  if (myRank == 0){
+    printf("%s, %d parts, %d queries per process\n", 
+           method, numParts, numQueries);
+    printf("  point assign:        %10.6f s\n", tpoint);
+    printf("  point assign multi:  %10.6f s\n", tpointmulti);
+    printf("  box assign:          %10.6f s\n", tbox);
+    printf("  box assign multi:    %10.6f s\n", tboxmulti);
+    printf("%s\n", gbad ? "FAILED: results differ" : "PASSED");
+  }
+
+  /******************************************************************
+  ** Free the arrays allocated by Zoltan_LB_Partition, and free
+  ** the storage allocated for the Zoltan structure.
+  ******************************************************************/
+
+  Zoltan_LB_Free_Part(&importGlobalGids, &importLocalGids, 
+                      &importProcs, &importToPart);
+  Zoltan_LB_Free_Part(&exportGlobalGids, &exportLocalGids, 
+                      &exportProcs, &exportToPart);
+  ZOLTAN_FREE(&mprocs);
+  ZOLTAN_FREE(&mparts);
+
+  Zoltan_Destroy(&zz);
+
+  free(myPoints.myGlobalIDs);
+  free(myPoints.xyz);
+  free(qxyz); free(qbox);
+  free(procs1); free(parts1); free(procs2); free(parts2);
+  free(bprocs); free(bparts); free(proc_start); free(part_start);
+
+  MPI_Finalize();
+
+  return (gbad != 0);
+}
+
+/* Application defined query functions */
+
+static int get_number_of_objects(void *data, int *ierr)
+{
+  POINT_DATA *points = (POINT_DATA *)data;
+  *ierr = ZOLTAN_OK;
+  return points->numMyPoints;
+}
+
+static void get_object_list(void *data, int sizeGID, int sizeLID,
+            ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
+                  int wgt_dim, float *obj_wgts, int *ierr)
+{
+int i;
+  POINT_DATA *points = (POINT_DATA *)data;
+  *ierr = ZOLTAN_OK;
+
+  for (i=0; i<points->numMyPoints; i++){
+    globalID[i] = points->myGlobalIDs[i];
+    localID[i] = i;
+  }
+}
+
+static int get_num_geometry(void *data, int *ierr)
+{
+  *ierr = ZOLTAN_OK;
+  return 3;
+}
+
+static void get_geometry_list(void *data, int sizeGID, int sizeLID,
+                      int num_obj,
+             ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
+             int num_dim, double *geom_vec, int *ierr)
+{
+int i;
+  POINT_DATA *points = (POINT_DATA *)data;
+
+  if ( (sizeGID != 1) || (sizeLID != 1) || (num_dim != 3)){
+    *ierr = ZOLTAN_FATAL;
+    return;
+  }
+
+  *ierr = ZOLTAN_OK;
+
+  for (i=0;  i < num_obj ; i++){
+    memcpy(geom_vec + 3*i, points->xyz + 3*localID[i], 3 * sizeof(double));
+  }
+}
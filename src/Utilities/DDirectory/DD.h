@@ -59,13 +59,17 @@
 extern "C" {
 #endif
 
-#define ZOLTAN_DD_HASH_TABLE_COUNT 100000 /* default # of linked list heads */
+#define ZOLTAN_DD_MIN_TABLE_LENGTH  64    /* smallest # of hash table slots */
+#define ZOLTAN_DD_MAX_LOAD        0.75    /* grow table beyond this fill    */
+#define ZOLTAN_DD_MAX_TABLE_LENGTH (1 << 30) /* largest power of 2 that a
+                                                DD_NodeIdx holds          */
 #define ZOLTAN_DD_NO_PROC           -1    /* not a possible processor #     */
 
 /* Tags for MPI communications.  These need unique values. Arbitrary */
 #define ZOLTAN_DD_FIND_MSG_TAG     29137  /* needs 3 consecutive values */
 #define ZOLTAN_DD_UPDATE_MSG_TAG   29140  /* needs 2 consecutive values */
 #define ZOLTAN_DD_REMOVE_MSG_TAG   29142  /* needs 2 consecutive values */
+#define ZOLTAN_DD_FIND_PLAN_TAG    29144  /* needs 3 consecutive values */
 
 #ifndef TRUE
 #define FALSE (0)
@@ -76,38 +80,60 @@ extern "C" {
 
 unsigned int Zoltan_DD_Hash2(ZOLTAN_ID_PTR key, int num_id_entries,
  unsigned int n, void *hashdata, ZOLTAN_HASH_FN *fn);
+unsigned int Zoltan_DD_Hash_Local(ZOLTAN_ID_PTR key, int num_id_entries);
 
 void Zoltan_DD_default_cleanup(void *hashdata);
 
+int DD_Has_Ranges(Zoltan_DD_Directory *dd);
+
 typedef unsigned int DD_Hash_fn(ZOLTAN_ID_PTR, int, unsigned int, void *,
                                 ZOLTAN_HASH_FN *);
 typedef void DD_Cleanup_fn(void*);
+typedef void *DD_Copy_fn(void*);
 
 
 
 /************  Zoltan_DD_Directory, DD_Node  **********************/
 
-typedef int DD_NodeIdx;   /* Index into dd->nodelist; 
+typedef int DD_NodeIdx;   /* Index of a slot in a DD_Table; 
                              must be a signed type as -1 indicates NULL */
 
-/* The following structure, DD_Node, is the basic unit of the hash table's
- * linked list.  DD_Node contains the global ID(used as the table lookup
- * key) and other necessary information.  NOTE: DD_Node is malloc'd to
- * store gid, lid & user data beyond the struct's end.
+/* The following structure, DD_Node, is one slot of the directory's open
+ * addressing (Robin Hood, linear probing) hash table.  The slot holds the
+ * local hash of the global ID, so most probes are rejected without touching
+ * the key, followed by the owner, partition and the global ID itself.
+ * NOTE: slots are dd->node_size bytes apart, so the gid, lid & user data
+ * are stored inline beyond the struct's end.
 */
 
 typedef struct DD_Node  {
+  unsigned int     hash;       /* Zoltan_DD_Hash_Local(gid); 0 if empty */
   int              owner;      /* processor hosting global ID object    */
   int              partition;  /* Optional data                         */
   int              errcheck;   /* Error checking(inconsistent updates) */
-  DD_NodeIdx       next;       /* index in nodelist of next DD_Node in 
-                                  linked list or free node list */
-  ZOLTAN_ID_TYPE  *gid;        /* gid used as key for update & lookup   */
+  ZOLTAN_ID_TYPE   gid[1];     /* gid used as key for update & lookup   */
                                /* lid starts at gid + dd->gid_length    */
                                /*(user) data starts at                 */
                                /* gid + dd->gid_length + dd->lid_length */
 } DD_Node;
 
+/* DD_Table is an open addressing hash table of DD_Nodes.  The directory
+ * keeps its GIDs in one; the optional Zoltan_DD_Find cache is another.
+ * A directory built by Zoltan_DD_Create_From_Ranges() keeps the GIDs of
+ * my range in a DD_Table used as a plain array instead: slot i belongs to
+ * GID dd->block_first + i and is occupied if its hash is not 0.
+*/
+
+typedef struct DD_Table  {
+  char      *nodes;        /* length * dd->node_size bytes of DD_Nodes  */
+  DD_NodeIdx length;       /* # of slots (power of 2), 0 until allocated */
+  DD_NodeIdx hint;         /* # of slots to allocate initially          */
+  DD_NodeIdx count;        /* # of occupied slots                       */
+} DD_Table;
+
+#define DD_NODE(dd, tab, idx) \
+  ((DD_Node *) ((tab)->nodes + (size_t) (idx) * (dd)->node_size))
+
 
 /* The directory structure, Zoltan_DD_Struct, is created by the call
  * to Zoltan_DD_Create(). It maintains the state information and storage
@@ -115,8 +141,7 @@ typedef struct DD_Node  {
  * be added in the future. This structure must be passed back to all other
  * distributed directory calls: Zoltan_DD_Update(), Zoltan_DD_Find(),
  * Zoltan_DD_Destroy(), Zoltan_DD_Set_Hash_Fn(), DD_Update_Local(),
- * DD_Find_Local(), DD_Remove_Local().  NOTE: Zoltan_DD_Struct is
- * malloc'd for storage beyond the struct's end to hold hash table.
+ * DD_Find_Local(), DD_Remove_Local().
 */
 
 struct Zoltan_DD_Struct {
@@ -126,8 +151,8 @@ struct Zoltan_DD_Struct {
   int lid_length;         /* = zz->Num_LID -- avoid needing Zoltan_Struct */
   int max_id_length;      /* max(gid_length, lid_length)           */
   int user_data_length;   /* Optional user data length in chars */
-  int table_length;       /* # of heads of linked lists             */
   size_t nodedata_size;   /* Malloc for GID & LID & user storage    */
+  size_t node_size;       /* Size of a table slot (DD_Node + data)  */
   size_t find_msg_size;   /* Total allocation for DD_FIND_MSG       */
   size_t update_msg_size; /* Total allocation for DD_UPDATE_MSG     */
   size_t remove_msg_size; /* Total allocation for DD_REMOVE_MSG     */
@@ -137,14 +162,18 @@ struct Zoltan_DD_Struct {
   void *hashdata;         /* Either our hash data ...              */
   ZOLTAN_HASH_FN *hashfn; /* ... Or user's hash function, not both */
   DD_Cleanup_fn *cleanup; /* Functioned to free our hash data      */
+  DD_Copy_fn *copy;       /* Duplicates our hash data for Copy; if */
+                          /* NULL, copies share the hash data      */
 
   MPI_Comm comm;          /* Dup of original MPI Comm(KDD)         */
-  DD_Node *nodelist;      /* Memory for storing all nodes in the directory */
-  char *nodedata;         /* Memory for storing all data in the directory  */
-  DD_NodeIdx nodelistlen; /* Length of the nodelist. */
-  DD_NodeIdx nextfreenode;/* Index of first free node in nodelist; 
-                             -1 if no nodes are free */
-  DD_NodeIdx table[1];    /* Hash table heads of the link lists     */
+  DD_Table table;         /* GIDs in my part of the directory      */
+  DD_Table block;         /* GIDs of my range, indexed by position */
+  ZOLTAN_ID_TYPE block_first; /* GID in slot 0 of block            */
+
+  DD_Table cache;         /* Answers to my Finds from other procs   */
+  int cache_max;          /* Max # of GIDs in cache, 0 = no caching */
+  unsigned int epoch;     /* Bumped by each Update and Remove       */
+  unsigned int cache_epoch; /* epoch the cache's answers belong to  */
 };
 
 
@@ -192,6 +221,56 @@ typedef struct  {          /* Only used by Zoltan_DD_Remove()      */
 
 
 
+/* A pending operation, Zoltan_DD_Request_Struct, is created by
+ * Zoltan_DD_Find_Begin() or Zoltan_DD_Update_Begin() and freed by the
+ * matching End, which completes the communication posted by the Begin.
+*/
+
+struct Zoltan_DD_Request_Struct {
+  Zoltan_DD_Directory *dd;  /* directory being queried or updated     */
+  ZOLTAN_COMM_OBJ *plan;    /* plan of the posted messages            */
+  int *procs;               /* destination of each message            */
+  char *sbuff;              /* messages sent (and Find answers)       */
+  char *rbuff;              /* messages received                      */
+  int count;                /* # of GIDs given to Begin               */
+  int nsend;                /* # of messages sent                     */
+  int nrec;                 /* # of messages received                 */
+
+  ZOLTAN_ID_PTR gid;        /* Find: caller's lists, filled in by End */
+  ZOLTAN_ID_PTR lid;
+  char *data;
+  int *partition;
+  int *owner;
+};
+
+
+
+/* A prepared find, Zoltan_DD_Find_Struct, is created by the call to
+ * Zoltan_DD_Find_Prepare().  The requested GIDs have already been sent to
+ * their directory processors, so each Zoltan_DD_Find_Execute() only looks
+ * them up and returns the answers (DD_Find_Msgs) through the saved plan.
+*/
+
+struct Zoltan_DD_Find_Struct {
+  Zoltan_DD_Directory *dd;  /* directory being queried                */
+  DD_Hash_fn *hash;         /* dd's hash function when prepared       */
+  void *hashdata;
+  ZOLTAN_HASH_FN *hashfn;
+
+  ZOLTAN_COMM_OBJ *plan;    /* sends answers back to the requesters   */
+
+  int count;                /* # of GIDs I asked for                  */
+  int *order;               /* index in my GID list of each answer    */
+  char *answers;            /* count answers, grouped by processor    */
+
+  int nrec;                 /* # of GIDs asked of my directory        */
+  ZOLTAN_ID_PTR gid;        /* those GIDs                             */
+  unsigned int *gid_hash;   /* their Zoltan_DD_Hash_Local() values    */
+  char *replies;            /* nrec answers to send back              */
+};
+
+
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
@@ -50,7 +50,6 @@
 
 #include "DD.h"
 #include "zoltan_align.h"
-#include "zz_hash.h"
 
 #ifdef __cplusplus
 /* if C++, define the rest of this header file as extern C */
@@ -95,11 +94,11 @@ int Zoltan_DD_Create (
  int num_lid,                 /* Number of entries in a local ID.      
                                  If zero, ignore LIDs                  */
  int user_length,             /* Optional user data length in chars, 0 ignore */
- int table_length,            /* sizeof hash table, use default if 0   */
+ int table_length,            /* expected # of GIDs, use default if 0  */
  int debug_level              /* control actions to errors, normally 0 */
 )
 {
-   int size, i;
+   int size;
    int my_proc;
    int array[3], max_array[3], min_array[3];
    char *yo = "Zoltan_DD_Create";
@@ -129,40 +128,61 @@ int Zoltan_DD_Create (
        return ZOLTAN_FATAL;
    }
 
-   /* malloc memory for the directory structure + hash table */
-   size = (table_length) ? table_length: ZOLTAN_DD_HASH_TABLE_COUNT;
-   size = Zoltan_Recommended_Hash_Size(size);
-   *dd  = (Zoltan_DD_Directory*) ZOLTAN_MALLOC (sizeof (Zoltan_DD_Directory)
-        + size * sizeof(DD_NodeIdx));
+   /* malloc memory for the directory structure; the hash table itself is
+    * allocated by the first Zoltan_DD_Update and grows as needed */
+   *dd  = (Zoltan_DD_Directory*) ZOLTAN_MALLOC (sizeof (Zoltan_DD_Directory));
    if (*dd == NULL)  {
-      ZOLTAN_PRINT_ERROR (my_proc, yo, "Can not malloc hash table");
+      ZOLTAN_PRINT_ERROR (my_proc, yo, "Can not malloc directory");
       if (debug_level > 4)
         ZOLTAN_TRACE_OUT(my_proc, yo, NULL);
       return ZOLTAN_MEMERR;
    }
 
-   /* NULL heads of link list in hash table */
-   for (i = 0; i < size; i++) (*dd)->table[i] = -1;  /* NULL values */
-   (*dd)->nodelist = NULL;
-   (*dd)->nodedata = NULL;
-   (*dd)->nodelistlen = 0;
-   (*dd)->nextfreenode = -1;
+   /* table_length is only a hint: the initial # of slots, as a power of 2,
+    * that holds table_length GIDs without growing (at most
+    * ZOLTAN_DD_MAX_TABLE_LENGTH; growing past that fails with ZOLTAN_MEMERR) */
+   size = 0;
+   if (table_length > 0)
+      for (size = ZOLTAN_DD_MIN_TABLE_LENGTH;
+           size < table_length / ZOLTAN_DD_MAX_LOAD
+            && size < ZOLTAN_DD_MAX_TABLE_LENGTH; size *= 2);
+   (*dd)->table.nodes  = NULL;
+   (*dd)->table.length = 0;
+   (*dd)->table.hint   = size;
+   (*dd)->table.count  = 0;
+
+   /* only Zoltan_DD_Create_From_Ranges() gives a directory a range block */
+   (*dd)->block.nodes  = NULL;
+   (*dd)->block.length = 0;
+   (*dd)->block.hint   = 0;
+   (*dd)->block.count  = 0;
+   (*dd)->block_first  = 0;
+
+   /* the Find cache is off until Zoltan_DD_Set_Cache() */
+   (*dd)->cache.nodes  = NULL;
+   (*dd)->cache.length = 0;
+   (*dd)->cache.hint   = 0;
+   (*dd)->cache.count  = 0;
+   (*dd)->cache_max    = 0;
+   (*dd)->epoch        = 0;
+   (*dd)->cache_epoch  = 0;
 
    /* save useful constants into directory for convenience */
    (*dd)->debug_level      = debug_level;  /* [0,3], default 0          */
    (*dd)->gid_length       = num_gid;      /* saved input Num_GID       */
    (*dd)->lid_length       = num_lid;      /* saved input Num_LIB       */
-   (*dd)->table_length     = size;         /* # of linked list heads    */
    (*dd)->user_data_length = user_length;  /* optional user data length */
    (*dd)->hash             = Zoltan_DD_Hash2;/* default hash algorithm   */
    (*dd)->hashdata         = NULL;         /* no hash data */
    (*dd)->hashfn           = NULL;         /* no hash function */
    (*dd)->cleanup          = NULL;         /* user registered cleanup   */
+   (*dd)->copy             = NULL;         /* copies share hash data    */
    (*dd)->max_id_length    = (num_gid > num_lid) ? num_gid : num_lid;
 
    /* frequently used dynamic allocation computed sizes */
    size = ((num_gid + num_lid) * sizeof(ZOLTAN_ID_TYPE)) + user_length;
    (*dd)->nodedata_size   = size;
+   (*dd)->node_size       = size + sizeof(DD_Node);
    (*dd)->update_msg_size = size + sizeof(DD_Update_Msg);
 
    size = num_gid * sizeof(ZOLTAN_ID_TYPE);
@@ -173,6 +193,7 @@ int Zoltan_DD_Create (
 
    /* force alignment */
    (*dd)->nodedata_size   = Zoltan_Align_size_t((*dd)->nodedata_size);
+   (*dd)->node_size       = Zoltan_Align_size_t((*dd)->node_size);
    (*dd)->update_msg_size = Zoltan_Align_size_t((*dd)->update_msg_size);
    (*dd)->remove_msg_size = Zoltan_Align_size_t((*dd)->remove_msg_size);
    (*dd)->find_msg_size   = Zoltan_Align_size_t((*dd)->find_msg_size);
@@ -218,12 +239,8 @@ int Zoltan_DD_Copy_To(Zoltan_DD_Directory **toptr, Zoltan_DD_Directory *from)
   }
 
   if (from) {
-    DD_NodeIdx i;
-
     to = *toptr = 
-      (Zoltan_DD_Directory *)ZOLTAN_MALLOC(
-        sizeof (Zoltan_DD_Directory) + 
-        (from->table_length * sizeof(DD_NodeIdx)));
+      (Zoltan_DD_Directory *)ZOLTAN_MALLOC(sizeof (Zoltan_DD_Directory));
 
     if (!to) {
       ZOLTAN_PRINT_ERROR(from->my_proc, yo, "Insufficient memory."); 
@@ -231,20 +248,41 @@ int Zoltan_DD_Copy_To(Zoltan_DD_Directory **toptr, Zoltan_DD_Directory *from)
     }
   
     *to = *from;
-    memcpy(to->table, from->table, to->table_length * sizeof(DD_NodeIdx));
 
     MPI_Comm_dup(from->comm, &(to->comm));
 
-    if (to->nodelistlen) {
-      to->nodelist = (DD_Node *) ZOLTAN_MALLOC(to->nodelistlen * sizeof(DD_Node));
-      memcpy(to->nodelist, from->nodelist, to->nodelistlen * sizeof(DD_Node));
+    if (from->copy) {
+      to->hashdata = from->copy(from->hashdata);
+      if (!to->hashdata) {
+        ZOLTAN_PRINT_ERROR(from->my_proc, yo, "Insufficient memory."); 
+        return ZOLTAN_MEMERR;
+      }
+    }
+
+    /* the copy starts with an empty Find cache of the same size */
+    to->cache.nodes = NULL;
+    to->cache.length = to->cache.count = 0;
 
-      to->nodedata = (char *) ZOLTAN_MALLOC(to->nodelistlen * to->nodedata_size);
-      memcpy(to->nodedata, from->nodedata, to->nodelistlen * to->nodedata_size);
+    if (to->table.length) {
+      to->table.nodes = (char *) ZOLTAN_MALLOC(to->table.length * to->node_size);
+      if (!to->table.nodes) {
+        ZOLTAN_PRINT_ERROR(from->my_proc, yo, "Insufficient memory."); 
+        to->table.length = to->table.count = 0;
+        return ZOLTAN_MEMERR;
+      }
+      memcpy(to->table.nodes, from->table.nodes,
+             to->table.length * to->node_size);
+    }
 
-      for (i = 0; i < to->nodelistlen; i++) {
-        to->nodelist[i].gid = (ZOLTAN_ID_PTR)(to->nodedata + i*to->nodedata_size);
+    if (to->block.length) {
+      to->block.nodes = (char *) ZOLTAN_MALLOC(to->block.length * to->node_size);
+      if (!to->block.nodes) {
+        ZOLTAN_PRINT_ERROR(from->my_proc, yo, "Insufficient memory."); 
+        to->block.length = to->block.count = 0;
+        return ZOLTAN_MEMERR;
       }
+      memcpy(to->block.nodes, from->block.nodes,
+             to->block.length * to->node_size);
     }
   }
 
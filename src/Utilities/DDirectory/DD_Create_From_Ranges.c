@@ -0,0 +1,347 @@
+/* 
+ * @HEADER
+ *
+ * ***********************************************************************
+ *
+ *  Zoltan Toolkit for Load-balancing, Partitioning, Ordering and Coloring
+ *                  Copyright 2012 Sandia Corporation
+ *
+ * Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ * the U.S. Government retains certain rights in this software.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the Corporation nor the names of the
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Questions? Contact Karen Devine	kddevin@sandia.gov
+ *                    Erik Boman	egboman@sandia.gov
+ *
+ * ***********************************************************************
+ *
+ * @HEADER
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "DD.h"
+#include "DD_Memory.h"
+
+
+#ifdef __cplusplus
+/* if C++, define the rest of this header file as extern C */
+extern "C" {
+#endif
+
+
+/*  NOTE: See file, README, for associated documentation. */
+
+
+typedef struct {
+   ZOLTAN_ID_TYPE low;        /* first GID of the range              */
+   ZOLTAN_ID_TYPE high;       /* one past the last GID of the range  */
+   int proc;                  /* processor holding the range         */
+} DD_Range;
+
+struct dd_range_struct {
+   DD_Range *range;           /* non-empty ranges, sorted by low     */
+   int nrange;                /* number of ranges                    */
+   ZOLTAN_ID_TYPE low_limit;  /* smallest GID in any range           */
+   ZOLTAN_ID_TYPE high_limit; /* one past the largest GID            */
+   ZOLTAN_ID_TYPE blocksize;  /* if not 0, proc p's range starts at  */
+                              /* low_limit + p * blocksize           */
+};
+
+static unsigned int dd_range_hash (ZOLTAN_ID_PTR gid, int gid_length,
+ unsigned int nproc, struct dd_range_struct *hashdata, ZOLTAN_HASH_FN *fn);
+
+static int compare_range (const void *a, const void *b);
+
+static void dd_range_cleanup (struct dd_range_struct *hashdata);
+static struct dd_range_struct *dd_range_copy (struct dd_range_struct *from);
+
+
+
+/*************  Zoltan_DD_Create_From_Ranges()  ***********************/
+
+/* Zoltan_DD_Create_From_Ranges() creates a directory of the GIDs
+ * first_gid, first_gid+1, ..., first_gid+count-1 on each processor, all
+ * owned by that processor, as Zoltan_DD_Create() followed by
+ * Zoltan_DD_Update() of every GID would.  Each processor is also the
+ * directory processor of its own range, so the GIDs are neither hashed
+ * nor sent:  they are stored in an array indexed by gid - first_gid, and
+ * the only communication is one MPI_Allgather of the ranges.  The ranges
+ * must not overlap but need not cover all GIDs; GIDs outside them may be
+ * added by Zoltan_DD_Update() and are hashed as usual.  The GID length is 1.
+*/
+
+int Zoltan_DD_Create_From_Ranges (
+ Zoltan_DD_Directory **dd,    /* contains directory state and pointers */
+ MPI_Comm comm,               /* Dup'ed and saved for future use       */
+ int num_lid,                 /* Number of entries in a local ID.
+                                 If zero, ignore LIDs                  */
+ int user_length,             /* Optional user data length in chars, 0 ignore */
+ ZOLTAN_ID_TYPE first_gid,    /* First GID of my range                 */
+ int count,                   /* Number of GIDs in my range            */
+ ZOLTAN_ID_PTR lid,           /* Optional list of count LIDs           */
+ char *user,                  /* Optional list of count user data      */
+ int *partition,              /* Optional list of count partitions     */
+ int debug_level              /* control actions to errors, normally 0 */
+)
+{
+   struct dd_range_struct *hashdata = NULL;
+   ZOLTAN_ID_TYPE  mine[2];           /* my first GID and # of GIDs      */
+   ZOLTAN_ID_TYPE *all = NULL;        /* every processor's mine[]        */
+   ZOLTAN_ID_TYPE  size;
+   DD_Range       *range;
+   DD_Node        *ptr;
+   int             i, n;
+   int             err, gerr;
+   char           *yo = "Zoltan_DD_Create_From_Ranges";
+
+   /* input sanity check, made collective:  a processor must not return
+    * alone before the collective calls below.  Zoltan_DD_Create() checks
+    * that the lengths agree. */
+   err = (dd == NULL || num_lid < 0 || user_length < 0 || count < 0
+    || first_gid + (ZOLTAN_ID_TYPE) count < first_gid) ? ZOLTAN_FATAL
+                                                         : ZOLTAN_OK;
+   MPI_Allreduce (&err, &gerr, 1, MPI_INT, MPI_MIN, comm);
+   if (gerr != ZOLTAN_OK)  {
+      ZOLTAN_PRINT_ERROR (ZOLTAN_DD_NO_PROC, yo, (err != ZOLTAN_OK)
+       ? "Invalid input argument" : "Invalid input argument on another proc");
+      return ZOLTAN_FATAL;
+   }
+
+   /* Zoltan_DD_Create() may fail on some processors only */
+   err = Zoltan_DD_Create (dd, comm, 1, num_lid, user_length, 0, debug_level);
+   MPI_Allreduce (&err, &gerr, 1, MPI_INT, MPI_MIN, comm);
+   if (gerr != ZOLTAN_OK)  {
+      if (err == ZOLTAN_OK)
+         Zoltan_DD_Destroy (dd);
+      return gerr;
+   }
+   if (debug_level > 4)
+      ZOLTAN_TRACE_IN ((*dd)->my_proc, yo, NULL);
+
+   hashdata = (struct dd_range_struct *) ZOLTAN_CALLOC (1, sizeof (*hashdata));
+   range = NULL;
+   if (hashdata != NULL)  {
+      (*dd)->hash     = (DD_Hash_fn*) &dd_range_hash;
+      (*dd)->hashdata = hashdata;
+      (*dd)->hashfn   = NULL;
+      (*dd)->cleanup  = (DD_Cleanup_fn*) &dd_range_cleanup;
+      (*dd)->copy     = (DD_Copy_fn*) &dd_range_copy;
+
+      hashdata->range = range
+       = (DD_Range *) ZOLTAN_MALLOC ((*dd)->nproc * sizeof (DD_Range));
+   }
+   all = (ZOLTAN_ID_TYPE *) ZOLTAN_MALLOC (2 * (*dd)->nproc
+                                           * sizeof (ZOLTAN_ID_TYPE));
+
+   /* every processor must reach the MPI_Allgather, or none */
+   err = (range == NULL || all == NULL) ? ZOLTAN_MEMERR : ZOLTAN_OK;
+   MPI_Allreduce (&err, &gerr, 1, MPI_INT, MPI_MIN, (*dd)->comm);
+   if (gerr != ZOLTAN_OK)  {
+      ZOLTAN_PRINT_ERROR ((*dd)->my_proc, yo, (err != ZOLTAN_OK)
+       ? "Unable to malloc range info" : "Memory error on another proc");
+      err = gerr;
+      goto fini;
+   }
+
+   /* learn every processor's range; this replaces hashing every GID and
+    * the all-to-all exchange of a Zoltan_DD_Update() */
+   mine[0] = first_gid;
+   mine[1] = (ZOLTAN_ID_TYPE) count;
+   MPI_Allgather (mine, 2, ZOLTAN_ID_MPI_TYPE, all, 2, ZOLTAN_ID_MPI_TYPE,
+                  (*dd)->comm);
+
+   /* keep the non-empty ranges, sorted by first GID */
+   for (i = n = 0; i < (*dd)->nproc; i++)
+      if (all[2*i+1] > 0)  {
+         range[n].low  = all[2*i];
+         range[n].high = all[2*i] + all[2*i+1];
+         range[n].proc = i;
+         n++;
+      }
+   qsort (range, n, sizeof (DD_Range), compare_range);
+
+   for (i = 1; i < n; i++)
+      if (range[i].low < range[i-1].high)  {
+         ZOLTAN_PRINT_ERROR ((*dd)->my_proc, yo, "GID ranges overlap");
+         err = ZOLTAN_FATAL;
+         goto fini;
+      }
+   hashdata->nrange     = n;
+   hashdata->low_limit  = (n > 0) ? range[0].low    : 0;
+   hashdata->high_limit = (n > 0) ? range[n-1].high : 0;
+
+   /* Equal, consecutive ranges in processor order (the last may be
+    * shorter) need no search: a GID's processor is its offset from
+    * low_limit divided by the range size. */
+   hashdata->blocksize = 0;
+   if (n == (*dd)->nproc)  {
+      size = range[0].high - range[0].low;
+      for (i = 0; i < n; i++)
+         if (range[i].proc != i
+          || range[i].low  != hashdata->low_limit + (ZOLTAN_ID_TYPE) i * size
+          || range[i].high -  range[i].low > size
+          || (i < n-1 && range[i].high - range[i].low != size))
+            break;
+      if (i == n)
+         hashdata->blocksize = size;
+   }
+
+   /* store my range's directory information by position */
+   if (count > 0)  {
+      (*dd)->block.nodes = (char *) ZOLTAN_MALLOC ((size_t) count
+                                                   * (*dd)->node_size);
+      if ((*dd)->block.nodes == NULL)  {
+         ZOLTAN_PRINT_ERROR ((*dd)->my_proc, yo, "Unable to malloc block");
+         err = ZOLTAN_MEMERR;
+         goto fini;
+      }
+   }
+   (*dd)->block.length = count;
+   (*dd)->block.count  = count;
+   (*dd)->block_first  = first_gid;
+
+   for (i = 0; i < count; i++)  {
+      ptr = DD_NODE(*dd, &(*dd)->block, i);
+      ptr->hash      = 1;                /* any nonzero value: occupied */
+      ptr->owner     = (*dd)->my_proc;
+      ptr->errcheck  = (*dd)->my_proc;
+      ptr->partition = (partition) ? partition[i] : -1;
+      ptr->gid[0]    = first_gid + i;
+      if (lid)  {
+         ZOLTAN_SET_ID (num_lid, ptr->gid + 1, lid + i * num_lid);
+      }
+      else
+         memset (ptr->gid + 1, 0, num_lid * sizeof (ZOLTAN_ID_TYPE));
+      if (user)
+         memcpy (ptr->gid + 1 + num_lid, user + (size_t) i * user_length,
+                 user_length);
+      else
+         memset (ptr->gid + 1 + num_lid, 0, user_length);
+   }
+
+fini:
+   ZOLTAN_FREE (&all);
+   if (debug_level > 4)
+      ZOLTAN_TRACE_OUT ((*dd)->my_proc, yo, NULL);
+   if (err != ZOLTAN_OK)
+      Zoltan_DD_Destroy (dd);
+   return err;
+}
+
+
+
+/* DD_Has_Ranges() is true for directories made by this function (and
+ * their copies).  Their hash function must not be replaced: the GIDs of a
+ * processor's range are stored by position, on that processor only.
+*/
+
+int DD_Has_Ranges (Zoltan_DD_Directory *dd)
+{
+   return dd->hash == (DD_Hash_fn*) &dd_range_hash;
+}
+
+
+
+/* dd_range_hash() returns the processor whose range holds gid; GIDs
+ * outside every range are spread by the default hash function.
+*/
+
+static unsigned int dd_range_hash (ZOLTAN_ID_PTR gid, int gid_length,
+ unsigned int nproc, struct dd_range_struct *hashdata, ZOLTAN_HASH_FN *fn)
+{
+   ZOLTAN_ID_TYPE id = *gid;
+   int lo, hi, mid;
+
+   if (id >= hashdata->low_limit && id < hashdata->high_limit)  {
+      if (hashdata->blocksize > 0)
+         return (unsigned int) ((id - hashdata->low_limit)
+                                / hashdata->blocksize);
+
+      /* find the last range starting at or below id */
+      lo = 0;
+      hi = hashdata->nrange - 1;
+      while (lo < hi)  {
+         mid = (lo + hi + 1) / 2;
+         if (hashdata->range[mid].low <= id)
+            lo = mid;
+         else
+            hi = mid - 1;
+      }
+      if (id < hashdata->range[lo].high)
+         return hashdata->range[lo].proc;
+   }
+
+   return Zoltan_DD_Hash2 (gid, gid_length, nproc, NULL, NULL);
+}
+
+
+
+static int compare_range (const void *a, const void *b)
+{
+   if (((DD_Range *) a)->low < ((DD_Range *) b)->low) return -1;
+   if (((DD_Range *) a)->low > ((DD_Range *) b)->low) return  1;
+   return 0;
+}
+
+
+
+static void dd_range_cleanup (struct dd_range_struct *hashdata)
+{
+   if (hashdata == NULL) return;
+   ZOLTAN_FREE (&hashdata->range);
+   ZOLTAN_FREE (&hashdata);
+}
+
+
+
+static struct dd_range_struct *dd_range_copy (struct dd_range_struct *from)
+{
+   struct dd_range_struct *to;
+
+   to = (struct dd_range_struct *) ZOLTAN_MALLOC (sizeof (*to));
+   if (to == NULL)
+      return NULL;
+   *to = *from;
+   to->range = (DD_Range *) ZOLTAN_MALLOC ((from->nrange + 1)
+                                           * sizeof (DD_Range));
+   if (to->range == NULL)  {
+      ZOLTAN_FREE (&to);
+      return NULL;
+   }
+   memcpy (to->range, from->range, from->nrange * sizeof (DD_Range));
+   return to;
+}
+
+#ifdef __cplusplus
+} /* closing bracket for extern "C" */
+#endif
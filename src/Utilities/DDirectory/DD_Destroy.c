@@ -49,6 +49,7 @@
 #include <stdlib.h>
 
 #include "DD.h"
+#include "DD_Memory.h"
 
 
 #ifdef __cplusplus
@@ -72,8 +73,9 @@ void Zoltan_DD_Destroy (Zoltan_DD_Directory **dd)
    if ((*dd)->debug_level > 4)
       ZOLTAN_TRACE_IN ((*dd)->my_proc, yo, NULL);
 
-   ZOLTAN_FREE(&((*dd)->nodelist));
-   ZOLTAN_FREE(&((*dd)->nodedata));
+   DD_Memory_Free_Table(&((*dd)->table));
+   DD_Memory_Free_Table(&((*dd)->block));
+   DD_Memory_Free_Table(&((*dd)->cache));
 
    /* execute user registered cleanup function, if needed */
    if ((*dd)->cleanup != NULL)
@@ -49,6 +49,7 @@
 #include <stdlib.h>
 
 #include "DD.h"
+#include "DD_Memory.h"
 
 
 #ifdef __cplusplus
@@ -63,28 +64,28 @@ int Zoltan_DD_GetLocalKeys(Zoltan_DD_Directory *dd,
 {
   int ierr = ZOLTAN_OK;
   int i, k;
-  DD_NodeIdx nodeidx;
   DD_Node *ptr;
-  int gid_alloc_size;
 
-  gid_alloc_size = dd->table_length;
-  (*gid) = (ZOLTAN_ID_PTR)ZOLTAN_MALLOC(
-                          gid_alloc_size*dd->gid_length*sizeof(ZOLTAN_ID_TYPE));
+  (*gid) = (ZOLTAN_ID_PTR)ZOLTAN_MALLOC((dd->table.count + dd->block.count)
+                     *dd->gid_length*sizeof(ZOLTAN_ID_TYPE));
+  if ((dd->table.count + dd->block.count) && (*gid) == NULL)
+    return ZOLTAN_MEMERR;
 
   k= 0;
-  for (i = 0; i < dd->table_length; i++)
-    for (nodeidx = dd->table[i]; nodeidx != -1;
-         nodeidx = dd->nodelist[nodeidx].next) {
-      ptr = dd->nodelist + nodeidx;
-      if (k >= gid_alloc_size) {
-        gid_alloc_size *= 2;
-        (*gid) = (ZOLTAN_ID_PTR)
-                  ZOLTAN_REALLOC((*gid),
-                         gid_alloc_size*dd->gid_length*sizeof(ZOLTAN_ID_TYPE));
-      }
+  for (i = 0; i < dd->table.length; i++) {
+    ptr = DD_NODE(dd, &dd->table, i);
+    if (ptr->hash != 0) {
+      ZOLTAN_SET_ID (dd->gid_length, (*gid)+k*dd->gid_length, ptr->gid);
+      k++;
+    }
+  }
+  for (i = 0; i < dd->block.length; i++) {
+    ptr = DD_NODE(dd, &dd->block, i);
+    if (ptr->hash != 0) {
       ZOLTAN_SET_ID (dd->gid_length, (*gid)+k*dd->gid_length, ptr->gid);
       k++;
     }
+  }
 
   (*size) = k;
 
@@ -94,8 +95,12 @@ int Zoltan_DD_GetLocalKeys(Zoltan_DD_Directory *dd,
 /*  NOTE: See file, README, for associated documentation. (RTH) */
 
 
-static int DD_Find_Local (Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
- ZOLTAN_ID_PTR lid, char *user, int *partition, int *owner) ;
+static int DD_Find_Local (Zoltan_DD_Directory *dd, DD_Table *tab,
+ ZOLTAN_ID_PTR gid, ZOLTAN_ID_PTR lid, char *user, int *partition,
+ int *owner) ;
+static void DD_Find_Cache (Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
+ ZOLTAN_ID_PTR lid, char *user, int partition, int owner) ;
+static int DD_Find_End (Zoltan_DD_Request **request, int *errcount) ;
 
 
 
@@ -110,22 +115,63 @@ int Zoltan_DD_Find (
  int  count,              /* Count of GIDs in above list (in)            */
  int *owner)              /* Outgoing optional list of data owners       */
 {
-   ZOLTAN_COMM_OBJ *plan  = NULL;     /* efficient MPI communication     */
-   char            *rbuff = NULL;     /* receive buffer                  */
-   char            *rbufftmp = NULL;  /* pointer into receive buffer     */
-   char            *sbuff = NULL;     /* send buffer                     */
+   Zoltan_DD_Request *req = NULL;
+   int                err;
+   int                errcount;       /* count of GIDs not found         */
+   char              *yo = "Zoltan_DD_Find";
+
+   if (dd != NULL && dd->debug_level > 4)
+      ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
+
+   err = Zoltan_DD_Find_Begin (dd, gid, lid, data, partition, count, owner,
+                               &req);
+   if (err == ZOLTAN_OK)
+      err = DD_Find_End (&req, &errcount);
+   if (err != ZOLTAN_OK && err != ZOLTAN_WARN)
+      goto fini;
+
+   /* GIDs not found anywhere make every processor's Find return a warning */
+   MPI_Allreduce(&errcount, &err, 1, MPI_INT, MPI_SUM, dd->comm);
+   err = (err) ? ZOLTAN_WARN : ZOLTAN_OK;
+
+fini:
+   if (dd != NULL && dd->debug_level > 4)
+      ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
+   return err;
+}
+
+
+
+/********************  Zoltan_DD_Find_Begin()  ********************/
+
+/* Zoltan_DD_Find_Begin() answers what it can from the Find cache, builds
+ * the communication plan and posts the remaining GIDs to their directory
+ * processors.  Zoltan_DD_Find_End() completes the find; in between, the
+ * caller may compute while the messages arrive.
+*/
+
+int Zoltan_DD_Find_Begin (
+ Zoltan_DD_Directory *dd, /* contains directory state information        */
+ ZOLTAN_ID_PTR gid,       /* Incoming list of GIDs to get owners proc    */
+ ZOLTAN_ID_PTR lid,       /* Outgoing corresponding list of LIDs         */
+ char *data,              /* Outgoing optional corresponding user data   */
+ int *partition,          /* Outgoing optional partition information     */
+ int  count,              /* Count of GIDs in above list (in)            */
+ int *owner,              /* Outgoing optional list of data owners       */
+ Zoltan_DD_Request **request) /* Outgoing handle for Zoltan_DD_Find_End  */
+{
+   Zoltan_DD_Request *req = NULL;
    char            *sbufftmp = NULL;  /* pointer into send buffer        */
-   int             *procs = NULL;     /* list of processors to contact   */
    DD_Find_Msg     *ptr   = NULL;
    int              i;
-   int              nrec;             /* number of messages to receive   */
+   int              cached_owner;     /* owner found in cache            */
    int              err = ZOLTAN_OK;  /* return error condition          */
-   int              errcount;         /* count of GIDs not found         */
-   char            *yo = "Zoltan_DD_Find";
+   char            *yo = "Zoltan_DD_Find_Begin";
 
 
    /* input sanity check */
-   if (dd == NULL || count < 0 || (gid == NULL && count > 0))  {
+   if (dd == NULL || count < 0 || (gid == NULL && count > 0)
+    || request == NULL)  {
       ZOLTAN_PRINT_ERROR (dd ? dd->my_proc : ZOLTAN_DD_NO_PROC, yo,
        "Invalid input argument");
       return ZOLTAN_FATAL;
@@ -133,131 +179,226 @@ int Zoltan_DD_Find (
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
 
+   *request = req = (Zoltan_DD_Request *) ZOLTAN_CALLOC (1, sizeof (*req));
+   if (req == NULL)  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to malloc request");
+      err = ZOLTAN_MEMERR;
+      goto fini;
+   }
+   req->dd        = dd;
+   req->gid       = gid;
+   req->lid       = lid;
+   req->data      = data;
+   req->partition = partition;
+   req->owner     = owner;
+   req->count     = count;
+
    /* allocate memory for processors to contact for directory info */
    if (count)  {
-      procs = (int*) ZOLTAN_MALLOC (sizeof(int) * count);
-      if (procs == NULL) {
+      req->procs = (int*) ZOLTAN_MALLOC (sizeof(int) * count);
+      if (req->procs == NULL) {
          ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to malloc proc list");
-         if (dd->debug_level > 4)
-           ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
-         return ZOLTAN_MEMERR;
+         err = ZOLTAN_MEMERR;
+         goto fini;
       }
    }
 
    /* allocate memory for DD_Find_Msg send buffer */
    if (count)  {
-      sbuff = (char*) ZOLTAN_CALLOC (count, dd->find_msg_size);
-      if (sbuff == NULL)  {
-         ZOLTAN_FREE (&procs);
+      req->sbuff = (char*) ZOLTAN_CALLOC (count, dd->find_msg_size);
+      if (req->sbuff == NULL)  {
          ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to malloc send buffer");
-         if (dd->debug_level > 4)
-            ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
-         return ZOLTAN_MEMERR;
+         err = ZOLTAN_MEMERR;
+         goto fini;
       }
    }
 
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After mallocs");
 
-   /* for each GID, fill DD_Find_Msg buffer and contact list */
-   sbufftmp = sbuff;
+   /* answers cached before the last Update or Remove may be stale */
+   if (dd->cache_max > 0 && dd->cache_epoch != dd->epoch)  {
+      DD_Memory_Clear_Table (dd, &dd->cache);
+      dd->cache_epoch = dd->epoch;
+   }
+
+   /* for each GID not answered by the cache, fill DD_Find_Msg buffer and
+    * contact list */
+   req->nsend = 0;
+   sbufftmp = req->sbuff;
    for (i = 0; i < count; i++)  {
-      procs[i] = dd->hash (gid + i*dd->gid_length, dd->gid_length, dd->nproc,
-                           dd->hashdata, dd->hashfn);
+      if (dd->cache.count > 0
+       && DD_Find_Local (dd, &dd->cache, gid + i*dd->gid_length,
+           lid ? lid + i*dd->lid_length : NULL,
+           data ? data + (size_t) i * (size_t) (dd->user_data_length) : NULL,
+           partition ? partition + i : NULL,
+           &cached_owner) == ZOLTAN_OK)  {
+         if (owner)
+            owner[i] = cached_owner;
+         continue;
+      }
+
+      req->procs[req->nsend] = dd->hash (gid + i*dd->gid_length,
+                                         dd->gid_length, dd->nproc,
+                                         dd->hashdata, dd->hashfn);
       ptr      = (DD_Find_Msg*) sbufftmp;
       sbufftmp += dd->find_msg_size;
 
       ptr->index = i;
-      ptr->proc  = procs[i];
+      ptr->proc  = req->procs[req->nsend++];
       ZOLTAN_SET_ID (dd->gid_length, ptr->id, gid + i*dd->gid_length);
    }
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After fill");
 
    /* create efficient communication plan */
-   err = Zoltan_Comm_Create (&plan, count, procs, dd->comm,
-    ZOLTAN_DD_FIND_MSG_TAG, &nrec);
+   err = Zoltan_Comm_Create (&req->plan, req->nsend, req->procs, dd->comm,
+    ZOLTAN_DD_FIND_MSG_TAG, &req->nrec);
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Create");
    if (err != ZOLTAN_OK)
       goto fini;
 
    /* allocate receive buffer */
-   if (nrec)  {
-      rbuff = (char*) ZOLTAN_MALLOC ((size_t)nrec*(size_t)(dd->find_msg_size));
-      if (rbuff == NULL)  {
+   if (req->nrec)  {
+      req->rbuff = (char*) ZOLTAN_MALLOC ((size_t) req->nrec
+                                          * (size_t) (dd->find_msg_size));
+      if (req->rbuff == NULL)  {
          err = ZOLTAN_MEMERR;
          goto fini;
       }
    }
 
    /* send out find messages across entire system */
-   err = Zoltan_Comm_Do (plan, ZOLTAN_DD_FIND_MSG_TAG+1, sbuff,
-    dd->find_msg_size, rbuff);
+   err = Zoltan_Comm_Do_Post (req->plan, ZOLTAN_DD_FIND_MSG_TAG+1,
+    req->sbuff, dd->find_msg_size, req->rbuff);
+   if (dd->debug_level > 6)
+      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Do_Post");
+
+fini:
+   if (err != ZOLTAN_OK)
+      DD_Request_Free (request);
+
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
+   return err;
+}
+
+
+
+/********************  Zoltan_DD_Find_End()  **********************/
+
+int Zoltan_DD_Find_End (
+ Zoltan_DD_Request **request) /* handle from Zoltan_DD_Find_Begin        */
+{
+   int errcount;
+
+   return DD_Find_End (request, &errcount);
+}
+
+
+
+/* DD_Find_End() waits for the find messages directed to me, answers them
+ * from my directory and returns the answers to their requesters.  It
+ * returns ZOLTAN_WARN if any of my GIDs was not found, and their number in
+ * errcount; no global error count is made.
+*/
+
+static int DD_Find_End (
+ Zoltan_DD_Request **request, /* handle from Zoltan_DD_Find_Begin        */
+ int *errcount)               /* # of my GIDs not found (out)            */
+{
+   Zoltan_DD_Directory *dd;
+   Zoltan_DD_Request   *req;
+   char            *rbufftmp = NULL;  /* pointer into receive buffer     */
+   char            *sbufftmp = NULL;  /* pointer into send buffer        */
+   DD_Find_Msg     *ptr   = NULL;
+   int              i;
+   int              err = ZOLTAN_OK;  /* return error condition          */
+   char            *yo = "Zoltan_DD_Find_End";
+
+   *errcount = 0;
+   if (request == NULL || *request == NULL)  {
+      ZOLTAN_PRINT_ERROR (ZOLTAN_DD_NO_PROC, yo, "Invalid input argument");
+      return ZOLTAN_FATAL;
+   }
+   req = *request;
+   dd  = req->dd;
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
+
+   err = Zoltan_Comm_Do_Wait (req->plan, ZOLTAN_DD_FIND_MSG_TAG+1,
+    req->sbuff, dd->find_msg_size, req->rbuff);
    if (err != ZOLTAN_OK)
       goto fini;
 
    if (dd->debug_level > 6)
-      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Do");
+      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Do_Wait");
 
    /* get find messages directed to me, fill in return information */
-   errcount = 0;
-   rbufftmp = rbuff;
-   for (i = 0; i < nrec; i++)  {
+   rbufftmp = req->rbuff;
+   for (i = 0; i < req->nrec; i++)  {
       ptr = (DD_Find_Msg*) rbufftmp;
       rbufftmp += dd->find_msg_size;
-      err = DD_Find_Local (dd, ptr->id, ptr->id,
-                           (char *)(ptr->id + dd->max_id_length),
-                           &ptr->partition, &ptr->proc);
-      if (err == ZOLTAN_WARN)
-          ++errcount;
+      DD_Find_Local (dd, &dd->table, ptr->id, ptr->id,
+                     (char *)(ptr->id + dd->max_id_length),
+                     &ptr->partition, &ptr->proc);
    }
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After fill in return info");
 
    /* send return information back to requester */
-   err = Zoltan_Comm_Do_Reverse(plan, ZOLTAN_DD_FIND_MSG_TAG+2, rbuff,
-    dd->find_msg_size, NULL, sbuff);
+   err = Zoltan_Comm_Do_Reverse(req->plan, ZOLTAN_DD_FIND_MSG_TAG+2,
+    req->rbuff, dd->find_msg_size, NULL, req->sbuff);
    if (err != ZOLTAN_OK)
       goto fini;
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Reverse");
 
    /* fill in user supplied lists with returned information */
-   sbufftmp = sbuff;
-   for (i = 0; i < count; i++) {
+   sbufftmp = req->sbuff;
+   for (i = 0; i < req->nsend; i++) {
       ptr = (DD_Find_Msg*) sbufftmp;
       sbufftmp += dd->find_msg_size;
 
-      if (owner)
-         owner[ptr->index] = ptr->proc;
-      if (partition)
-         partition[ptr->index] = ptr->partition ;
-      if (lid)
-         ZOLTAN_SET_ID(dd->lid_length,lid+ptr->index*dd->lid_length,ptr->id);
-      if (data)
-         memcpy(data + (size_t)(ptr->index) * (size_t)(dd->user_data_length),
+      if (ptr->proc == -1)
+         ++*errcount;
+
+      /* remember answers from other processors' directories, unless an
+       * Update or Remove has completed since Find_Begin */
+      if (dd->cache_max > 0 && dd->cache_epoch == dd->epoch
+       && req->procs[i] != dd->my_proc && ptr->proc != -1)
+         DD_Find_Cache (dd, req->gid + ptr->index * dd->gid_length, ptr->id,
+                        (char *)(ptr->id + dd->max_id_length),
+                        ptr->partition, ptr->proc);
+
+      if (req->owner)
+         req->owner[ptr->index] = ptr->proc;
+      if (req->partition)
+         req->partition[ptr->index] = ptr->partition ;
+      if (req->lid)
+         ZOLTAN_SET_ID(dd->lid_length, req->lid + ptr->index*dd->lid_length,
+                       ptr->id);
+      if (req->data)
+         memcpy(req->data + (size_t)(ptr->index)
+                          * (size_t)(dd->user_data_length),
                 ptr->id + dd->max_id_length, dd->user_data_length);
    }
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After fill return lists");
-/*    err = ZOLTAN_OK;     */
 
-   MPI_Allreduce(&errcount, &err, 1, MPI_INT, MPI_SUM, dd->comm);
-   err = (err) ? ZOLTAN_WARN : ZOLTAN_OK;
+   err = (*errcount) ? ZOLTAN_WARN : ZOLTAN_OK;
 
    /* if at least one GID was not found, potentially notify caller of error */
    if (dd->debug_level > 0)  {
       char str[100];      /* diagnostic message string */
-      sprintf (str, "Processed %d GIDs, GIDs not found: %d", count, errcount);
+      sprintf (str, "Processed %d GIDs, GIDs not found: %d", req->count,
+               *errcount);
       ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
    }
 
 fini:
-   ZOLTAN_FREE (&sbuff);
-   ZOLTAN_FREE (&rbuff);
-   ZOLTAN_FREE (&procs) ;
-   Zoltan_Comm_Destroy (&plan);
+   DD_Request_Free (request);
 
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
@@ -273,11 +414,12 @@ fini:
 /******************  DD_Find_Local()  ***************************/
 
 /* For a given gid, DD_Find_Local() provides its local ID, owner, optional
- * user data, and partition from the local distributed directory. An error
- * is returned if the gid is not found.
+ * user data, and partition from the local distributed directory (or from
+ * the Find cache). An error is returned if the gid is not found.
 */
 
 static int DD_Find_Local (Zoltan_DD_Directory *dd,
+ DD_Table *tab,             /* dd->table or dd->cache                 */
  ZOLTAN_ID_PTR gid,         /* incoming GID to locate (in)            */
  ZOLTAN_ID_PTR lid,         /* gid's LID (out)                        */
  char *user,                /* gid's user data (out)                  */
@@ -285,8 +427,6 @@ static int DD_Find_Local (Zoltan_DD_Directory *dd,
  int *owner)                /* gid's owner (processor number) (out)   */
 {
    DD_Node *ptr;
-   DD_NodeIdx nodeidx;
-   int      index;
    char    *yo = "DD_Find_Local";
 
    /* input sanity check */
@@ -297,26 +437,21 @@ static int DD_Find_Local (Zoltan_DD_Directory *dd,
    if (dd->debug_level > 5)
       ZOLTAN_TRACE_IN (dd->my_proc, yo, NULL);
 
-   /* compute offset into hash table to find head of linked list */
-   index = Zoltan_DD_Hash2 (gid, dd->gid_length, dd->table_length,
-                            dd->hashdata, NULL);
-   /* walk link list until end looking for matching global ID */
-   for (nodeidx = dd->table[index]; nodeidx != -1;
-        nodeidx = dd->nodelist[nodeidx].next) {
-      ptr = dd->nodelist + nodeidx;
-      if (ZOLTAN_EQ_ID (dd->gid_length, gid, ptr->gid) == TRUE)  {
-         /* matching global ID found! Return gid's information */
-         if (lid) ZOLTAN_SET_ID(dd->lid_length, lid, ptr->gid + dd->gid_length);
-         if (user) memcpy(user, ptr->gid + (dd->gid_length + dd->lid_length),
-                          dd->user_data_length);
-
-         if (owner)     *owner     = ptr->owner;
-         if (partition) *partition = ptr->partition;
-
-         if (dd->debug_level > 5)
-            ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
-         return ZOLTAN_OK;
-      }
+   /* probe the hash table for the matching global ID */
+   ptr = DD_Memory_Find_Node (dd, tab, gid,
+                              Zoltan_DD_Hash_Local (gid, dd->gid_length));
+   if (ptr != NULL)  {
+      /* matching global ID found! Return gid's information */
+      if (lid) ZOLTAN_SET_ID(dd->lid_length, lid, ptr->gid + dd->gid_length);
+      if (user) memcpy(user, ptr->gid + (dd->gid_length + dd->lid_length),
+                       dd->user_data_length);
+
+      if (owner)     *owner     = ptr->owner;
+      if (partition) *partition = ptr->partition;
+
+      if (dd->debug_level > 5)
+         ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
+      return ZOLTAN_OK;
    }
 
 
@@ -325,13 +460,52 @@ static int DD_Find_Local (Zoltan_DD_Directory *dd,
    if (dd->debug_level > 5)
       ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
 
-   if (dd->debug_level > 0)  {
+   if (dd->debug_level > 0 && tab == &dd->table)  {
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "GID not found");
       return ZOLTAN_WARN;
    }
    return ZOLTAN_WARN;
 }
 
+
+
+/******************  DD_Find_Cache()  ***************************/
+
+/* DD_Find_Cache() remembers another processor's answer for gid so that
+ * later Finds of gid need no communication.  When the cache holds
+ * dd->cache_max GIDs it is emptied and starts over.
+*/
+
+static void DD_Find_Cache (Zoltan_DD_Directory *dd,
+ ZOLTAN_ID_PTR gid,         /* GID that was found (in)                */
+ ZOLTAN_ID_PTR lid,         /* its LID (in)                           */
+ char *user,                /* its user data (in)                     */
+ int partition,             /* its partition number (in)              */
+ int owner)                 /* its owner (in)                         */
+{
+   DD_Node     *ptr;
+   unsigned int hash = Zoltan_DD_Hash_Local (gid, dd->gid_length);
+
+   /* the same GID may be asked for more than once in a single Find */
+   if (DD_Memory_Find_Node (dd, &dd->cache, gid, hash) != NULL)
+      return;
+
+   if (dd->cache.count >= dd->cache_max)
+      DD_Memory_Clear_Table (dd, &dd->cache);
+
+   /* if memory runs out, just don't cache this answer */
+   ptr = DD_Memory_Alloc_Node (dd, &dd->cache, gid, hash);
+   if (ptr == NULL)
+      return;
+
+   ptr->owner     = owner;
+   ptr->partition = partition;
+   ZOLTAN_SET_ID (dd->gid_length, ptr->gid, gid);
+   ZOLTAN_SET_ID (dd->lid_length, ptr->gid + dd->gid_length, lid);
+   memcpy(ptr->gid + (dd->gid_length + dd->lid_length), user,
+          dd->user_data_length);
+}
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
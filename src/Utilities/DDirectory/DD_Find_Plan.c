@@ -0,0 +1,312 @@
+/* 
+ * @HEADER
+ *
+ * ***********************************************************************
+ *
+ *  Zoltan Toolkit for Load-balancing, Partitioning, Ordering and Coloring
+ *                  Copyright 2012 Sandia Corporation
+ *
+ * Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ * the U.S. Government retains certain rights in this software.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the Corporation nor the names of the
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Questions? Contact Karen Devine	kddevin@sandia.gov
+ *                    Erik Boman	egboman@sandia.gov
+ *
+ * ***********************************************************************
+ *
+ * @HEADER
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DD.h"
+#include "DD_Memory.h"
+
+
+#ifdef __cplusplus
+/* if C++, define the rest of this header file as extern C */
+extern "C" {
+#endif
+
+
+/*  NOTE: See file, README, for associated documentation. */
+
+
+/******************  Zoltan_DD_Find_Prepare()  ********************/
+
+/* Zoltan_DD_Find_Prepare() does the part of Zoltan_DD_Find() that only
+ * depends on the list of GIDs: it hashes each GID to its directory
+ * processor, builds the communication plan and sends the GIDs.  The
+ * returned plan answers the same query, against the directory's current
+ * contents, with each Zoltan_DD_Find_Execute().
+*/
+
+int Zoltan_DD_Find_Prepare (
+ Zoltan_DD_Directory *dd,     /* contains directory state information     */
+ ZOLTAN_ID_PTR gid,           /* Incoming list of GIDs to find            */
+ int count,                   /* Count of GIDs in above list              */
+ Zoltan_DD_Find_Plan **fplan) /* Outgoing plan for Zoltan_DD_Find_Execute */
+{
+   Zoltan_DD_Find_Plan *fp = NULL;
+   ZOLTAN_COMM_OBJ *plan   = NULL;
+   ZOLTAN_ID_PTR    sbuff  = NULL;    /* GIDs, grouped by processor      */
+   int             *procs  = NULL;    /* directory processor of each GID */
+   int             *start  = NULL;    /* first GID sent to each proc     */
+   int              i, j;
+   int              err = ZOLTAN_OK;
+   char            *yo = "Zoltan_DD_Find_Prepare";
+
+   /* input sanity check */
+   if (dd == NULL || count < 0 || (gid == NULL && count > 0) || fplan == NULL){
+      ZOLTAN_PRINT_ERROR (dd ? dd->my_proc : ZOLTAN_DD_NO_PROC, yo,
+       "Invalid input argument");
+      return ZOLTAN_FATAL;
+   }
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
+
+   *fplan = fp = (Zoltan_DD_Find_Plan *) ZOLTAN_CALLOC (1, sizeof (*fp));
+   start = (int *) ZOLTAN_CALLOC (dd->nproc + 1, sizeof (int));
+   if (fp == NULL || start == NULL)  {
+      err = ZOLTAN_MEMERR;
+      goto fini;
+   }
+   fp->dd       = dd;
+   fp->hash     = dd->hash;
+   fp->hashdata = dd->hashdata;
+   fp->hashfn   = dd->hashfn;
+   fp->count    = count;
+
+   if (count)  {
+      procs      = (int *) ZOLTAN_MALLOC (sizeof(int) * count);
+      fp->order  = (int *) ZOLTAN_MALLOC (sizeof(int) * count);
+      sbuff      = (ZOLTAN_ID_PTR) ZOLTAN_MALLOC (sizeof(ZOLTAN_ID_TYPE)
+                                                  * count * dd->gid_length);
+      fp->answers = (char *) ZOLTAN_MALLOC ((size_t) count * dd->find_msg_size);
+      if (procs == NULL || fp->order == NULL || sbuff == NULL
+       || fp->answers == NULL)  {
+         err = ZOLTAN_MEMERR;
+         goto fini;
+      }
+   }
+
+   /* group the GIDs by directory processor, so the plan needs no indices
+    * and the answers come back in the same order */
+   for (i = 0; i < count; i++)  {
+      procs[i] = dd->hash (gid + i*dd->gid_length, dd->gid_length, dd->nproc,
+                           dd->hashdata, dd->hashfn);
+      start[procs[i]+1]++;
+   }
+   for (i = 0; i < dd->nproc; i++)
+      start[i+1] += start[i];
+   for (i = 0; i < count; i++)  {
+      j = start[procs[i]]++;
+      fp->order[j] = i;
+      ZOLTAN_SET_ID (dd->gid_length, sbuff + j*dd->gid_length,
+                     gid + i*dd->gid_length);
+   }
+   /* start[i] is now the end of processor i's group */
+   for (i = 0, j = 0; i < dd->nproc; i++)
+      while (j < start[i])
+         procs[j++] = i;
+
+   err = Zoltan_Comm_Create (&plan, count, procs, dd->comm,
+    ZOLTAN_DD_FIND_PLAN_TAG, &fp->nrec);
+   if (err != ZOLTAN_OK)
+      goto fini;
+
+   if (fp->nrec)  {
+      fp->gid      = (ZOLTAN_ID_PTR) ZOLTAN_MALLOC (sizeof(ZOLTAN_ID_TYPE)
+                                                * fp->nrec * dd->gid_length);
+      fp->gid_hash = (unsigned int *) ZOLTAN_MALLOC (fp->nrec
+                                                     * sizeof (unsigned int));
+      fp->replies  = (char *) ZOLTAN_MALLOC ((size_t) fp->nrec
+                                             * dd->find_msg_size);
+      if (fp->gid == NULL || fp->gid_hash == NULL || fp->replies == NULL)  {
+         err = ZOLTAN_MEMERR;
+         goto fini;
+      }
+   }
+
+   /* send the GIDs to their directory processors, once */
+   err = Zoltan_Comm_Do (plan, ZOLTAN_DD_FIND_PLAN_TAG+1, (char *) sbuff,
+    dd->gid_length * sizeof (ZOLTAN_ID_TYPE), (char *) fp->gid);
+   if (err != ZOLTAN_OK)
+      goto fini;
+
+   for (i = 0; i < fp->nrec; i++)
+      fp->gid_hash[i] = Zoltan_DD_Hash_Local (fp->gid + i*dd->gid_length,
+                                              dd->gid_length);
+
+   /* from now on, only answers travel, from directory to requester */
+   err = Zoltan_Comm_Invert_Plan (&plan);
+   if (err != ZOLTAN_OK)
+      goto fini;
+   fp->plan = plan;
+   plan = NULL;
+
+fini:
+   ZOLTAN_FREE (&sbuff);
+   ZOLTAN_FREE (&procs);
+   ZOLTAN_FREE (&start);
+   Zoltan_Comm_Destroy (&plan);
+   if (err != ZOLTAN_OK)  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to prepare find");
+      Zoltan_DD_Find_Destroy (fplan);
+   }
+
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
+   return err;
+}
+
+
+
+/******************  Zoltan_DD_Find_Execute()  ********************/
+
+/* Zoltan_DD_Find_Execute() returns the same information as Zoltan_DD_Find()
+ * for the GIDs given to Zoltan_DD_Find_Prepare(), reflecting all updates
+ * and removals since.  Only the answers are communicated.
+*/
+
+int Zoltan_DD_Find_Execute (
+ Zoltan_DD_Find_Plan *fp, /* plan from Zoltan_DD_Find_Prepare()          */
+ ZOLTAN_ID_PTR lid,       /* Outgoing corresponding list of LIDs         */
+ char *data,              /* Outgoing optional corresponding user data   */
+ int *partition,          /* Outgoing optional partition information     */
+ int *owner)              /* Outgoing optional list of data owners       */
+{
+   Zoltan_DD_Directory *dd;
+   DD_Find_Msg     *ptr;
+   DD_Node         *node;
+   int              i;
+   int              err;
+   int              errcount;         /* count of GIDs not found         */
+   char            *yo = "Zoltan_DD_Find_Execute";
+
+   /* input sanity check */
+   if (fp == NULL || fp->dd == NULL)  {
+      ZOLTAN_PRINT_ERROR (ZOLTAN_DD_NO_PROC, yo, "Invalid input argument");
+      return ZOLTAN_FATAL;
+   }
+   dd = fp->dd;
+   if (dd->hash != fp->hash || dd->hashdata != fp->hashdata
+    || dd->hashfn != fp->hashfn)  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo,
+       "Hash function changed since Zoltan_DD_Find_Prepare");
+      return ZOLTAN_FATAL;
+   }
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
+
+   /* answer the GIDs asked of my directory */
+   errcount = 0;
+   for (i = 0; i < fp->nrec; i++)  {
+      ptr  = (DD_Find_Msg *) (fp->replies + (size_t) i * dd->find_msg_size);
+      node = DD_Memory_Find_Node (dd, &dd->table, fp->gid + i*dd->gid_length,
+                                  fp->gid_hash[i]);
+      if (node == NULL)  {
+         ptr->proc = -1;
+         ++errcount;
+         continue;
+      }
+      ptr->proc      = node->owner;
+      ptr->partition = node->partition;
+      ZOLTAN_SET_ID (dd->lid_length, ptr->id, node->gid + dd->gid_length);
+      memcpy (ptr->id + dd->max_id_length,
+              node->gid + (dd->gid_length + dd->lid_length),
+              dd->user_data_length);
+   }
+
+   err = Zoltan_Comm_Do (fp->plan, ZOLTAN_DD_FIND_PLAN_TAG+2, fp->replies,
+    dd->find_msg_size, fp->answers);
+   if (err != ZOLTAN_OK)
+      goto fini;
+
+   /* fill in user supplied lists; answers are grouped like the GIDs sent */
+   for (i = 0; i < fp->count; i++)  {
+      int j = fp->order[i];
+      ptr = (DD_Find_Msg *) (fp->answers + (size_t) i * dd->find_msg_size);
+
+      if (owner)
+         owner[j] = ptr->proc;
+      if (ptr->proc == -1)
+         continue;
+      if (partition)
+         partition[j] = ptr->partition;
+      if (lid)
+         ZOLTAN_SET_ID (dd->lid_length, lid + j*dd->lid_length, ptr->id);
+      if (data)
+         memcpy (data + (size_t) j * (size_t) (dd->user_data_length),
+                 ptr->id + dd->max_id_length, dd->user_data_length);
+   }
+
+   MPI_Allreduce(&errcount, &err, 1, MPI_INT, MPI_SUM, dd->comm);
+   err = (err) ? ZOLTAN_WARN : ZOLTAN_OK;
+
+   if (dd->debug_level > 0)  {
+      char str[100];      /* diagnostic message string */
+      sprintf (str, "Processed %d GIDs, GIDs not found: %d", fp->count,
+               errcount);
+      ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
+   }
+
+fini:
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
+   return err;
+}
+
+
+
+/******************  Zoltan_DD_Find_Destroy()  ********************/
+
+void Zoltan_DD_Find_Destroy (Zoltan_DD_Find_Plan **fplan)
+{
+   if (fplan == NULL || *fplan == NULL)
+      return;
+
+   Zoltan_Comm_Destroy (&(*fplan)->plan);
+   ZOLTAN_FREE (&(*fplan)->order);
+   ZOLTAN_FREE (&(*fplan)->answers);
+   ZOLTAN_FREE (&(*fplan)->gid);
+   ZOLTAN_FREE (&(*fplan)->gid_hash);
+   ZOLTAN_FREE (&(*fplan)->replies);
+   ZOLTAN_FREE (fplan);
+}
+
+
+#ifdef __cplusplus
+} /* closing bracket for extern "C" */
+#endif
@@ -97,6 +97,19 @@ unsigned int Zoltan_DD_Hash2(ZOLTAN_ID_PTR key, int num_id_entries,
   return(k % n);
 }
 
+unsigned int Zoltan_DD_Hash_Local(ZOLTAN_ID_PTR key, int num_id_entries)
+{
+/* Full 32-bit hash used to place a GID in its owner's local hash table.
+ * The seed differs from Zoltan_DD_Hash2's, so the slot is independent of
+ * the processor the GID was hashed to.  Never returns 0, which marks an
+ * empty slot.
+ */
+  uint32_t k;
+  MurmurHash3_x86_32((void *)key, sizeof(ZOLTAN_ID_TYPE)*num_id_entries,
+                     15, (void *)&k);
+  return(k ? k : 1);
+}
+
 #endif  /* ZZ_MURMUR_HASH */
 
 #ifdef ZZ_KNUTH_HASH
@@ -150,6 +163,18 @@ unsigned int Zoltan_DD_Hash2(ZOLTAN_ID_PTR key, int num_id_entries,
   return (h%n);
 }
 
+unsigned int Zoltan_DD_Hash_Local(ZOLTAN_ID_PTR key, int num_id_entries)
+{
+/* Full 32-bit hash used to place a GID in its owner's local hash table;
+ * never returns 0, which marks an empty slot.  The multiply-shift mixes
+ * the high bits of Zoltan_DD_Hash2 into the low bits used for the slot.
+ */
+  unsigned int h = Zoltan_DD_Hash2(key, num_id_entries, 0xFFFFFFFFU,
+                                   NULL, NULL);
+  h = (h * ZOLTAN_DD_HASH_CONSTANT) ^ (h >> 16);
+  return (h ? h : 1);
+}
+
 #endif /* ZOLTAN_KNUTH_HASH */
 
 
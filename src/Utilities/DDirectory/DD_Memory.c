@@ -49,6 +49,7 @@
 #include <stdlib.h>
 
 #include "DD.h"
+#include "DD_Memory.h"
 
 
 #ifdef __cplusplus
@@ -57,112 +58,263 @@ extern "C" {
 #endif
 
 /*
- * Idea:  Store hash table as array of bucket heads, pointing into
- * an array-based linked list of nodes (instead of to individually 
- * allocated nodes).
- * The array-based memory would have a free-memory list running
- * through it, allowing items to be added to or deleted from the 
- * directory.
+ * A DD_Table is an open addressing hash table with linear probing and
+ * Robin Hood ordering:  every run of occupied slots is sorted by home slot
+ * (hash & (length-1)), so a probe can stop as soon as it meets an
+ * entry closer to its home than the key would be.  Removal shifts the rest
+ * of the run back by one slot, so no tombstones are needed.  The table
+ * doubles when it becomes more than ZOLTAN_DD_MAX_LOAD full.
  */
 
+#define DD_PROBE_DIST(tab, slot, hash) \
+  (((slot) - (DD_NodeIdx) ((hash) & ((tab)->length - 1))) & ((tab)->length - 1))
+
+/******************************************************************************/
+
+static DD_Node *DD_Memory_Insert(
+  Zoltan_DD_Directory *dd,  /* directory state information    */
+  DD_Table *tab,            /* table to insert into           */
+  unsigned int hash         /* hash of the entry to insert    */
+)
+{
+/* Find the slot for a new entry in its probe run, shift the remainder of
+ * the run up to the next empty slot and return the freed slot.  The table
+ * must have at least one empty slot.
+ */
+  DD_NodeIdx slot, last, dist, mask = tab->length - 1;
+  DD_Node *ptr;
+
+  /* Skip the entries at least as far from home as the new one */
+  slot = hash & mask;
+  for (dist = 0; ; dist++) {
+    ptr = DD_NODE(dd, tab, slot);
+    if (ptr->hash == 0 || DD_PROBE_DIST(tab, slot, ptr->hash) < dist)
+      break;
+    slot = (slot + 1) & mask;
+  }
+
+  if (ptr->hash != 0) {
+    for (last = slot; DD_NODE(dd, tab, last)->hash != 0; last = (last + 1) & mask);
+    for (; last != slot; last = (last - 1) & mask)
+      memcpy(DD_NODE(dd, tab, last), DD_NODE(dd, tab, (last - 1) & mask), dd->node_size);
+  }
+  return ptr;
+}
+
 /******************************************************************************/
-int DD_Memory_Alloc_Nodelist(
+
+static int DD_Memory_Rehash(
   Zoltan_DD_Directory *dd,  /* directory state information    */
-  DD_NodeIdx count,         /* Number of GIDs in update list  */
-  float overalloc           /* Percentage to extra nodes to
-                               allocate (for future dynamic 
-                               additions).                    */
+  DD_Table *tab,            /* table to grow                  */
+  DD_NodeIdx newlen         /* new # of slots; power of 2     */
 )
 {
-/* Allocate node memory and initialize it to be all free. */
-/* Return error code if memory alloc fails.               */
-  int ierr = ZOLTAN_OK;
+/* Move all nodes into a new table of newlen slots. */
+  char *oldtable = tab->nodes;
+  DD_NodeIdx oldlen = tab->length;
+  DD_NodeIdx i;
   DD_Node *ptr;
-  char *dataptr;
-  DD_NodeIdx nodeidx;
-  DD_NodeIdx len = count * (1. + overalloc);
-
-  dd->nodelistlen = len;
-
-  if (len > 0) {
-
-    dd->nodelist = (DD_Node *) ZOLTAN_MALLOC(sizeof(DD_Node) * len);
-    dd->nodedata = (char *) ZOLTAN_MALLOC(dd->nodedata_size * len);
-    /* TODO ADD ERROR CHECK */
-
-    /* Initialize the freenode list; all nodes are initially free. */
-    /* Also initialize gid pointers to nodedata.                   */
-    dd->nextfreenode = 0;
-    for (ptr = dd->nodelist, dataptr = dd->nodedata, nodeidx = 0; 
-         nodeidx < len;
-         nodeidx++, ptr++, dataptr += dd->nodedata_size) {
-      ptr->next = nodeidx + 1;
-      ptr->gid = (ZOLTAN_ID_PTR) dataptr;
-    }
-    dd->nodelist[len-1].next = -1;  /* NULL value at end of list */
+
+  tab->nodes = (char *) ZOLTAN_CALLOC(newlen, dd->node_size);
+  if (tab->nodes == NULL) {
+    tab->nodes = oldtable;
+    return ZOLTAN_MEMERR;
+  }
+  tab->length = newlen;
+
+  for (i = 0; i < oldlen; i++) {
+    ptr = (DD_Node *) (oldtable + (size_t) i * dd->node_size);
+    if (ptr->hash != 0)
+      memcpy(DD_Memory_Insert(dd, tab, ptr->hash), ptr, dd->node_size);
   }
 
-  return ierr;
+  ZOLTAN_FREE(&oldtable);
+  return ZOLTAN_OK;
 }
 
 /******************************************************************************/
 
-DD_NodeIdx DD_Memory_Alloc_Node(Zoltan_DD_Directory *dd)
+int DD_Memory_Alloc_Table(
+  Zoltan_DD_Directory *dd,  /* directory state information    */
+  DD_Table *tab,            /* table to make room in          */
+  DD_NodeIdx count          /* Number of nodes about to be added */
+)
 {
-/* "allocate" a node by removing it from the free list and returning
- * its NodeIdx.
+/* Make room for count more nodes, growing the table if it would become
+ * more than ZOLTAN_DD_MAX_LOAD full.  Return error code if memory alloc
+ * fails or the table would need more than ZOLTAN_DD_MAX_TABLE_LENGTH slots.
  */
-DD_NodeIdx returnnode;
-
-  if (dd->nextfreenode == -1) {
-    /* No more room for new nodes in the node list.
-     * Realloc memory and set up a new freelist.
-     */
-    DD_NodeIdx newlen = dd->nodelistlen * 2;
-    DD_NodeIdx nodeidx;
-    DD_Node *ptr;
-    char *dataptr;
-
-    dd->nodelist = (DD_Node *) ZOLTAN_REALLOC(dd->nodelist,
-                                              sizeof(DD_Node) * newlen);
-    dd->nodedata = (char *) ZOLTAN_REALLOC(dd->nodedata,
-                                           dd->nodedata_size * newlen);
-    /* TODO ADD ERROR CHECK */
-
-    /* Reinitialize the gid pointers in the realloc'ed nodelist. */
-    for (ptr = dd->nodelist, dataptr = dd->nodedata, nodeidx = 0;
-         nodeidx < newlen;
-         ptr++, dataptr += dd->nodedata_size, nodeidx++) 
-      ptr->gid = (ZOLTAN_ID_PTR) dataptr;
-
-    /* Initialize free list in the newly extended memory */
-    dd->nextfreenode = dd->nodelistlen;
-    for (nodeidx = dd->nodelistlen; nodeidx < newlen-1; nodeidx++)
-      dd->nodelist[nodeidx].next = nodeidx+1;
-    dd->nodelist[newlen-1].next = -1;
-    dd->nodelistlen = newlen;
+  double need = (double) tab->count + count;
+  DD_NodeIdx newlen = tab->length;
+
+  if (newlen == 0)
+    newlen = (tab->hint > ZOLTAN_DD_MIN_TABLE_LENGTH)
+           ? tab->hint : ZOLTAN_DD_MIN_TABLE_LENGTH;
+  while (newlen < need / ZOLTAN_DD_MAX_LOAD) {
+    if (newlen >= ZOLTAN_DD_MAX_TABLE_LENGTH)
+      return ZOLTAN_MEMERR;          /* doubling would overflow DD_NodeIdx */
+    newlen *= 2;
   }
 
-  returnnode = dd->nextfreenode;
-  dd->nextfreenode = dd->nodelist[returnnode].next;
-  dd->nodelist[returnnode].next = -1;
+  if (newlen == tab->length)
+    return ZOLTAN_OK;
+  return DD_Memory_Rehash(dd, tab, newlen);
+}
 
-  return returnnode;
+/******************************************************************************/
+
+DD_Node *DD_Memory_Block_Node(
+  Zoltan_DD_Directory *dd,  /* directory state information    */
+  ZOLTAN_ID_PTR gid         /* GID to look up                 */
+)
+{
+/* Return gid's slot in dd->block, occupied or not, or NULL if gid is not
+ * in my range of a Zoltan_DD_Create_From_Ranges() directory.
+ */
+  if (dd->block.length == 0 || *gid < dd->block_first
+   || *gid - dd->block_first >= (ZOLTAN_ID_TYPE) dd->block.length)
+    return NULL;
+  return DD_NODE(dd, &dd->block, *gid - dd->block_first);
+}
+
+/******************************************************************************/
+
+DD_Node *DD_Memory_Find_Node(
+  Zoltan_DD_Directory *dd,  /* directory state information    */
+  DD_Table *tab,            /* table to search                */
+  ZOLTAN_ID_PTR gid,        /* GID to look up                 */
+  unsigned int hash         /* Zoltan_DD_Hash_Local(gid)      */
+)
+{
+/* Return the node holding gid, or NULL if gid is not in the directory.
+ * The directory's GIDs in my range are found by position in dd->block.
+ */
+  DD_NodeIdx slot, dist;
+  DD_Node *ptr;
+
+  if (tab == &dd->table && (ptr = DD_Memory_Block_Node(dd, gid)) != NULL)
+    return (ptr->hash != 0) ? ptr : NULL;
+
+  if (tab->length == 0)
+    return NULL;
+
+  slot = hash & (tab->length - 1);
+  for (dist = 0; ; dist++) {
+    ptr = DD_NODE(dd, tab, slot);
+    if (ptr->hash == 0 || DD_PROBE_DIST(tab, slot, ptr->hash) < dist)
+      return NULL;
+    if (ptr->hash == hash && ZOLTAN_EQ_ID(dd->gid_length, gid, ptr->gid))
+      return ptr;
+    slot = (slot + 1) & (tab->length - 1);
+  }
+}
+
+/******************************************************************************/
+
+DD_Node *DD_Memory_Alloc_Node(
+  Zoltan_DD_Directory *dd,  /* directory state information    */
+  DD_Table *tab,            /* table to add the node to       */
+  ZOLTAN_ID_PTR gid,        /* the new GID                    */
+  unsigned int hash         /* Zoltan_DD_Hash_Local of new GID */
+)
+{
+/* "allocate" a node for a GID that is not yet in the directory, growing
+ * the table if needed.  Returns the cleared node with its hash set, or
+ * NULL if the table could not grow.  The caller fills in the GID.
+ */
+  DD_Node *ptr;
+
+  if (tab == &dd->table && (ptr = DD_Memory_Block_Node(dd, gid)) != NULL) {
+    memset(ptr, 0, dd->node_size);
+    ptr->hash = hash;
+    dd->block.count++;
+    return ptr;
+  }
+
+  if (DD_Memory_Alloc_Table(dd, tab, 1) != ZOLTAN_OK)
+    return NULL;
+
+  ptr = DD_Memory_Insert(dd, tab, hash);
+  memset(ptr, 0, dd->node_size);
+  ptr->hash = hash;
+  tab->count++;
+  return ptr;
 }
 
 /******************************************************************************/
 
 void DD_Memory_Free_Node(
   Zoltan_DD_Directory *dd,
-  DD_NodeIdx freenode
+  DD_Table *tab,
+  DD_Node *freenode
+)
+{
+/* "free" a node by shifting the rest of its probe run back by one slot.
+ * A node of dd->block is just marked empty.
+ */
+  DD_NodeIdx mask, slot, next;
+  DD_Node *ptr;
+
+  if (tab == &dd->table
+   && DD_Memory_Block_Node(dd, freenode->gid) == freenode) {
+    freenode->hash = 0;
+    dd->block.count--;
+    return;
+  }
+
+  mask = tab->length - 1;
+  slot = (DD_NodeIdx) (((char *) freenode - tab->nodes) / dd->node_size);
+  next = (slot + 1) & mask;
+  for (ptr = DD_NODE(dd, tab, next);
+       ptr->hash != 0 && DD_PROBE_DIST(tab, next, ptr->hash) > 0;
+       ptr = DD_NODE(dd, tab, next)) {
+    memcpy(DD_NODE(dd, tab, slot), ptr, dd->node_size);
+    slot = next;
+    next = (next + 1) & mask;
+  }
+  DD_NODE(dd, tab, slot)->hash = 0;
+  tab->count--;
+}
+
+/******************************************************************************/
+
+void DD_Memory_Clear_Table(
+  Zoltan_DD_Directory *dd,
+  DD_Table *tab
+)
+{
+/* Remove all nodes but keep the table's memory. */
+  if (tab->count)
+    memset(tab->nodes, 0, (size_t) tab->length * dd->node_size);
+  tab->count = 0;
+}
+
+/******************************************************************************/
+
+void DD_Memory_Free_Table(
+  DD_Table *tab
+)
+{
+/* Release the table's memory; the table can be reused afterwards. */
+  ZOLTAN_FREE(&tab->nodes);
+  tab->length = tab->count = 0;
+}
+
+/******************************************************************************/
+
+void DD_Request_Free(
+  Zoltan_DD_Request **request
 )
 {
-/* "free" a node by returning it to the free list.  */
-  
-  /* TODO Error check:  freenode should be < nodelistlen */
+/* Release a Find or Update request and its communication buffers. */
+  if (request == NULL || *request == NULL)
+    return;
 
-  dd->nodelist[freenode].next = dd->nextfreenode;
-  dd->nextfreenode = freenode;
+  Zoltan_Comm_Destroy(&(*request)->plan);
+  ZOLTAN_FREE(&(*request)->procs);
+  ZOLTAN_FREE(&(*request)->sbuff);
+  ZOLTAN_FREE(&(*request)->rbuff);
+  ZOLTAN_FREE(request);
 }
 
 #ifdef __cplusplus
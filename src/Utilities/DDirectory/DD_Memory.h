@@ -58,9 +58,17 @@
 extern "C" {
 #endif
 
-extern int *DD_Memory_Alloc_Nodelist(Zoltan_DD_Directory *, DD_NodeIdx , float);
-extern DD_NodeIdx DD_Memory_Alloc_Node(Zoltan_DD_Directory *);
-extern void DD_Memory_Free_Node(Zoltan_DD_Directory*, DD_NodeIdx);
+extern int DD_Memory_Alloc_Table(Zoltan_DD_Directory *, DD_Table *,
+                                 DD_NodeIdx);
+extern DD_Node *DD_Memory_Find_Node(Zoltan_DD_Directory *, DD_Table *,
+                                    ZOLTAN_ID_PTR, unsigned int);
+extern DD_Node *DD_Memory_Alloc_Node(Zoltan_DD_Directory *, DD_Table *,
+                                     ZOLTAN_ID_PTR, unsigned int);
+extern DD_Node *DD_Memory_Block_Node(Zoltan_DD_Directory *, ZOLTAN_ID_PTR);
+extern void DD_Memory_Free_Node(Zoltan_DD_Directory *, DD_Table *, DD_Node *);
+extern void DD_Memory_Clear_Table(Zoltan_DD_Directory *, DD_Table *);
+extern void DD_Memory_Free_Table(DD_Table *);
+extern void DD_Request_Free(Zoltan_DD_Request **);
 
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
@@ -69,8 +69,8 @@ extern "C" {
 int Zoltan_DD_Print (
  Zoltan_DD_Directory *dd)        /* contains directory state information */
 {
-   int      i,j;
-   DD_NodeIdx nodeidx;
+   int      i,j,t;
+   DD_Table *tab;
    DD_Node *ptr;
    char    *yo = "Zoltan_DD_Print";
 
@@ -83,25 +83,28 @@ int Zoltan_DD_Print (
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_IN (dd->my_proc, yo, NULL);
 
-   /* walk linked list printing each node */
-   for (i = 0; i < dd->table_length; i++)
-      for (nodeidx = dd->table[i]; nodeidx != -1;
-           nodeidx = dd->nodelist[nodeidx].next) {
-         ptr = dd->nodelist + nodeidx;
-         printf ("ZOLTAN DD Print(%d): \tList %3d, \tGID ", dd->my_proc, i);
-         printf("(");
-         for (j = 0 ; j < dd->gid_length; j++)
-            printf(ZOLTAN_ID_SPEC " ", ptr->gid[j]);
-         printf(") ");
-         if (dd->lid_length > 0)  {
-            printf("\tLID (");
-            for (j = 0; j < dd->lid_length; j++)
-               printf( ZOLTAN_ID_SPEC " ", ptr->gid[j+dd->gid_length]);
+   /* walk hash table and range block printing each node */
+   for (t = 0; t < 2; t++)  {
+      tab = (t == 0) ? &dd->table : &dd->block;
+      for (i = 0; i < tab->length; i++)
+         if (DD_NODE(dd, tab, i)->hash != 0) {
+            ptr = DD_NODE(dd, tab, i);
+            printf ("ZOLTAN DD Print(%d): \t%s %3d, \tGID ", dd->my_proc,
+             (t == 0) ? "Slot" : "Block", i);
+            printf("(");
+            for (j = 0 ; j < dd->gid_length; j++)
+               printf(ZOLTAN_ID_SPEC " ", ptr->gid[j]);
             printf(") ");
+            if (dd->lid_length > 0)  {
+               printf("\tLID (");
+               for (j = 0; j < dd->lid_length; j++)
+                  printf( ZOLTAN_ID_SPEC " ", ptr->gid[j+dd->gid_length]);
+               printf(") ");
+            }
+            printf ("\tPart %d\n", ptr->partition);
+            printf ("\tOwner %d\n", ptr->owner);
          }
-         printf ("\tPart %d\n", ptr->partition);
-         printf ("\tOwner %d\n", ptr->owner);
-      }
+   }
 
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL) ;
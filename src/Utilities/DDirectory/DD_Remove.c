@@ -99,6 +99,8 @@ int Zoltan_DD_Remove (
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_IN (dd->my_proc, yo, NULL);
 
+   /* every processor calls Remove, so all Find caches are invalidated */
+   dd->epoch++;
 
    /* allocate memory for processor contact list */
    if (count)  {
@@ -213,8 +215,6 @@ static int DD_Remove_Local (Zoltan_DD_Directory *dd,
  ZOLTAN_ID_PTR gid)                /* GID to be removed (in)  */
 {
    DD_Node *ptr;
-   DD_NodeIdx nodeidx, prevnodeidx;
-   int index;
    char *yo = "DD_Remove_Local";
 
    /* input sanity checking */
@@ -226,28 +226,15 @@ static int DD_Remove_Local (Zoltan_DD_Directory *dd,
    if (dd->debug_level > 5)
       ZOLTAN_TRACE_IN (dd->my_proc, yo, NULL);
 
-   /* compute offset into hash table to find head of linked list */
-   index = Zoltan_DD_Hash2 (gid, dd->gid_length, dd->table_length,
-                            dd->hashdata, NULL);
-
-   /* walk linked list until end looking for matching gid (key) */
-   prevnodeidx = -1;
-   for (nodeidx = dd->table[index]; nodeidx != -1;
-      nodeidx = dd->nodelist[nodeidx].next) {
-      ptr = dd->nodelist + nodeidx;
-      if (ZOLTAN_EQ_ID(dd->gid_length, gid, ptr->gid) == TRUE)  {
-         /* found node to remove, need to preserve its next ptr */
-         if (prevnodeidx != -1)
-            dd->nodelist[prevnodeidx].next = ptr->next;
-         else
-            dd->table[index] = ptr->next;
-         DD_Memory_Free_Node(dd, nodeidx);       /* now OK to delete node */
-
-         if (dd->debug_level > 5)
-            ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
-         return ZOLTAN_OK;
-      }
-      prevnodeidx = nodeidx;
+   /* probe the hash table for the matching gid (key) */
+   ptr = DD_Memory_Find_Node (dd, &dd->table, gid,
+                              Zoltan_DD_Hash_Local (gid, dd->gid_length));
+   if (ptr != NULL)  {
+      DD_Memory_Free_Node(dd, &dd->table, ptr);       /* now OK to delete node */
+
+      if (dd->debug_level > 5)
+         ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
+      return ZOLTAN_OK;
    }
 
    /* We get here only if the global ID has not been found */
@@ -0,0 +1,102 @@
+/* 
+ * @HEADER
+ *
+ * ***********************************************************************
+ *
+ *  Zoltan Toolkit for Load-balancing, Partitioning, Ordering and Coloring
+ *                  Copyright 2012 Sandia Corporation
+ *
+ * Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ * the U.S. Government retains certain rights in this software.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the Corporation nor the names of the
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Questions? Contact Karen Devine	kddevin@sandia.gov
+ *                    Erik Boman	egboman@sandia.gov
+ *
+ * ***********************************************************************
+ *
+ * @HEADER
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "DD.h"
+#include "DD_Memory.h"
+
+
+#ifdef __cplusplus
+/* if C++, define the rest of this header file as extern C */
+extern "C" {
+#endif
+
+
+/*  NOTE: See file, README, for associated documentation. */
+
+
+/*************  Zoltan_DD_Set_Cache()  ***********************/
+
+/* Zoltan_DD_Set_Cache() lets Zoltan_DD_Find() remember up to max_entries
+ * answers from other processors' directories.  Repeated Finds of those GIDs
+ * are answered locally; only the rest are sent.  Every Zoltan_DD_Update()
+ * or Zoltan_DD_Remove() invalidates the cache.  max_entries of 0 turns the
+ * cache off and frees its memory.
+*/
+
+int Zoltan_DD_Set_Cache (
+ Zoltan_DD_Directory *dd,              /* directory state information */
+ int max_entries)                      /* max # of GIDs to cache      */
+{
+   char *yo = "Zoltan_DD_Set_Cache";
+
+   /* input sanity checking */
+   if (dd == NULL || max_entries < 0)  {
+      ZOLTAN_PRINT_ERROR (dd ? dd->my_proc : 0, yo, "Invalid input argument");
+      return ZOLTAN_FATAL ;
+   }
+
+   DD_Memory_Free_Table (&dd->cache);
+   dd->cache_max = max_entries;
+   dd->cache_epoch = dd->epoch;
+
+   /* the cache table starts small and grows with the answers it holds */
+   dd->cache.hint = 0;
+
+   if (dd->debug_level > 0)
+      ZOLTAN_PRINT_INFO (dd->my_proc, yo, "Successful");
+
+   return ZOLTAN_OK;
+}
+
+
+#ifdef __cplusplus
+} /* closing bracket for extern "C" */
+#endif
@@ -83,11 +83,16 @@ int Zoltan_DD_Set_Hash_Fn (
       ZOLTAN_PRINT_ERROR (0, yo, "Invalid input argument");
       return ZOLTAN_FATAL ;
    }
+   if (DD_Has_Ranges (dd))  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Hash function of a Zoltan_DD_Create_From_Ranges directory is fixed");
+      return ZOLTAN_FATAL;
+   }
 
    dd->hash = (DD_Hash_fn*)dd_hash_user;
    dd->hashdata = NULL;
    dd->hashfn = hash;
    dd->cleanup = (DD_Cleanup_fn*) NULL; 
+   dd->copy    = (DD_Copy_fn*) NULL;
 
    if (dd->debug_level > 0)
       ZOLTAN_PRINT_INFO (dd->my_proc, yo, "Successful");
@@ -88,6 +88,10 @@ int Zoltan_DD_Set_Neighbor_Hash_Fn1 (
      ZOLTAN_PRINT_ERROR (0, yo, "NULL DDirectory pointer");
      return ZOLTAN_FATAL;
    }
+   if (DD_Has_Ranges (dd)) {
+     ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Hash function of a Zoltan_DD_Create_From_Ranges directory is fixed");
+     return ZOLTAN_FATAL;
+   }
    if (size < 1) {
      ZOLTAN_PRINT_WARN (0, yo, "Invalid input argument; size < 1");
      return ZOLTAN_WARN;
@@ -104,6 +108,7 @@ int Zoltan_DD_Set_Neighbor_Hash_Fn1 (
    dd->hashfn  = NULL;
    dd->hashdata = hashdata;
    dd->cleanup = (DD_Cleanup_fn*) &Zoltan_DD_default_cleanup;
+   dd->copy    = (DD_Copy_fn*) NULL;
    hashdata->max_gid = size * dd->nproc;     /* larger GIDs out of range */
 
    return ZOLTAN_OK;
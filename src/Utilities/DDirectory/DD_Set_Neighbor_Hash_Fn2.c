@@ -112,6 +112,10 @@ int Zoltan_DD_Set_Neighbor_Hash_Fn2 (
       ZOLTAN_PRINT_ERROR (0, yo, "Invalid input argument");
       return ZOLTAN_FATAL;
    }
+   if (DD_Has_Ranges (dd))  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Hash function of a Zoltan_DD_Create_From_Ranges directory is fixed");
+      return ZOLTAN_FATAL;
+   }
 
   hashdata = (struct dd_nh2_struct*) ZOLTAN_MALLOC(sizeof(struct dd_nh2_struct));
   if (hashdata == NULL) {
@@ -125,6 +129,7 @@ int Zoltan_DD_Set_Neighbor_Hash_Fn2 (
    dd->hashdata = hashdata;
    dd->hashfn    = NULL;
    dd->cleanup = (DD_Cleanup_fn*)&dd_nh2_cleanup;
+   dd->copy    = (DD_Copy_fn*) NULL;
 
    /* malloc and initialize storage for range information structures */
    hashdata->ptr = (Range_Info*)  ZOLTAN_MALLOC (n * sizeof (Range_Info));
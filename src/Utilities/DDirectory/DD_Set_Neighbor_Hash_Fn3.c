@@ -91,6 +91,10 @@ int Zoltan_DD_Set_Neighbor_Hash_Fn3 (
     ZOLTAN_PRINT_ERROR (0, yo, "Invalid input argument");
     return ZOLTAN_FATAL;
   }
+  if (DD_Has_Ranges (dd)) {
+    ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Hash function of a Zoltan_DD_Create_From_Ranges directory is fixed");
+    return ZOLTAN_FATAL;
+  }
 
   hashdata = (struct dd_nh3_struct*) ZOLTAN_MALLOC(sizeof(struct dd_nh3_struct));
   if (hashdata == NULL) {
@@ -107,6 +111,7 @@ int Zoltan_DD_Set_Neighbor_Hash_Fn3 (
   dd->hashdata    = hashdata;
   dd->hashfn  = NULL;
   dd->cleanup = (DD_Cleanup_fn*)&Zoltan_DD_default_cleanup;
+  dd->copy    = (DD_Copy_fn*) NULL;
 
   return ZOLTAN_OK;
 }
@@ -70,14 +70,13 @@ void Zoltan_DD_Stats (
  Zoltan_DD_Directory *dd)   /* directory state information */
 {
    int node_count = 0;     /* counts Nodes in local directory      */
-   int maxlength  = 0;     /* length of longest linked list        */
-   int list_count = 0;     /* number of linked lints in hash table */
+   int maxlength  = 0;     /* longest probe from a node's home slot */
+   double sumlength = 0.;  /* sum of probe lengths, for the average */
 
    int      length;
    int      i;
-   DD_NodeIdx nodeidx;
    DD_Node *ptr;
-   char     str[100];      /* used to build message string */
+   char     str[200];      /* used to build message string */
    char    *yo = "Zoltan_DD_Stats";
 
 
@@ -90,31 +89,45 @@ void Zoltan_DD_Stats (
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_IN (dd->my_proc, yo, NULL);
 
-   /* walk down each list in hash table to find every Node */
-   for (i = 0; i < dd->table_length; i++) {
-      length = 0;                    /* reset length for next count */
-      if (dd->table[i] != -1)
-         list_count++;               /* count of distict linked lists */
-
-      for (nodeidx = dd->table[i]; nodeidx != -1;
-           nodeidx = dd->nodelist[nodeidx].next) {
-         ptr = dd->nodelist + nodeidx;
-         if (dd->debug_level > 6) {
-            sprintf(str, "GID " ZOLTAN_ID_SPEC ", Owner %d, Table Index %d.",
-                    *ptr->gid, ptr->owner, i);
-            ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
-         }
-         length++;                  /* linked list length */
-         node_count++;              /* count of Nodes */
+   /* visit every occupied slot of the hash table */
+   for (i = 0; i < dd->table.length; i++) {
+      ptr = DD_NODE(dd, &dd->table, i);
+      if (ptr->hash == 0)
+         continue;
+      if (dd->debug_level > 6) {
+         sprintf(str, "GID " ZOLTAN_ID_SPEC ", Owner %d, Table Index %d.",
+                 *ptr->gid, ptr->owner, i);
+         ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
       }
+      /* number of slots probed to find this node */
+      length = ((i - (int) (ptr->hash & (dd->table.length - 1)))
+             & (dd->table.length - 1)) + 1;
+      sumlength += length;
+      node_count++;                 /* count of Nodes */
       if (length > maxlength)
-         maxlength = length;        /* save length of longest linked list */
+         maxlength = length;        /* save longest probe */
    }
 
-   sprintf(str, "Hash table size %d, %d nodes on %d lists, max list length %d.",
-           dd->table_length, node_count, list_count, maxlength);
+   sprintf(str, "Hash table size %d, %d nodes (load %.2f), "
+           "average probe length %.2f, max probe length %d.",
+           dd->table.length, node_count,
+           dd->table.length ? (double) node_count / dd->table.length : 0.,
+           node_count ? sumlength / node_count : 0., maxlength);
    ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
 
+   if (dd->block.length > 0)  {
+      sprintf(str, "Range block of %d GIDs holds %d nodes.",
+              dd->block.length, dd->block.count);
+      ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
+   }
+
+   if (dd->cache_max > 0)  {
+      sprintf(str, "Find cache holds %d of at most %d GIDs.",
+              (dd->cache_epoch == dd->epoch) ? dd->cache.count : 0,
+              dd->cache_max);
+      ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
+   }
+
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
 }
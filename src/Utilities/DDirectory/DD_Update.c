@@ -72,23 +72,46 @@ int Zoltan_DD_Update (
  int *partition,           /* Optional, grouping of GIDs to partitions */
  int count)                /* Number of GIDs in update list            */
 {
-   int             *procs = NULL;   /* list of processors to contact   */
+   Zoltan_DD_Request *req = NULL;
+   int                err;
+
+   err = Zoltan_DD_Update_Begin (dd, gid, lid, user, partition, count, &req);
+   if (err != ZOLTAN_OK)
+      return err;
+
+   return Zoltan_DD_Update_End (&req);
+}
+
+
+
+/******************   Zoltan_DD_Update_Begin()  *******************/
+
+/* Zoltan_DD_Update_Begin() builds the communication plan and posts the
+ * update messages to the GIDs' directory processors.  The directory is
+ * updated by Zoltan_DD_Update_End(); in between, the caller may compute
+ * while the messages arrive.
+*/
+
+int Zoltan_DD_Update_Begin (
+ Zoltan_DD_Directory *dd,  /* directory state information              */
+ ZOLTAN_ID_PTR gid,        /* Incoming list of GIDs to update          */
+ ZOLTAN_ID_PTR lid,        /* Incoming corresponding LIDs (optional)   */
+ char *user,               /* Incoming list of user data (optional)    */
+ int *partition,           /* Optional, grouping of GIDs to partitions */
+ int count,                /* Number of GIDs in update list            */
+ Zoltan_DD_Request **request) /* Outgoing handle for Update_End        */
+{
+   Zoltan_DD_Request *req = NULL;
    DD_Update_Msg   *ptr   = NULL;
-   ZOLTAN_COMM_OBJ *plan  = NULL;   /* for efficient MPI communication */
-   char            *sbuff = NULL;   /* send buffer                     */
    char            *sbufftmp = NULL;/* pointer into send buffer        */
-   char            *rbuff = NULL;   /* receive buffer                  */
-   char            *rbufftmp = NULL;/* pointer into receive buffer     */
-   int              nrec;           /* number of receives to expect    */
    int              i;
-   int              err;
-   int              errcount = 0;   /* count of GIDs not found, added  */
-   char             str[100];       /* build error message string      */
-   char            *yo = "Zoltan_DD_Update";
+   int              err = ZOLTAN_OK;
+   char            *yo = "Zoltan_DD_Update_Begin";
 
 
    /* input sanity checking */
-   if (dd == NULL || count < 0 || (gid == NULL && count > 0))  {
+   if (dd == NULL || count < 0 || (gid == NULL && count > 0)
+    || request == NULL)  {
       ZOLTAN_PRINT_ERROR ((dd == NULL ? ZOLTAN_DD_NO_PROC : dd->my_proc), yo,
        "Invalid input argument");
       return ZOLTAN_FATAL;
@@ -96,23 +119,19 @@ int Zoltan_DD_Update (
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
 
-   /* part of initializing the error checking process             */
-   /* for each linked list head, walk its list resetting errcheck */
-   if (dd->debug_level)
-      for (i = 0; i < dd->table_length; i++) {
-         DD_NodeIdx nodeidx;
-         for (nodeidx = dd->table[i]; nodeidx != -1;
-              nodeidx = dd->nodelist[nodeidx].next)
-            dd->nodelist[nodeidx].errcheck = ZOLTAN_DD_NO_PROC;
-      }
-
-   if (dd->debug_level > 6)
-      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After reset errcheck");
+   *request = req = (Zoltan_DD_Request *) ZOLTAN_CALLOC (1, sizeof (*req));
+   if (req == NULL)  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to malloc request");
+      err = ZOLTAN_MEMERR;
+      goto fini;
+   }
+   req->dd    = dd;
+   req->count = req->nsend = count;
 
    /* allocate memory for list of processors to contact */
    if (count) {
-      procs = (int*) ZOLTAN_MALLOC (sizeof(int) * count);
-      if (procs == NULL)  {
+      req->procs = (int*) ZOLTAN_MALLOC (sizeof(int) * count);
+      if (req->procs == NULL)  {
          ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to malloc proc list");
          err = ZOLTAN_MEMERR;
          goto fini;
@@ -121,8 +140,8 @@ int Zoltan_DD_Update (
 
    /* allocate memory for DD_Update_Msg send buffer */
    if (count)  {
-      sbuff = (char*) ZOLTAN_CALLOC (count, dd->update_msg_size);
-      if (sbuff == NULL)  {
+      req->sbuff = (char*) ZOLTAN_CALLOC (count, dd->update_msg_size);
+      if (req->sbuff == NULL)  {
          ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Unable to malloc send buffer");
          err = ZOLTAN_MEMERR;
          goto fini;
@@ -133,10 +152,10 @@ int Zoltan_DD_Update (
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After mallocs");
 
    /* for each GID given, fill in contact list and then message structure */
-   sbufftmp = sbuff;
+   sbufftmp = req->sbuff;
    for (i = 0; i < count; i++)  {
-      procs[i] = dd->hash(gid + i*dd->gid_length, dd->gid_length, dd->nproc,
-                          dd->hashdata, dd->hashfn);
+      req->procs[i] = dd->hash(gid + i*dd->gid_length, dd->gid_length,
+                               dd->nproc, dd->hashdata, dd->hashfn);
       ptr      = (DD_Update_Msg*) sbufftmp;
       sbufftmp += dd->update_msg_size;
 
@@ -169,8 +188,8 @@ int Zoltan_DD_Update (
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After fill contact list");
 
    /* now create efficient communication plan */
-   err = Zoltan_Comm_Create (&plan, count, procs, dd->comm,
-    ZOLTAN_DD_UPDATE_MSG_TAG, &nrec);
+   err = Zoltan_Comm_Create (&req->plan, count, req->procs, dd->comm,
+    ZOLTAN_DD_UPDATE_MSG_TAG, &req->nrec);
    if (err != ZOLTAN_OK)  {
       ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Comm_Create error");
       goto fini;
@@ -179,39 +198,110 @@ int Zoltan_DD_Update (
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Create");
 
-   /* If dd has no nodes allocated (e.g., first call to DD_Update; 
-    * create the nodelist and freelist 
-    */
-   if (nrec && dd->nodelistlen == 0) {
-      DD_Memory_Alloc_Nodelist(dd, (DD_NodeIdx) nrec, 0.); 
-                               /* TODO Add overalloc parameter */
-   }
-
    /* allocate receive buffer for nrec DD_Update_Msg structures */
-   if (nrec)  {
-      rbuff = (char*)ZOLTAN_MALLOC((size_t)nrec*(size_t)(dd->update_msg_size));
-      if (rbuff == NULL)  {
+   if (req->nrec)  {
+      req->rbuff = (char*) ZOLTAN_MALLOC ((size_t) req->nrec
+                                          * (size_t) (dd->update_msg_size));
+      if (req->rbuff == NULL)  {
          ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Receive buffer malloc failed");
          err = ZOLTAN_MEMERR;
          goto fini;
       }
    }
 
-   /* send my update messages & receive updates directed to me */
-   err = Zoltan_Comm_Do (plan, ZOLTAN_DD_UPDATE_MSG_TAG+1, sbuff,
-    dd->update_msg_size, rbuff);
+   /* send my update messages; Update_End receives those directed to me */
+   err = Zoltan_Comm_Do_Post (req->plan, ZOLTAN_DD_UPDATE_MSG_TAG+1,
+    req->sbuff, dd->update_msg_size, req->rbuff);
+   if (err != ZOLTAN_OK)  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Comm_Do_Post error");
+      goto fini;
+   }
+
+   if (dd->debug_level > 6)
+      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Do_Post");
+
+fini:
+   if (err != ZOLTAN_OK)
+      DD_Request_Free (request);
+
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
+   return err;
+}
+
+
+
+/******************   Zoltan_DD_Update_End()  *********************/
+
+int Zoltan_DD_Update_End (
+ Zoltan_DD_Request **request) /* handle from Zoltan_DD_Update_Begin    */
+{
+   Zoltan_DD_Directory *dd;
+   Zoltan_DD_Request   *req;
+   DD_Update_Msg   *ptr   = NULL;
+   char            *rbufftmp = NULL;/* pointer into receive buffer     */
+   int              i;
+   int              nnew;           /* # of GIDs that may be new       */
+   int              err;
+   int              errcount = 0;   /* count of GIDs not found, added  */
+   char             str[100];       /* build error message string      */
+   char            *yo = "Zoltan_DD_Update_End";
+
+   if (request == NULL || *request == NULL)  {
+      ZOLTAN_PRINT_ERROR (ZOLTAN_DD_NO_PROC, yo, "Invalid input argument");
+      return ZOLTAN_FATAL;
+   }
+   req = *request;
+   dd  = req->dd;
+   if (dd->debug_level > 4)
+      ZOLTAN_TRACE_IN(dd->my_proc, yo, NULL);
+
+   /* part of initializing the error checking process             */
+   /* for each occupied table slot, reset errcheck                 */
+   if (dd->debug_level)  {
+      for (i = 0; i < dd->table.length; i++)
+         DD_NODE(dd, &dd->table, i)->errcheck = ZOLTAN_DD_NO_PROC;
+      for (i = 0; i < dd->block.length; i++)
+         DD_NODE(dd, &dd->block, i)->errcheck = ZOLTAN_DD_NO_PROC;
+   }
+
+   if (dd->debug_level > 6)
+      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After reset errcheck");
+
+   /* receive updates directed to me */
+   err = Zoltan_Comm_Do_Wait (req->plan, ZOLTAN_DD_UPDATE_MSG_TAG+1,
+    req->sbuff, dd->update_msg_size, req->rbuff);
    if (err != ZOLTAN_OK)  {
-      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Comm_Do error");
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Comm_Do_Wait error");
       goto fini;
    }
 
    if (dd->debug_level > 6)
-      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Do");
+      ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Comm_Do_Wait");
+
+   /* Grow the hash table once for the worst case that every GID received
+    * is new, rather than repeatedly while inserting.  GIDs of my range
+    * have their slots in dd->block already.
+    */
+   nnew = req->nrec;
+   if (dd->block.length)
+      for (i = 0; i < req->nrec; i++)  {
+         ptr = (DD_Update_Msg *) (req->rbuff
+                                  + (size_t) i * dd->update_msg_size);
+         if (DD_Memory_Block_Node (dd, ptr->gid) != NULL)
+            --nnew;
+      }
+   if (nnew && DD_Memory_Alloc_Table(dd, &dd->table,
+                                     (DD_NodeIdx) nnew) != ZOLTAN_OK) {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Hash table malloc failed");
+      err = ZOLTAN_MEMERR;
+      goto fini;
+   }
 
    /* for each message rec'd, update local directory information */
    errcount = 0;
-   rbufftmp = rbuff;
-   for (i = 0; i < nrec; i++)  {
+   rbufftmp = req->rbuff;
+   for (i = 0; i < req->nrec; i++)  {
       ptr = (DD_Update_Msg *) rbufftmp;
       rbufftmp += dd->update_msg_size;
 
@@ -227,22 +317,24 @@ int Zoltan_DD_Update (
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO(dd->my_proc, yo, "After Local update");
 
+   /* every processor calls Update_End, so all Find caches are invalidated;
+    * not before now, as Finds between Update_Begin and Update_End still
+    * see the old directory */
+   dd->epoch++;
+
    err = ZOLTAN_OK;
    if (dd->debug_level)  /* overwrite error return if extra checking is on */
       err = (errcount) ? ZOLTAN_WARN : ZOLTAN_OK;
 
 fini:
-   ZOLTAN_FREE (&procs);
-   ZOLTAN_FREE (&sbuff);
-   ZOLTAN_FREE (&rbuff);
-   Zoltan_Comm_Destroy (&plan);
-
    if (dd->debug_level)  {
-      sprintf (str, "Processed %d GIDs (%d local), %d GID errors", count,
-       nrec, errcount);
+      sprintf (str, "Processed %d GIDs (%d local), %d GID errors", req->count,
+       req->nrec, errcount);
       ZOLTAN_PRINT_INFO (dd->my_proc, yo, str);
    }
 
+   DD_Request_Free (request);
+
    if (dd->debug_level > 4)
       ZOLTAN_TRACE_OUT(dd->my_proc, yo, NULL);
    return err;
@@ -267,9 +359,8 @@ static int DD_Update_Local (Zoltan_DD_Directory *dd,
  int partition,             /* gid's partition (in), -1 if not used      */
  int owner)                 /* gid's current owner (proc number) (in)    */
 {
-   int index;
+   unsigned int hash;
    char *yo = "DD_Update_Local";
-   DD_NodeIdx nodeidx;
    DD_Node *ptr;
 
    /* input sanity checking */
@@ -281,44 +372,43 @@ static int DD_Update_Local (Zoltan_DD_Directory *dd,
    if (dd->debug_level > 5)
       ZOLTAN_TRACE_IN (dd->my_proc, yo, NULL);
 
-   /* compute offset into hash table to find head of linked list */
-   index = Zoltan_DD_Hash2 (gid, dd->gid_length, dd->table_length,
-                            dd->hashdata, NULL);
-
-   /* walk linked list until end looking for matching gid */
-   for (nodeidx = dd->table[index]; nodeidx != -1;
-        nodeidx = dd->nodelist[nodeidx].next) {
-       ptr = dd->nodelist + nodeidx;
-       if (ZOLTAN_EQ_ID (dd->gid_length, gid, ptr->gid) == TRUE)  {
-          /* found match, update directory information */
-          if (lid)
-             ZOLTAN_SET_ID (dd->lid_length,ptr->gid + dd->gid_length, lid);
-          if (user)
-             memcpy(ptr->gid + (dd->gid_length + dd->lid_length), user,
-                    dd->user_data_length);
-
-          ptr->owner = owner;
-          if (partition != -1)
-             ptr->partition = partition;
-
-          /* Response to multiple updates to a gid in 1 update cycle */
-          if (dd->debug_level > 0 && ptr->errcheck != owner)  {
-             ZOLTAN_PRINT_INFO (dd->my_proc, yo, "Multiply defined GID");
-             if (dd->debug_level > 4)
-                ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
-             return ZOLTAN_WARN;
-          }
-
-          ptr->errcheck = owner;
-          if (dd->debug_level > 5)
-             ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
-          return ZOLTAN_OK;          /* ignore all errors */
-       }
+   /* probe the hash table for a matching gid */
+   hash = Zoltan_DD_Hash_Local (gid, dd->gid_length);
+   ptr = DD_Memory_Find_Node (dd, &dd->table, gid, hash);
+   if (ptr != NULL)  {
+      /* found match, update directory information */
+      if (lid)
+         ZOLTAN_SET_ID (dd->lid_length,ptr->gid + dd->gid_length, lid);
+      if (user)
+         memcpy(ptr->gid + (dd->gid_length + dd->lid_length), user,
+                dd->user_data_length);
+
+      ptr->owner = owner;
+      if (partition != -1)
+         ptr->partition = partition;
+
+      /* Response to multiple updates to a gid in 1 update cycle */
+      if (dd->debug_level > 0 && ptr->errcheck != owner)  {
+         ZOLTAN_PRINT_INFO (dd->my_proc, yo, "Multiply defined GID");
+         if (dd->debug_level > 4)
+            ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
+         return ZOLTAN_WARN;
+      }
+
+      ptr->errcheck = owner;
+      if (dd->debug_level > 5)
+         ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
+      return ZOLTAN_OK;          /* ignore all errors */
    }
 
    /* gid not found. Create new DD_Node and fill it in */
-   nodeidx = DD_Memory_Alloc_Node(dd);
-   ptr = dd->nodelist + nodeidx;
+   ptr = DD_Memory_Alloc_Node(dd, &dd->table, gid, hash);
+   if (ptr == NULL)  {
+      ZOLTAN_PRINT_ERROR (dd->my_proc, yo, "Hash table malloc failed");
+      if (dd->debug_level > 5)
+         ZOLTAN_TRACE_OUT (dd->my_proc, yo, NULL);
+      return ZOLTAN_MEMERR;
+   }
 
    ZOLTAN_SET_ID (dd->gid_length, ptr->gid, gid);
 
@@ -341,10 +431,6 @@ static int DD_Update_Local (Zoltan_DD_Directory *dd,
    ptr->owner = owner;
    ptr->errcheck = owner;
 
-   /* Add node to the linked list */
-   ptr->next = dd->table[index];
-   dd->table[index] = nodeidx;
-
    if (dd->debug_level > 6)
       ZOLTAN_PRINT_INFO (dd->my_proc, yo, "Created new directory item");
    if (dd->debug_level > 5)
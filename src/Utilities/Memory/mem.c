@@ -72,6 +72,9 @@ static size_t max_alloc = 0;	/* Largest single allocation */
 
 static int nmalloc = 0;         /* number of calls to malloc */
 static int nfree = 0;           /* number of calls to free */
+/* The counts are kept at every debug level and Zoltan may allocate from   */
+/* OpenMP threads; the list of active allocations (DEBUG_MEMORY > 1) is    */
+/* not thread-safe.                                                        */
 
 /* Macro to get rank information for printing and error messages. */
 /* If not using MPI, compile with -DZOLTAN_NO_MPI; all messages   */
@@ -342,6 +345,9 @@ double *Zoltan_Malloc(size_t n, char *filename, int lineno)
               (unsigned long) n);
       return ((double *) NULL);
     }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
     nmalloc++;
 
 #ifdef REALLOC_BUG
@@ -517,6 +523,9 @@ void Zoltan_Free (void **ptr, char *filename, int lineno)
   if (ptr == NULL || *ptr == NULL) 
     return;
 
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
   nfree++;
 
   if (DEBUG_MEMORY > 1) {
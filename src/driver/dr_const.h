@@ -348,12 +348,17 @@ struct Test_Flags {
   int Multi_Callbacks;      /* Exercises list-based callback functions. */
   int Graph_Callbacks;      /* Register and test graph callbacks */
   int Hypergraph_Callbacks; /* Register and test hypergraph callbacks */
+  int Hypergraph_Pages;     /* Register Get_HG_CS_Page instead of Get_HG_CS,
+                               returning at most this many lists per page */
+  int Hypergraph_CSR;       /* Partition with the hypergraph registered
+                               through Zoltan_Set_HG_CSR */
   int No_Global_Objects;    /* Test case where there are no objects on any process */
   int Gen_Files;            /* Exercise output file generation. */
   int Null_Lists;           /* Exercises null import or export lists to
                                Zoltan_Migrate. */
   float Dynamic_Weights;    /* Perturb weights between iterations. */
   float Dynamic_Graph;      /* Graph pertubation between iterations. */
+  int Static_Coords;        /* Keep graph coordinates between iterations. */
   int Vtx_Inc;              /* Increment #vertices for each iteration. */
 };
 
@@ -45,6 +45,10 @@
  */
 
 
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "dr_const.h"
 #include "dr_util_const.h"
 #include "dr_err_const.h"
@@ -124,6 +128,407 @@ int update_hvertex_proc(MESH_INFO_PTR mesh)
   return 1;
 }
 
+/****************************************************************************/
+/*
+ * Checks of the distributed directory for "test ddirectory": the hash
+ * table, the Find cache, prepared finds, split-phase Update and Find, and
+ * directories built from GID ranges.  Processor p owns GIDs p+1,
+ * p+1+nproc, ..., DD_TEST_N+p of them, so every answer follows from the
+ * GID and the round of updates:  local ID k for the k-th GID of its owner,
+ * partition (gid + round) % 5.  While "removed" is set, GIDs with
+ * k % 3 == 0 are out of the directory.
+ */
+
+#define DD_TEST_N 200   /* several times the initial table length */
+
+static int dd_test_expect(ZOLTAN_ID_TYPE gid, int nproc, int round,
+  int removed, int *owner, ZOLTAN_ID_TYPE *lid, int *part)
+{
+ZOLTAN_ID_TYPE k = (gid - 1) / nproc;
+int p = (int) ((gid - 1) % nproc);
+
+  if (gid == 0 || k >= (ZOLTAN_ID_TYPE) (DD_TEST_N + p) ||
+      (removed && (k % 3 == 0)))
+    return 0;
+  *owner = p;
+  *lid = k;
+  *part = (int) ((gid + round) % 5);
+  return 1;
+}
+
+static int dd_test_compare(int proc, int nproc, char *what, int count,
+  ZOLTAN_ID_PTR gid, ZOLTAN_ID_PTR lid, int *part, int *owner, int round,
+  int removed)
+{
+int i, o = 0, p = 0, bad = 0;
+ZOLTAN_ID_TYPE l = 0;
+
+  for (i = 0; i < count; i++) {
+    if (!dd_test_expect(gid[i], nproc, round, removed, &o, &l, &p)) {
+      if (owner[i] != -1) bad++;
+    }
+    else if (owner[i] != o || lid[i] != l || part[i] != p)
+      bad++;
+  }
+  if (bad)
+    printf("%d DDirectory Test:  %s: %d wrong answers\n", proc, what, bad);
+  return bad;
+}
+
+static unsigned int dd_test_hash(ZOLTAN_ID_PTR gid, int gid_length,
+  unsigned int nproc)
+{
+  return (unsigned int) (gid[0] % nproc);
+}
+
+static int dd_test_update(Zoltan_DD_Directory *dd, int proc, int nproc,
+  int round, int nmine, ZOLTAN_ID_PTR mine, ZOLTAN_ID_PTR lid, int *part)
+{
+int i;
+
+  for (i = 0; i < nmine; i++) {
+    mine[i] = (ZOLTAN_ID_TYPE) (proc + 1 + i * nproc);
+    lid[i] = (ZOLTAN_ID_TYPE) i;
+    part[i] = (int) ((mine[i] + round) % 5);
+  }
+  return Zoltan_DD_Update(dd, mine, lid, NULL, part, nmine);
+}
+
+static int dd_test_remove(Zoltan_DD_Directory *dd, int nmine,
+  ZOLTAN_ID_PTR mine, ZOLTAN_ID_PTR gone)
+{
+int i, n = 0;
+
+  for (i = 0; i < nmine; i += 3)
+    gone[n++] = mine[i];
+  return Zoltan_DD_Remove(dd, gone, n);
+}
+
+/* GIDs of range directory r: processor q holds count(q) GIDs from
+ * first(q); r == 0 gives equal ranges in processor order, r == 1 unequal
+ * ranges in reverse processor order. */
+static int dd_range_count(int r, int q)
+{
+  return (r == 0) ? DD_TEST_N : DD_TEST_N + q;
+}
+
+static ZOLTAN_ID_TYPE dd_range_first(int r, int q, int nproc)
+{
+ZOLTAN_ID_TYPE first = 1;
+int i;
+
+  if (r == 0)
+    return first + (ZOLTAN_ID_TYPE) q * DD_TEST_N;
+  for (i = nproc - 1; i > q; i--)
+    first += dd_range_count(r, i);
+  return first;
+}
+
+static int dd_range_compare(int proc, int nproc, char *what, int r,
+  int count, ZOLTAN_ID_PTR gid, ZOLTAN_ID_PTR lid, int *part, int *owner,
+  ZOLTAN_ID_TYPE extra)
+{
+/* GIDs outside every range are not found, except extra, ...,
+ * extra+nproc-1, which processor gid - extra added with Zoltan_DD_Update. */
+ZOLTAN_ID_TYPE first;
+int i, q, bad = 0;
+
+  for (i = 0; i < count; i++) {
+    for (q = 0; q < nproc; q++) {
+      first = dd_range_first(r, q, nproc);
+      if (gid[i] >= first && gid[i] < first + dd_range_count(r, q))
+        break;
+    }
+    if (q < nproc) {
+      if (owner[i] != q || lid[i] != gid[i] - first ||
+          part[i] != (int) (gid[i] % 5))
+        bad++;
+    }
+    else if (gid[i] >= extra && gid[i] < extra + nproc) {
+      if (owner[i] != (int) (gid[i] - extra) || part[i] != -1)
+        bad++;
+    }
+    else if (owner[i] != -1)
+      bad++;
+  }
+  if (bad)
+    printf("%d DDirectory Test:  %s: %d wrong answers\n", proc, what, bad);
+  return bad;
+}
+
+/* Errors expected from the checks would read like failures in the
+ * output; stderr goes to /dev/null between these two calls. */
+static int dd_quiet_begin(void)
+{
+int saved, null;
+
+  fflush(stderr);
+  saved = dup(fileno(stderr));
+  null = open("/dev/null", O_WRONLY);
+  if (null >= 0) {
+    dup2(null, fileno(stderr));
+    close(null);
+  }
+  return saved;
+}
+
+static void dd_quiet_end(int saved)
+{
+  fflush(stderr);
+  if (saved >= 0) {
+    dup2(saved, fileno(stderr));
+    close(saved);
+  }
+}
+
+int test_ddirectory_features(int proc)
+{
+Zoltan_DD_Directory *dd = NULL, *ddCopy = NULL;
+Zoltan_DD_Find_Plan *plan = NULL;
+Zoltan_DD_Request *req1 = NULL, *req2 = NULL;
+ZOLTAN_ID_PTR mine = NULL, mlid = NULL, gone = NULL;
+ZOLTAN_ID_PTR want = NULL, lid = NULL, lid2 = NULL;
+int *mpart = NULL, *part = NULL, *part2 = NULL, *owner = NULL, *owner2 = NULL;
+ZOLTAN_ID_TYPE first, extra;
+int nproc, nbor, nmine, nwant, maxwant, count, q, quiet;
+int i, r, ierr, ierr2, error = 0, gerror = 0;
+
+#define DD_TEST_OK(e) ((e) == ZOLTAN_OK || (e) == ZOLTAN_WARN)
+#define DD_TEST_FAIL(msg) \
+  { printf("%d DDirectory Test:  %s\n", proc, msg); error++; }
+
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+  nbor = (proc + 1) % nproc;
+  nmine = DD_TEST_N + proc;
+
+  /* Look up my GIDs, my neighbor's and one GID nobody has */
+  maxwant = 2 * (DD_TEST_N + nproc) + 1;
+  mine = (ZOLTAN_ID_PTR) malloc(sizeof(ZOLTAN_ID_TYPE) * 3 * nmine);
+  want = (ZOLTAN_ID_PTR) malloc(sizeof(ZOLTAN_ID_TYPE) * 3 * maxwant);
+  mpart = (int *) malloc(sizeof(int) * nmine);
+  part = (int *) malloc(sizeof(int) * 4 * maxwant);
+  if (mine == NULL || want == NULL || mpart == NULL || part == NULL) {
+    Gen_Error(0, "Fatal:  insufficient memory");
+    error = 1;
+    goto End;
+  }
+  mlid = mine + nmine;
+  gone = mlid + nmine;
+  lid = want + maxwant;
+  lid2 = lid + maxwant;
+  part2 = part + maxwant;
+  owner = part2 + maxwant;
+  owner2 = owner + maxwant;
+
+  nwant = 0;
+  for (i = 0; i < DD_TEST_N + nbor; i++)
+    want[nwant++] = (ZOLTAN_ID_TYPE) (nbor + 1 + i * nproc);
+  for (i = 0; i < nmine; i++)
+    want[nwant++] = (ZOLTAN_ID_TYPE) (proc + 1 + i * nproc);
+  want[nwant++] = (ZOLTAN_ID_TYPE) (nproc * (DD_TEST_N + nproc) + 1 + proc);
+
+  /* Hash table:  no length hint, so it grows from the minimum size */
+  if (proc == 0) printf("    Test DD hash table\n");
+  ierr = Zoltan_DD_Create(&dd, MPI_COMM_WORLD, 1, 1, 0, 0, 0);
+  if (ierr) {
+    Gen_Error(0, "Fatal:  Error returned by Zoltan_DD_Create");
+    error = 1;
+    goto End;
+  }
+  if (dd_test_update(dd, proc, nproc, 0, nmine, mine, mlid, mpart))
+    DD_TEST_FAIL("Update failed");
+  ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+  if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+  error += dd_test_compare(proc, nproc, "Find", nwant, want, lid, part,
+                           owner, 0, 0);
+
+  /* Removal shifts the rest of a probe run back */
+  if (dd_test_remove(dd, nmine, mine, gone))
+    DD_TEST_FAIL("Remove failed");
+  ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+  if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+  error += dd_test_compare(proc, nproc, "Find after Remove", nwant, want,
+                           lid, part, owner, 0, 1);
+  if (dd_test_update(dd, proc, nproc, 1, nmine, mine, mlid, mpart))
+    DD_TEST_FAIL("Update failed");
+
+  /* Find cache:  answers must not outlive an Update or Remove */
+  if (proc == 0) printf("    Test DD Find cache\n");
+  if (Zoltan_DD_Set_Cache(dd, 2 * maxwant))
+    DD_TEST_FAIL("Set_Cache failed");
+  for (i = 0; i < 2; i++) {
+    ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+    if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+    error += dd_test_compare(proc, nproc, "cached Find", nwant, want, lid,
+                             part, owner, 1, 0);
+  }
+  if (dd_test_update(dd, proc, nproc, 2, nmine, mine, mlid, mpart))
+    DD_TEST_FAIL("Update failed");
+  ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+  if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+  error += dd_test_compare(proc, nproc, "cached Find after Update", nwant,
+                           want, lid, part, owner, 2, 0);
+  if (dd_test_remove(dd, nmine, mine, gone))
+    DD_TEST_FAIL("Remove failed");
+  ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+  if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+  error += dd_test_compare(proc, nproc, "cached Find after Remove", nwant,
+                           want, lid, part, owner, 2, 1);
+  if (dd_test_update(dd, proc, nproc, 3, nmine, mine, mlid, mpart))
+    DD_TEST_FAIL("Update failed");
+
+  /* Prepared finds see every later Update and Remove */
+  if (proc == 0) printf("    Test DD Find plan\n");
+  if (Zoltan_DD_Find_Prepare(dd, want, nwant, &plan))
+    DD_TEST_FAIL("Find_Prepare failed");
+  for (r = 3; r < 5; r++) {
+    if (r > 3 && dd_test_update(dd, proc, nproc, r, nmine, mine, mlid, mpart))
+      DD_TEST_FAIL("Update failed");
+    ierr = Zoltan_DD_Find_Execute(plan, lid, NULL, part, owner);
+    if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find_Execute failed");
+    error += dd_test_compare(proc, nproc, "Find_Execute", nwant, want, lid,
+                             part, owner, r, 0);
+  }
+  if (dd_test_remove(dd, nmine, mine, gone))
+    DD_TEST_FAIL("Remove failed");
+  ierr = Zoltan_DD_Find_Execute(plan, lid, NULL, part, owner);
+  if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find_Execute failed");
+  error += dd_test_compare(proc, nproc, "Find_Execute after Remove", nwant,
+                           want, lid, part, owner, 4, 1);
+  Zoltan_DD_Find_Destroy(&plan);
+
+  /* Split-phase Update and Find; two finds outstanding at once */
+  if (proc == 0) printf("    Test DD Begin/End\n");
+  for (i = 0; i < nmine; i++) {
+    mine[i] = (ZOLTAN_ID_TYPE) (proc + 1 + i * nproc);
+    mlid[i] = (ZOLTAN_ID_TYPE) i;
+    mpart[i] = (int) (mine[i] % 5);       /* round 5 */
+  }
+  ierr = Zoltan_DD_Update_Begin(dd, mine, mlid, NULL, mpart, nmine, &req1);
+  if (ierr == ZOLTAN_OK)
+    ierr = Zoltan_DD_Update_End(&req1);
+  if (ierr) DD_TEST_FAIL("Update_Begin/End failed");
+  ierr = Zoltan_DD_Find_Begin(dd, want, lid, NULL, part, nwant, owner, &req1);
+  ierr2 = Zoltan_DD_Find_Begin(dd, want, lid2, NULL, part2, nwant, owner2,
+                               &req2);
+  if (ierr || ierr2) DD_TEST_FAIL("Find_Begin failed");
+  ierr = Zoltan_DD_Find_End(&req1);
+  ierr2 = Zoltan_DD_Find_End(&req2);
+  if (!DD_TEST_OK(ierr) || !DD_TEST_OK(ierr2)) DD_TEST_FAIL("Find_End failed");
+  error += dd_test_compare(proc, nproc, "Find_End", nwant, want, lid, part,
+                           owner, 5, 0);
+  error += dd_test_compare(proc, nproc, "second Find_End", nwant, want, lid2,
+                           part2, owner2, 5, 0);
+
+  /* A find inside a pending update sees the old directory, and the
+   * answers it caches must not outlive the update */
+  for (i = 0; i < nmine; i++)
+    mpart[i] = (int) ((mine[i] + 6) % 5); /* round 6 */
+  ierr = Zoltan_DD_Update_Begin(dd, mine, mlid, NULL, mpart, nmine, &req1);
+  if (ierr) DD_TEST_FAIL("Update_Begin failed");
+  ierr2 = Zoltan_DD_Find_Begin(dd, want, lid, NULL, part, nwant, owner, &req2);
+  if (ierr2 == ZOLTAN_OK)
+    ierr2 = Zoltan_DD_Find_End(&req2);
+  if (!DD_TEST_OK(ierr2)) DD_TEST_FAIL("Find_Begin/End failed");
+  error += dd_test_compare(proc, nproc, "Find_End during Update", nwant,
+                           want, lid, part, owner, 5, 0);
+  if (ierr == ZOLTAN_OK && Zoltan_DD_Update_End(&req1))
+    DD_TEST_FAIL("Update_End failed");
+  ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+  if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+  error += dd_test_compare(proc, nproc, "cached Find after Update_End",
+                           nwant, want, lid, part, owner, 6, 0);
+  Zoltan_DD_Destroy(&dd);
+
+  /* Range directories:  equal ranges in processor order (found by
+   * division), then unequal ranges in reverse order (binary search) */
+  for (r = 0; r < 2; r++) {
+    if (proc == 0) printf("    Test DD_Create_From_Ranges %d\n", r);
+    first = dd_range_first(r, proc, nproc);
+    count = dd_range_count(r, proc);
+    q = (r == 0) ? nproc - 1 : 0;          /* holds the highest range */
+    extra = dd_range_first(r, q, nproc) + dd_range_count(r, q);
+    for (i = 0; i < count; i++) {
+      mlid[i] = (ZOLTAN_ID_TYPE) i;
+      mpart[i] = (int) ((first + i) % 5);
+    }
+    ierr = Zoltan_DD_Create_From_Ranges(&dd, MPI_COMM_WORLD, 1, 0, first,
+                                        count, mlid, NULL, mpart, 0);
+    if (ierr) {
+      Gen_Error(0, "Fatal:  Error returned by Zoltan_DD_Create_From_Ranges");
+      error = 1;
+      goto End;
+    }
+
+    /* a GID past every range is hashed as usual */
+    mine[0] = extra + proc;
+    if (Zoltan_DD_Update(dd, mine, NULL, NULL, NULL, 1))
+      DD_TEST_FAIL("Update outside the ranges failed");
+
+    /* my range, my neighbor's, and GIDs past the ranges */
+    nwant = 0;
+    for (i = 0; i < count; i++)
+      want[nwant++] = first + i;
+    for (i = 0; i < dd_range_count(r, nbor); i++)
+      want[nwant++] = dd_range_first(r, nbor, nproc) + i;
+    want[nwant++] = extra + nbor;
+    want[nwant++] = extra + nproc;
+
+    ddCopy = Zoltan_DD_Copy(dd);
+    if (ddCopy == NULL) DD_TEST_FAIL("Copy failed");
+    ierr = Zoltan_DD_Find(dd, want, lid, NULL, part, nwant, owner);
+    if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+    error += dd_range_compare(proc, nproc, "range Find", r, nwant, want,
+                              lid, part, owner, extra);
+    if (ddCopy != NULL) {
+      ierr = Zoltan_DD_Find(ddCopy, want, lid, NULL, part, nwant, owner);
+      if (!DD_TEST_OK(ierr)) DD_TEST_FAIL("Find failed");
+      error += dd_range_compare(proc, nproc, "range Find in copy", r, nwant,
+                                want, lid, part, owner, extra);
+    }
+    Zoltan_DD_Destroy(&ddCopy);
+
+    /* the ranges fix the hash function; it must not be replaced */
+    quiet = dd_quiet_begin();
+    if (Zoltan_DD_Set_Hash_Fn(dd, dd_test_hash) != ZOLTAN_FATAL ||
+        Zoltan_DD_Set_Neighbor_Hash_Fn1(dd, DD_TEST_N) != ZOLTAN_FATAL ||
+        Zoltan_DD_Set_Neighbor_Hash_Fn3(dd, nproc * DD_TEST_N) != ZOLTAN_FATAL)
+      DD_TEST_FAIL("hash function of a range directory replaced");
+    dd_quiet_end(quiet);
+    Zoltan_DD_Destroy(&dd);
+  }
+
+  /* an invalid range on one processor fails on all, without hanging */
+  if (proc == 0) printf("    Test DD_Create_From_Ranges error\n");
+  quiet = dd_quiet_begin();
+  ierr = Zoltan_DD_Create_From_Ranges(&dd, MPI_COMM_WORLD, 0, 0, 1,
+                                      (proc == nproc - 1) ? -1 : 0,
+                                      NULL, NULL, NULL, 0);
+  dd_quiet_end(quiet);
+  if (ierr != ZOLTAN_FATAL)
+    DD_TEST_FAIL("invalid range accepted");
+  if (ierr == ZOLTAN_OK)
+    Zoltan_DD_Destroy(&dd);
+
+End:
+  if (plan) Zoltan_DD_Find_Destroy(&plan);
+  if (dd) Zoltan_DD_Destroy(&dd);
+  safe_free((void **)(void *) &mine);
+  safe_free((void **)(void *) &want);
+  safe_free((void **)(void *) &mpart);
+  safe_free((void **)(void *) &part);
+
+  MPI_Allreduce(&error, &gerror, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  if (gerror) {
+    Gen_Error(0, "Fatal:  Error returned by DDirectory feature test");
+    return 0;
+  }
+  return 1;
+
+#undef DD_TEST_OK
+#undef DD_TEST_FAIL
+}
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
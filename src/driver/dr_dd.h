@@ -56,6 +56,7 @@ void destroy_elem_dd();
 extern int build_elem_dd(MESH_INFO_PTR);
 extern int update_elem_dd(MESH_INFO_PTR);
 extern int update_hvertex_proc(MESH_INFO_PTR);
+extern int test_ddirectory_features(int);
 
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
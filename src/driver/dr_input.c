@@ -503,6 +503,11 @@ int read_cmd_file (
     else if (sscanf(line, " test dynamic graph" SKIPEQ "%f%n",
 		    &Test.Dynamic_Graph, &n) == 1)
       continue;                /* Dynamic graph; edges/verts change between iter. */
+    else if (sscanf(line, " test thread multiple" SKIPEQ "%d%n", &i, &n) == 1)
+      continue;                /* Read before MPI_Init by read_thread_multiple */
+    else if (sscanf(line, " test static coordinates" SKIPEQ "%d%n",
+		    &Test.Static_Coords, &n) == 1)
+      continue;                /* Don't perturb coordinates between iter. */
     else if (sscanf(line, " test vertex increment" SKIPEQ "%i%n",
                     &Test.Vtx_Inc, &n) == 1)
       continue;                /* Add more vertices in each iteration. */
@@ -525,6 +530,12 @@ int read_cmd_file (
     else if (sscanf(line, " test hypergraph callback" SKIPEQ "%d%n",
 		    &Test.Hypergraph_Callbacks, &n) == 1)
       continue;             /* HyperGraph-based callback function testing */
+    else if (sscanf(line, " test hypergraph pages" SKIPEQ "%d%n",
+		    &Test.Hypergraph_Pages, &n) == 1)
+      continue;             /* Paged hypergraph callback (Get_HG_CS_Page) */
+    else if (sscanf(line, " test hypergraph csr" SKIPEQ "%d%n",
+		    &Test.Hypergraph_CSR, &n) == 1)
+      continue;             /* Hypergraph arrays (Zoltan_Set_HG_CSR) */
     else if (sscanf(line, " test no global objects" SKIPEQ "%d%n",
 		    &Test.No_Global_Objects, &n) == 1)
       continue;             /* HyperGraph-based callback function testing */
@@ -625,6 +636,30 @@ int read_cmd_file (
   return 1;
 }
 
+/* Returns the value of "Test Thread Multiple" in the command file, or 0.
+ * Every process reads it, since MPI must be initialized accordingly before
+ * the command file is read and broadcast. */
+int read_thread_multiple(const char *filename)
+{
+  FILE *file_cmd;
+  char  line[MAX_INPUT_STR_LN + 1], *pline;
+  int   value = 0;
+
+  if ((file_cmd = fopen (filename, "r")) == NULL)
+    return 0;
+
+  while (fgets (line, MAX_INPUT_STR_LN, file_cmd)) {
+    for (pline = line; *pline; pline++)
+      *pline = tolower (*pline);
+    if (sscanf(line, " test thread multiple" SKIPEQ "%d", &value) == 1)
+      break;
+    value = 0;
+  }
+  fclose (file_cmd);
+  return value;
+}
+
+
 
 
 int check_inp (
@@ -703,7 +738,7 @@ void brdcst_cmd_info (
 {
   int ctrl_id, j, k;
   int size;
-  int int_params[20];  /* Make sure this array is large enough */
+  int int_params[23];  /* Make sure this array is large enough */
   float float_params[2];  /* Make sure this array is large enough */
 
   k = 0;
@@ -724,6 +759,8 @@ void brdcst_cmd_info (
   int_params[j++] = Test.Multi_Callbacks;
   int_params[j++] = Test.Graph_Callbacks;
   int_params[j++] = Test.Hypergraph_Callbacks;
+  int_params[j++] = Test.Hypergraph_Pages;
+  int_params[j++] = Test.Hypergraph_CSR;
   int_params[j++] = Test.No_Global_Objects;
   int_params[j++] = Test.Null_Lists;
   int_params[j++] = Output.Text;
@@ -737,6 +774,7 @@ void brdcst_cmd_info (
   int_params[j++] = Test.RCB_Box;
   int_params[j++] = Test.Gen_Files;
   int_params[j++] = Test.Vtx_Inc;
+  int_params[j++] = Test.Static_Coords;
 
   MPI_Bcast (int_params, j, MPI_INT, 0, MPI_COMM_WORLD);
 
@@ -748,6 +786,8 @@ void brdcst_cmd_info (
   Test.Multi_Callbacks   = int_params[j++];
   Test.Graph_Callbacks   = int_params[j++];
   Test.Hypergraph_Callbacks   = int_params[j++];
+  Test.Hypergraph_Pages  = int_params[j++];
+  Test.Hypergraph_CSR    = int_params[j++];
   Test.No_Global_Objects = int_params[j++];
   Test.Null_Lists        = int_params[j++];
   Output.Text            = int_params[j++];
@@ -761,6 +801,7 @@ void brdcst_cmd_info (
   Test.RCB_Box           = int_params[j++];
   Test.Gen_Files         = int_params[j++];
   Test.Vtx_Inc           = int_params[j++];
+  Test.Static_Coords     = int_params[j++];
 
   MPI_Bcast (pio_info, sizeof(PARIO_INFO), MPI_BYTE, 0, MPI_COMM_WORLD);
 
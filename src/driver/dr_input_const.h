@@ -163,6 +163,10 @@ extern int read_cmd_file(
   UNDEFINED_INFO_PTR undef
 );
 
+extern int read_thread_multiple(
+  const char *filename
+);
+
 extern int check_inp(
   PROB_INFO_PTR prob,
   PARIO_INFO_PTR pio_info
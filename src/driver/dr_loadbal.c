@@ -83,6 +83,18 @@ static int Export_Lists_Special = 0;
 static void test_drops(int, MESH_INFO_PTR, PARIO_INFO_PTR,
    struct Zoltan_Struct *);
 
+/* Arrays handed to Zoltan_Set_HG_CSR for "test hypergraph csr". */
+struct HG_CSR_Arrays {
+  ZOLTAN_ID_PTR vtx_gid;
+  ZOLTAN_ID_PTR edge_gid;
+  int *edge_ptr;
+  ZOLTAN_ID_PTR pin_gid;
+  float *edge_wgts;
+};
+static struct Zoltan_Struct *copy_with_hg_csr(struct Zoltan_Struct *,
+   MESH_INFO_PTR, struct HG_CSR_Arrays *);
+static void free_hg_csr(struct HG_CSR_Arrays *);
+
 
 extern int Zoltan_Order_Test(struct Zoltan_Struct *zz, int *num_gid_entries,  int *num_lid_entries,
   int num_obj,  ZOLTAN_ID_PTR global_ids,  ZOLTAN_ID_PTR local_ids,  int *rank,  int *iperm);
@@ -124,6 +136,7 @@ ZOLTAN_PART_FN get_part;
 ZOLTAN_HG_SIZE_CS_FN get_hg_size_compressed_pin_storage;
 ZOLTAN_HG_SIZE_EDGE_WTS_FN get_hg_size_edge_weights;
 ZOLTAN_HG_CS_FN get_hg_compressed_pin_storage;
+ZOLTAN_HG_CS_PAGE_FN get_hg_compressed_pin_page;
 ZOLTAN_HG_EDGE_WTS_FN get_hg_edge_weights;
 
 ZOLTAN_HG_SIZE_CS_FN get_nemesis_hg_size;
@@ -486,7 +499,15 @@ int setup_zoltan(struct Zoltan_Struct *zz, int Proc, PROB_INFO_PTR prob,
       return 0;
     }
 
-    if (Zoltan_Set_Fn(zz, ZOLTAN_HG_CS_FN_TYPE,
+    if (Test.Hypergraph_Pages) {
+      if (Zoltan_Set_Fn(zz, ZOLTAN_HG_CS_PAGE_FN_TYPE,
+			(void (*)()) get_hg_compressed_pin_page,
+			(void *) mesh) == ZOLTAN_FATAL) {
+	Gen_Error(0, "fatal:  error returned from Zoltan_Set_Fn()\n");
+	return 0;
+      }
+    }
+    else if (Zoltan_Set_Fn(zz, ZOLTAN_HG_CS_FN_TYPE,
 		      (void (*)()) get_hg_compressed_pin_storage,
 		      (void *) mesh) == ZOLTAN_FATAL) {
       Gen_Error(0, "fatal:  error returned from Zoltan_Set_Fn()\n");
@@ -567,6 +588,10 @@ int run_zoltan(struct Zoltan_Struct *zz, int Proc, PROB_INFO_PTR prob,
 /* Local declarations. */
   char *yo = "run_zoltan";
   struct Zoltan_Struct *zz_copy;
+  struct Zoltan_Struct *zz_lb;       /* zz, or a copy reading HG_CSR arrays */
+  struct HG_CSR_Arrays hg_csr;
+  char *lb_buf;
+  size_t lb_bufsize;
 
   /* Variables returned by Zoltan */
   ZOLTAN_ID_PTR import_gids = NULL;  /* Global nums of objs to be imported   */
@@ -627,16 +652,31 @@ int run_zoltan(struct Zoltan_Struct *zz, int Proc, PROB_INFO_PTR prob,
     Timer_Callback_Time = 0.0;
 #endif /* TIMER_CALLBACKS */
 
+    zz_lb = zz;
+    if (Test.Hypergraph_CSR) {
+      /* Partition the same hypergraph registered as arrays. */
+      zz_lb = copy_with_hg_csr(zz, mesh, &hg_csr);
+      if (zz_lb == NULL) {
+	Gen_Error(0, "fatal:  error returned from copy_with_hg_csr()\n");
+	return 0;
+      }
+    }
+
     MPI_Barrier(MPI_COMM_WORLD);   /* For timings only */
     stime = MPI_Wtime();
 
-    ierr = Zoltan_LB_Partition(zz, &new_decomp,
+    ierr = Zoltan_LB_Partition(zz_lb, &new_decomp,
 		 &num_gid_entries, &num_lid_entries,
 		 &num_imported, &import_gids,
 		 &import_lids, &import_procs, &import_to_part,
 		 &num_exported, &export_gids,
 		 &export_lids, &export_procs, &export_to_part);
 
+    if (zz_lb != zz) {
+      Zoltan_Destroy(&zz_lb);
+      free_hg_csr(&hg_csr);
+    }
+
     if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
       Gen_Error(0, "fatal:  error returned from Zoltan_LB_Partition()\n");
       return 0;
@@ -794,6 +834,27 @@ exit(-1);
 
     Zoltan_Destroy(&zz_copy);
 
+    /*
+     * Test serialization:  replace the partition with one restored from
+     * its serialized form; the drop tests below then use the restored one.
+     * HIER does not support serialization.
+     */
+    if (strcasecmp(prob->method, "HIER")) {
+      lb_bufsize = Zoltan_LB_Serialize_Size(zz);
+      lb_buf = (char *) malloc(lb_bufsize);
+      if (lb_buf == NULL) {
+	Gen_Error(0, "fatal:  insufficient memory\n");
+	return 0;
+      }
+      if (Zoltan_LB_Serialize(zz, lb_bufsize, lb_buf) ||
+          Zoltan_LB_Deserialize(zz, lb_bufsize, lb_buf)){
+	Gen_Error(0, "fatal:  Zoltan_LB_Serialize/Deserialize failure\n");
+	free(lb_buf);
+	return 0;
+      }
+      free(lb_buf);
+    }
+
     /* Evaluate the new balance */
     if (Debug_Driver > 0) {
       if (!Test.Dynamic_Graph){
@@ -2136,6 +2197,203 @@ void get_hg_compressed_pin_storage(
       row_ptr[i+1] = row_ptr[i]+pins;
   }
 
+End:
+
+  STOP_CALLBACK_TIMER;
+}
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+static struct Zoltan_Struct *copy_with_hg_csr(
+  struct Zoltan_Struct *zz,
+  MESH_INFO_PTR mesh,
+  struct HG_CSR_Arrays *csr)
+{
+  /* Return a copy of zz whose hypergraph is registered with
+   * Zoltan_Set_HG_CSR from the mesh, for comparison with the callbacks.
+   * The vertex local IDs Zoltan_Set_HG_CSR uses are indices into the
+   * array, so every element must be listed in order: no blanking, no
+   * visible_nvtx, one local ID entry.  Hyperedge weights are passed only
+   * if each local hyperedge has exactly its own weight.  Returns NULL on
+   * every process if any process fails; the arrays are then freed. */
+  struct Zoltan_Struct *zz_copy = NULL;
+  int nvtx = mesh->num_elems;
+  int nedges = mesh->nhedges;
+  int npins = (nedges ? mesh->hindex[nedges] : 0);
+  int wdim = mesh->hewgt_dim;
+  int gid = Num_GID - 1;
+  int i, k, ierr;
+  int err = 0, gerr = 0;
+
+  memset(csr, 0, sizeof(struct HG_CSR_Arrays));
+
+  if ((mesh->data_type != HYPERGRAPH) ||
+      (mesh->format != ZOLTAN_COMPRESSED_EDGE) ||
+      mesh->blank_count || mesh->visible_nvtx || (Num_LID > 1)) {
+    Gen_Error(0, "fatal:  test hypergraph csr needs an unblanked "
+		 "hypergraph in compressed edge format\n");
+    err = 1;
+    goto End;
+  }
+
+  csr->vtx_gid = (ZOLTAN_ID_PTR) malloc((nvtx + 1) * Num_GID *
+					sizeof(ZOLTAN_ID_TYPE));
+  csr->edge_gid = (ZOLTAN_ID_PTR) malloc((nedges + 1) * Num_GID *
+					 sizeof(ZOLTAN_ID_TYPE));
+  csr->edge_ptr = (int *) malloc((nedges + 1) * sizeof(int));
+  csr->pin_gid = (ZOLTAN_ID_PTR) malloc((npins + 1) * Num_GID *
+					sizeof(ZOLTAN_ID_TYPE));
+  if (!csr->vtx_gid || !csr->edge_gid || !csr->edge_ptr || !csr->pin_gid) {
+    Gen_Error(0, "fatal:  insufficient memory\n");
+    err = 1;
+    goto End;
+  }
+
+  for (i = 0; i < nvtx; i++) {
+    for (k = 0; k < gid; k++) csr->vtx_gid[i*Num_GID+k] = 0;
+    csr->vtx_gid[i*Num_GID+gid] = mesh->elements[i].globalID;
+  }
+  for (i = 0; i < nedges; i++) {
+    for (k = 0; k < gid; k++) csr->edge_gid[i*Num_GID+k] = 0;
+    csr->edge_gid[i*Num_GID+gid] = mesh->hgid[i];
+  }
+  csr->edge_ptr[0] = 0;
+  for (i = 0; i < nedges; i++)
+    csr->edge_ptr[i+1] = mesh->hindex[i+1];
+  for (i = 0; i < npins; i++) {
+    for (k = 0; k < gid; k++) csr->pin_gid[i*Num_GID+k] = 0;
+    csr->pin_gid[i*Num_GID+gid] = mesh->hvertex[i];
+  }
+
+  if (mesh->heNumWgts > 0) {
+    if (mesh->heNumWgts != nedges) err = 1;
+    for (i = 0; !err && (i < nedges); i++)
+      if (mesh->heWgtId[i] != mesh->hgid[i]) err = 1;
+    if (err) {
+      Gen_Error(0, "fatal:  test hypergraph csr needs a weight for each "
+		   "local hyperedge\n");
+      goto End;
+    }
+    csr->edge_wgts = (float *) malloc(nedges * wdim * sizeof(float) + 1);
+    if (!csr->edge_wgts) {
+      Gen_Error(0, "fatal:  insufficient memory\n");
+      err = 1;
+      goto End;
+    }
+    memcpy(csr->edge_wgts, mesh->hewgts, nedges * wdim * sizeof(float));
+  }
+
+  zz_copy = Zoltan_Copy(zz);
+  if (zz_copy == NULL) {
+    Gen_Error(0, "fatal:  Zoltan_Copy failure\n");
+    err = 1;
+    goto End;
+  }
+
+  /* ZOLTAN_WARN: OBJ_WEIGHT_DIM > 0, and the arrays give unit weights. */
+  ierr = Zoltan_Set_HG_CSR(zz_copy, nvtx, csr->vtx_gid, nedges,
+			   csr->edge_gid, csr->edge_ptr, csr->pin_gid,
+			   csr->edge_wgts);
+  if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)) {
+    Gen_Error(0, "fatal:  error returned from Zoltan_Set_HG_CSR()\n");
+    err = 1;
+  }
+
+End:
+  MPI_Allreduce(&err, &gerr, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  if (gerr) {
+    if (zz_copy) Zoltan_Destroy(&zz_copy);
+    free_hg_csr(csr);
+    return NULL;
+  }
+  return zz_copy;
+}
+
+static void free_hg_csr(struct HG_CSR_Arrays *csr)
+{
+  safe_free((void **)(void *) &(csr->vtx_gid));
+  safe_free((void **)(void *) &(csr->edge_gid));
+  safe_free((void **)(void *) &(csr->edge_ptr));
+  safe_free((void **)(void *) &(csr->pin_gid));
+  safe_free((void **)(void *) &(csr->edge_wgts));
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+void get_hg_compressed_pin_page(
+  void *data,
+  int num_gid_entries,
+  int format,
+  int first_list,
+  int max_lists,
+  int max_pins,
+  int *num_lists,
+  ZOLTAN_ID_PTR rowcol_GID,
+  int *rowcol_ptr,
+  ZOLTAN_ID_PTR pin_GID, int *ierr)
+{
+  /* Same pins as get_hg_compressed_pin_storage, but a page of whole
+   * hyperedges at a time, at most Test.Hypergraph_Pages of them. */
+  MESH_INFO_PTR mesh;
+  ZOLTAN_ID_PTR edg_GID, vtx_GID;
+  int gid = num_gid_entries - 1;
+  int i, j, k, n, pins;
+
+  START_CALLBACK_TIMER;
+  *ierr = ZOLTAN_OK;
+  *num_lists = 0;
+
+  mesh = (MESH_INFO_PTR) data;
+  if (data == NULL) {
+    *ierr = ZOLTAN_FATAL;
+    goto End;
+  }
+
+  if ((format != mesh->format) || (first_list < 0) ||
+      (first_list + max_lists > mesh->nhedges)){
+    *ierr = ZOLTAN_FATAL;
+    goto End;
+  }
+
+  if (max_lists > Test.Hypergraph_Pages)
+    max_lists = Test.Hypergraph_Pages;
+
+  edg_GID = rowcol_GID;
+  vtx_GID = pin_GID;
+  rowcol_ptr[0] = 0;
+
+  for (n=0, i=first_list; n < max_lists; n++, i++){
+    pins = 0;
+    for (j=mesh->hindex[i]; j<mesh->hindex[i+1]; j++){
+      if (!mesh->visible_nvtx || (mesh->hvertex[j] <= mesh->visible_nvtx))
+        pins++;
+    }
+    if (rowcol_ptr[n] + pins > max_pins){
+      if (n == 0)
+        rowcol_ptr[1] = pins;   /* Zoltan asks again with more room */
+      break;
+    }
+
+    for (k=0; k<gid; k++){
+      *edg_GID++ = 0;
+    }
+    *edg_GID++ = mesh->hgid[i];
+
+    for (j=mesh->hindex[i]; j<mesh->hindex[i+1]; j++){
+      if (mesh->visible_nvtx && (mesh->hvertex[j] > mesh->visible_nvtx))
+	; /* skip pin */
+      else{
+	for (k=0; k<gid; k++){
+	  *vtx_GID++ = 0;
+	}
+	*vtx_GID++ = mesh->hvertex[j];
+      }
+    }
+    rowcol_ptr[n+1] = rowcol_ptr[n] + pins;
+  }
+  *num_lists = n;
+
 End:
 
   STOP_CALLBACK_TIMER;
@@ -2315,6 +2573,8 @@ static void test_point_drops(FILE *, double *, struct Zoltan_Struct *,
   int, int *, int, int *, int, int);
 static void test_box_drops(FILE *, double *, double *, struct Zoltan_Struct *,
   int, int, int, int);
+static void test_multi_drops(FILE *, MESH_INFO_PTR, struct Zoltan_Struct *,
+  int);
 
 static void test_drops(
   int Proc,
@@ -2395,6 +2655,8 @@ int test_both;  /* If true, test both Zoltan_*_Assign and Zoltan_*_PP_Assign. */
 						  proc has no parts */
 		-1, test_both);
 
+  test_multi_drops(fp, mesh, zz, Proc);
+
   fclose(fp);
 }
 
@@ -2460,6 +2722,98 @@ int i;
   }
 }
 
+/*****************************************************************************/
+static void test_multi_drops(
+  FILE *fp,
+  MESH_INFO_PTR mesh,
+  struct Zoltan_Struct *zz,
+  int Proc
+)
+{
+/* Check that the batched assign functions agree with the single-point and
+ * single-box ones for the centers of this processor's elements and boxes
+ * around them.  Prints only errors, so output is unchanged when they agree.
+ */
+int status, status1;
+int i, j, k, n = 0;
+int nd = mesh->num_dims;
+int one_proc, one_part;
+int proccnt, partcnt;
+int procs1[1000], parts1[1000];
+double *coords = NULL, *boxes = NULL;
+int *procs = NULL, *parts = NULL;
+int *proc_start = NULL, *part_start = NULL;
+int *box_procs = NULL, *box_parts = NULL;
+
+  coords = (double *) malloc((mesh->num_elems * (nd + 6) + 1) * sizeof(double));
+  procs = (int *) malloc((4 * mesh->num_elems + 2) * sizeof(int));
+  if (coords == NULL || procs == NULL) {
+    fprintf(fp, "%d Error:  memory allocation in test_multi_drops\n", Proc);
+    goto End;
+  }
+  boxes = coords + mesh->num_elems * nd;
+  parts = procs + mesh->num_elems;
+  proc_start = parts + mesh->num_elems;
+  part_start = proc_start + mesh->num_elems + 1;
+
+  for (i = 0; i < mesh->num_elems; i++) {
+    if (mesh->eb_nnodes[mesh->elements[i].elem_blk] == 0) continue;
+    for (k = 0; k < 3; k++) {
+      boxes[6*n+k] = (k < nd ? mesh->elements[i].avg_coord[k] : 0.) - 0.5;
+      boxes[6*n+3+k] = boxes[6*n+k] + 1.0;
+    }
+    for (k = 0; k < nd; k++)
+      coords[n*nd+k] = mesh->elements[i].avg_coord[k];
+    n++;
+  }
+
+  status = Zoltan_LB_Point_PP_Assign_Multi(zz, n, coords, procs, parts);
+  if (status != ZOLTAN_OK)
+    fprintf(fp, "error returned from Zoltan_LB_Point_PP_Assign_Multi()\n");
+  else {
+    for (i = 0; i < n; i++) {
+      status1 = Zoltan_LB_Point_PP_Assign(zz, coords + i*nd, &one_proc,
+                                          &one_part);
+      if (status1 != ZOLTAN_OK || one_proc != procs[i] || one_part != parts[i])
+        fprintf(fp, "%d Error:  Zoltan_LB_Point_PP_Assign_Multi gives proc %d "
+                    "part %d for point %d; Zoltan_LB_Point_PP_Assign gives "
+                    "proc %d part %d\n", Proc, procs[i], parts[i], i,
+                    one_proc, one_part);
+    }
+  }
+
+  status = Zoltan_LB_Box_PP_Assign_Multi(zz, n, boxes, proc_start, &box_procs,
+                                         part_start, &box_parts);
+  if (status != ZOLTAN_OK)
+    fprintf(fp, "error returned from Zoltan_LB_Box_PP_Assign_Multi()\n");
+  else {
+    for (i = 0; i < n; i++) {
+      status1 = Zoltan_LB_Box_PP_Assign(zz, boxes[6*i], boxes[6*i+1],
+                                        boxes[6*i+2], boxes[6*i+3],
+                                        boxes[6*i+4], boxes[6*i+5],
+                                        procs1, &proccnt, parts1, &partcnt);
+      if (status1 == ZOLTAN_OK && proccnt == proc_start[i+1] - proc_start[i]
+          && partcnt == part_start[i+1] - part_start[i]) {
+        for (j = 0; j < proccnt; j++)
+          if (procs1[j] != box_procs[proc_start[i]+j]) break;
+        if (j == proccnt) {
+          for (j = 0; j < partcnt; j++)
+            if (parts1[j] != box_parts[part_start[i]+j]) break;
+          if (j == partcnt) continue;
+        }
+      }
+      fprintf(fp, "%d Error:  Zoltan_LB_Box_PP_Assign_Multi and "
+                  "Zoltan_LB_Box_PP_Assign differ for box %d\n", Proc, i);
+    }
+    ZOLTAN_FREE(&box_procs);
+    ZOLTAN_FREE(&box_parts);
+  }
+
+End:
+  safe_free((void **)(void *) &coords);
+  safe_free((void **)(void *) &procs);
+}
+
 /*****************************************************************************/
 static void test_box_drops(
   FILE *fp,
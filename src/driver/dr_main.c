@@ -147,6 +147,7 @@ int main(int argc, char *argv[])
   int    iteration;
   int    error, gerror;
   int    print_output = 1;
+  int    thread_multiple, provided;
 
   MESH_INFO  mesh;             /* mesh information struct */
   PARIO_INFO pio_info;
@@ -154,8 +155,12 @@ int main(int argc, char *argv[])
 
 /***************************** BEGIN EXECUTION ******************************/
 
-  /* initialize MPI */
-  MPI_Init(&argc, &argv);
+  /* initialize MPI; threaded Zoltan methods may need MPI_THREAD_MULTIPLE */
+  thread_multiple = read_thread_multiple((argc > 1) ? argv[1] : "zdrive.inp");
+  if (thread_multiple)
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  else
+    MPI_Init(&argc, &argv);
 
 #ifdef VAMPIR
   VT_initialize(&argc, &argv);
@@ -189,10 +194,13 @@ int main(int argc, char *argv[])
   Test.Multi_Callbacks = 0;
   Test.Graph_Callbacks = 1;
   Test.Hypergraph_Callbacks = 1;
+  Test.Hypergraph_Pages = 0;
+  Test.Hypergraph_CSR = 0;
   Test.Gen_Files = 0;
   Test.Null_Lists = NONE;
   Test.Dynamic_Weights = .0;
   Test.Dynamic_Graph = .0;
+  Test.Static_Coords = 0;
   Test.Vtx_Inc = 0;
 
   Output.Text = 1;
@@ -284,7 +292,8 @@ int main(int argc, char *argv[])
   /* broadcast the command info to all of the processor */
   brdcst_cmd_info(Proc, &prob, &pio_info, &mesh);
 
-  Zoltan_Set_Param(NULL, "DEBUG_MEMORY", "1");
+  /* memory debugging is off in threaded runs, as in most applications */
+  Zoltan_Set_Param(NULL, "DEBUG_MEMORY", thread_multiple ? "0" : "1");
   print_output = Output.Text;
 
   /*
@@ -470,7 +479,7 @@ if (iteration == 1) {
       char str[4];
       /* Perturb coordinates of mesh */
       if (mesh.data_type == ZOLTAN_GRAPH){
-        for (i = 0; i < mesh.num_elems; i++) {
+        for (i = 0; i < mesh.num_elems && !Test.Static_Coords; i++) {
           for (j = 0; j < mesh.num_dims; j++) {
             /* tmp = ((float) rand())/RAND_MAX; *//* Equiv. to sjplimp's test */
             tmp = (float) (i % 10) / 10.;
@@ -48,6 +48,7 @@
 #include "dr_util_const.h"
 #include "dr_err_const.h"
 #include "dr_par_util_const.h"
+#include "dr_dd.h"
 
 
 #ifdef __cplusplus
@@ -304,8 +305,11 @@ struct map_list_head *tmp_maps = NULL, *map = NULL;
   safe_free((void **)(void *) &tmp_maps);
   safe_free((void **)(void *) &sindex);
 
-  if (Test.DDirectory) 
+  if (Test.DDirectory) {
     compare_maps_with_ddirectory_results(proc, mesh);
+    if (!test_ddirectory_features(proc))
+      return 0;
+  }
 
   DEBUG_TRACE_END(proc, yo);
   return 1;
@@ -696,14 +696,14 @@ int create_a_graph(
       adj[next++] = right;
       start[i+1]++;
 
-      left = gid - nvtxs;
-      right = gid + nvtxs;
+      left = (long)gid - (long)nvtxs;
+      right = (long)gid + (long)nvtxs;
 
       if (left >= 0){
         adj[next++] = left;
         start[i+1]++;
       }
-      if (right < gnvtxs){
+      if (right < (long)gnvtxs){
         adj[next++] = right;
         start[i+1]++;
       }
@@ -68,6 +68,35 @@ int Zoltan_Hier_Copy_Structure(
   return ZOLTAN_OK;
 }
 
+size_t Zoltan_Hier_Serialize_Structure_Size(
+  ZZ const *zz                 /* Zoltan structure */
+) {
+  /* currently, no persistent data is defined by hierarchical balancing,
+     so nothing needs to be saved */
+  return 0;
+}
+
+int Zoltan_Hier_Serialize_Structure(
+  ZZ const *zz,                /* Zoltan structure */
+  char **buf                   /* Buffer position */
+) {
+  /* the levels' decompositions are not kept after balancing, so the
+     decomposition cannot be saved */
+  ZOLTAN_PRINT_ERROR(zz->Proc, "Zoltan_Hier_Serialize_Structure",
+                     "LB_METHOD HIER does not support serialization.");
+  return ZOLTAN_FATAL;
+}
+
+int Zoltan_Hier_Deserialize_Structure(
+  ZZ *zz,                      /* Zoltan structure */
+  char **buf,                  /* Buffer position */
+  size_t *avail                /* Bytes left in buffer */
+) {
+  ZOLTAN_PRINT_ERROR(zz->Proc, "Zoltan_Hier_Deserialize_Structure",
+                     "LB_METHOD HIER does not support serialization.");
+  return ZOLTAN_FATAL;
+}
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
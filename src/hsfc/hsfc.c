@@ -63,6 +63,7 @@ extern "C" {
 #include "hsfc.h"
 #include "hsfc_params.h"
 #include "zz_const.h"
+#include "zz_sort.h"
 #include <float.h>
 
 /****************************************************************************/
@@ -71,6 +72,14 @@ static int partition_stats(ZZ *zz, int ndots,
                    Dots *dots, int *obj_sizes,
                    float *work_fraction, int *parts, int *new_parts);
 
+static int adaptive_bins(ZZ *zz, int ndots, Dots *dots, float *work_fraction,
+                   float *target, Partition *grand_partition, double *bin_weight,
+                   double *work, int *pcount, double *total_weight, int *loops);
+
+static int integer_keys(ZZ *zz, int ndots, Dots *dots, int dim, HSFC_Data *d,
+                   float *work_fraction, float *target, double *tsum,
+                   int budget, double *total_weight, int *loops);
+
 /****************************************************************************/
 
 /* Zoltan_HSFC - Main routine, Load Balance: Hilbert Space Filling Curve */
@@ -131,6 +140,8 @@ int Zoltan_HSFC(
    int        err;
    int        final_output;
    int        param;
+   int        adaptive;
+   int        ikeys;
    int        idummy;
    double     ddummy;
    int        dim;
@@ -147,10 +158,14 @@ int Zoltan_HSFC(
    Zoltan_Bind_Param (HSFC_params, "KEEP_CUTS", (void*) &param);
    Zoltan_Bind_Param (HSFC_params, "REDUCE_DIMENSIONS", (void*) &idummy);
    Zoltan_Bind_Param (HSFC_params, "DEGENERATE_RATIO", (void*) &ddummy);
-   param = idummy = final_output = 0;
+   Zoltan_Bind_Param (HSFC_params, "HSFC_ADAPTIVE_BINS", (void*) &adaptive);
+   Zoltan_Bind_Param (HSFC_params, "HSFC_INTEGER_KEYS", (void*) &ikeys);
+   param = idummy = final_output = adaptive = ikeys = 0;
    ddummy = 0.0;
    Zoltan_Assign_Param_Vals (zz->Params, HSFC_params, zz->Debug_Level, zz->Proc,
     zz->Debug_Proc);
+   if (ikeys)
+      adaptive = 0;     /* HSFC_INTEGER_KEYS replaces the binned search */
 
    if (sizeof (int) != 4) {
      ZOLTAN_HSFC_ERROR(ZOLTAN_FATAL, 
@@ -172,6 +187,7 @@ int Zoltan_HSFC(
    else{
      d = (HSFC_Data*) zz->LB.Data_Structure;
      ZOLTAN_FREE (&d->final_partition);
+     ZOLTAN_FREE (&d->ikey_bound);
    }
 
    /* obtain dot information: gids, lids, weights  */
@@ -307,9 +323,8 @@ int Zoltan_HSFC(
 
    ZOLTAN_TRACE_DETAIL (zz, yo, "About to enter main loop\n");
 
-
    /* This loop is the real guts of the partitioning algorithm */
-   for (loop = 0; loop < MAX_LOOPS; loop++) {
+   for (loop = 0; !adaptive && !ikeys && loop < MAX_LOOPS; loop++) {
       /* initialize bins, DEFAULT_BIN_MAX is less than any possible max,... */
       for (i = 0;        i <   pcount; i++) 
          grand_weight[i] = temp_weight[i] = 0.0; /* SUM */
@@ -412,6 +427,16 @@ int Zoltan_HSFC(
       grand_partition[pcount-1].r = 1.0 + (2.0 * FLT_EPSILON) ;
       } /* end of loop */
 
+   /* HSFC_ADAPTIVE_BINS:  the same search, refining only the bins that
+      hold cuts */
+   if (adaptive) {
+      err = adaptive_bins (zz, ndots, dots, work_fraction, target,
+       grand_partition, temp_weight, grand_weight, &pcount, &total_weight,
+       &loop);
+      if (err != ZOLTAN_OK)
+         ZOLTAN_HSFC_ERROR (err, "Error returned from adaptive_bins");
+      }
+
    ZOLTAN_TRACE_DETAIL (zz, yo, "Exited main loop");
    Zoltan_Multifree (__FILE__, __LINE__, 3, &grand_weight, &partition, &delta);
    if (zz->Obj_Weight_Dim > 1)
@@ -422,73 +447,82 @@ int Zoltan_HSFC(
    if (d->final_partition == NULL)
       ZOLTAN_HSFC_ERROR (ZOLTAN_MEMERR, "Unable to malloc final_partition");
 
-   /* initializations required to start loop below */
-   d->final_partition[0].l = 0.0;
-   for (k = 0; k < zz->LB.Num_Global_Parts; k++) {
-      tsum[k] = 0.0;
-      d->final_partition[k].index = k;
+   if (ikeys) {
+      /* HSFC_INTEGER_KEYS:  cuts placed exactly between integer keys */
+      err = integer_keys (zz, ndots, dots, dim, d, work_fraction, target,
+       tsum, 3 * pcount, &total_weight, &loop);
+      if (err != ZOLTAN_OK)
+         ZOLTAN_HSFC_ERROR (err, "Error returned from integer_keys");
       }
-   actual = desired = total_weight;
-   i = k = 0;
-   correction = 1.0;
+   else {
+      /* initializations required to start loop below */
+      d->final_partition[0].l = 0.0;
+      for (k = 0; k < zz->LB.Num_Global_Parts; k++) {
+         tsum[k] = 0.0;
+         d->final_partition[k].index = k;
+         }
+      actual = desired = total_weight;
+      i = k = 0;
+      correction = 1.0;
+
+      /* set new partition on [0,1] by summing grand_weights until targets met */
+      /* k counts partitions and i counts grand partitions */
+      while (1)  {
+         if (k >= zz->LB.Num_Global_Parts  ||  i >= pcount)
+            break;
+
+         /* case:  current partition should remain empty */
+         if (target[k] == 0.0)  {
+            d->final_partition[k].r = grand_partition[i].l;
+            k++;
+            if (k < zz->LB.Num_Global_Parts)
+               d->final_partition[k].l = grand_partition[i].l;
+            continue;
+            }
 
-   /* set new partition on [0,1] by summing grand_weights until targets met */
-   /* k counts partitions and i counts grand partitions */
-   while (1)  {
-      if (k >= zz->LB.Num_Global_Parts  ||  i >= pcount)
-         break;
+         /* case: current bin weights fit into current partition */
+         temp = correction * target[k];
+         if (tsum[k] + temp_weight[i] <= temp)  {
+            tsum[k] += temp_weight[i];
+            i++;
+            continue;
+            }
 
-      /* case:  current partition should remain empty */
-      if (target[k] == 0.0)  {
-         d->final_partition[k].r = grand_partition[i].l;
-         k++;
-         if (k < zz->LB.Num_Global_Parts)
-            d->final_partition[k].l = grand_partition[i].l;
-         continue;
-         }
+         /* case: current bin weights overfill current partition */
+         if (temp - tsum[k] > tsum[k] + temp_weight[i] - temp)  {
+            tsum[k] += temp_weight[i];
+            actual  -= tsum[k];
+            desired -= target[k];
+            d->final_partition[k].r = grand_partition[i].r;
+            k++;
+            if (k < zz->LB.Num_Global_Parts)
+               d->final_partition[k].l = grand_partition[i].r;
+            i++;
+            }
+         else    { /* don't include current bin weight in current partition */
+            actual  -= tsum[k];
+            desired -= target[k];
+            d->final_partition[k].r = grand_partition[i].l;
+            k++;
+            if (k < zz->LB.Num_Global_Parts)
+               d->final_partition[k].l = grand_partition[i].l;
+            }
 
-      /* case: current bin weights fit into current partition */
-      temp = correction * target[k];
-      if (tsum[k] + temp_weight[i] <= temp)  {
-         tsum[k] += temp_weight[i];
-         i++;
-         continue;
+         /* correct target[]s for cumulative partitioning errors (Bruce H.) */
+         correction = ((desired == 0) ? 1.0 : actual/desired);
          }
+      /* check if we didn't close out last sum, fix right boundary if needed */   
+      if (i == pcount && k < zz->LB.Num_Global_Parts)
+        {
+        d->final_partition[k].r = 1.0 + (2.0 * FLT_EPSILON) ;
+        k++;
+        }
 
-      /* case: current bin weights overfill current partition */
-      if (temp - tsum[k] > tsum[k] + temp_weight[i] - temp)  {
-         tsum[k] += temp_weight[i];
-         actual  -= tsum[k];
-         desired -= target[k];
-         d->final_partition[k].r = grand_partition[i].r;
-         k++;
-         if (k < zz->LB.Num_Global_Parts)
-            d->final_partition[k].l = grand_partition[i].r;
-         i++;
-         }
-      else    { /* don't include current bin weight in current partition */
-         actual  -= tsum[k];
-         desired -= target[k];
-         d->final_partition[k].r = grand_partition[i].l;
-         k++;
-         if (k < zz->LB.Num_Global_Parts)
-            d->final_partition[k].l = grand_partition[i].l;
+      /* if last partition(s) is empty, loop stops w/o setting final_partition(s) */
+      for (i = k; i < zz->LB.Num_Global_Parts; i++)  {
+         d->final_partition[i].r = 1.0 + (2.0 * FLT_EPSILON);
+         d->final_partition[i].l = 1.0 + (2.0 * FLT_EPSILON);
          }
-
-      /* correct target[]s for cumulative partitioning errors (Bruce H.) */
-      correction = ((desired == 0) ? 1.0 : actual/desired);
-      }
-   /* check if we didn't close out last sum, fix right boundary if needed */   
-   if (i == pcount && k < zz->LB.Num_Global_Parts)
-     {
-     d->final_partition[k].r = 1.0 + (2.0 * FLT_EPSILON) ;
-     k++;
-     }
-
-   /* if last partition(s) is empty, loop stops w/o setting final_partition(s) */
-   for (i = k; i < zz->LB.Num_Global_Parts; i++)  {
-      d->final_partition[i].r = 1.0 + (2.0 * FLT_EPSILON);
-      d->final_partition[i].l = 1.0 + (2.0 * FLT_EPSILON);
       }
 
    out_of_tolerance = 0;
@@ -505,7 +539,9 @@ int Zoltan_HSFC(
    /* Set the final part number for all dots */
    for (i = 0; i < ndots; i++) {
       j = dots[i].part / N; /* grand_partition is N times final_partition parts*/
-      if (dots[i].fsfc <  d->final_partition[j].r
+      if (ikeys)
+          p = d->final_partition + dots[i].part;  /* set from integer keys */
+      else if (dots[i].fsfc <  d->final_partition[j].r
        && dots[i].fsfc >= d->final_partition[j].l)
           p = d->final_partition + j;
       else
@@ -705,8 +741,10 @@ int Zoltan_HSFC_compare (const void *key, const void *arg)
 void Zoltan_HSFC_Free_Structure (ZZ *zz)
    {
    HSFC_Data *data = (HSFC_Data*) zz->LB.Data_Structure;
-   if (data != NULL)
+   if (data != NULL) {
       ZOLTAN_FREE (&data->final_partition);
+      ZOLTAN_FREE (&data->ikey_bound);
+      }
    ZOLTAN_FREE (&zz->LB.Data_Structure);
    }
 
@@ -735,6 +773,8 @@ int Zoltan_HSFC_Copy_Structure(ZZ *toZZ, ZZ const *fromZZ)
   toZZ->LB.Data_Structure = (void *)to;
 
   *to = *from;
+  to->final_partition = NULL;
+  to->ikey_bound = NULL;
 
   if (from->final_partition){
     len = sizeof(Partition) * fromZZ->LB.Num_Global_Parts;
@@ -750,8 +790,134 @@ int Zoltan_HSFC_Copy_Structure(ZZ *toZZ, ZZ const *fromZZ)
     memcpy(to->final_partition, from->final_partition, len);
   }
 
+  if (from->ikey_bound){
+    len = sizeof(uint64_t) * fromZZ->LB.Num_Global_Parts;
+
+    to->ikey_bound = (uint64_t*) ZOLTAN_MALLOC(len);
+
+    if (!to->ikey_bound){
+      Zoltan_HSFC_Free_Structure(toZZ);
+      ZOLTAN_PRINT_ERROR(fromZZ->Proc, yo, "Insufficient memory.");
+      return ZOLTAN_MEMERR;
+    }
+
+    memcpy(to->ikey_bound, from->ikey_bound, len);
+  }
+
   return ZOLTAN_OK;
 }
+
+/* Serialization of an hsfc data structure for Zoltan_LB_Serialize:
+ * the bounding box, ndimension and tran, then a flag telling whether
+ * final_partition is present and final_partition, then the same for
+ * ikey_bound.  fhsfc is restored from the dimension of the (transformed)
+ * geometry. */
+
+size_t Zoltan_HSFC_Serialize_Structure_Size(ZZ const *zz)
+{
+  HSFC_Data const *data = (HSFC_Data const *)zz->LB.Data_Structure;
+  size_t size = 9 * sizeof(double) + 3 * sizeof(int) 
+              + ZOLTAN_SERIAL_TRANSFORM_SIZE;
+
+  if (data->final_partition)
+    size += zz->LB.Num_Global_Parts * (2 * sizeof(double) + sizeof(int));
+  if (data->ikey_bound)
+    size += zz->LB.Num_Global_Parts * sizeof(uint64_t);
+  return size;
+}
+
+int Zoltan_HSFC_Serialize_Structure(ZZ const *zz, char **buf)
+{
+  HSFC_Data const *data = (HSFC_Data const *)zz->LB.Data_Structure;
+  Partition const *p;
+  int i, flag;
+
+  Zoltan_Serialize_Double(buf, data->bbox_hi, 3);
+  Zoltan_Serialize_Double(buf, data->bbox_lo, 3);
+  Zoltan_Serialize_Double(buf, data->bbox_extent, 3);
+  Zoltan_Serialize_Int(buf, &(data->ndimension), 1);
+  Zoltan_Serialize_Transform(buf, &(data->tran));
+  flag = (data->final_partition != NULL);
+  Zoltan_Serialize_Int(buf, &flag, 1);
+  for (i = 0; flag && i < zz->LB.Num_Global_Parts; i++) {
+    p = &(data->final_partition[i]);
+    Zoltan_Serialize_Double(buf, &(p->r), 1);
+    Zoltan_Serialize_Double(buf, &(p->l), 1);
+    Zoltan_Serialize_Int(buf, &(p->index), 1);
+  }
+  flag = (data->ikey_bound != NULL);
+  Zoltan_Serialize_Int(buf, &flag, 1);
+  if (flag)
+    Zoltan_Serialize_Bytes(buf, data->ikey_bound,
+                           zz->LB.Num_Global_Parts * sizeof(uint64_t));
+  return ZOLTAN_OK;
+}
+
+int Zoltan_HSFC_Deserialize_Structure(ZZ *zz, char **buf, size_t *avail)
+{
+  char *yo = "Zoltan_HSFC_Deserialize_Structure";
+  HSFC_Data *data;
+  Partition *p;
+  size_t len;
+  int i, dim, flag, ierr;
+
+  data = (HSFC_Data *)ZOLTAN_CALLOC(1, sizeof(HSFC_Data));
+  if (!data){
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+    return ZOLTAN_MEMERR;
+  }
+  zz->LB.Data_Structure = (void *)data;
+
+  ierr = Zoltan_Deserialize_Double(buf, avail, data->bbox_hi, 3);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Double(buf, avail, data->bbox_lo, 3);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Double(buf, avail, data->bbox_extent, 3);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(data->ndimension), 1);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Transform(buf, avail, &(data->tran));
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &flag, 1);
+  if (!ierr && flag){
+    len = zz->LB.Num_Global_Parts * sizeof(Partition);
+    data->final_partition = (Partition *)ZOLTAN_MALLOC(len);
+    if (data->final_partition == NULL)
+      ierr = ZOLTAN_MEMERR;
+    for (i = 0; !ierr && i < zz->LB.Num_Global_Parts; i++){
+      p = &(data->final_partition[i]);
+      ierr = Zoltan_Deserialize_Double(buf, avail, &(p->r), 1);
+      if (!ierr) ierr = Zoltan_Deserialize_Double(buf, avail, &(p->l), 1);
+      if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(p->index), 1);
+    }
+  }
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &flag, 1);
+  if (!ierr && flag){
+    len = zz->LB.Num_Global_Parts * sizeof(uint64_t);
+    data->ikey_bound = (uint64_t *)ZOLTAN_MALLOC(len);
+    if (data->ikey_bound == NULL)
+      ierr = ZOLTAN_MEMERR;
+    else
+      ierr = Zoltan_Deserialize_Bytes(buf, avail, data->ikey_bound, len);
+  }
+  if (ierr){
+    Zoltan_HSFC_Free_Structure(zz);
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, (ierr == ZOLTAN_MEMERR 
+                       ? "Insufficient memory." : "Buffer is truncated."));
+    return ierr;
+  }
+
+  /* as in Zoltan_HSFC */
+  dim = (data->tran.Target_Dim > 0 ? data->tran.Target_Dim 
+                                   : data->ndimension);
+  if      (dim == 1)  data->fhsfc = Zoltan_HSFC_InvHilbert1d;
+  else if (dim == 2)  data->fhsfc = Zoltan_HSFC_InvHilbert2d;
+  else if (dim == 3)  data->fhsfc = Zoltan_HSFC_InvHilbert3d;
+
+  return ZOLTAN_OK;
+}
+
 void Zoltan_HSFC_Print_Structure(ZZ *zz)
 {
 HSFC_Data *data;
@@ -903,6 +1069,490 @@ double *gpartWgt = NULL;
   return ZOLTAN_OK;
 }
 
+
+/****************************************************************************/
+
+/* interval [l,r) of the curve known to hold cuts first_cut to last_cut */
+typedef struct Bracket {
+   double l, r;
+   double below;        /* global weight of the dots before l */
+   double weight;       /* global weight of the dots in [l,r) */
+   int    first_cut, last_cut;
+   int    active;       /* still refinable */
+   int    nsub;         /* number of sub-bins in the current pass */
+   int    bin;          /* index of its first sub-bin in the current pass */
+   } Bracket;
+
+/* MPI_Op combining (sum, max, min) triples of bin statistics */
+static void bin_merge (void *in, void *inout, int *len, MPI_Datatype *dptr)
+   {
+   double *a = (double*) in;
+   double *b = (double*) inout;
+   int i;
+
+   for (i = 0; i < 3 * *len; i += 3) {
+      b[i] += a[i];
+      if (a[i+1] > b[i+1])  b[i+1] = a[i+1];
+      if (a[i+2] < b[i+2])  b[i+2] = a[i+2];
+      }
+   }
+
+/* index of the sub-bin [l+s*h, l+(s+1)*h) of nsub sub-bins holding x */
+static int sub_bin (double x, double l, double h, int nsub)
+   {
+   int s = (int) ((x - l) / h);
+
+   if (s < 0)         s = 0;
+   if (s > nsub - 1)  s = nsub - 1;
+   while (s > 0  &&  x < l + s * h)                s--;
+   while (s < nsub - 1  &&  x >= l + (s+1) * h)    s++;
+   return s;
+   }
+
+
+
+/* Version of the main loop of Zoltan_HSFC for HSFC_ADAPTIVE_BINS.  As there,
+ * the first pass bins all dots on pcount equal bins of [0,1] and each later
+ * pass divides the bins holding cuts into N-1 sub-bins per cut, until no such
+ * bin is refinable or MAX_LOOPS is reached.  But the bins without cuts are
+ * not binned again, and a bin stops being refined as soon as it is resolved,
+ * so a pass reduces only N-1 bins per unresolved cut instead of
+ * N*(parts-1)+1.  The sum, max and min of the bins are reduced together.
+ * On return grand_partition and bin_weight hold the bins with cuts and the
+ * gaps between them, as input to the final partitioning in Zoltan_HSFC, and
+ * pcount is their number (at most 2*parts-1).  bin_weight and work have
+ * space for 3 * pcount doubles. */
+static int adaptive_bins(
+ ZZ        *zz,
+ int        ndots,
+ Dots      *dots,
+ float     *work_fraction,
+ float     *target,             /* Output: desired weight of each part */
+ Partition *grand_partition,    /* Output: bins for the final partition */
+ double    *bin_weight,         /* Output: weight of each bin */
+ double    *work,
+ int       *pcount,
+ double    *total_weight,       /* Output: weight of all dots */
+ int       *loops)              /* Output: number of passes */
+   {
+   char    *yo = "adaptive_bins";
+   int      nparts = zz->LB.Num_Global_Parts;
+   Bracket *br = NULL, *newbr = NULL, *tmpbr;
+   Partition *ref = NULL, *p;   /* brackets being refined */
+   double  *cut = NULL;         /* cumulative target weight at each cut */
+   int     *active = NULL;      /* dots in brackets being refined */
+   int      nactive, nbr, nnew, nref, nsub, nbins;
+   Bracket *q;
+   int      i, j, k, m, n, s, b, loop, err = ZOLTAN_OK;
+   double   h, below, l, r, *w;
+   MPI_Datatype bin_type;
+   MPI_Op   bin_op;
+
+   br     = (Bracket*)  ZOLTAN_MALLOC (sizeof(Bracket)   * nparts);
+   newbr  = (Bracket*)  ZOLTAN_MALLOC (sizeof(Bracket)   * nparts);
+   ref    = (Partition*)ZOLTAN_MALLOC (sizeof(Partition) * nparts);
+   cut    = (double*)   ZOLTAN_MALLOC (sizeof(double)    * nparts);
+   active = (int*)      ZOLTAN_MALLOC (sizeof(int)       * (ndots + 1));
+   if (br == NULL || newbr == NULL || ref == NULL || cut == NULL
+    || active == NULL) {
+      ZOLTAN_PRINT_ERROR (zz->Proc, yo, "Malloc error for brackets");
+      Zoltan_Multifree (__FILE__, __LINE__, 5, &br, &newbr, &ref, &cut,
+       &active);
+      return ZOLTAN_MEMERR;
+      }
+
+   MPI_Type_contiguous (3, MPI_DOUBLE, &bin_type);
+   MPI_Type_commit (&bin_type);
+   MPI_Op_create (&bin_merge, 1, &bin_op);
+
+   /* one bracket holding all cuts, divided into the initial bins */
+   nbr = 1;
+   br[0].l = 0.0;
+   br[0].r = 1.0 + (2.0 * FLT_EPSILON);
+   br[0].below = br[0].weight = 0.0;
+   br[0].first_cut = 0;
+   br[0].last_cut = nparts - 2;
+   br[0].active = 1;
+   for (i = 0; i < ndots; i++)
+      active[i] = i;
+   nactive = ndots;
+
+   for (loop = 0; loop < MAX_LOOPS; loop++) {
+      for (nref = nbins = b = 0; b < nbr; b++)
+         if (br[b].active) {
+            ref[nref].l = br[b].l;
+            ref[nref].r = br[b].r;
+            ref[nref].index = b;
+            nref++;
+            br[b].nsub = (loop == 0) ? *pcount
+             : (N - 1) * (br[b].last_cut - br[b].first_cut + 1);
+            br[b].bin = nbins;
+            nbins += br[b].nsub;
+            }
+      if (nref == 0)
+         break;        /* all cuts resolved */
+      for (i = 0; i < 3 * nbins; i += 3) {
+         work[i]   = 0.0;
+         work[i+1] = DEFAULT_BIN_MAX;
+         work[i+2] = DEFAULT_BIN_MIN;
+         }
+
+      /* bin the dots in brackets being refined; forget the others */
+      for (n = j = 0; j < nactive; j++) {
+         i = active[j];
+         p = (Partition*) bsearch (&dots[i].fsfc, ref, nref, sizeof(Partition),
+          Zoltan_HSFC_compare);
+         if (p == NULL)
+            continue;
+         active[n++] = i;
+         q = br + p->index;
+         s = sub_bin (dots[i].fsfc, p->l, (p->r - p->l) / q->nsub, q->nsub);
+         if (loop == 0)
+            dots[i].part = s;
+         m = 3 * (q->bin + s);
+         work[m] += dots[i].weight;
+         if (dots[i].fsfc > work[m+1])  work[m+1] = dots[i].fsfc;
+         if (dots[i].fsfc < work[m+2])  work[m+2] = dots[i].fsfc;
+         }
+      nactive = n;
+
+      err = MPI_Allreduce (work, bin_weight, nbins, bin_type, bin_op,
+       zz->Communicator);
+      if (err != MPI_SUCCESS) {
+         ZOLTAN_PRINT_ERROR (zz->Proc, yo, "MPI_Allreduce returned error");
+         err = ZOLTAN_FATAL;
+         goto End;
+         }
+      err = ZOLTAN_OK;
+
+      if (loop == 0) {
+         *total_weight = 0.0;
+         for (i = 0; i < nbins; i++)
+            *total_weight += bin_weight[3*i];
+         below = 0.0;
+         for (k = 0; k < nparts; k++) {
+            target[k] = work_fraction[k] * *total_weight;
+            below += target[k];
+            cut[k] = below;
+            }
+         }
+
+      if (zz->Debug_Level >= ZOLTAN_DEBUG_ALL && zz->Proc == 0)
+         printf ("HSFC adaptive loop %d: %d of %d bins holding cuts refined\n",
+          loop, nref, nbr);
+
+      /* move each cut into the sub-bin of its bracket holding it */
+      for (nnew = b = 0; b < nbr; b++) {
+         if (!br[b].active) {
+            newbr[nnew++] = br[b];
+            continue;
+            }
+         nsub = br[b].nsub;
+         w = bin_weight + 3 * br[b].bin;
+         h = (br[b].r - br[b].l) / nsub;
+         below = br[b].below;
+         s = 0;
+         for (k = br[b].first_cut; k <= br[b].last_cut; k++) {
+            /* cuts increase, so the sweep over the sub-bins continues */
+            for (; s < nsub - 1  &&  below + w[3*s] <= cut[k]; s++)
+               below += w[3*s];
+            l = br[b].l + s * h;
+            r = (s == nsub - 1) ? br[b].r : br[b].l + (s+1) * h;
+            if (nnew > 0  &&  newbr[nnew-1].l == l  &&  newbr[nnew-1].r == r) {
+               newbr[nnew-1].last_cut = k;
+               continue;
+               }
+            newbr[nnew].l = l;
+            newbr[nnew].r = r;
+            newbr[nnew].below = below;
+            newbr[nnew].weight = w[3*s];
+            newbr[nnew].first_cut = newbr[nnew].last_cut = k;
+            newbr[nnew].active = (w[3*s+1] - w[3*s+2] > REFINEMENT_LIMIT);
+            nnew++;
+            }
+         }
+      tmpbr = br;  br = newbr;  newbr = tmpbr;
+      nbr  = nnew;
+      }
+   *loops = loop;
+
+   /* bins for the final partition:  the brackets and the gaps between them */
+   n = 0;
+   l = below = 0.0;
+   for (b = 0; b < nbr; b++) {
+      if (br[b].l > l) {
+         grand_partition[n].l = l;
+         grand_partition[n].r = br[b].l;
+         bin_weight[n] = (br[b].below > below) ? br[b].below - below : 0.0;
+         n++;
+         }
+      grand_partition[n].l = br[b].l;
+      grand_partition[n].r = br[b].r;
+      bin_weight[n] = br[b].weight;
+      n++;
+      l = br[b].r;
+      below = br[b].below + br[b].weight;
+      }
+   if (n == 0  ||  l < 1.0 + (2.0 * FLT_EPSILON)) {
+      grand_partition[n].l = l;
+      grand_partition[n].r = 1.0 + (2.0 * FLT_EPSILON);
+      bin_weight[n] = (*total_weight > below) ? *total_weight - below : 0.0;
+      n++;
+      }
+   for (i = 0; i < n; i++)
+      grand_partition[i].index = i;
+   *pcount = n;
+
+End:
+   MPI_Op_free (&bin_op);
+   MPI_Type_free (&bin_type);
+   Zoltan_Multifree (__FILE__, __LINE__, 5, &br, &newbr, &ref, &cut, &active);
+   return err;
+   }
+
+/****************************************************************************/
+
+/* range [lo, lo + 2^shift) of integer keys known to hold cuts first_cut to
+   last_cut */
+typedef struct KeyRange {
+   uint64_t lo;
+   double below;        /* global weight of the dots with keys before lo */
+   double weight;       /* global weight of the dots in the range */
+   int    first_cut, last_cut;
+   } KeyRange;
+
+/* index of the first of the sorted keys key[lo:hi-1] not less than x */
+static int key_lower_bound (uint64_t *key, int lo, int hi, uint64_t x)
+   {
+   int mid;
+
+   while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (key[mid] < x)
+         lo = mid + 1;
+      else
+         hi = mid;
+      }
+   return lo;
+   }
+
+
+
+/* HSFC_INTEGER_KEYS version of the partitioning in Zoltan_HSFC.  Instead of
+ * binning the double keys, the dots get integer Hilbert keys, which are
+ * radix sorted locally; the local weight in any range of keys is then a
+ * difference of prefix sums.  Each pass divides the ranges holding cuts
+ * into 2^b sub-ranges on the next b bits of the keys and sums their weights
+ * in one MPI_Allreduce, with b (at most 8) chosen to reduce no more than
+ * budget bins.  When all bits are resolved, each cut lies on a single key,
+ * and the dots with that key go entirely below or above it, so the cuts
+ * are exact and independent of the spread of the keys.  Sets dots[].part,
+ * target, tsum (weight of each part), total_weight, d->ikey_bound, the
+ * integer cuts used by point assign, and d->final_partition, the cuts
+ * scaled to [0,1] for box assign. */
+static int integer_keys (
+ ZZ        *zz,
+ int        ndots,
+ Dots      *dots,
+ int        dim,
+ HSFC_Data *d,
+ float     *work_fraction,
+ float     *target,             /* Output: desired weight of each part */
+ double    *tsum,               /* Output: weight of each part */
+ int        budget,             /* bins allowed in a reduction */
+ double    *total_weight,       /* Output: weight of all dots */
+ int       *loops)              /* Output: number of passes */
+   {
+   char     *yo = "integer_keys";
+   int       nparts = zz->LB.Num_Global_Parts;
+   uint64_t  (*fkey)(ZZ*, double*);
+   uint64_t *key = NULL;        /* sorted keys of the local dots */
+   uint64_t *bound = NULL;      /* bound[k]: first key after part k */
+   int      *perm = NULL;       /* dot of each sorted key */
+   double   *pw = NULL;         /* pw[j]: local weight of sorted dots < j */
+   double   *cut = NULL;        /* cumulative target weight at each cut */
+   double   *wbound = NULL;     /* global weight of the keys before bound */
+   double   *work = NULL, *bins = NULL, *w;
+   KeyRange *rng = NULL, *newrng = NULL, *tmprng;
+   int       bits, shift, b, nsub, nr, nnew, nbins;
+   int       i, j, k, r, s, m, j0, j1, loop, err = ZOLTAN_OK;
+   double    below, sum, x[3];
+   double    actual, desired, correction, temp;
+   uint64_t  lo;
+
+   if      (dim == 1)  { fkey = Zoltan_HSFC_IKey1d;  bits = HSFC_IKEY_BITS_1D; }
+   else if (dim == 2)  { fkey = Zoltan_HSFC_IKey2d;  bits = HSFC_IKEY_BITS_2D; }
+   else                { fkey = Zoltan_HSFC_IKey3d;  bits = HSFC_IKEY_BITS_3D; }
+   if (budget < 256)
+      budget = 256;
+
+   key    = (uint64_t*) ZOLTAN_MALLOC (sizeof(uint64_t) * (ndots + 1));
+   perm   = (int*)      ZOLTAN_MALLOC (sizeof(int)      * (ndots + 1));
+   pw     = (double*)   ZOLTAN_MALLOC (sizeof(double)   * (ndots + 1));
+   bound  = (uint64_t*) ZOLTAN_MALLOC (sizeof(uint64_t) * nparts);
+   cut    = (double*)   ZOLTAN_MALLOC (sizeof(double)   * nparts);
+   wbound = (double*)   ZOLTAN_MALLOC (sizeof(double)   * nparts);
+   rng    = (KeyRange*) ZOLTAN_MALLOC (sizeof(KeyRange) * nparts);
+   newrng = (KeyRange*) ZOLTAN_MALLOC (sizeof(KeyRange) * nparts);
+   work   = (double*)   ZOLTAN_MALLOC (sizeof(double)   * 2 * budget);
+   if (key == NULL || perm == NULL || pw == NULL || bound == NULL
+    || cut == NULL || wbound == NULL || rng == NULL || newrng == NULL
+    || work == NULL) {
+      ZOLTAN_PRINT_ERROR (zz->Proc, yo, "Malloc error for keys");
+      err = ZOLTAN_MEMERR;
+      goto End;
+      }
+   bins = work + budget;
+
+   /* integer keys of the dots scaled to the bounding box, sorted locally */
+   for (i = 0; i < ndots; i++) {
+      for (j = 0; j < dim; j++)
+         x[j] = (dots[i].x[j] - d->bbox_lo[j]) / d->bbox_extent[j];
+      key[i]  = fkey (zz, x);
+      perm[i] = i;
+      }
+   err = Zoltan_radixsort_list_inc_uint64 (key, perm, ndots, 1);
+   if (err != ZOLTAN_OK) {
+      ZOLTAN_PRINT_ERROR (zz->Proc, yo, "Error returned from radix sort");
+      goto End;
+      }
+   pw[0] = 0.0;
+   for (j = 0; j < ndots; j++)
+      pw[j+1] = pw[j] + dots[perm[j]].weight;
+
+   /* one range holding all cuts; the first pass also gives the total weight */
+   nr = 1;
+   rng[0].lo = 0;
+   rng[0].below = rng[0].weight = 0.0;
+   rng[0].first_cut = 0;
+   rng[0].last_cut = nparts - 2;
+   shift = bits;
+
+   for (loop = 0; shift > 0; loop++) {
+      for (b = 1; b < 8 && b < shift && (nr << (b+1)) <= budget; b++);
+      nsub = 1 << b;
+      shift -= b;
+      nbins = nr * nsub;
+
+      /* local weight of each sub-range */
+      for (m = r = 0; r < nr; r++) {
+         j0 = key_lower_bound (key, 0, ndots, rng[r].lo);
+         for (s = 0; s < nsub; s++, m++) {
+            j1 = key_lower_bound (key, j0, ndots,
+             rng[r].lo + ((uint64_t) (s+1) << shift));
+            work[m] = pw[j1] - pw[j0];
+            j0 = j1;
+            }
+         }
+
+      err = MPI_Allreduce (work, bins, nbins, MPI_DOUBLE, MPI_SUM,
+       zz->Communicator);
+      if (err != MPI_SUCCESS) {
+         ZOLTAN_PRINT_ERROR (zz->Proc, yo, "MPI_Allreduce returned error");
+         err = ZOLTAN_FATAL;
+         goto End;
+         }
+      err = ZOLTAN_OK;
+
+      if (loop == 0) {
+         /* cumulative targets, normalized so the last cut is the total */
+         *total_weight = 0.0;
+         for (i = 0; i < nbins; i++)
+            *total_weight += bins[i];
+         for (sum = 0.0, k = 0; k < nparts; k++)
+            sum += work_fraction[k];
+         for (below = 0.0, k = 0; k < nparts; k++) {
+            target[k] = work_fraction[k] * *total_weight;
+            below += work_fraction[k];
+            cut[k] = (sum > 0.0) ? *total_weight * below / sum : 0.0;
+            }
+         }
+
+      if (zz->Debug_Level >= ZOLTAN_DEBUG_ALL && zz->Proc == 0)
+         printf ("HSFC integer keys loop %d: %d key ranges holding cuts, "
+          "%d bits\n", loop, nr, b);
+
+      /* move each cut into the sub-range holding it */
+      for (nnew = r = 0; r < nr; r++) {
+         w = bins + r * nsub;
+         below = rng[r].below;
+         s = 0;
+         for (k = rng[r].first_cut; k <= rng[r].last_cut; k++) {
+            for (; s < nsub - 1  &&  below + w[s] < cut[k]; s++)
+               below += w[s];
+            lo = rng[r].lo + ((uint64_t) s << shift);
+            if (nnew > 0  &&  newrng[nnew-1].lo == lo) {
+               newrng[nnew-1].last_cut = k;
+               continue;
+               }
+            newrng[nnew].lo = lo;
+            newrng[nnew].below = below;
+            newrng[nnew].weight = w[s];
+            newrng[nnew].first_cut = newrng[nnew].last_cut = k;
+            nnew++;
+            }
+         }
+      tmprng = rng;  rng = newrng;  newrng = tmprng;
+      nr = nnew;
+      if (nr == 0)
+         break;        /* single part, no cuts */
+      }
+   *loops = loop;
+
+   /* each range is now a single key; as in the final partition of
+      Zoltan_HSFC, its dots join the part ending there if that brings the
+      part nearer its target corrected for the previous parts' errors */
+   actual = desired = *total_weight;
+   correction = 1.0;
+   below = 0.0;
+   for (r = 0; r < nr; r++)
+      for (k = rng[r].first_cut; k <= rng[r].last_cut; k++) {
+         temp = correction * target[k];
+         if ((k > 0  &&  bound[k-1] > rng[r].lo)
+          || temp - (rng[r].below - below)
+           > rng[r].below + rng[r].weight - below - temp) {
+            bound[k]  = rng[r].lo + 1;
+            wbound[k] = rng[r].below + rng[r].weight;
+            }
+         else {
+            bound[k]  = rng[r].lo;
+            wbound[k] = rng[r].below;
+            }
+         actual  -= wbound[k] - below;
+         desired -= target[k];
+         correction = ((desired == 0) ? 1.0 : actual/desired);
+         below = wbound[k];
+         }
+   bound[nparts-1]  = (uint64_t) 1 << bits;    /* one past the largest key */
+   wbound[nparts-1] = *total_weight;
+
+   for (below = 0.0, k = 0; k < nparts; k++) {
+      tsum[k] = wbound[k] - below;
+      below = wbound[k];
+      d->final_partition[k].index = k;
+      d->final_partition[k].l = (k == 0) ? 0.0
+       : ldexp ((double) bound[k-1], -bits);
+      d->final_partition[k].r = (k == nparts - 1) ? 1.0 + (2.0 * FLT_EPSILON)
+       : ldexp ((double) bound[k], -bits);
+      }
+
+   for (k = j = 0; j < ndots; j++) {
+      while (k < nparts - 1  &&  key[j] >= bound[k])
+         k++;
+      dots[perm[j]].part = k;
+      }
+
+   /* keep the exact cuts; the doubles above drop their low bits */
+   d->ikey_bound = bound;
+   bound = NULL;
+
+End:
+   Zoltan_Multifree (__FILE__, __LINE__, 9, &key, &perm, &pw, &bound, &cut,
+    &wbound, &rng, &newrng, &work);
+   return err;
+   }
+
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
@@ -105,6 +105,8 @@ typedef struct Partition {
 
 typedef struct HSFC_Data {
    Partition *final_partition;
+   uint64_t  *ikey_bound;        /* HSFC_INTEGER_KEYS: first key after each
+                                    part, else NULL */
    double     bbox_hi[3];        /* smallest bounding box, high point */
    double     bbox_lo[3];        /* smallest bounding box, low point */
    double     bbox_extent[3];    /* length of each side of bounding box */
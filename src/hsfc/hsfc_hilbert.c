@@ -74,16 +74,35 @@ double Zoltan_HSFC_InvHilbert1d (ZZ *zz, double *coord)
 
 
 
-/* Given x,y coordinates in [0,1]x[0,1], returns the Hilbert key [0,1] */
-double Zoltan_HSFC_InvHilbert2d (ZZ *zz, double *coord)
+/* Given a 1-d coordinate in [0,1], returns it as the integer Hilbert key of
+HSFC_IKEY_BITS_1D bits (the coordinate truncated to that precision) */
+uint64_t Zoltan_HSFC_IKey1d (ZZ *zz, double *coord)
+   {
+   char *yo = "Zoltan_HSFC_IKey1d";
+
+   /* sanity check for input arguments */
+   if (coord[0] < 0.0)
+      ZOLTAN_PRINT_ERROR (zz->Proc, yo, "Spatial Coordinates out of range.");
+
+   if (coord[0] >= 1.0)
+      return (((uint64_t) 1) << HSFC_IKEY_BITS_1D) - 1;
+   return (uint64_t) ldexp (coord[0], HSFC_IKEY_BITS_1D);
+   }
+
+
+
+/* Given x,y coordinates in [0,1]x[0,1], returns the integer Hilbert key of
+HSFC_IKEY_BITS_2D bits */
+uint64_t Zoltan_HSFC_IKey2d (ZZ *zz, double *coord)
    {
    static const unsigned *d[]={idata2d,  idata2d  +4, idata2d  +8, idata2d  +12};
    static const unsigned *s[]={istate2d, istate2d +4, istate2d +8, istate2d +12};
 
    int level;
-   unsigned int key[2], c[2], temp, state;
-   const int MAXLEVEL = 28; /* 56 bits of significance, 28 per dimension */
-   char *yo = "Zoltan_HSFC_InvHilbert2d";
+   unsigned int c[2], temp, state;
+   uint64_t key;
+   const int MAXLEVEL = HSFC_IKEY_BITS_2D / 2;  /* 28 per dimension */
+   char *yo = "Zoltan_HSFC_IKey2d";
 
    /* sanity check for input arguments */
    if ((coord[0] < 0.0) || (coord[0] > 1.0) || (coord[1] < 0.0) 
@@ -95,27 +114,35 @@ double Zoltan_HSFC_InvHilbert2d (ZZ *zz, double *coord)
    c[1] = (unsigned int) (coord[1] * (double) IMAX);               /* y */
 
    /* use state tables to convert nested quadrant's coordinates level by level */
-   key[0] = key[1] = 0;
+   key = 0;
    state = 0;
    for (level = 0; level < MAXLEVEL; level++) {
       temp = ((c[0] >> (30-level)) & 2)    /* extract 2 bits at current level */
            | ((c[1] >> (31-level)) & 1);
 
-      /* treat key[] as long shift register, shift in converted coordinate */
-      key[0] = (key[0] << 2) | (key[1] >> 30);
-      key[1] = (key[1] << 2) | *(d[state] + temp);
+      /* shift in converted coordinate */
+      key = (key << 2) | *(d[state] + temp);
 
       state = *(s[state] + temp);
       }
 
-   /* convert 2 part Hilbert key to double and return */
-   return ldexp ((double) key[0], -24)  +  ldexp ((double) key[1], -56);
+   return key;
    }
 
 
 
-/* Given x,y,z coordinates in [0,1]x[0,1]x[0,1], returns Hilbert key in [0,1] */
-double Zoltan_HSFC_InvHilbert3d (ZZ *zz, double *coord)
+/* Given x,y coordinates in [0,1]x[0,1], returns the Hilbert key [0,1] */
+double Zoltan_HSFC_InvHilbert2d (ZZ *zz, double *coord)
+   {
+   /* a single rounding of the integer key, as the sum of its two halves */
+   return ldexp ((double) Zoltan_HSFC_IKey2d (zz, coord), -HSFC_IKEY_BITS_2D);
+   }
+
+
+
+/* Given x,y,z coordinates in [0,1]x[0,1]x[0,1], returns the integer Hilbert
+key of HSFC_IKEY_BITS_3D bits */
+uint64_t Zoltan_HSFC_IKey3d (ZZ *zz, double *coord)
    {
    static const unsigned int *d[] =
      {idata3d,      idata3d +8,   idata3d +16,  idata3d +24,
@@ -134,9 +161,10 @@ double Zoltan_HSFC_InvHilbert3d (ZZ *zz, double *coord)
       istate3d +160, istate3d +168, istate3d +176, istate3d +184};
 
    int level;
-   unsigned int key[2], c[3], temp, state;
-   const int MAXLEVEL = 19; /* 56 bits of significance, 18+ per dimension */
-   char *yo = "Zoltan_HSFC_InvHilbert3d";
+   unsigned int c[3], temp, state;
+   uint64_t key;
+   const int MAXLEVEL = HSFC_IKEY_BITS_3D / 3;  /* 19 per dimension */
+   char *yo = "Zoltan_HSFC_IKey3d";
 
    /* sanity check for input arguments */
    if ((coord[0] < 0.0)  || (coord[0] > 1.0) || (coord[1] < 0.0)
@@ -149,22 +177,29 @@ double Zoltan_HSFC_InvHilbert3d (ZZ *zz, double *coord)
    c[2] = (unsigned int) (coord[2] * (double) IMAX);     /* z */
 
    /* use state tables to convert nested quadrant's coordinates level by level */
-   key[0] = key[1] = 0;
+   key = 0;
    state = 0;
    for (level = 0; level < MAXLEVEL; level++) {
       temp = ((c[0] >> (29-level)) & 4)  /* extract 3 bits at current level */
            | ((c[1] >> (30-level)) & 2)
            | ((c[2] >> (31-level)) & 1);
 
-      /* treat key[] as long shift register, shift in converted coordinate */
-      key[0] = (key[0] << 3) |  (key[1] >> 29);
-      key[1] = (key[1] << 3) | *(d[state] + temp);
+      /* shift in converted coordinate */
+      key = (key << 3) | *(d[state] + temp);
 
       state = *(s[state] + temp);
       }
 
-   /* convert 2 part Hilbert key to double and return */
-   return ldexp ((double) key[0], -25)  +  ldexp ((double) key[1], -57);
+   return key;
+   }
+
+
+
+/* Given x,y,z coordinates in [0,1]x[0,1]x[0,1], returns Hilbert key in [0,1] */
+double Zoltan_HSFC_InvHilbert3d (ZZ *zz, double *coord)
+   {
+   /* a single rounding of the integer key, as the sum of its two halves */
+   return ldexp ((double) Zoltan_HSFC_IKey3d (zz, coord), -HSFC_IKEY_BITS_3D);
    }
 
 
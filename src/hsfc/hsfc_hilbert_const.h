@@ -229,6 +229,16 @@ static unsigned const istate3d [] ={ /* 3 dimension to nkey state transitions */
 
 
 
+/* significant bits of the integer Hilbert keys; the double keys are these
+   scaled to [0,1] */
+#define HSFC_IKEY_BITS_1D 53
+#define HSFC_IKEY_BITS_2D 56
+#define HSFC_IKEY_BITS_3D 57
+
+uint64_t Zoltan_HSFC_IKey1d (ZZ*, double *coord);
+uint64_t Zoltan_HSFC_IKey2d (ZZ*, double *coord);
+uint64_t Zoltan_HSFC_IKey3d (ZZ*, double *coord);
+
 double Zoltan_HSFC_InvHilbert1d (ZZ*, double *coord);
 double Zoltan_HSFC_InvHilbert2d (ZZ*, double *coord);
 double Zoltan_HSFC_InvHilbert3d (ZZ*, double *coord);
@@ -58,6 +58,9 @@ extern "C" {
    Guide.  For instructions on its use, please see the Users Guide.   */
 
 
+static int hsfc_point_part(ZZ *, HSFC_Data *, double *);
+static int hsfc_point_ikey_part(ZZ *, HSFC_Data *, double *, int);
+
 /* Point drop for refinement after above partitioning */
 int Zoltan_HSFC_Point_Assign (
    ZZ *zz, 
@@ -65,12 +68,7 @@ int Zoltan_HSFC_Point_Assign (
    int *proc,
    int *part)
    {
-   double     scaled[3];
-   double     pt[3];
-   double     fsfc;
-   Partition *p;
    int        i;
-   int        dim;
    HSFC_Data *d;
    int        err;
    char *yo = "Zoltan_HSFC_Point_Assign";
@@ -81,6 +79,131 @@ int Zoltan_HSFC_Point_Assign (
       ZOLTAN_HSFC_ERROR (ZOLTAN_FATAL,
        "No Decomposition Data available; use KEEP_CUTS parameter.");
 
+   /* Find partition containing point and return its number */
+   i = hsfc_point_part (zz, d, x);
+   if (i < 0)
+      ZOLTAN_HSFC_ERROR (ZOLTAN_FATAL, "programming error, shouldn't happen");
+   if (part != NULL) {
+      if (zz->LB.Remap)
+         *part = zz->LB.Remap[i];
+      else
+         *part = i;
+      }
+   if (proc != NULL) {
+      if (zz->LB.Remap) 
+         *proc = Zoltan_LB_Part_To_Proc(zz, zz->LB.Remap[i], NULL);
+      else
+         *proc = Zoltan_LB_Part_To_Proc(zz, i, NULL);
+      }
+   err = ZOLTAN_OK;
+
+End:
+   ZOLTAN_TRACE_EXIT (zz, yo);
+   return err;
+   }
+
+
+
+/* Point drop for an array of points; coordinates are stored consecutively,
+ * ndimension per point.  Points are independent and are divided among
+ * threads with OpenMP. */
+int Zoltan_HSFC_Point_Assign_Multi (
+   ZZ *zz, 
+   int num_points,
+   double *coords, 
+   int *procs,
+   int *parts)
+   {
+   int        i, k, p;
+   int        nbad = 0;
+   HSFC_Data *d;
+   int        err = ZOLTAN_OK;
+   char *yo = "Zoltan_HSFC_Point_Assign_Multi";
+
+   ZOLTAN_TRACE_ENTER (zz, yo);
+   d = (HSFC_Data *) zz->LB.Data_Structure;
+   if (d == NULL)
+      ZOLTAN_HSFC_ERROR (ZOLTAN_FATAL,
+       "No Decomposition Data available; use KEEP_CUTS parameter.");
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k, p) reduction(+:nbad) schedule(static) \
+        if (num_points > 1024)
+#endif
+   for (i = 0; i < num_points; i++) {
+      k = hsfc_point_part (zz, d, coords + i * d->ndimension);
+      if (k < 0) {
+         nbad++;
+         p = -1;
+         }
+      else
+         p = (zz->LB.Remap ? zz->LB.Remap[k] : k);
+      if (parts != NULL)
+         parts[i] = p;
+      if (procs != NULL)
+         procs[i] = (p < 0 ? -1 : Zoltan_LB_Part_To_Proc (zz, p, NULL));
+      }
+   if (nbad)
+      ZOLTAN_HSFC_ERROR (ZOLTAN_FATAL, "programming error, shouldn't happen");
+
+End:
+   ZOLTAN_TRACE_EXIT (zz, yo);
+   return err;
+   }
+
+
+
+/* Part of a transformed point under HSFC_INTEGER_KEYS: its integer key is
+ * compared with the integer cuts, as the dots were in Zoltan_HSFC, so that
+ * point assign agrees with the partition to the last bit of the key. */
+static int hsfc_point_ikey_part (
+   ZZ *zz,
+   HSFC_Data *d,
+   double *pt,
+   int dim)
+   {
+   double     scaled[3];
+   uint64_t   key;
+   int        i, lo, hi, mid;
+
+   for (i = 0; i < dim; i++)
+      {
+      scaled[i] = (pt[i] - d->bbox_lo[i]) / d->bbox_extent[i];
+      if (scaled[i] < 0.0)   scaled[i] = 0.0;
+      if (scaled[i] > 1.0)   scaled[i] = 1.0;
+      }
+   if      (dim == 1)  key = Zoltan_HSFC_IKey1d (zz, scaled);
+   else if (dim == 2)  key = Zoltan_HSFC_IKey2d (zz, scaled);
+   else                key = Zoltan_HSFC_IKey3d (zz, scaled);
+
+   /* first part whose bound is above key; the last part has no bound */
+   lo = 0;
+   hi = zz->LB.Num_Global_Parts - 1;
+   while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (d->ikey_bound[mid] > key)
+         hi = mid;
+      else
+         lo = mid + 1;
+      }
+   return lo;
+   }
+
+
+
+/* Returns the index of the partition containing point x, or -1 */
+static int hsfc_point_part (
+   ZZ *zz,
+   HSFC_Data *d,
+   double *x)
+   {
+   double     scaled[3];
+   double     pt[3];
+   double     fsfc;
+   Partition *p;
+   int        i;
+   int        dim;
+
    for (i=0; i<d->ndimension; i++){
      pt[i] = x[i];  /* we don't want to change caller's "x" */
    }
@@ -94,6 +217,9 @@ int Zoltan_HSFC_Point_Assign (
      dim = d->ndimension;
    }
 
+   if (d->ikey_bound != NULL)
+      return hsfc_point_ikey_part (zz, d, pt, dim);
+
    /* Calculate scaled coordinates, calculate HSFC coordinate */
    for (i = 0; i < dim; i++)
       {
@@ -103,31 +229,15 @@ int Zoltan_HSFC_Point_Assign (
       }
    fsfc = d->fhsfc (zz, scaled);           /* Note, this is a function call */
 
-   /* Find partition containing point and return its number */
+   /* Find partition containing point */
    p = (Partition *) bsearch (&fsfc, d->final_partition, zz->LB.Num_Global_Parts,
     sizeof (Partition), Zoltan_HSFC_compare);
 
-   if (p == NULL)
-      ZOLTAN_HSFC_ERROR (ZOLTAN_FATAL, "programming error, shouldn't happen");
-   if (part != NULL) {
-      if (zz->LB.Remap)
-         *part = zz->LB.Remap[p->index];
-      else
-         *part = p->index;
-      }
-   if (proc != NULL) {
-      if (zz->LB.Remap) 
-         *proc = Zoltan_LB_Part_To_Proc(zz, zz->LB.Remap[p->index], NULL);
-      else
-         *proc = Zoltan_LB_Part_To_Proc(zz, p->index, NULL);
-      }
-   err = ZOLTAN_OK;
-
-End:
-   ZOLTAN_TRACE_EXIT (zz, yo);
-   return err;
+   return (p == NULL ? -1 : p->index);
    }
 
+
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
@@ -125,6 +125,7 @@ enum Zoltan_Fn_Type {
   ZOLTAN_HIER_NUM_LEVELS_FN_TYPE,
   ZOLTAN_HIER_PART_FN_TYPE,
   ZOLTAN_HIER_METHOD_FN_TYPE,
+  ZOLTAN_HG_CS_PAGE_FN_TYPE,
   ZOLTAN_MAX_FN_TYPES               /*  This entry should always be last. */
 };
 
@@ -1847,6 +1848,54 @@ typedef int ZOLTAN_HG_CS_FORT_FN(
   ZOLTAN_ID_PTR pin_GID,
   int *ierr
 );
+
+/*****************************************************************************/
+/*
+ *  Function to return a page of the pins (non-zeroes) of a hypergraph in
+ *  compressed vertex or compressed hyperedge storage format.  Used in
+ *  place of Get_HG_CS() when defined, so that Zoltan never needs all of
+ *  the application's pins in one buffer.  Get_HG_Size_CS() still supplies
+ *  the total number of lists and the format.  The same pages must be
+ *  returned each time a given first_list is requested.
+ *
+ *  Input:
+ *    data                --  pointer to user defined data structure
+ *    num_gid_entries     --  number of array entries of type ZOLTAN_ID_TYPE
+ *                            in a global ID
+ *    format              --  ZOLTAN_COMPRESSED_VERTEX or ZOLTAN_COMPRESSED_EDGE
+ *    first_list          --  index (0 to num_lists-1) of the first vertex
+ *                            or edge to return in this page
+ *    max_lists           --  room in vtxedge_GID (and max_lists+1 in
+ *                            vtxedge_ptr)
+ *    max_pins            --  room in pin_GID
+ *
+ *  Output:
+ *    num_lists   -- number of consecutive vertices or edges, starting at
+ *                   first_list, returned in this page.  Only whole lists
+ *                   are returned.  If list first_list alone has more than
+ *                   max_pins pins, set num_lists to 0 and vtxedge_ptr[1]
+ *                   to its number of pins; Zoltan will ask again with
+ *                   a larger max_pins.
+ *    vtxedge_GID -- as in ZOLTAN_HG_CS_FN, for the lists in this page
+ *    vtxedge_ptr -- as in ZOLTAN_HG_CS_FN, relative to this page; 
+ *                   vtxedge_ptr[num_lists] is the number of pins returned
+ *    pin_GID     -- as in ZOLTAN_HG_CS_FN, for the lists in this page
+ *    ierr        --  error code
+ */
+
+typedef void ZOLTAN_HG_CS_PAGE_FN(
+  void *data,
+  int num_gid_entries,
+  int format,
+  int first_list,
+  int max_lists,
+  int max_pins,
+  int *num_lists,
+  ZOLTAN_ID_PTR vtxedge_GID,
+  int *vtxedge_ptr,
+  ZOLTAN_ID_PTR pin_GID,
+  int *ierr
+);
 /*****************************************************************************/
 /*
  *  Function to return the number of edges for which the application
@@ -2588,6 +2637,12 @@ extern int Zoltan_Set_HG_CS_Fn(
   void *data_ptr
 );
 
+extern int Zoltan_Set_HG_CS_Page_Fn(
+  struct Zoltan_Struct *zz, 
+  ZOLTAN_HG_CS_PAGE_FN *fn_ptr, 
+  void *data_ptr
+);
+
 extern int Zoltan_Set_HG_Size_Edge_Wts_Fn(
   struct Zoltan_Struct *zz, 
   ZOLTAN_HG_SIZE_EDGE_WTS_FN *fn_ptr, 
@@ -2600,6 +2655,38 @@ extern int Zoltan_Set_HG_Edge_Wts_Fn(
   void *data_ptr
 );
 
+/*
+ *  Function to give Zoltan a hypergraph that the application already holds
+ *  in compressed edge (CSR) form.  Zoltan registers its own Num_Obj, Obj_List,
+ *  HG_Size_CS and HG_CS_Page query functions (and, if edge_wgts is not NULL,
+ *  HG_Size_Edge_Wts and HG_Edge_Wts) that read these arrays in place.
+ *  The arrays belong to the application; Zoltan neither modifies nor frees
+ *  them, and they must stay valid until the last Zoltan call that queries
+ *  the hypergraph has returned.
+ *  Input:
+ *    zz                  --  Pointer to a Zoltan structure.
+ *    num_vtx             --  Number of vertices (objects) on this process.
+ *    vtx_GID             --  Global IDs of those vertices.
+ *    num_edges           --  Number of (partial) hyperedges on this process.
+ *    edge_GID            --  Global IDs of those hyperedges.
+ *    edge_ptr            --  The pins of hyperedge i are pin_GID entries
+ *                            edge_ptr[i] through edge_ptr[i+1]-1.
+ *    pin_GID             --  Global IDs of the pin vertices.
+ *    edge_wgts           --  EDGE_WEIGHT_DIM weights per hyperedge, or NULL.
+ *  Returned value:       --  Error code
+ */
+
+extern int Zoltan_Set_HG_CSR(
+  struct Zoltan_Struct *zz,
+  int num_vtx,
+  ZOLTAN_ID_PTR vtx_GID,
+  int num_edges,
+  ZOLTAN_ID_PTR edge_GID,
+  int *edge_ptr,
+  ZOLTAN_ID_PTR pin_GID,
+  float *edge_wgts
+);
+
 extern int Zoltan_Set_Num_Fixed_Obj_Fn(
   struct Zoltan_Struct *zz, 
   ZOLTAN_NUM_FIXED_OBJ_FN *fn_ptr, 
@@ -3296,6 +3383,148 @@ extern int Zoltan_LB_Box_Assign(
   int *numprocs
 );
 
+/*****************************************************************************/
+/* 
+ * Routine to determine which processors and partitions an array of points
+ * should be assigned to.  Equivalent to calling Zoltan_LB_Point_PP_Assign
+ * for each point, but faster for many points.
+ * Note that this only works of the current partition was produced via a
+ * geometric algorithm - currently RCB, RIB, HSFC.
+ * 
+ * Input:
+ *   zz                   -- pointer to Zoltan structure
+ *   num_points           -- number of points
+ *   coords               -- coordinates of the points, stored consecutively
+ *                           with as many coordinates per point as returned
+ *                           by ZOLTAN_NUM_GEOM_FN
+ *
+ * Output:
+ *   procs                -- procs[i] is the processor that point i should be
+ *                           assigned to; may be NULL
+ *   parts                -- parts[i] is the partition that point i should be
+ *                           assigned to; may be NULL
+ *
+ * Returned value:       --  Error code
+ */
+
+extern int Zoltan_LB_Point_PP_Assign_Multi(
+  struct Zoltan_Struct *zz,
+  int num_points,
+  double *coords,
+  int *procs,
+  int *parts
+);
+
+/*****************************************************************************/
+/* 
+ * Version of Zoltan_LB_Point_PP_Assign_Multi that can be used when the
+ * number of partitions equals the number of processors, as
+ * Zoltan_LB_Point_Assign.
+ */
+
+extern int Zoltan_LB_Point_Assign_Multi(
+  struct Zoltan_Struct *zz,
+  int num_points,
+  double *coords,
+  int *procs
+);
+
+/*****************************************************************************/
+/* 
+ * Routine to determine which partitions and processors each of an array of
+ * bounding boxes intersects.  Equivalent to calling Zoltan_LB_Box_PP_Assign
+ * for each box, but faster for many boxes.
+ * Note that this only works of the current partition was produced via a
+ * geometric algorithm - currently RCB, RIB, HSFC.
+ * 
+ * Input:
+ *   zz                   -- pointer to Zoltan structure
+ *   num_boxes            -- number of boxes
+ *   boxes                -- xmin, ymin, zmin, xmax, ymax, zmax of each box
+ *
+ * Output:
+ *   proc_start           -- array of size num_boxes+1 allocated by the
+ *                           application; the processors that box i
+ *                           intersects are (*procs)[proc_start[i]] to
+ *                           (*procs)[proc_start[i+1]-1].  If NULL, 
+ *                           processors are not computed.
+ *   procs                -- list of processors, allocated by Zoltan;
+ *                           free it with ZOLTAN_FREE.
+ *   part_start           -- as proc_start, for partitions.
+ *   parts                -- list of partitions, allocated by Zoltan;
+ *                           free it with ZOLTAN_FREE.
+ *
+ * Returned value:       --  Error code
+ */
+
+extern int Zoltan_LB_Box_PP_Assign_Multi(
+  struct Zoltan_Struct *zz,
+  int num_boxes,
+  double *boxes,
+  int *proc_start,
+  int **procs,
+  int *part_start,
+  int **parts
+);
+
+/*****************************************************************************/
+/* 
+ * Version of Zoltan_LB_Box_PP_Assign_Multi that can be used when the
+ * number of partitions equals the number of processors, as
+ * Zoltan_LB_Box_Assign.
+ */
+
+extern int Zoltan_LB_Box_Assign_Multi(
+  struct Zoltan_Struct *zz,
+  int num_boxes,
+  double *boxes,
+  int *proc_start,
+  int **procs
+);
+
+/*****************************************************************************/
+/*
+ * Routines to save the current partition of a Zoltan structure -- the
+ * partition-to-processor maps and the data kept by the method for
+ * Zoltan_LB_Point_Assign, Zoltan_LB_Box_Assign and repartitioning --
+ * in a buffer, and to restore it, e.g., after a restart, without
+ * repartitioning.  Each processor saves and restores its own buffer;
+ * no communication is done.  A buffer can be restored only by the same
+ * version of Zoltan on a machine with the same byte order, into a Zoltan
+ * structure with the same LB_METHOD and number of processors.
+ * Supported for all methods with Zoltan_Copy support (RCB, RIB, HSFC,
+ * HYPERGRAPH, HIER, and methods that keep no data).
+ *
+ * Zoltan_LB_Serialize_Size returns the number of bytes needed.
+ *
+ * Input:
+ *   zz                   -- pointer to Zoltan structure
+ *   bufSize              -- size of buf in bytes
+ *   buf                  -- Zoltan_LB_Deserialize:  buffer written by
+ *                           Zoltan_LB_Serialize
+ *
+ * Output:
+ *   buf                  -- Zoltan_LB_Serialize:  the partition
+ *
+ * Returned value:       --  Error code
+ */
+
+extern size_t Zoltan_LB_Serialize_Size(
+  struct Zoltan_Struct const *zz
+);
+
+extern int Zoltan_LB_Serialize(
+  struct Zoltan_Struct const *zz,
+  size_t bufSize,
+  char *buf
+);
+
+extern int Zoltan_LB_Deserialize(
+  struct Zoltan_Struct *zz,
+  size_t bufSize,
+  char *buf
+);
+
 /*
  *  Function to set the desired partition sizes. 
  *
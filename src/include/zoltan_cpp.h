@@ -441,6 +441,12 @@ public:
     return Zoltan_Set_HG_CS_Fn( ZZ_Ptr, fn_ptr, data );
   }
   ///--------------------------
+  int Set_HG_CS_Page_Fn    ( ZOLTAN_HG_CS_PAGE_FN * fn_ptr,
+                               void * data = 0 )
+  {
+    return Zoltan_Set_HG_CS_Page_Fn( ZZ_Ptr, fn_ptr, data );
+  }
+  ///--------------------------
   int Set_HG_Size_Edge_Wts_Fn    ( ZOLTAN_HG_SIZE_EDGE_WTS_FN * fn_ptr,
                                void * data = 0 )
   {
@@ -453,6 +459,15 @@ public:
     return Zoltan_Set_HG_Edge_Wts_Fn( ZZ_Ptr, fn_ptr, data );
   }
   ///--------------------------
+  int Set_HG_CSR ( int num_vtx, ZOLTAN_ID_PTR vtx_GID,
+                   int num_edges, ZOLTAN_ID_PTR edge_GID,
+                   int * edge_ptr, ZOLTAN_ID_PTR pin_GID,
+                   float * edge_wgts = 0 )
+  {
+    return Zoltan_Set_HG_CSR( ZZ_Ptr, num_vtx, vtx_GID, num_edges, edge_GID,
+                              edge_ptr, pin_GID, edge_wgts );
+  }
+  ///--------------------------
   int Set_Hier_Num_Levels_Fn( ZOLTAN_HIER_NUM_LEVELS_FN * fn_ptr,
                                void * data = 0 )
   {
@@ -593,6 +608,42 @@ public:
                                     parts, &numparts );
   }
 
+  int LB_Point_PP_Assign_Multi ( const int &num_points,
+                                 double * const coords,
+                                 int * const procs,
+                                 int * const parts )
+  {
+    return Zoltan_LB_Point_PP_Assign_Multi( ZZ_Ptr, num_points, coords,
+                                            procs, parts );
+  }
+
+  int LB_Box_PP_Assign_Multi ( const int &num_boxes,
+                               double * const boxes,
+                               int * const proc_start,
+                               int *&procs,
+                               int * const part_start,
+                               int *&parts )
+  {
+    return Zoltan_LB_Box_PP_Assign_Multi( ZZ_Ptr, num_boxes, boxes,
+                                          proc_start, &procs,
+                                          part_start, &parts );
+  }
+
+  size_t LB_Serialize_Size()
+  {
+    return Zoltan_LB_Serialize_Size( ZZ_Ptr );
+  }
+
+  int LB_Serialize ( const size_t &bufSize, char * const buf )
+  {
+    return Zoltan_LB_Serialize( ZZ_Ptr, bufSize, buf );
+  }
+
+  int LB_Deserialize ( const size_t &bufSize, char * const buf )
+  {
+    return Zoltan_LB_Deserialize( ZZ_Ptr, bufSize, buf );
+  }
+
   int Invert_Lists             ( const int &num_known,
                                  ZOLTAN_ID_PTR const known_global_ids,
                                  ZOLTAN_ID_PTR const known_local_ids,
@@ -65,6 +65,14 @@ struct Zoltan_DD_Struct;
 
 typedef struct Zoltan_DD_Struct Zoltan_DD_Directory;
 
+struct Zoltan_DD_Find_Struct;
+
+typedef struct Zoltan_DD_Find_Struct Zoltan_DD_Find_Plan;
+
+struct Zoltan_DD_Request_Struct;
+
+typedef struct Zoltan_DD_Request_Struct Zoltan_DD_Request;
+
 
 /***********  Distributed Directory Function Prototypes ************/
 
@@ -72,6 +80,12 @@ int Zoltan_DD_Create(Zoltan_DD_Directory **dd, MPI_Comm comm,
                      int num_gid, int num_lid, int user_length,
                      int table_length, int debug_level);
 
+int Zoltan_DD_Create_From_Ranges(Zoltan_DD_Directory **dd, MPI_Comm comm,
+                                 int num_lid, int user_length,
+                                 ZOLTAN_ID_TYPE first_gid, int count,
+                                 ZOLTAN_ID_PTR lid, char *user,
+                                 int *partition, int debug_level);
+
 int Zoltan_DD_Copy_To(Zoltan_DD_Directory **toptr, Zoltan_DD_Directory *from);
 
 Zoltan_DD_Directory *Zoltan_DD_Copy(Zoltan_DD_Directory *from);
@@ -88,8 +102,30 @@ int Zoltan_DD_Find(Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
 int Zoltan_DD_Remove(Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
                      int count);
 
+int Zoltan_DD_Update_Begin(Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
+                           ZOLTAN_ID_PTR lid, char *user, int *partition,
+                           int count, Zoltan_DD_Request **request);
+
+int Zoltan_DD_Update_End(Zoltan_DD_Request **request);
+
+int Zoltan_DD_Find_Begin(Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
+                         ZOLTAN_ID_PTR lid, char *data, int *partition,
+                         int count, int *owner, Zoltan_DD_Request **request);
+
+int Zoltan_DD_Find_End(Zoltan_DD_Request **request);
+
+int Zoltan_DD_Find_Prepare(Zoltan_DD_Directory *dd, ZOLTAN_ID_PTR gid,
+                           int count, Zoltan_DD_Find_Plan **plan);
+
+int Zoltan_DD_Find_Execute(Zoltan_DD_Find_Plan *plan, ZOLTAN_ID_PTR lid,
+                           char *data, int *partition, int *owner);
+
+void Zoltan_DD_Find_Destroy(Zoltan_DD_Find_Plan **plan);
+
 int Zoltan_DD_Set_Hash_Fn(Zoltan_DD_Directory *dd, ZOLTAN_HASH_FN *hash);
 
+int Zoltan_DD_Set_Cache(Zoltan_DD_Directory *dd, int max_entries);
+
 void Zoltan_DD_Stats(Zoltan_DD_Directory *dd);
 
 int Zoltan_DD_Set_Neighbor_Hash_Fn1(Zoltan_DD_Directory *dd, int size);
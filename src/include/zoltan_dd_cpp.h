@@ -96,6 +96,22 @@ public:
     return rc;
     }
 
+  int Create_From_Ranges(const MPI_Comm &comm, const int &num_lid,
+    const int &user_length_in_chars, const ZOLTAN_ID_TYPE &first_gid,
+    const int &count, ZOLTAN_ID_PTR lid, char *user, int *partition,
+    const int &debug_level)
+    {
+    if (this->DD)
+      {
+      Zoltan_DD_Destroy(&this->DD);
+      this->DD = NULL;
+      }
+
+    return Zoltan_DD_Create_From_Ranges (&this->DD, comm, num_lid,
+                  user_length_in_chars, first_gid, count, lid, user,
+                  partition, debug_level);
+    }
+
   ~Zoltan_DD()
     {
     Zoltan_DD_Destroy (&this->DD) ;
@@ -129,12 +145,59 @@ public:
     {
     return Zoltan_DD_Remove (this->DD, gid, count);
     }
+
+  int Update_Begin (ZOLTAN_ID_PTR gid, ZOLTAN_ID_PTR lid,
+    char *user, int *partition, const int &count, Zoltan_DD_Request **request)
+    {
+    return Zoltan_DD_Update_Begin (this->DD, gid, lid, user, partition, count,
+                                   request);
+    }
+
+  static int Update_End (Zoltan_DD_Request **request)
+    {
+    return Zoltan_DD_Update_End (request);
+    }
+
+  int Find_Begin (ZOLTAN_ID_PTR gid, ZOLTAN_ID_PTR lid, char *data,
+    int *partition, const int &count, int *owner,
+    Zoltan_DD_Request **request) const
+    {
+    return Zoltan_DD_Find_Begin (this->DD, gid, lid, data, partition, count,
+                                 owner, request);
+    }
+
+  static int Find_End (Zoltan_DD_Request **request)
+    {
+    return Zoltan_DD_Find_End (request);
+    }
+
+  int Find_Prepare (ZOLTAN_ID_PTR gid, const int &count,
+                    Zoltan_DD_Find_Plan **plan) const
+    {
+    return Zoltan_DD_Find_Prepare (this->DD, gid, count, plan);
+    }
+
+  static int Find_Execute (Zoltan_DD_Find_Plan *plan, ZOLTAN_ID_PTR lid,
+                           char *data, int *partition, int *owner)
+    {
+    return Zoltan_DD_Find_Execute (plan, lid, data, partition, owner);
+    }
+
+  static void Find_Destroy (Zoltan_DD_Find_Plan **plan)
+    {
+    Zoltan_DD_Find_Destroy (plan);
+    }
   
   int Set_Hash_Fn (unsigned int (*hash) (ZOLTAN_ID_PTR, int, unsigned int))
     {
     return Zoltan_DD_Set_Hash_Fn (this->DD, hash);
     } 
 
+  int Set_Cache (const int &max_entries)
+    {
+    return Zoltan_DD_Set_Cache (this->DD, max_entries);
+    }
+
   void Stats () const
     {
     Zoltan_DD_Stats (this->DD) ;
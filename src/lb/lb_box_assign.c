@@ -53,6 +53,10 @@ extern "C" {
 
 #include "zz_const.h"
 
+static int box_assign_multi(ZZ *, char *, int, double *, int *, int **,
+  int *, int **);
+static int grow_list(int **, int *, int);
+
 /****************************************************************************/
 int Zoltan_LB_Box_Assign (
  ZZ *zz,
@@ -116,6 +120,174 @@ int Zoltan_LB_Box_PP_Assign (
   return zz->LB.Box_Assign(zz, xlo, ylo, zlo, xhi, yhi, zhi, procs, proc_count,
                            parts, part_count);
 }
+/****************************************************************************/
+int Zoltan_LB_Box_Assign_Multi (
+ ZZ *zz,
+ int num_boxes,
+ double *boxes,
+ int *proc_start,
+ int **procs)
+{
+  char *yo = "Zoltan_LB_Box_Assign_Multi";
+
+  if (zz->LB.Box_Assign == NULL) {
+    /* function not supported by current decomposition method */
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                   "Box_Assign not supported by chosen partitioning method.");
+    return ZOLTAN_FATAL;  
+  }
+
+  if (zz->LB.PartDist != NULL) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo,
+      "Non-uniform distribution of partitions over processors is specified; "
+      "use Zoltan_LB_Box_PP_Assign_Multi.");
+    return ZOLTAN_FATAL;
+  }
+
+  /* Parts and procs are the same; compute only the parts. */
+  return box_assign_multi(zz, yo, num_boxes, boxes, NULL, NULL,
+                          proc_start, procs);
+}
+
+/****************************************************************************/
+int Zoltan_LB_Box_PP_Assign_Multi (
+ ZZ *zz,
+ int num_boxes,
+ double *boxes,
+ int *proc_start,
+ int **procs,
+ int *part_start,
+ int **parts)
+{
+  char *yo = "Zoltan_LB_Box_PP_Assign_Multi";
+
+  if (zz->LB.Box_Assign == NULL) {
+    /* function not supported by current decomposition method */
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                   "Box_Assign not supported by chosen partitioning method.");
+    return ZOLTAN_FATAL;  
+  }
+
+  return box_assign_multi(zz, yo, num_boxes, boxes, proc_start, procs,
+                          part_start, parts);
+}
+
+/****************************************************************************/
+static int box_assign_multi (
+ ZZ *zz,
+ char *yo,
+ int num_boxes,
+ double *boxes,        /* xlo, ylo, zlo, xhi, yhi, zhi of each box */
+ int *proc_start,      /* if not NULL, procs of box i are returned in */
+ int **procs,          /* (*procs)[proc_start[i]:proc_start[i+1]-1] */
+ int *part_start,      /* if not NULL, parts of box i are returned in */
+ int **parts)          /* (*parts)[part_start[i]:part_start[i+1]-1] */
+{
+/* Calls LB.Box_Assign for each box, asking only for parts; this avoids the
+ * work proportional to the number of processors that LB.Box_Assign does
+ * for processor lists.  The processors are found from the parts as in
+ * Zoltan_RB_Box_Assign and listed in increasing order. */
+  int *partbuf = NULL;       /* parts of one box */
+  int *lastbox = NULL;       /* lastbox[p] = last box listed on proc p */
+  int maxprocs = 0, maxparts = 0;
+  int nprocs = 0, nparts = 0;
+  int i, j, k, p, q, first_proc, last_proc, tmp, count;
+  double *b;
+  int ierr = ZOLTAN_OK;
+
+  if (procs) *procs = NULL;
+  if (parts) *parts = NULL;
+
+  partbuf = (int *) ZOLTAN_MALLOC((zz->LB.Num_Global_Parts + zz->Num_Proc)
+                                  * sizeof(int));
+  if (partbuf == NULL) {
+    ierr = ZOLTAN_MEMERR;
+    goto End;
+  }
+  lastbox = partbuf + zz->LB.Num_Global_Parts;
+  for (p = 0; p < zz->Num_Proc; p++) lastbox[p] = -1;
+
+  if (proc_start) proc_start[0] = 0;
+  if (part_start) part_start[0] = 0;
+
+  for (i = 0; i < num_boxes; i++) {
+    b = boxes + 6 * i;
+    ierr = zz->LB.Box_Assign(zz, b[0], b[1], b[2], b[3], b[4], b[5],
+                             NULL, &tmp, partbuf, &count);
+    if (ierr != ZOLTAN_OK && ierr != ZOLTAN_WARN) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Error returned from Box_Assign.");
+      goto End;
+    }
+
+    if (part_start) {
+      if (grow_list(parts, &maxparts, nparts + count) != ZOLTAN_OK) {
+        ierr = ZOLTAN_MEMERR;
+        goto End;
+      }
+      for (j = 0; j < count; j++)
+        (*parts)[nparts++] = partbuf[j];
+      part_start[i+1] = nparts;
+    }
+
+    if (proc_start) {
+      for (j = 0; j < count; j++) {
+        first_proc = Zoltan_LB_Part_To_Proc(zz, partbuf[j], NULL);
+        last_proc = first_proc + 1;
+        if (!zz->LB.Single_Proc_Per_Part) {
+          /* Part may be spread across multiple procs. Include them all. */
+          if (partbuf[j] < zz->LB.Num_Global_Parts - 1)
+            last_proc = Zoltan_LB_Part_To_Proc(zz, partbuf[j]+1, NULL);
+          else
+            last_proc = zz->Num_Proc;
+          if (last_proc <= first_proc) last_proc = first_proc + 1;
+        }
+        if (grow_list(procs, &maxprocs, nprocs + last_proc - first_proc)
+            != ZOLTAN_OK) {
+          ierr = ZOLTAN_MEMERR;
+          goto End;
+        }
+        for (p = first_proc; p < last_proc; p++) {
+          if (lastbox[p] == i) continue;
+          lastbox[p] = i;
+          /* insert in increasing order; lists are short */
+          for (k = nprocs++; k > proc_start[i] && (*procs)[k-1] > p; k--)
+            (*procs)[k] = (*procs)[k-1];
+          (*procs)[k] = p;
+        }
+      }
+      proc_start[i+1] = nprocs;
+    }
+  }
+
+End:
+  ZOLTAN_FREE(&partbuf);
+  if (ierr != ZOLTAN_OK && ierr != ZOLTAN_WARN) {
+    if (procs) ZOLTAN_FREE(procs);
+    if (parts) ZOLTAN_FREE(parts);
+    for (q = 0; q <= num_boxes; q++) {
+      if (proc_start) proc_start[q] = 0;
+      if (part_start) part_start[q] = 0;
+    }
+  }
+  return ierr;
+}
+
+/****************************************************************************/
+static int grow_list(int **list, int *max, int need)
+{
+/* Make room for need entries in *list, doubling its size as needed. */
+  int *tmp;
+
+  if (need <= *max) return ZOLTAN_OK;
+  if (need < 2 * (*max)) need = 2 * (*max);
+  if (need < 64) need = 64;
+  tmp = (int *) ZOLTAN_REALLOC(*list, need * sizeof(int));
+  if (tmp == NULL) return ZOLTAN_MEMERR;
+  *list = tmp;
+  *max = need;
+  return ZOLTAN_OK;
+}
+
 
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
@@ -65,6 +65,7 @@ extern "C" {
  */
 
 struct Zoltan_Struct;
+struct Zoltan_Transform_Struct;
 
 typedef int ZOLTAN_LB_FN(struct Zoltan_Struct *, float *, int *, 
                          ZOLTAN_ID_PTR *, ZOLTAN_ID_PTR *, int **, int **,
@@ -75,9 +76,19 @@ typedef void ZOLTAN_LB_FREE_DATA_FN(struct Zoltan_Struct *);
 
 typedef int ZOLTAN_LB_COPY_DATA_FN(struct Zoltan_Struct *to, struct Zoltan_Struct const *from);
 
+typedef size_t ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN(struct Zoltan_Struct const *);
+
+typedef int ZOLTAN_LB_SERIALIZE_DATA_FN(struct Zoltan_Struct const *, char **);
+
+typedef int ZOLTAN_LB_DESERIALIZE_DATA_FN(struct Zoltan_Struct *, char **, 
+                                          size_t *);
+
 typedef int ZOLTAN_LB_POINT_ASSIGN_FN(struct Zoltan_Struct *, double *, int *, 
                                       int *);
 
+typedef int ZOLTAN_LB_POINT_ASSIGN_MULTI_FN(struct Zoltan_Struct *, int,
+                                            double *, int *, int *);
+
 typedef int ZOLTAN_LB_BOX_ASSIGN_FN(struct Zoltan_Struct *, 
                                     double, double, double,
                                     double, double, double,
@@ -208,10 +219,24 @@ struct Zoltan_LB_Struct {
   ZOLTAN_LB_COPY_DATA_FN *Copy_Structure;
                                   /*  Pointer to function that copies the
                                       Data_Structure                         */
+  ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN *Serialize_Structure_Size;
+                                  /*  Pointer to function that returns the
+                                      number of bytes Serialize_Structure
+                                      writes.                                */
+  ZOLTAN_LB_SERIALIZE_DATA_FN *Serialize_Structure;
+                                  /*  Pointer to function that writes the
+                                      Data_Structure to a buffer.            */
+  ZOLTAN_LB_DESERIALIZE_DATA_FN *Deserialize_Structure;
+                                  /*  Pointer to function that rebuilds the
+                                      Data_Structure from a buffer.          */
   ZOLTAN_LB_POINT_ASSIGN_FN *Point_Assign;
                                   /*  Pointer to the function that performs
                                       Point_Assign; this ptr is set based on 
                                       the method used.                       */
+  ZOLTAN_LB_POINT_ASSIGN_MULTI_FN *Point_Assign_Multi;
+                                  /*  Pointer to the function that performs
+                                      Point_Assign for an array of points;
+                                      set with Point_Assign.                 */
   ZOLTAN_LB_BOX_ASSIGN_FN *Box_Assign;
                                   /*  Pointer to the function that performs
                                       Box_Assign; this ptr is set based on 
@@ -299,6 +324,19 @@ extern int Zoltan_LB_Remap(struct Zoltan_Struct *, int *, int, int *, int *,
 
 extern int Zoltan_LB_Copy_Struct(struct Zoltan_Struct *to, 
                                struct Zoltan_Struct const *from);
+extern void Zoltan_Serialize_Bytes(char **, void const *, size_t);
+extern int Zoltan_Deserialize_Bytes(char **, size_t *, void *, size_t);
+extern void Zoltan_Serialize_Int(char **, int const *, int);
+extern int Zoltan_Deserialize_Int(char **, size_t *, int *, int);
+extern void Zoltan_Serialize_Double(char **, double const *, int);
+extern int Zoltan_Deserialize_Double(char **, size_t *, double *, int);
+extern void Zoltan_Serialize_Transform(char **, 
+                                       struct Zoltan_Transform_Struct const *);
+extern int Zoltan_Deserialize_Transform(char **, size_t *,
+                                        struct Zoltan_Transform_Struct *);
+
+/* Bytes written by Zoltan_Serialize_Transform */
+#define ZOLTAN_SERIAL_TRANSFORM_SIZE (21 * sizeof(double) + 7 * sizeof(int))
 extern int Zoltan_LB_Special_Free_Part(struct Zoltan_Struct *,
   ZOLTAN_ID_PTR *, ZOLTAN_ID_PTR *, int **, int **);
 
@@ -337,9 +375,28 @@ extern ZOLTAN_LB_COPY_DATA_FN Zoltan_HSFC_Copy_Structure;
 extern ZOLTAN_LB_COPY_DATA_FN Zoltan_Hier_Copy_Structure;
 extern ZOLTAN_LB_COPY_DATA_FN Zoltan_PHG_Copy_Structure;
 
+/* SERIALIZE DATA_STRUCTURE FUNCTIONS */
+extern ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN Zoltan_RCB_Serialize_Structure_Size;
+extern ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN Zoltan_RIB_Serialize_Structure_Size;
+extern ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN Zoltan_HSFC_Serialize_Structure_Size;
+extern ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN Zoltan_Hier_Serialize_Structure_Size;
+extern ZOLTAN_LB_SERIALIZE_DATA_SIZE_FN Zoltan_PHG_Serialize_Structure_Size;
+extern ZOLTAN_LB_SERIALIZE_DATA_FN Zoltan_RCB_Serialize_Structure;
+extern ZOLTAN_LB_SERIALIZE_DATA_FN Zoltan_RIB_Serialize_Structure;
+extern ZOLTAN_LB_SERIALIZE_DATA_FN Zoltan_HSFC_Serialize_Structure;
+extern ZOLTAN_LB_SERIALIZE_DATA_FN Zoltan_Hier_Serialize_Structure;
+extern ZOLTAN_LB_SERIALIZE_DATA_FN Zoltan_PHG_Serialize_Structure;
+extern ZOLTAN_LB_DESERIALIZE_DATA_FN Zoltan_RCB_Deserialize_Structure;
+extern ZOLTAN_LB_DESERIALIZE_DATA_FN Zoltan_RIB_Deserialize_Structure;
+extern ZOLTAN_LB_DESERIALIZE_DATA_FN Zoltan_HSFC_Deserialize_Structure;
+extern ZOLTAN_LB_DESERIALIZE_DATA_FN Zoltan_Hier_Deserialize_Structure;
+extern ZOLTAN_LB_DESERIALIZE_DATA_FN Zoltan_PHG_Deserialize_Structure;
+
 /* POINT_ASSIGN FUNCTIONS */
 extern ZOLTAN_LB_POINT_ASSIGN_FN Zoltan_RB_Point_Assign;
 extern ZOLTAN_LB_POINT_ASSIGN_FN Zoltan_HSFC_Point_Assign;
+extern ZOLTAN_LB_POINT_ASSIGN_MULTI_FN Zoltan_RB_Point_Assign_Multi;
+extern ZOLTAN_LB_POINT_ASSIGN_MULTI_FN Zoltan_HSFC_Point_Assign_Multi;
 
 /* BOX_ASSIGN FUNCTIONS */
 extern ZOLTAN_LB_BOX_ASSIGN_FN Zoltan_RB_Box_Assign;
@@ -1141,7 +1141,7 @@ int Zoltan_LB_Eval (ZZ *zzin, int print_stats, ZOLTAN_BALANCE_EVAL *obj, ZOLTAN_
     return ierr;
   }
 
-  if (zz->Get_HG_Size_CS && zz->Get_HG_CS){
+  if (zz->Get_HG_Size_CS && (zz->Get_HG_CS || zz->Get_HG_CS_Page)){
     hypergraph_callbacks = 1;
   }
   if ((zz->Get_Num_Edges != NULL || zz->Get_Num_Edges_Multi != NULL) &&
@@ -107,7 +107,11 @@ void Zoltan_LB_Init(struct Zoltan_LB_Struct *lb, int num_proc)
   lb->Data_Structure = NULL;
   lb->Free_Structure = Zoltan_RCB_Free_Structure;
   lb->Copy_Structure = Zoltan_RCB_Copy_Structure;
+  lb->Serialize_Structure_Size = Zoltan_RCB_Serialize_Structure_Size;
+  lb->Serialize_Structure = Zoltan_RCB_Serialize_Structure;
+  lb->Deserialize_Structure = Zoltan_RCB_Deserialize_Structure;
   lb->Point_Assign = Zoltan_RB_Point_Assign;
+  lb->Point_Assign_Multi = Zoltan_RB_Point_Assign_Multi;
   lb->Box_Assign = Zoltan_RB_Box_Assign;
   lb->Imb_Tol_Len = 10;
   lb->Imbalance_Tol = (float *)ZOLTAN_MALLOC((lb->Imb_Tol_Len)*sizeof(float));
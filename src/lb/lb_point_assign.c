@@ -100,6 +100,54 @@ int Zoltan_LB_Point_PP_Assign (
   return zz->LB.Point_Assign(zz, x, proc, part);  /* call appropriate method */
 }
 
+/****************************************************************************/
+int Zoltan_LB_Point_Assign_Multi (
+ ZZ *zz,
+ int num_points,
+ double *coords,
+ int *procs)
+{
+/* Returns processors to which an array of points should be assigned. */
+  char *yo = "Zoltan_LB_Point_Assign_Multi";
+  if (zz->LB.Point_Assign_Multi == NULL) {
+    /* function not supported by current decomposition method */
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                   "Point_Assign not supported by chosen partitioning method.");
+    return ZOLTAN_FATAL;  
+  }
+
+  if (zz->LB.PartDist != NULL) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+      "Non-uniform distribution of partitions over processors is specified; "
+      "use Zoltan_LB_Point_PP_Assign_Multi.");
+    return ZOLTAN_FATAL;
+  }
+
+  /* pass procs in partition argument as in Zoltan_LB_Point_Assign. */
+  return zz->LB.Point_Assign_Multi(zz, num_points, coords, NULL, procs); 
+}
+
+/****************************************************************************/
+int Zoltan_LB_Point_PP_Assign_Multi (
+ ZZ *zz,
+ int num_points,
+ double *coords,
+ int *procs,
+ int *parts)
+{
+/* Returns processors and partitions to which an array of points should be
+ * assigned. */
+  char *yo = "Zoltan_LB_Point_PP_Assign_Multi";
+  if (zz->LB.Point_Assign_Multi == NULL) {
+    /* function not supported by current decomposition method */
+     ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                   "Point_Assign not supported by chosen partitioning method.");
+     return ZOLTAN_FATAL ;   
+  }
+
+  return zz->LB.Point_Assign_Multi(zz, num_points, coords, procs, parts);
+}
+
 
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
@@ -0,0 +1,457 @@
+/* 
+ * @HEADER
+ *
+ * ***********************************************************************
+ *
+ *  Zoltan Toolkit for Load-balancing, Partitioning, Ordering and Coloring
+ *                  Copyright 2012 Sandia Corporation
+ *
+ * Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ * the U.S. Government retains certain rights in this software.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the Corporation nor the names of the
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Questions? Contact Karen Devine	kddevin@sandia.gov
+ *                    Erik Boman	egboman@sandia.gov
+ *
+ * ***********************************************************************
+ *
+ * @HEADER
+ */
+
+#ifdef __cplusplus
+/* if C++, define the rest of this header file as extern C */
+extern "C" {
+#endif
+
+#include "zz_const.h"
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/*
+ *  This file contains routines for saving the result of a partitioning
+ *  (the LB structure and the method's Data_Structure) in a buffer and
+ *  restoring it later, e.g., to restart an application without
+ *  repartitioning.  Each processor saves and restores its own buffer;
+ *  no communication is done.  Structures are written field by field, so
+ *  the buffer holds no padding; it can be restored only by the same
+ *  version of Zoltan on a machine with the same byte order and type
+ *  sizes, with the same LB_METHOD and number of processors.
+ */
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+
+#define ZOLTAN_LB_SERIAL_MAGIC "ZOLTANLB"
+#define ZOLTAN_LB_SERIAL_VERSION 1
+
+/* Flags for the optional parts of the buffer. */
+#define ZOLTAN_LB_SERIAL_REMAP     1
+#define ZOLTAN_LB_SERIAL_OLDREMAP  2
+#define ZOLTAN_LB_SERIAL_PARTDIST  4
+#define ZOLTAN_LB_SERIAL_PROCDIST  8
+#define ZOLTAN_LB_SERIAL_DATA     16
+
+struct Zoltan_LB_Serial_Header {
+  char Magic[8];                  /* ZOLTAN_LB_SERIAL_MAGIC */
+  int Version;                    /* ZOLTAN_LB_SERIAL_VERSION */
+  int Byte_Order;                 /* 1 as stored by the writing machine */
+  int Method;
+  int Num_Proc;
+  int Num_Global_Parts;
+  int Num_Global_Parts_Param;
+  int Num_Local_Parts_Param;
+  int Prev_Global_Parts_Param;
+  int Prev_Local_Parts_Param;
+  int Single_Proc_Per_Part;
+  int Uniform_Parts;
+  int Flags;                      /* ZOLTAN_LB_SERIAL_* flags */
+  size_t Data_Size;               /* bytes of Data_Structure that follow */
+};
+
+/* Bytes written by serialize_header:  Magic, the twelve ints, Data_Size */
+#define ZOLTAN_LB_SERIAL_HEADER_SIZE (8 + 12 * sizeof(int) + sizeof(size_t))
+
+static void serialize_header(char **, struct Zoltan_LB_Serial_Header const *);
+static int deserialize_header(char **, size_t *, 
+                              struct Zoltan_LB_Serial_Header *);
+static int deserialize_int_array(char **, size_t *, int **, int);
+
+/*****************************************************************************/
+
+void Zoltan_Serialize_Bytes(char **buf, void const *src, size_t len)
+{
+/* Append len bytes at src to *buf and advance *buf. */
+  memcpy(*buf, src, len);
+  *buf += len;
+}
+
+int Zoltan_Deserialize_Bytes(char **buf, size_t *avail, void *dst, size_t len)
+{
+/* Read len bytes from *buf into dst; advance *buf and decrease *avail.
+   Returns ZOLTAN_FATAL if fewer than len bytes are available. */
+  if (*avail < len)
+    return ZOLTAN_FATAL;
+  memcpy(dst, *buf, len);
+  *buf += len;
+  *avail -= len;
+  return ZOLTAN_OK;
+}
+
+void Zoltan_Serialize_Int(char **buf, int const *src, int num)
+{
+/* Append num ints at src to *buf and advance *buf. */
+  Zoltan_Serialize_Bytes(buf, src, num * sizeof(int));
+}
+
+int Zoltan_Deserialize_Int(char **buf, size_t *avail, int *dst, int num)
+{
+  return Zoltan_Deserialize_Bytes(buf, avail, dst, num * sizeof(int));
+}
+
+void Zoltan_Serialize_Double(char **buf, double const *src, int num)
+{
+/* Append num doubles at src to *buf and advance *buf. */
+  Zoltan_Serialize_Bytes(buf, src, num * sizeof(double));
+}
+
+int Zoltan_Deserialize_Double(char **buf, size_t *avail, double *dst, int num)
+{
+  return Zoltan_Deserialize_Bytes(buf, avail, dst, num * sizeof(double));
+}
+
+/*****************************************************************************/
+
+void Zoltan_Serialize_Transform(char **buf, ZZ_Transform const *tran)
+{
+/* Write the geometric transformation kept by RCB, RIB and HSFC; 
+   ZOLTAN_SERIAL_TRANSFORM_SIZE bytes. */
+  Zoltan_Serialize_Int(buf, &(tran->Target_Dim), 1);
+  Zoltan_Serialize_Double(buf, &(tran->Transformation[0][0]), 9);
+  Zoltan_Serialize_Int(buf, tran->Permutation, 3);
+  Zoltan_Serialize_Double(buf, tran->CM, 3);
+  Zoltan_Serialize_Double(buf, &(tran->Evecs[0][0]), 9);
+  Zoltan_Serialize_Int(buf, tran->Axis_Order, 3);
+}
+
+int Zoltan_Deserialize_Transform(char **buf, size_t *avail, ZZ_Transform *tran)
+{
+  int ierr;
+
+  ierr = Zoltan_Deserialize_Int(buf, avail, &(tran->Target_Dim), 1);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Double(buf, avail, 
+                                     &(tran->Transformation[0][0]), 9);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, tran->Permutation, 3);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Double(buf, avail, tran->CM, 3);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Double(buf, avail, &(tran->Evecs[0][0]), 9);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, tran->Axis_Order, 3);
+  return ierr;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+
+size_t Zoltan_LB_Serialize_Size(ZZ const *zz)
+{
+struct Zoltan_LB_Struct const *lb = &(zz->LB);
+size_t size = ZOLTAN_LB_SERIAL_HEADER_SIZE;
+
+  if (lb->Remap)
+    size += lb->Num_Global_Parts * sizeof(int);
+  if (lb->OldRemap)
+    size += lb->Num_Global_Parts * sizeof(int);
+  if (lb->PartDist)
+    size += (lb->Num_Global_Parts + 1) * sizeof(int);
+  if (lb->ProcDist)
+    size += (zz->Num_Proc + 1) * sizeof(int);
+  if (lb->Data_Structure && lb->Serialize_Structure_Size)
+    size += lb->Serialize_Structure_Size(zz);
+
+  return size;
+}
+
+/*****************************************************************************/
+
+int Zoltan_LB_Serialize(ZZ const *zz, size_t bufSize, char *buf)
+{
+char *yo = "Zoltan_LB_Serialize";
+struct Zoltan_LB_Struct const *lb = &(zz->LB);
+struct Zoltan_LB_Serial_Header h;
+char *data;
+int ierr;
+
+  if (lb->Method == HIER) {
+    /* HIER keeps no data after partitioning, but its decomposition cannot 
+       be restored without repartitioning; let it report the error. */
+    return lb->Serialize_Structure(zz, &buf);
+  }
+  if (lb->Data_Structure && !lb->Serialize_Structure) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                       "LB_METHOD does not support serialization.");
+    return ZOLTAN_FATAL;
+  }
+  if (bufSize < Zoltan_LB_Serialize_Size(zz)) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                       "Buffer is smaller than Zoltan_LB_Serialize_Size.");
+    return ZOLTAN_FATAL;
+  }
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.Magic, ZOLTAN_LB_SERIAL_MAGIC, sizeof(h.Magic));
+  h.Version = ZOLTAN_LB_SERIAL_VERSION;
+  h.Byte_Order = 1;
+  h.Method = lb->Method;
+  h.Num_Proc = zz->Num_Proc;
+  h.Num_Global_Parts = lb->Num_Global_Parts;
+  h.Num_Global_Parts_Param = lb->Num_Global_Parts_Param;
+  h.Num_Local_Parts_Param = lb->Num_Local_Parts_Param;
+  h.Prev_Global_Parts_Param = lb->Prev_Global_Parts_Param;
+  h.Prev_Local_Parts_Param = lb->Prev_Local_Parts_Param;
+  h.Single_Proc_Per_Part = lb->Single_Proc_Per_Part;
+  h.Uniform_Parts = lb->Uniform_Parts;
+  if (lb->Remap) h.Flags |= ZOLTAN_LB_SERIAL_REMAP;
+  if (lb->OldRemap) h.Flags |= ZOLTAN_LB_SERIAL_OLDREMAP;
+  if (lb->PartDist) h.Flags |= ZOLTAN_LB_SERIAL_PARTDIST;
+  if (lb->ProcDist) h.Flags |= ZOLTAN_LB_SERIAL_PROCDIST;
+  if (lb->Data_Structure) {
+    h.Flags |= ZOLTAN_LB_SERIAL_DATA;
+    h.Data_Size = lb->Serialize_Structure_Size(zz);
+  }
+
+  serialize_header(&buf, &h);
+  if (lb->Remap)
+    Zoltan_Serialize_Bytes(&buf, lb->Remap, 
+                           lb->Num_Global_Parts * sizeof(int));
+  if (lb->OldRemap)
+    Zoltan_Serialize_Bytes(&buf, lb->OldRemap, 
+                           lb->Num_Global_Parts * sizeof(int));
+  if (lb->PartDist)
+    Zoltan_Serialize_Bytes(&buf, lb->PartDist, 
+                           (lb->Num_Global_Parts + 1) * sizeof(int));
+  if (lb->ProcDist)
+    Zoltan_Serialize_Bytes(&buf, lb->ProcDist, 
+                           (zz->Num_Proc + 1) * sizeof(int));
+  if (lb->Data_Structure) {
+    data = buf;
+    ierr = lb->Serialize_Structure(zz, &buf);
+    if (ierr)
+      return ierr;
+    if ((size_t)(buf - data) != h.Data_Size) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Serialize_Structure wrote a "
+                         "different size than Serialize_Structure_Size.");
+      return ZOLTAN_FATAL;
+    }
+  }
+
+  return ZOLTAN_OK;
+}
+
+/*****************************************************************************/
+
+int Zoltan_LB_Deserialize(ZZ *zz, size_t bufSize, char *buf)
+{
+char *yo = "Zoltan_LB_Deserialize";
+struct Zoltan_LB_Struct *lb = &(zz->LB);
+struct Zoltan_LB_Serial_Header h;
+int ierr = ZOLTAN_OK;
+
+  if (lb->Method == HIER)
+    return lb->Deserialize_Structure(zz, &buf, &bufSize);
+
+  if (deserialize_header(&buf, &bufSize, &h) != ZOLTAN_OK ||
+      memcmp(h.Magic, ZOLTAN_LB_SERIAL_MAGIC, sizeof(h.Magic)) != 0) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                       "Buffer was not written by Zoltan_LB_Serialize.");
+    return ZOLTAN_FATAL;
+  }
+  if (h.Version != ZOLTAN_LB_SERIAL_VERSION || h.Byte_Order != 1) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Buffer was written by an "
+                       "incompatible version of Zoltan or machine.");
+    return ZOLTAN_FATAL;
+  }
+  if (h.Method != lb->Method || h.Num_Proc != zz->Num_Proc) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Buffer was written with a different "
+                       "LB_METHOD or number of processors.");
+    return ZOLTAN_FATAL;
+  }
+  if ((h.Flags & ZOLTAN_LB_SERIAL_DATA) && !lb->Deserialize_Structure) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                       "LB_METHOD does not support serialization.");
+    return ZOLTAN_FATAL;
+  }
+
+  /* Replace the current partition. */
+  ZOLTAN_FREE(&(lb->Remap));
+  ZOLTAN_FREE(&(lb->OldRemap));
+  ZOLTAN_FREE(&(lb->PartDist));
+  ZOLTAN_FREE(&(lb->ProcDist));
+  if (lb->Free_Structure)
+    lb->Free_Structure(zz);
+  lb->Data_Structure = NULL;
+
+  lb->Num_Global_Parts = h.Num_Global_Parts;
+  lb->Num_Global_Parts_Param = h.Num_Global_Parts_Param;
+  lb->Num_Local_Parts_Param = h.Num_Local_Parts_Param;
+  lb->Prev_Global_Parts_Param = h.Prev_Global_Parts_Param;
+  lb->Prev_Local_Parts_Param = h.Prev_Local_Parts_Param;
+  lb->Single_Proc_Per_Part = h.Single_Proc_Per_Part;
+  lb->Uniform_Parts = h.Uniform_Parts;
+
+  if (h.Flags & ZOLTAN_LB_SERIAL_REMAP)
+    ierr = deserialize_int_array(&buf, &bufSize, &(lb->Remap), 
+                                 h.Num_Global_Parts);
+  if (!ierr && (h.Flags & ZOLTAN_LB_SERIAL_OLDREMAP))
+    ierr = deserialize_int_array(&buf, &bufSize, &(lb->OldRemap), 
+                                 h.Num_Global_Parts);
+  if (!ierr && (h.Flags & ZOLTAN_LB_SERIAL_PARTDIST))
+    ierr = deserialize_int_array(&buf, &bufSize, &(lb->PartDist), 
+                                 h.Num_Global_Parts + 1);
+  if (!ierr && (h.Flags & ZOLTAN_LB_SERIAL_PROCDIST))
+    ierr = deserialize_int_array(&buf, &bufSize, &(lb->ProcDist), 
+                                 h.Num_Proc + 1);
+  if (ierr) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, (ierr == ZOLTAN_MEMERR 
+                       ? "Insufficient memory." : "Buffer is truncated."));
+    goto End;
+  }
+
+  if (h.Flags & ZOLTAN_LB_SERIAL_DATA) {
+    if (bufSize < h.Data_Size) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Buffer is truncated.");
+      ierr = ZOLTAN_FATAL;
+      goto End;
+    }
+    bufSize = h.Data_Size;
+    ierr = lb->Deserialize_Structure(zz, &buf, &bufSize);
+    if (ierr) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                         "Error returned from Deserialize_Structure.");
+      goto End;
+    }
+    if (bufSize != 0) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Data size in buffer does not match "
+                         "the LB_METHOD's data structure.");
+      ierr = ZOLTAN_FATAL;
+      goto End;
+    }
+  }
+
+End:
+  if (ierr) {
+    /* Leave zz without a partition rather than with part of one. */
+    ZOLTAN_FREE(&(lb->Remap));
+    ZOLTAN_FREE(&(lb->OldRemap));
+    ZOLTAN_FREE(&(lb->PartDist));
+    ZOLTAN_FREE(&(lb->ProcDist));
+    if (lb->Free_Structure)
+      lb->Free_Structure(zz);
+    lb->Data_Structure = NULL;
+  }
+  return ierr;
+}
+
+/*****************************************************************************/
+
+static void serialize_header(
+  char **buf, 
+  struct Zoltan_LB_Serial_Header const *h
+)
+{
+  Zoltan_Serialize_Bytes(buf, h->Magic, sizeof(h->Magic));
+  Zoltan_Serialize_Int(buf, &(h->Version), 1);
+  Zoltan_Serialize_Int(buf, &(h->Byte_Order), 1);
+  Zoltan_Serialize_Int(buf, &(h->Method), 1);
+  Zoltan_Serialize_Int(buf, &(h->Num_Proc), 1);
+  Zoltan_Serialize_Int(buf, &(h->Num_Global_Parts), 1);
+  Zoltan_Serialize_Int(buf, &(h->Num_Global_Parts_Param), 1);
+  Zoltan_Serialize_Int(buf, &(h->Num_Local_Parts_Param), 1);
+  Zoltan_Serialize_Int(buf, &(h->Prev_Global_Parts_Param), 1);
+  Zoltan_Serialize_Int(buf, &(h->Prev_Local_Parts_Param), 1);
+  Zoltan_Serialize_Int(buf, &(h->Single_Proc_Per_Part), 1);
+  Zoltan_Serialize_Int(buf, &(h->Uniform_Parts), 1);
+  Zoltan_Serialize_Int(buf, &(h->Flags), 1);
+  Zoltan_Serialize_Bytes(buf, &(h->Data_Size), sizeof(size_t));
+}
+
+static int deserialize_header(
+  char **buf, 
+  size_t *avail, 
+  struct Zoltan_LB_Serial_Header *h
+)
+{
+  int ierr;
+
+  ierr = Zoltan_Deserialize_Bytes(buf, avail, h->Magic, sizeof(h->Magic));
+  if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Version), 1);
+  if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Byte_Order), 1);
+  if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Method), 1);
+  if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Num_Proc), 1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Num_Global_Parts), 1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Num_Global_Parts_Param), 1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Num_Local_Parts_Param), 1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Prev_Global_Parts_Param),1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Prev_Local_Parts_Param), 1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Single_Proc_Per_Part), 1);
+  if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Uniform_Parts), 1);
+  if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(h->Flags), 1);
+  if (!ierr) 
+    ierr = Zoltan_Deserialize_Bytes(buf, avail, &(h->Data_Size), 
+                                    sizeof(size_t));
+  return ierr;
+}
+
+/*****************************************************************************/
+
+static int deserialize_int_array(
+  char **buf, 
+  size_t *avail, 
+  int **array, 
+  int num
+)
+{
+  *array = (int *) ZOLTAN_MALLOC(num * sizeof(int));
+  if (num > 0 && *array == NULL)
+    return ZOLTAN_MEMERR;
+  return Zoltan_Deserialize_Bytes(buf, avail, *array, num * sizeof(int));
+}
+
+#ifdef __cplusplus
+} /* closing bracket for extern "C" */
+#endif
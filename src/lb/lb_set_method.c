@@ -108,25 +108,38 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_Block;
     zz->LB.Free_Structure = NULL;
     zz->LB.Copy_Structure = NULL;
+    zz->LB.Serialize_Structure_Size = NULL;
+    zz->LB.Serialize_Structure = NULL;
+    zz->LB.Deserialize_Structure = NULL;
   }
   else if (strcmp(method_upper, "CYCLIC") == 0) {
     zz->LB.Method = CYCLIC;
     zz->LB.LB_Fn = Zoltan_Cyclic;
     zz->LB.Free_Structure = NULL;
     zz->LB.Copy_Structure = NULL;
+    zz->LB.Serialize_Structure_Size = NULL;
+    zz->LB.Serialize_Structure = NULL;
+    zz->LB.Deserialize_Structure = NULL;
   }
   else if (strcmp(method_upper, "RANDOM") == 0) {
     zz->LB.Method = RANDOM;
     zz->LB.LB_Fn = Zoltan_Random;
     zz->LB.Free_Structure = NULL;
     zz->LB.Copy_Structure = NULL;
+    zz->LB.Serialize_Structure_Size = NULL;
+    zz->LB.Serialize_Structure = NULL;
+    zz->LB.Deserialize_Structure = NULL;
   }
   else if (strcmp(method_upper, "RCB") == 0) {
     zz->LB.Method = RCB;
     zz->LB.LB_Fn = Zoltan_RCB;
     zz->LB.Free_Structure = Zoltan_RCB_Free_Structure;
     zz->LB.Copy_Structure = Zoltan_RCB_Copy_Structure;
+    zz->LB.Serialize_Structure_Size = Zoltan_RCB_Serialize_Structure_Size;
+    zz->LB.Serialize_Structure = Zoltan_RCB_Serialize_Structure;
+    zz->LB.Deserialize_Structure = Zoltan_RCB_Deserialize_Structure;
     zz->LB.Point_Assign = Zoltan_RB_Point_Assign;
+    zz->LB.Point_Assign_Multi = Zoltan_RB_Point_Assign_Multi;
     zz->LB.Box_Assign = Zoltan_RB_Box_Assign;
   }
   else if (strcmp(method_upper, "OCTPART") == 0) {
@@ -142,7 +155,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     /* Next two are useful only when using PHG */
     zz->LB.Free_Structure = Zoltan_PHG_Free_Structure;
     zz->LB.Copy_Structure = Zoltan_PHG_Copy_Structure;
+    zz->LB.Serialize_Structure_Size = Zoltan_PHG_Serialize_Structure_Size;
+    zz->LB.Serialize_Structure = Zoltan_PHG_Serialize_Structure;
+    zz->LB.Deserialize_Structure = Zoltan_PHG_Deserialize_Structure;
     zz->LB.Point_Assign = NULL;
+    zz->LB.Point_Assign_Multi = NULL;
     zz->LB.Box_Assign = NULL;
   }
   /* PARMETIS is here for backward compatibility.
@@ -155,7 +172,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_ParMetis;
     zz->LB.Free_Structure = NULL;
     zz->LB.Copy_Structure = NULL;
+    zz->LB.Serialize_Structure_Size = NULL;
+    zz->LB.Serialize_Structure = NULL;
+    zz->LB.Deserialize_Structure = NULL;
     zz->LB.Point_Assign = NULL;
+    zz->LB.Point_Assign_Multi = NULL;
     zz->LB.Box_Assign = NULL;
 #else
     ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
@@ -170,7 +191,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_Reftree_Part;
     zz->LB.Free_Structure = Zoltan_Reftree_Free_Structure;
     zz->LB.Copy_Structure = NULL;
+    zz->LB.Serialize_Structure_Size = NULL;
+    zz->LB.Serialize_Structure = NULL;
+    zz->LB.Deserialize_Structure = NULL;
     zz->LB.Point_Assign = NULL;
+    zz->LB.Point_Assign_Multi = NULL;
     zz->LB.Box_Assign = NULL;
   }
   else if (strcmp(method_upper, "RIB") == 0) {
@@ -178,7 +203,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_RIB;
     zz->LB.Free_Structure = Zoltan_RIB_Free_Structure;
     zz->LB.Copy_Structure = Zoltan_RIB_Copy_Structure;
+    zz->LB.Serialize_Structure_Size = Zoltan_RIB_Serialize_Structure_Size;
+    zz->LB.Serialize_Structure = Zoltan_RIB_Serialize_Structure;
+    zz->LB.Deserialize_Structure = Zoltan_RIB_Deserialize_Structure;
     zz->LB.Point_Assign = Zoltan_RB_Point_Assign;
+    zz->LB.Point_Assign_Multi = Zoltan_RB_Point_Assign_Multi;
     zz->LB.Box_Assign = Zoltan_RB_Box_Assign;
   }
   else if (strcmp(method_upper, "HSFC") == 0) {
@@ -186,7 +215,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_HSFC;
     zz->LB.Free_Structure = Zoltan_HSFC_Free_Structure;
     zz->LB.Copy_Structure = Zoltan_HSFC_Copy_Structure;
+    zz->LB.Serialize_Structure_Size = Zoltan_HSFC_Serialize_Structure_Size;
+    zz->LB.Serialize_Structure = Zoltan_HSFC_Serialize_Structure;
+    zz->LB.Deserialize_Structure = Zoltan_HSFC_Deserialize_Structure;
     zz->LB.Point_Assign = Zoltan_HSFC_Point_Assign;
+    zz->LB.Point_Assign_Multi = Zoltan_HSFC_Point_Assign_Multi;
     zz->LB.Box_Assign = Zoltan_HSFC_Box_Assign;
   }
   else if ((strcmp(method_upper, "HYPERGRAPH") == 0) 
@@ -198,7 +231,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_PHG;
     zz->LB.Free_Structure = Zoltan_PHG_Free_Structure;
     zz->LB.Copy_Structure = Zoltan_PHG_Copy_Structure;
+    zz->LB.Serialize_Structure_Size = Zoltan_PHG_Serialize_Structure_Size;
+    zz->LB.Serialize_Structure = Zoltan_PHG_Serialize_Structure;
+    zz->LB.Deserialize_Structure = Zoltan_PHG_Deserialize_Structure;
     zz->LB.Point_Assign = NULL;
+    zz->LB.Point_Assign_Multi = NULL;
     zz->LB.Box_Assign = NULL;
   }
   else if (strcmp(method_upper, "HIER") == 0) {
@@ -207,7 +244,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = Zoltan_Hier;
     zz->LB.Free_Structure = Zoltan_Hier_Free_Structure;
     zz->LB.Copy_Structure = Zoltan_Hier_Copy_Structure;
+    zz->LB.Serialize_Structure_Size = Zoltan_Hier_Serialize_Structure_Size;
+    zz->LB.Serialize_Structure = Zoltan_Hier_Serialize_Structure;
+    zz->LB.Deserialize_Structure = Zoltan_Hier_Deserialize_Structure;
     zz->LB.Point_Assign = NULL;
+    zz->LB.Point_Assign_Multi = NULL;
     zz->LB.Box_Assign = NULL;
 #else
     ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
@@ -222,7 +263,11 @@ int Zoltan_LB_Set_LB_Method(ZZ *zz, char *method_name)
     zz->LB.LB_Fn = NULL;
     zz->LB.Free_Structure = NULL;
     zz->LB.Copy_Structure = NULL;
+    zz->LB.Serialize_Structure_Size = NULL;
+    zz->LB.Serialize_Structure = NULL;
+    zz->LB.Deserialize_Structure = NULL;
     zz->LB.Point_Assign = NULL;
+    zz->LB.Point_Assign_Multi = NULL;
     zz->LB.Box_Assign = NULL;
   }
 
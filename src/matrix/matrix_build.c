@@ -430,7 +430,7 @@ matrix_get_edges(ZZ *zz, Zoltan_matrix *matrix, ZOLTAN_ID_PTR *yGID, ZOLTAN_ID_P
   int *edgeSize = NULL;
 
   ZOLTAN_TRACE_ENTER(zz, yo);
-  if (zz->Get_HG_Size_CS && zz->Get_HG_CS) {
+  if (zz->Get_HG_Size_CS && (zz->Get_HG_CS || zz->Get_HG_CS_Page)) {
     hypergraph_callbacks = 1;
   }
   if ((zz->Get_Num_Edges != NULL || zz->Get_Num_Edges_Multi != NULL) &&
@@ -44,6 +44,7 @@
  * @HEADER
  */
 
+
 #ifdef __cplusplus
 /* if C++, define the rest of this header file as extern C */
 extern "C" {
@@ -51,7 +52,70 @@ extern "C" {
 
 #include "zz_const.h"
 #include "zz_sort.h"
+#include "zz_util_const.h"
 #include "hsfc_hilbert_const.h"
+#include "hsfcOrder.h"
+
+/* Keys of the previous ordering, kept in zz->Order when LOCAL_HSFC_REUSE
+ * is set.  Objects whose global ID and coordinates are unchanged reuse their
+ * key, as long as the new bounding box fits in the one the keys came from. */
+typedef struct {
+  int n;                   /* number of objects ordered                     */
+  int num_gid;             /* zz->Num_GID when the keys were computed       */
+  int ndim;                /* geometric dimension                           */
+  double lo[3];            /* bounding box the keys were computed in        */
+  double width[3];
+  ZOLTAN_ID_PTR gids;      /* global IDs, n*num_gid                         */
+  double *coords;          /* unscaled coordinates, n*ndim                  */
+  uint64_t *keys;          /* integer Hilbert key of each object            */
+  int *order;              /* object indices by decreasing key              */
+} LocalHSFC_Cache;
+
+void Zoltan_LocalHSFC_Free_Cache(void **cache)
+{
+  LocalHSFC_Cache *c = (LocalHSFC_Cache *) *cache;
+
+  if (c == NULL) return;
+  ZOLTAN_FREE(&c->gids);
+  ZOLTAN_FREE(&c->coords);
+  ZOLTAN_FREE(&c->keys);
+  ZOLTAN_FREE(&c->order);
+  ZOLTAN_FREE(cache);
+}
+
+int Zoltan_LocalHSFC_Copy_Cache(void **to, void const *from)
+{
+  LocalHSFC_Cache const *f = (LocalHSFC_Cache const *) from;
+  LocalHSFC_Cache *c;
+  int n, ngid;
+
+  *to = NULL;
+  if (f == NULL) return ZOLTAN_OK;
+
+  n = f->n;
+  ngid = f->num_gid;
+  c = (LocalHSFC_Cache *) ZOLTAN_MALLOC(sizeof(LocalHSFC_Cache));
+  if (c == NULL) return ZOLTAN_MEMERR;
+  *c = *f;
+  c->gids = (ZOLTAN_ID_PTR) ZOLTAN_MALLOC(n * ngid * sizeof(ZOLTAN_ID_TYPE));
+  c->coords = (double *) ZOLTAN_MALLOC(n * f->ndim * sizeof(double));
+  c->keys = (uint64_t *) ZOLTAN_MALLOC(n * sizeof(uint64_t));
+  c->order = (int *) ZOLTAN_MALLOC(n * sizeof(int));
+  if (n && (!c->gids || !c->coords || !c->keys || !c->order))
+  {
+    Zoltan_LocalHSFC_Free_Cache((void **) &c);
+    return ZOLTAN_MEMERR;
+  }
+  if (n)
+  {
+    memcpy(c->gids, f->gids, n * ngid * sizeof(ZOLTAN_ID_TYPE));
+    memcpy(c->coords, f->coords, n * f->ndim * sizeof(double));
+    memcpy(c->keys, f->keys, n * sizeof(uint64_t));
+    memcpy(c->order, f->order, n * sizeof(int));
+  }
+  *to = (void *) c;
+  return ZOLTAN_OK;
+}
 
 
 int Zoltan_LocalHSFC_Order(
@@ -73,7 +137,7 @@ int Zoltan_LocalHSFC_Order(
 
   int n;
 
-  double (*fhsfc)(ZZ*, double*);  /* space filling curve function */
+  uint64_t (*fkey)(ZZ*, double*);  /* space filling curve function */
 
   int wgt_dim=0; 
   float *obj_wgts=0;
@@ -83,23 +147,29 @@ int Zoltan_LocalHSFC_Order(
   double *geomArray=0;
 
   /* Variables for bounding box */
-  double *minValInDim;
-  double *maxValInDim;
-  double *widthDim;
-
-
-  double *hsfcKey=0;
+  double minValInDim[3];
+  double maxValInDim[3];
+  double widthDim[3];
+
+  int num_threads;
+  LocalHSFC_Cache *cache;
+  ZOLTAN_MAP *map = NULL;
+  int *where = NULL;        /* where[c]: object now holding cached object c */
+  int *newObj = NULL;       /* objects whose keys must be computed */
+  uint64_t *newKey = NULL;
+  int numNew = 0;
+
+  uint64_t *hsfcKey=0;
   int *coordIndx=0;
 
   /* Counters */
   int objNum;
   int dimNum;
+  int i, j, k;
+  intptr_t c;
 
   ZOLTAN_ID_TYPE tmp, offset=0;
 
-  int myrank;
-  MPI_Comm_rank(MPI_COMM_WORLD,&myrank);
-
   ZOLTAN_TRACE_ENTER(zz, yo);
 
   /******************************************************************/
@@ -110,12 +180,24 @@ int Zoltan_LocalHSFC_Order(
   {
     order_opt = (ZOOS *) ZOLTAN_MALLOC(sizeof(ZOOS));
     strcpy(order_opt->method,"LOCAL_HSFC");
+    order_opt->num_threads = 1;
+    order_opt->reuse = 0;
   }
   /******************************************************************/
 
   /* local HSFC only computes the rank vector */
   order_opt->return_args = RETURN_RANK; 
 
+  num_threads = order_opt->num_threads;
+  if (num_threads < 1) num_threads = 1;
+#ifndef _OPENMP
+  if (num_threads > 1) {
+    if (zz->Proc == 0)
+      ZOLTAN_PRINT_WARN(zz->Proc, yo,
+        "LOCAL_HSFC_NUM_THREADS ignored; Zoltan was not compiled with OpenMP");
+    num_threads = 1;
+  }
+#endif
 
   /******************************************************************/
   /* Check that num_obj equals the number of objects on this proc. */
@@ -158,22 +240,38 @@ int Zoltan_LocalHSFC_Order(
   }
   /******************************************************************/
 
+  /******************************************************************/   
+  /* Specify which HSFC function to use (based on dim) */
   /******************************************************************/
-  /* Place coords in bounding box                                   */
+  if (numGeomDims==1)
+  {
+    fkey = Zoltan_HSFC_IKey1d;
+  }
+  else if (numGeomDims==2)
+  {
+    fkey = Zoltan_HSFC_IKey2d;
+  }
+  else if (numGeomDims==3)
+  {
+    fkey = Zoltan_HSFC_IKey3d;
+  }
+  else /* this error should have been previously caught */
+  {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Geometry should be of dimension 1, 2, or 3.");
+      ZOLTAN_FREE(&geomArray);
+      return(ZOLTAN_FATAL);
+  }
   /******************************************************************/
-  minValInDim =  (double *) malloc(numGeomDims * sizeof (double));
-  maxValInDim =  (double *) malloc(numGeomDims * sizeof (double));
-  widthDim =  (double *) malloc(numGeomDims * sizeof (double));
 
+  /*************************************************************/
+  /* Determine min, max, and width for each dimension          */
+  /*************************************************************/
   for(dimNum=0; dimNum<numGeomDims; dimNum++)
   {
     minValInDim[dimNum] = HUGE_VAL;
     maxValInDim[dimNum] = -HUGE_VAL;
   }
 
-  /*************************************************************/
-  /* Determine min, max, and width for each dimension          */
-  /*************************************************************/
   for (objNum=0; objNum<n; objNum++)
   {
     for(dimNum=0; dimNum<numGeomDims; dimNum++)
@@ -192,65 +290,170 @@ int Zoltan_LocalHSFC_Order(
   for(dimNum=0; dimNum<numGeomDims; dimNum++)
   {
     widthDim[dimNum] = maxValInDim[dimNum] - minValInDim[dimNum]; 
+    if (!(widthDim[dimNum] > 0.0))  /* flat dimension (or no objects) */
+    {
+      widthDim[dimNum] = 1.0;
+      if (n == 0) minValInDim[dimNum] = 0.0;
+    }
   }
   /*************************************************************/
 
-  /*************************************************************/
-  /* Rescale values to fit in bounding box                     */
-  /*************************************************************/
-  for (objNum=0; objNum<n; objNum++)
+  /******************************************************************/
+  /* Keys of the previous call can be reused if they were computed  */
+  /* in a box that still contains every object.                     */
+  /******************************************************************/
+  cache = (LocalHSFC_Cache *) zz->Order.local_hsfc;
+  if (cache && order_opt->reuse &&
+      cache->ndim == numGeomDims && cache->num_gid == zz->Num_GID)
   {
     for(dimNum=0; dimNum<numGeomDims; dimNum++)
     {
-      geomArray[objNum * numGeomDims + dimNum] -= minValInDim[dimNum];
-      geomArray[objNum * numGeomDims + dimNum] /= widthDim[dimNum];
+      if (n > 0 &&
+          (minValInDim[dimNum] < cache->lo[dimNum] ||
+           maxValInDim[dimNum] > cache->lo[dimNum] + cache->width[dimNum]))
+        break;
+    }
+    if (dimNum < numGeomDims)
+    {
+      Zoltan_LocalHSFC_Free_Cache(&zz->Order.local_hsfc);
+      cache = NULL;
+    }
+    else
+    {
+      for(dimNum=0; dimNum<numGeomDims; dimNum++)
+      {
+        minValInDim[dimNum] = cache->lo[dimNum];
+        widthDim[dimNum] = cache->width[dimNum];
+      }
     }
   }
-  /*************************************************************/
-
-  free(minValInDim); minValInDim=0;
-  free(maxValInDim); maxValInDim=0;
-  free(widthDim); widthDim=0;
+  else if (cache)
+  {
+    Zoltan_LocalHSFC_Free_Cache(&zz->Order.local_hsfc);
+    cache = NULL;
+  }
   /******************************************************************/
 
-  /******************************************************************/   
-  /* Specify which HSFC function to use (based on dim) */
-  /******************************************************************/
-  if (numGeomDims==1)
+  hsfcKey = (uint64_t *) ZOLTAN_MALLOC(n * sizeof (uint64_t));
+  coordIndx = (int *) ZOLTAN_MALLOC(n * sizeof(int));
+  newObj = (int *) ZOLTAN_MALLOC(n * sizeof(int));
+  newKey = (uint64_t *) ZOLTAN_MALLOC(n * sizeof (uint64_t));
+  if (n && (!hsfcKey || !coordIndx || !newObj || !newKey))
   {
-    fhsfc = Zoltan_HSFC_InvHilbert1d;
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Memory error.");
+    ierr = ZOLTAN_MEMERR;
+    goto End;
   }
-  else if (numGeomDims==2)
+
+  /******************************************************************/
+  /* Pick up the keys of unchanged objects.  Objects usually keep   */
+  /* their position in the object list; the map is built only if    */
+  /* one of them did not.                                           */
+  /******************************************************************/
+  if (cache && cache->n > 0)
   {
-    fhsfc = Zoltan_HSFC_InvHilbert2d;
+    where = (int *) ZOLTAN_MALLOC(cache->n * sizeof(int));
+    if (!where)
+    {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Memory error.");
+      ierr = ZOLTAN_MEMERR;
+      goto End;
+    }
+    for (i=0; i<cache->n; i++) where[i] = -1;
   }
-  else if (numGeomDims==3)
+
+  for (objNum=0; objNum<n; objNum++)
   {
-    fhsfc = Zoltan_HSFC_InvHilbert3d;
+    c = ZOLTAN_NOT_FOUND;
+    if (where)
+    {
+      if (objNum < cache->n &&
+          ZOLTAN_EQ_GID(zz, gids + objNum * zz->Num_GID,
+                            cache->gids + objNum * zz->Num_GID))
+      {
+        c = objNum;
+      }
+      else
+      {
+        if (!map)
+        {
+          map = Zoltan_Map_Create(zz, 0, zz->Num_GID * sizeof(ZOLTAN_ID_TYPE),
+                                  0, cache->n);
+          if (!map)
+          {
+            ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Memory error.");
+            ierr = ZOLTAN_MEMERR;
+            goto End;
+          }
+          for (i=0; i<cache->n; i++)
+            Zoltan_Map_Add(zz, map, (char *) (cache->gids + i * zz->Num_GID), i);
+        }
+        Zoltan_Map_Find(zz, map, (char *) (gids + objNum * zz->Num_GID), &c);
+      }
+    }
+
+    if (c != ZOLTAN_NOT_FOUND && where[c] < 0 &&
+        !memcmp(cache->coords + c * numGeomDims,
+                geomArray + objNum * numGeomDims,
+                numGeomDims * sizeof(double)))
+    {
+      where[c] = objNum;
+      hsfcKey[objNum] = cache->keys[c];
+    }
+    else
+    {
+      newObj[numNew++] = objNum;
+    }
   }
-  else /* this error should have been previously caught */
+
+  /******************************************************************/
+  /* Generate hsfc keys of the remaining objects                    */
+  /******************************************************************/
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(num_threads) private(dimNum,objNum) schedule(static)
+#endif
+  for (j=0; j<numNew; j++)
   {
-      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Geometry should be of dimension 1, 2, or 3.");
-      return(ZOLTAN_FATAL);
+    double x[3];
+    objNum = newObj[j];
+    for(dimNum=0; dimNum<numGeomDims; dimNum++)
+    {
+      x[dimNum] = (geomArray[objNum * numGeomDims + dimNum]
+                   - minValInDim[dimNum]) / widthDim[dimNum];
+      if (x[dimNum] > 1.0) x[dimNum] = 1.0;  /* roundoff in a reused box */
+      if (x[dimNum] < 0.0) x[dimNum] = 0.0;
+    }
+    newKey[j] = fkey(zz, x);
+    hsfcKey[objNum] = newKey[j];
   }
   /******************************************************************/
 
   /******************************************************************/
-  /* Generate hsfc keys and indices to be sorted                    */
+  /* Sort new objects based on keys                                 */
   /******************************************************************/
-  hsfcKey = (double *) malloc(n * sizeof (double));
-  coordIndx = (int *) malloc(n *sizeof(int));
-  for (objNum=0; objNum<n; objNum++)
+  ierr = Zoltan_radixsort_list_inc_uint64(newKey, newObj, numNew, num_threads);
+  if (ierr != ZOLTAN_OK)
   {
-    hsfcKey[objNum] = fhsfc(zz, &(geomArray[objNum * numGeomDims]) );
-    coordIndx[objNum] = objNum;
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Memory error.");
+    goto End;
   }
   /******************************************************************/
 
   /******************************************************************/
-  /* Sort indices based on keys                                     */
+  /* Merge with the reused objects, which are already ordered;      */
+  /* coordIndx lists objects by decreasing key.                     */
   /******************************************************************/
-  Zoltan_quicksort_pointer_dec_double (coordIndx, hsfcKey, 0, n-1);
+  i = 0;            /* next position in cache->order */
+  j = numNew - 1;   /* next (largest remaining) new object */
+  for (k=0; k<n; k++)
+  {
+    while (where && i < cache->n && where[cache->order[i]] < 0) i++;
+    if (where && i < cache->n &&
+        (j < 0 || cache->keys[cache->order[i]] >= newKey[j]))
+      coordIndx[k] = where[cache->order[i++]];
+    else
+      coordIndx[k] = newObj[j--];
+  }
   /******************************************************************/
 
 
@@ -277,12 +480,52 @@ int Zoltan_LocalHSFC_Order(
 
   /* iperm is to be deprecated so not calculated*/
 
-  free(hsfcKey);
-  free(coordIndx);
+  /******************************************************************/
+  /* Keep keys for the next call                                    */
+  /******************************************************************/
+  Zoltan_LocalHSFC_Free_Cache(&zz->Order.local_hsfc);
+  if (order_opt->reuse)
+  {
+    cache = (LocalHSFC_Cache *) ZOLTAN_CALLOC(1, sizeof(LocalHSFC_Cache));
+    if (cache)
+    {
+      cache->n = n;
+      cache->num_gid = zz->Num_GID;
+      cache->ndim = numGeomDims;
+      for(dimNum=0; dimNum<numGeomDims; dimNum++)
+      {
+        cache->lo[dimNum] = minValInDim[dimNum];
+        cache->width[dimNum] = widthDim[dimNum];
+      }
+      cache->gids = ZOLTAN_MALLOC_GID_ARRAY(zz, n);
+      cache->coords = geomArray;
+      cache->keys = hsfcKey;
+      cache->order = coordIndx;
+      geomArray = NULL;
+      hsfcKey = NULL;
+      coordIndx = NULL;
+      if (n && !cache->gids)
+        Zoltan_LocalHSFC_Free_Cache((void **) &cache);
+      else
+        ZOLTAN_COPY_GID_ARRAY(cache->gids, gids, zz, n);
+      zz->Order.local_hsfc = (void *) cache;
+    }
+  }
+  /******************************************************************/
+
+End:
+  Zoltan_Map_Destroy(zz, &map);
+  ZOLTAN_FREE(&where);
+  ZOLTAN_FREE(&newObj);
+  ZOLTAN_FREE(&newKey);
+  ZOLTAN_FREE(&hsfcKey);
+  ZOLTAN_FREE(&coordIndx);
+  ZOLTAN_FREE(&geomArray);
+  ZOLTAN_FREE(&parts);
 
   ZOLTAN_TRACE_EXIT(zz, yo);
 
-  return (ZOLTAN_OK);
+  return (ierr);
 
 }
 
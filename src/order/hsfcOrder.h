@@ -56,3 +56,9 @@ int Zoltan_LocalHSFC_Order(
 	ZOOS *order_opt       /* Ordering options, parsed by Zoltan_Order */
 			   );
 
+/* Frees the keys kept in zz->Order by LOCAL_HSFC_REUSE */
+void Zoltan_LocalHSFC_Free_Cache(void **cache);
+
+/* Copies those keys for Zoltan_Copy_To */
+int Zoltan_LocalHSFC_Copy_Cache(void **to, void const *from);
+
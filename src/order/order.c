@@ -162,9 +162,13 @@ int Zoltan_Order (
 
   opt.use_order_info = 0;
   opt.start_index = 0;
+  opt.num_threads = 1;
+  opt.reuse = 0;
 
   Zoltan_Bind_Param(Order_params, "ORDER_METHOD", (void *) opt.method);
   Zoltan_Bind_Param(Order_params, "USE_ORDER_INFO", (void *) &opt.use_order_info);
+  Zoltan_Bind_Param(Order_params, "LOCAL_HSFC_NUM_THREADS", (void *) &opt.num_threads);
+  Zoltan_Bind_Param(Order_params, "LOCAL_HSFC_REUSE", (void *) &opt.reuse);
 
   Zoltan_Assign_Param_Vals(zz->Params, Order_params, zz->Debug_Level,
                            zz->Proc, zz->Debug_Proc);
@@ -90,6 +90,8 @@ struct Zoltan_Order_Struct {
   /* Deprecated */
   int  num_separators;          /* Optional: # of separators. */
   int *sep_sizes;               /* Optional: Separator sizes. */
+
+  void *local_hsfc;             /* LOCAL_HSFC keys kept for reuse */
 };
 
 typedef struct Zoltan_Order_Struct ZOS;
@@ -104,6 +106,8 @@ struct Zoltan_Order_Options {
   int start_index;		/* In: Permutations start at 0 or 1? */
   int use_order_info;		/* In: Put order info into ZOS? */
   int return_args;		/* Out: What return arguments were computed? */
+  int num_threads;		/* In: Threads per process (LOCAL_HSFC) */
+  int reuse;			/* In: Reuse keys of the previous ordering? */
 };
 
 typedef struct Zoltan_Order_Options ZOOS;
@@ -151,6 +155,8 @@ extern int Zoltan_Get_Processor_Graph(int *vtxdist, int Num_Proc, int i);
 /* Utility routines for memory management */
 extern int  Zoltan_Order_Init_Tree (struct Zoltan_Order_Struct *order, int blocknbr, int leavesnbr);
 extern void Zoltan_Order_Free_Struct(struct Zoltan_Order_Struct *order);
+extern int  Zoltan_Order_Copy_Struct(struct Zoltan_Order_Struct *to,
+                                     struct Zoltan_Order_Struct const *from);
 
 
 
@@ -59,6 +59,8 @@ extern "C" {
 static PARAM_VARS Order_params[] = {
         { "ORDER_METHOD", NULL, "STRING", 0 },
         { "USE_ORDER_INFO", NULL, "INT", 0 },
+        { "LOCAL_HSFC_NUM_THREADS", NULL, "INT", 0 },
+        { "LOCAL_HSFC_REUSE", NULL, "INT", 0 },
         { NULL, NULL, NULL, 0 } };
 
 
@@ -53,6 +53,7 @@ extern "C" {
 
 #include "zz_const.h"
 #include "order_const.h"
+#include "hsfcOrder.h"
 
 
 /****************************************************************************
@@ -81,6 +82,8 @@ int  Zoltan_Order_Init_Tree (struct Zoltan_Order_Struct *order, int blocknbr, in
  ****************************************************************************/
 void Zoltan_Order_Free_Struct(struct Zoltan_Order_Struct *order)
 {
+  Zoltan_LocalHSFC_Free_Cache(&order->local_hsfc);
+
   if (order->needfree == 0)
     return;
 
@@ -91,6 +94,16 @@ void Zoltan_Order_Free_Struct(struct Zoltan_Order_Struct *order)
   order->needfree = 0;
 }
 
+/****************************************************************************
+ *  Function which gives a copied ordering structure its own LOCAL_HSFC keys
+ ****************************************************************************/
+int Zoltan_Order_Copy_Struct(struct Zoltan_Order_Struct *to,
+                             struct Zoltan_Order_Struct const *from)
+{
+  to->local_hsfc = NULL;
+  return Zoltan_LocalHSFC_Copy_Cache(&to->local_hsfc, from->local_hsfc);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -149,7 +149,9 @@ int Zoltan_RB_find_bisector(
   double *quality,      /* quality of the cut (output) */
   int    *dotlist,      /* list of active dots. */
   int rectilinear,      /* if 1, all dots with same value on same side of cut*/
-  int average_cuts      /* force cut to be halfway between two closest dots. */
+  int average_cuts,     /* force cut to be halfway between two closest dots. */
+  int histogram_bins    /* if > 1, narrow the interval with histograms of
+                           this many bins before the bisection loop. */
 )
 {
 /* Local declarations. */
@@ -190,6 +192,9 @@ int Zoltan_RB_find_bisector(
   int     markactive;                /* which side of cut is active = 0/1 */
   int     iteration;                 /* bisection iteration no. */
   int     i, j, k, numlist;
+  int     round;                     /* histogram round */
+  int    *binidx = NULL;             /* histogram bin of each active dot */
+  double *hist = NULL;               /* global histogram; weights and count */
   int     tfs_early_exit = 0;        /* Flag used only with Tflops_Special,
                                         indicating early exit when all weight
                                         is to be put in one partition. */
@@ -498,6 +503,50 @@ int Zoltan_RB_find_bisector(
     eps = (temp-1.) / (log(num_parts)/log(2.0))
           * 0.5*Zoltan_norm(mcnorm, nwgts, wtsum, scale);
 
+    /* Narrow [valuemin, valuemax] to the histogram bin where the norms of
+       the lower and upper weights cross; one reduction per round. */
+    if (histogram_bins > 1 && !Tflops_Special && wgts) {
+      binidx = (int *) ZOLTAN_MALLOC(dotnum * sizeof(int));
+      hist = (double *) ZOLTAN_MALLOC(2 * histogram_bins * (nwgts+1)
+                                      * sizeof(double));
+      if ((dotnum && !binidx) || !hist) {
+        /* Not fatal; skip the histogram rounds. */
+        ZOLTAN_FREE(&binidx);
+        ZOLTAN_FREE(&hist);
+      }
+      for (round = 0; hist && round < HISTOGRAM_MAX_ROUNDS; round++) {
+        if (Zoltan_RB_histogram_reduce(dots, wgts, uniformWeight, nwgts, nwgts,
+                                       dotlist, numlist, valuemin, valuemax,
+                                       histogram_bins, binidx, hist,
+                                       local_comm) != ZOLTAN_OK)
+          break;
+        loopCount++;
+
+        /* tmplo = weight in and below bin k; tmphi = weight above bin k */
+        for (j=0; j<nwgts; j++){
+          tmplo[j] = weightlo[j];
+          tmphi[j] = weighthi[j];
+          for (k=0; k<histogram_bins; k++)
+            tmphi[j] += hist[k*(nwgts+1)+j];
+        }
+        for (k=0; k<histogram_bins-1; k++){
+          Zoltan_daxpy(nwgts, 1., &hist[k*(nwgts+1)], tmplo, tmplo);
+          Zoltan_daxpy(nwgts, -1., &hist[k*(nwgts+1)], tmphi, tmphi);
+          if (Zoltan_norm(mcnorm, nwgts, tmplo, scalelo) >=
+              Zoltan_norm(mcnorm, nwgts, tmphi, scalehi))
+            break;
+        }
+        if (hist[k*(nwgts+1)+nwgts] == 0.) break;
+
+        Zoltan_RB_histogram_apply(k, histogram_bins, nwgts, hist, binidx,
+                                  dotmark, dotlist, &numlist,
+                                  &valuemin, &valuemax, weightlo, weighthi);
+        if (hist[k*(nwgts+1)+nwgts] <= 1.) break;
+      }
+      ZOLTAN_FREE(&binidx);
+      ZOLTAN_FREE(&hist);
+    }
+
     /* bisector iteration */
     iteration = 0;
     while (iteration++ < MAX_BISECT_ITER){
@@ -53,6 +53,7 @@ extern "C" {
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <float.h>
 #include "zoltan_mem.h"
 #include "par_median_const.h"
@@ -60,9 +61,17 @@ extern "C" {
 #include "par_average_const.h"
 #include "zoltan_timer.h"
 #include "zz_const.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define TINY   1.0e-6
 
+/* Minimum number of active dots per thread before the local scan of
+ * Zoltan_RB_find_median is split among threads; below this, the
+ * fork/join cost outweighs the scan. */
+#define MEDIAN_MIN_DOTS_PER_THREAD 4096
+
 /*#define WATCH_MEDIAN_FIND*/
 
 /* Data structure for parallel find median routine */
@@ -82,9 +91,29 @@ struct median {          /* median cut info */
 ----------------------------------------------------------------------
 	Zoltan_RB_find_median			void
 	Zoltan_RB_median_merge			void
+	median_scan				static void
+	median_scan_compact			static void
+	median_scan_threaded			static void
+	median_gather				static int
+	median_compact				static int
+	Zoltan_RB_histogram_reduce		int
+	Zoltan_RB_histogram_apply		void
 
 ******************************************************************************/
 
+static void median_scan(double *, double *, double, int, int *, int *,
+  int, int, double, struct median *, int *, int *);
+static void median_scan_compact(double *, double *, double, int *, int, int,
+  double, struct median *, int *, int *);
+static int median_gather(double *, double *, int, int *, int *, int, int, int,
+  double **, double **, int **);
+static int median_compact(int, int, double *, double *, int *, int *, int *);
+#ifdef _OPENMP
+static void median_scan_threaded(int, double *, double *, double, int, int *,
+  int *, int, int, double, struct median *, int *, int *, struct median *,
+  int *);
+#endif
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
@@ -120,11 +149,26 @@ int Zoltan_RB_find_median(
   double *wgthi,        /* weight of upper partition (output) */
   int    *dotlist,      /* list of active dots */
   int rectilinear_blocks,/*if set all dots with same value on same side of cut*/
-  int average_cuts      /* force cut to be halfway between two closest dots. */
+  int average_cuts,     /* force cut to be halfway between two closest dots. */
+  int num_threads,      /* number of threads for the local scan of dots;
+                           ignored unless compiled with OpenMP */
+  int histogram_bins,   /* if > 1, narrow the search interval with up to
+                           HISTOGRAM_MAX_ROUNDS histograms of this many bins
+                           before iterating on single cuts */
+  int compact,          /* if set, copy coordinates and weights of active
+                           dots into contiguous arrays that are partitioned
+                           in place as the active set shrinks, rather than
+                           reading them through dotlist */
+  double reuse_tol      /* if > 0 and first_guess is set, accept the first
+                           guess without further iterations when the weight
+                           below it is within reuse_tol*weight of its
+                           target (incremental repartitioning) */
 )
 {
 /* Local declarations. */
   struct median med, medme;          /* median data */
+  struct median *thrmed = NULL;      /* per-thread median data */
+  int    *thrindex = NULL;           /* per-thread indexlo, indexhi */
 
 
   double  wtmax, wtsum, wtok, wtupto;/* temporary wts */
@@ -137,11 +181,34 @@ int Zoltan_RB_find_median(
 
   int     i, j, k, numlist;
   int     first_iteration;
+  int     incremental;               /* try first guess against reuse_tol */
   int     indexlo=0, indexhi=0;      /* indices of dot closest to median */
   int     breakflag;                 /* for breaking out of median iteration */
   int     markactive;                /* which side of cut is active = 0/1 */
   int     rank=0;                    /* rank in partition (Tflops_Special) */
   int     loopCount=0;
+  int     round;                     /* histogram round */
+  int    *binidx = NULL;             /* histogram bin of each active dot */
+  double *hist = NULL;               /* global histogram; weight and count */
+  double  cum;                       /* cumulative weight in histogram */
+
+  /* Active dots as seen by the median iteration.  Either the input arrays
+   * indexed through list = dotlist, or (compact) arrays indexed directly
+   * (list == NULL): the input arrays themselves until the first cut, then
+   * contiguous copies with aidx mapping back to the input dots. */
+  double *xs = dots;                 /* coordinates */
+  double *ws = wgts;                 /* first weight, stride wstride */
+  int     wstride = wgtflag;
+  int    *mark = dotmark;            /* side of cut */
+  int    *list = dotlist;            /* active list, or NULL if compact */
+  double *acoord = NULL;             /* compact coordinates */
+  double *awgt = NULL;               /* compact weights */
+  int    *aidx = NULL;               /* index in dots of compact dot; this
+                                        is dotlist, which is otherwise
+                                        unused once the dots are copied */
+  int    *amark = NULL;              /* compact side of cut */
+  int     keep = 0;                  /* compact dots with mark == keep are
+                                        active; see median_scan_compact */
 
   /* MPI data types and user functions */
 
@@ -162,6 +229,18 @@ int Zoltan_RB_find_median(
 
   rank = proc - proclower;
 
+#ifdef _OPENMP
+  if (num_threads > 1 && dotnum >= num_threads * MEDIAN_MIN_DOTS_PER_THREAD) {
+    thrmed = (struct median *) ZOLTAN_MALLOC(num_threads*sizeof(struct median));
+    thrindex = (int *) ZOLTAN_MALLOC(2*num_threads*sizeof(int));
+    if (!thrmed || !thrindex) {
+      /* Not fatal; fall back to the serial scan. */
+      ZOLTAN_FREE(&thrmed);
+      ZOLTAN_FREE(&thrindex);
+    }
+  }
+#endif
+
 /***************************** BEGIN EXECUTION ******************************/
 
   /* create MPI data and function types for box and median */
@@ -187,6 +266,7 @@ int Zoltan_RB_find_median(
   w = wgts;                     /* we use 1st weight only */
   for (i = 0; i < dotnum;i++) {
     dotlist[i] = i;
+    if (compact) dotmark[i] = 0;   /* active, for median_scan_compact */
     if (wgtflag){
       if (*w > wtmax) wtmax = *w;
       w += wgtflag;
@@ -226,6 +306,62 @@ int Zoltan_RB_find_median(
   weighthi = weightlo = 0.0;
 
   first_iteration = 1;
+  incremental = (first_guess && reuse_tol > 0. && weight > 0.);
+
+  /* Narrow [valuemin, valuemax] to the histogram bin holding the target
+   * weight; each round costs one reduction of 2*histogram_bins doubles.
+   * Dots in lower (upper) bins become non-active and are marked 0 (1), so
+   * the median iteration below starts with its invariants satisfied. */
+  if (histogram_bins > 1 && !Tflops_Special && weight > 0. && !incremental) {
+    binidx = (int *) ZOLTAN_MALLOC(dotnum * sizeof(int));
+    hist = (double *) ZOLTAN_MALLOC(4 * histogram_bins * sizeof(double));
+    if ((dotnum && !binidx) || !hist) {
+      /* Not fatal; skip the histogram rounds. */
+      ZOLTAN_FREE(&binidx);
+      ZOLTAN_FREE(&hist);
+    }
+    for (round = 0; hist && round < HISTOGRAM_MAX_ROUNDS; round++) {
+      if (Zoltan_RB_histogram_reduce(dots, wgts, uniformWeight, 1, wgtflag,
+                                     dotlist, numlist, valuemin, valuemax,
+                                     histogram_bins, binidx, hist,
+                                     local_comm) != ZOLTAN_OK)
+        break;
+      loopCount++;
+
+      /* First bin at which the cumulative weight reaches the target. */
+      for (cum = weightlo, k = 0; k < histogram_bins - 1; k++) {
+        if (cum + hist[2*k] >= targetlo) break;
+        cum += hist[2*k];
+      }
+      if (hist[2*k+1] == 0. || hist[2*k] <= 0.) break;
+
+      Zoltan_RB_histogram_apply(k, histogram_bins, 1, hist, binidx, dotmark,
+                                dotlist, &numlist, &valuemin, &valuemax,
+                                &weightlo, &weighthi);
+      if (hist[2*k+1] <= 1.) break;
+    }
+    ZOLTAN_FREE(&binidx);
+    ZOLTAN_FREE(&hist);
+  }
+
+  /* Switch to the compact kernels.  If dotlist is still the identity and
+   * weights are unstrided, the input arrays are already contiguous; they are
+   * scanned directly and only the dots left active by the first cut are
+   * copied.  Otherwise copy the active dots now.  On allocation failure
+   * keep using dotlist. */
+  if (compact && numlist > 0) {
+    if (numlist == dotnum && (!wgts || wgtflag == 1))
+      list = NULL;
+    else if (median_gather(dots, wgts, wgtflag, dotmark, dotlist, 0, numlist,
+                           -1, &acoord, &awgt, &amark) >= 0) {
+      aidx = dotlist;
+      xs = acoord;
+      ws = awgt;
+      wstride = 1;
+      mark = amark;
+      list = NULL;
+    }
+  }
 
   /* median iteration */
   /* zoom in on bisector until correct # of dots in each half of partition */
@@ -276,38 +412,19 @@ int Zoltan_RB_find_median(
       /* also set all fields in median data struct */
       /* save indices of closest dots on either side */
 
-      for (j = 0; j < numlist; j++) {
-        i = dotlist[j];
-        tmp_wgt = (wgts ? wgts[i*wgtflag] : uniformWeight);
-        if (dots[i] <= tmp_half) {            /* in lower part */
-          medme.totallo += tmp_wgt;
-          dotmark[i] = 0;
-          if (dots[i] > medme.valuelo) {       /* my closest dot */
-            medme.valuelo = dots[i];
-            medme.wtlo = tmp_wgt;
-            medme.countlo = 1;
-            indexlo = i;
-          }                                            /* tied for closest */
-          else if (dots[i] == medme.valuelo) {
-            medme.wtlo += tmp_wgt;
-            medme.countlo++;
-          }
-        }
-        else {                                         /* in upper part */
-          medme.totalhi += tmp_wgt;
-          dotmark[i] = 1;
-          if (dots[i] < medme.valuehi) {       /* my closest dot */
-            medme.valuehi = dots[i];
-            medme.wthi = tmp_wgt;
-            medme.counthi = 1;
-            indexhi = i;
-          }                                            /* tied for closest */
-          else if (dots[i] == medme.valuehi) {
-            medme.wthi += tmp_wgt;
-            medme.counthi++;
-          }
-        }
-      }
+#ifdef _OPENMP
+      if (thrmed)
+        median_scan_threaded(num_threads, xs, ws, uniformWeight, wstride,
+                             mark, list, keep, numlist, tmp_half, &medme,
+                             &indexlo, &indexhi, thrmed, thrindex);
+      else
+#endif
+      if (list)
+        median_scan(dots, wgts, uniformWeight, wgtflag, dotmark, dotlist,
+                    0, numlist, tmp_half, &medme, &indexlo, &indexhi);
+      else
+        median_scan_compact(xs, ws, uniformWeight, mark, keep, numlist,
+                            tmp_half, &medme, &indexlo, &indexhi);
 
       med.totallo = med.totalhi = 0.0;
       med.valuelo = -DBL_MAX;
@@ -328,6 +445,17 @@ int Zoltan_RB_find_median(
          MPI_Allreduce(&medme,&med,1,med_type,med_op,local_comm);
       }
 
+      /* incremental: keep the old cut if it is still good enough; every
+         dot has been marked by the scan, so this costs one reduction */
+      if (incremental) {
+        incremental = 0;
+        if (fabs(weightlo + med.totallo - targetlo) <= reuse_tol * weight) {
+          weightlo += med.totallo;
+          weighthi += med.totalhi;
+          break;
+        }
+      }
+
       /* test median guess for convergence */
       /* move additional dots that are next to cut across it */
 
@@ -338,11 +466,11 @@ int Zoltan_RB_find_median(
 
         if (med.counthi == 1) {                  /* only one dot to move */
           if (weightlo + med.wthi < targetlo) {  /* move it, keep iterating */
-            if (proc == med.prochi) dotmark[indexhi] = 0;
+            if (proc == med.prochi) mark[indexhi] = 0;
           }
           else {                                 /* only move if beneficial */
             if (weightlo + med.wthi - targetlo < targetlo - weightlo) {
-              if (proc == med.prochi) dotmark[indexhi] = 0;
+              if (proc == med.prochi) mark[indexhi] = 0;
               weightlo += med.wthi;
             }
             weighthi = weight - weightlo;
@@ -370,11 +498,11 @@ int Zoltan_RB_find_median(
             breakflag = 1;
           }                                      /* wtok = most I can move */
           for (j = 0, wtsum = 0.0; j < numlist && wtsum < wtok; j++) {
-            i = dotlist[j];
-            if (dots[i] == med.valuehi) { /* only move if better */
-              tmp_wgt = (wgts ? wgts[i*wgtflag] : uniformWeight);
+            i = (list ? list[j] : j);
+            if (xs[i] == med.valuehi && mark[i] >= 0) { /* only move if better */
+              tmp_wgt = (ws ? ws[i*wstride] : uniformWeight);
               if (wtsum + tmp_wgt - wtok < wtok - wtsum) {
-                dotmark[i] = 0;
+                mark[i] = 0;
                 wtsum += tmp_wgt;  /* KDD Moved sum inside if test 1/2002 */
               }
             }
@@ -410,11 +538,11 @@ int Zoltan_RB_find_median(
 
         if (med.countlo == 1) {                  /* only one dot to move */
           if (weighthi + med.wtlo < targethi) {  /* move it, keep iterating */
-            if (proc == med.proclo) dotmark[indexlo] = 1;
+            if (proc == med.proclo) mark[indexlo] = 1;
           }
           else {                                 /* only move if beneficial */
             if (weighthi + med.wtlo - targethi < targethi - weighthi) {
-              if (proc == med.proclo) dotmark[indexlo] = 1;
+              if (proc == med.proclo) mark[indexlo] = 1;
               weighthi += med.wtlo;
             }
             weightlo = weight - weighthi;
@@ -442,11 +570,11 @@ int Zoltan_RB_find_median(
             breakflag = 1;
           }                                      /* wtok = most I can move */
           for (j = 0, wtsum = 0.0; j < numlist && wtsum < wtok; j++) {
-            i = dotlist[j];
-            if (dots[i] == med.valuelo) { /* only move if better */
-              tmp_wgt = (wgts ? wgts[i*wgtflag] : uniformWeight);
+            i = (list ? list[j] : j);
+            if (xs[i] == med.valuelo && mark[i] >= 0) { /* only move if better */
+              tmp_wgt = (ws ? ws[i*wstride] : uniformWeight);
               if (wtsum + tmp_wgt - wtok < wtok - wtsum) {
-                dotmark[i] = 1;
+                mark[i] = 1;
                 wtsum += tmp_wgt; /* KDD Moved sum inside if test 1/2002 */
               }
             }
@@ -482,22 +610,59 @@ int Zoltan_RB_find_median(
 
       /* shrink the active list */
       
-      k = 0;
-      for (j = 0; j < numlist; j++) {
-        i = dotlist[j];
-        if (dotmark[i] == markactive) dotlist[k++] = i;
+      if (list) {
+        k = 0;
+        for (j = 0; j < numlist; j++) {
+          i = dotlist[j];
+          if (dotmark[i] == markactive) dotlist[k++] = i;
+        }
+        numlist = k;
+      }
+      else if (aidx) {
+        numlist = median_compact(numlist, markactive, acoord, awgt, aidx,
+                                 amark, dotmark);
+        keep = markactive;
+      }
+      else {
+        /* first cut on the input arrays; copy the remaining active dots */
+        k = median_gather(dots, wgts, wgtflag, dotmark, dotlist, 1, numlist,
+                          markactive, &acoord, &awgt, &amark);
+        if (k >= 0) {
+          aidx = dotlist;
+          xs = acoord;
+          ws = awgt;
+          mark = amark;
+        }
+        else {
+          for (k = j = 0; j < numlist; j++)
+            if (dotmark[j] == markactive) dotlist[k++] = j;
+          list = dotlist;
+        }
+        numlist = k;
+      }
+
+#ifdef _OPENMP
+      if (thrmed && numlist < num_threads * MEDIAN_MIN_DOTS_PER_THREAD) {
+        /* Active list has become too short to be worth threading. */
+        ZOLTAN_FREE(&thrmed);
+        ZOLTAN_FREE(&thrindex);
       }
-      numlist = k;
+#endif
     }
   }
   else { /* if one processor set all dots to 0 (Tflops_Special) */
     for (i = 0; i < numlist; i++)
-      dotmark[i] = 0;
+      mark[i] = 0;
     weightlo = weight;
     weighthi = 0.;
     tmp_half = valuemax;
   }
 
+  /* compact: marks of dots left in the arrays are still in amark */
+  if (aidx)
+    for (j = 0; j < numlist; j++)
+      dotmark[aidx[j]] = (amark[j] >= 0 ? amark[j] : -1 - amark[j]);
+
   /* found median */
   *valuehalf = tmp_half;
 
@@ -513,6 +678,12 @@ int Zoltan_RB_find_median(
   if (!Tflops_Special)
      MPI_Op_free(&med_op);
 
+  ZOLTAN_FREE(&thrmed);
+  ZOLTAN_FREE(&thrindex);
+  ZOLTAN_FREE(&acoord);
+  ZOLTAN_FREE(&awgt);
+  ZOLTAN_FREE(&amark);
+
 #ifdef WATCH_MEDIAN_FIND
   if ((num_procs>1) && (rank==0)){
     fprintf(stderr,"%s loop count %d interval size %d median (%lf - %lf) %lf\n",
@@ -525,6 +696,493 @@ int Zoltan_RB_find_median(
   return 1;
 }
 
+/*****************************************************************************/
+
+/* Scan active dots dotlist[start:end-1] against trial cut tmp_half.
+ * Marks each dot with the side of the cut it is on and accumulates the
+ * weights and the dot(s) closest to the cut into medme.  medme must be
+ * initialized by the caller. */
+static void median_scan(
+  double *dots,
+  double *wgts,
+  double uniformWeight,
+  int wgtflag,
+  int *dotmark,
+  int *dotlist,
+  int start,
+  int end,
+  double tmp_half,
+  struct median *medme,
+  int *indexlo,
+  int *indexhi
+)
+{
+  int i, j;
+  double tmp_wgt;
+
+  for (j = start; j < end; j++) {
+    i = dotlist[j];
+    tmp_wgt = (wgts ? wgts[i*wgtflag] : uniformWeight);
+    if (dots[i] <= tmp_half) {            /* in lower part */
+      medme->totallo += tmp_wgt;
+      dotmark[i] = 0;
+      if (dots[i] > medme->valuelo) {       /* my closest dot */
+        medme->valuelo = dots[i];
+        medme->wtlo = tmp_wgt;
+        medme->countlo = 1;
+        *indexlo = i;
+      }                                            /* tied for closest */
+      else if (dots[i] == medme->valuelo) {
+        medme->wtlo += tmp_wgt;
+        medme->countlo++;
+      }
+    }
+    else {                                         /* in upper part */
+      medme->totalhi += tmp_wgt;
+      dotmark[i] = 1;
+      if (dots[i] < medme->valuehi) {       /* my closest dot */
+        medme->valuehi = dots[i];
+        medme->wthi = tmp_wgt;
+        medme->counthi = 1;
+        *indexhi = i;
+      }                                            /* tied for closest */
+      else if (dots[i] == medme->valuehi) {
+        medme->wthi += tmp_wgt;
+        medme->counthi++;
+      }
+    }
+  }
+}
+
+/*****************************************************************************/
+
+/* Version of median_scan for compact dots x[0:n-1] with weights w[0:n-1]
+ * (or uniformWeight if w is NULL).  Dots with mark == keep are active; the
+ * others have left the active set without being removed from the arrays
+ * (see median_compact) and are skipped.  Their marks are recoded on the way
+ * to -1 (side 0) or -2 (side 1), so that marks >= 0 on return are those of
+ * the active dots.  With OpenMP the first pass computes the side of each
+ * dot, the weight totals and the nearest values on both sides without
+ * data-dependent branches, so that it vectorizes, and the second pass sums
+ * the dots tied at the nearest values; otherwise the reductions cannot be
+ * vectorized and a single pass as in median_scan is used.  medme must be
+ * freshly initialized; indexlo/indexhi are positions in x. */
+static void median_scan_compact(
+  double *x,
+  double *w,
+  double uniformWeight,
+  int *mark,
+  int keep,
+  int n,
+  double tmp_half,
+  struct median *medme,
+  int *indexlo,
+  int *indexhi
+)
+{
+  int j;
+  int countlo = 0, counthi = 0;
+  double totallo = 0., totalhi = 0.;
+  double valuelo = medme->valuelo, valuehi = medme->valuehi;
+  double wtlo = 0., wthi = 0.;
+#ifdef _OPENMP
+  int numlo = 0, numhi = 0;
+  int firstlo, firsthi;
+
+  /* The loop bodies load x[j] and w[j] unconditionally; conditional loads
+   * in the selects are miscompiled by some compilers for AVX-512. */
+  if (w) {
+#pragma omp simd reduction(+:totallo,totalhi) reduction(max:valuelo) reduction(min:valuehi)
+    for (j = 0; j < n; j++) {
+      double xj = x[j], wj = w[j];
+      int m = mark[j];
+      int live = (m == keep);
+      int hi = live & (xj > tmp_half);
+      int lo = live & !hi;
+      mark[j] = (live ? hi : (m < 0 ? m : -1 - m));
+      totalhi += (hi ? wj : 0.);
+      totallo += (lo ? wj : 0.);
+      valuelo = ((lo & (xj > valuelo)) ? xj : valuelo);
+      valuehi = ((hi & (xj < valuehi)) ? xj : valuehi);
+    }
+  }
+  else {
+#pragma omp simd reduction(+:numlo,numhi) reduction(max:valuelo) reduction(min:valuehi)
+    for (j = 0; j < n; j++) {
+      double xj = x[j];
+      int m = mark[j];
+      int live = (m == keep);
+      int hi = live & (xj > tmp_half);
+      int lo = live & !hi;
+      mark[j] = (live ? hi : (m < 0 ? m : -1 - m));
+      numhi += hi;
+      numlo += lo;
+      valuelo = ((lo & (xj > valuelo)) ? xj : valuelo);
+      valuehi = ((hi & (xj < valuehi)) ? xj : valuehi);
+    }
+    totalhi = numhi * uniformWeight;
+    totallo = numlo * uniformWeight;
+  }
+
+  /* Count the dots tied at the nearest values and find the first of each,
+   * as in median_scan.  Ties are rare, so their weights are summed only
+   * from the first tied dot on, and only if there is more than one. */
+  firstlo = firsthi = n;
+#pragma omp simd reduction(+:countlo,counthi) reduction(min:firstlo,firsthi)
+  for (j = 0; j < n; j++) {
+    double xj = x[j];
+    int live = (mark[j] >= 0);
+    int islo = live & (xj == valuelo);
+    int ishi = live & (xj == valuehi);
+    countlo += islo;
+    counthi += ishi;
+    firstlo = ((islo & (j < firstlo)) ? j : firstlo);
+    firsthi = ((ishi & (j < firsthi)) ? j : firsthi);
+  }
+  if (countlo) {
+    *indexlo = firstlo;
+    wtlo = (w ? w[firstlo] : uniformWeight);
+    if (countlo > 1)
+      for (j = firstlo + 1; j < n; j++)
+        if (mark[j] >= 0 && x[j] == valuelo)
+          wtlo += (w ? w[j] : uniformWeight);
+  }
+  if (counthi) {
+    *indexhi = firsthi;
+    wthi = (w ? w[firsthi] : uniformWeight);
+    if (counthi > 1)
+      for (j = firsthi + 1; j < n; j++)
+        if (mark[j] >= 0 && x[j] == valuehi)
+          wthi += (w ? w[j] : uniformWeight);
+  }
+#else
+  double tmp_wgt;
+
+  for (j = 0; j < n; j++) {
+    if (mark[j] != keep) {
+      if (mark[j] >= 0) mark[j] = -1 - mark[j];
+      continue;
+    }
+    tmp_wgt = (w ? w[j] : uniformWeight);
+    if (x[j] <= tmp_half) {
+      totallo += tmp_wgt;
+      mark[j] = 0;
+      if (x[j] > valuelo) {
+        valuelo = x[j];
+        wtlo = tmp_wgt;
+        countlo = 1;
+        *indexlo = j;
+      }
+      else if (x[j] == valuelo) {
+        wtlo += tmp_wgt;
+        countlo++;
+      }
+    }
+    else {
+      totalhi += tmp_wgt;
+      mark[j] = 1;
+      if (x[j] < valuehi) {
+        valuehi = x[j];
+        wthi = tmp_wgt;
+        counthi = 1;
+        *indexhi = j;
+      }
+      else if (x[j] == valuehi) {
+        wthi += tmp_wgt;
+        counthi++;
+      }
+    }
+  }
+#endif
+
+  medme->totallo = totallo;
+  medme->totalhi = totalhi;
+  medme->valuelo = valuelo;
+  medme->valuehi = valuehi;
+  medme->wtlo = wtlo;
+  medme->wthi = wthi;
+  medme->countlo = countlo;
+  medme->counthi = counthi;
+}
+
+/*****************************************************************************/
+
+/* Copy dots into newly allocated contiguous arrays for the compact kernels:
+ * coordinates into acoord and first weights into awgt (if wgts), with the
+ * marks in amark set to 0 (active).  If ident is set the candidates are dots 0..n-1,
+ * otherwise dotlist[0:n-1]; if keep >= 0 only those with dotmark == keep
+ * are copied.  The indices of the copied dots are stored, in order, at the
+ * front of dotlist.  Returns the number of dots copied, or -1 (with nothing
+ * allocated) if out of memory. */
+static int median_gather(
+  double *dots,
+  double *wgts,
+  int wgtflag,
+  int *dotmark,
+  int *dotlist,
+  int ident,
+  int n,
+  int keep,
+  double **acoord,
+  double **awgt,
+  int **amark
+)
+{
+  int i, j, k;
+
+  *acoord = (double *) ZOLTAN_MALLOC(n * sizeof(double));
+  *awgt = (wgts ? (double *) ZOLTAN_MALLOC(n * sizeof(double)) : NULL);
+  *amark = (int *) ZOLTAN_MALLOC(n * sizeof(int));
+  if (!*acoord || (wgts && !*awgt) || !*amark) {
+    ZOLTAN_FREE(acoord);
+    ZOLTAN_FREE(awgt);
+    ZOLTAN_FREE(amark);
+    return -1;
+  }
+
+  for (k = j = 0; j < n; j++) {
+    i = (ident ? j : dotlist[j]);
+    if (keep < 0 || dotmark[i] == keep) {
+      (*acoord)[k] = dots[i];
+      if (wgts) (*awgt)[k] = wgts[i*wgtflag];
+      (*amark)[k] = 0;
+      dotlist[k++] = i;
+    }
+  }
+  return k;
+}
+
+/*****************************************************************************/
+
+/* Remove compact dots with amark != keep from the active set.  If at least
+ * an eighth of the n array entries are no longer active, the dots that stay
+ * are moved, in order, to the front of acoord, awgt, aidx and amark, the
+ * marks of the others are stored in dotmark, and the number kept is
+ * returned.  Otherwise moving them would cost more than it saves in the next
+ * scans; n is returned and the departed dots are skipped by
+ * median_scan_compact. */
+static int median_compact(
+  int n,
+  int keep,
+  double *acoord,
+  double *awgt,
+  int *aidx,
+  int *amark,
+  int *dotmark
+)
+{
+  int j, k;
+
+  for (k = j = 0; j < n; j++)
+    k += (amark[j] == keep);
+
+  if (8 * k > 7 * n)
+    return n;
+
+  for (k = j = 0; j < n; j++) {
+    if (amark[j] == keep) {
+      acoord[k] = acoord[j];
+      if (awgt) awgt[k] = awgt[j];
+      aidx[k] = aidx[j];
+      amark[k] = amark[j];
+      k++;
+    }
+    else
+      dotmark[aidx[j]] = (amark[j] >= 0 ? amark[j] : -1 - amark[j]);
+  }
+  return k;
+}
+
+#ifdef _OPENMP
+/*****************************************************************************/
+
+/* Threaded version of median_scan.  dotlist is split into one contiguous
+ * chunk per thread; each thread scans its chunk into its own entry of
+ * thrmed, and the partial results are merged in thread order so that
+ * indexlo/indexhi refer to the first closest dot in dotlist, as in the
+ * serial scan.  If dotlist is NULL, the dots are compact and each chunk is
+ * scanned with median_scan_compact. */
+static void median_scan_threaded(
+  int num_threads,
+  double *dots,
+  double *wgts,
+  double uniformWeight,
+  int wgtflag,
+  int *dotmark,
+  int *dotlist,
+  int keep,                 /* as in median_scan_compact if dotlist is NULL */
+  int numlist,
+  double tmp_half,
+  struct median *medme,
+  int *indexlo,
+  int *indexhi,
+  struct median *thrmed,    /* scratch of length num_threads */
+  int *thrindex             /* scratch of length 2*num_threads */
+)
+{
+  int t, nthreads = 1;
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    int tid = omp_get_thread_num();
+    int nt = omp_get_num_threads();
+    int chunk = (numlist + nt - 1) / nt;
+    int start = tid * chunk;
+    int end = (start + chunk < numlist ? start + chunk : numlist);
+
+    if (tid == 0) nthreads = nt;
+    thrmed[tid] = *medme;
+    thrindex[2*tid] = thrindex[2*tid+1] = -1;
+    if (start < end && dotlist)
+      median_scan(dots, wgts, uniformWeight, wgtflag, dotmark, dotlist,
+                  start, end, tmp_half, &thrmed[tid],
+                  &thrindex[2*tid], &thrindex[2*tid+1]);
+    else if (start < end) {
+      median_scan_compact(dots + start, (wgts ? wgts + start : NULL),
+                          uniformWeight, dotmark + start, keep, end - start,
+                          tmp_half, &thrmed[tid],
+                          &thrindex[2*tid], &thrindex[2*tid+1]);
+      thrindex[2*tid] += start;
+      thrindex[2*tid+1] += start;
+    }
+  }
+
+  for (t = 0; t < nthreads; t++) {
+    medme->totallo += thrmed[t].totallo;
+    if (thrmed[t].valuelo > medme->valuelo) {
+      medme->valuelo = thrmed[t].valuelo;
+      medme->wtlo = thrmed[t].wtlo;
+      medme->countlo = thrmed[t].countlo;
+      *indexlo = thrindex[2*t];
+    }
+    else if (thrmed[t].countlo && thrmed[t].valuelo == medme->valuelo) {
+      medme->wtlo += thrmed[t].wtlo;
+      medme->countlo += thrmed[t].countlo;
+    }
+
+    medme->totalhi += thrmed[t].totalhi;
+    if (thrmed[t].valuehi < medme->valuehi) {
+      medme->valuehi = thrmed[t].valuehi;
+      medme->wthi = thrmed[t].wthi;
+      medme->counthi = thrmed[t].counthi;
+      *indexhi = thrindex[2*t+1];
+    }
+    else if (thrmed[t].counthi && thrmed[t].valuehi == medme->valuehi) {
+      medme->wthi += thrmed[t].wthi;
+      medme->counthi += thrmed[t].counthi;
+    }
+  }
+}
+#endif
+
+/*****************************************************************************/
+
+/* Histogram of the active dots dotlist[0:numlist-1] over histogram_bins
+ * equal-width bins of [valuemin, valuemax].  On return, binidx[j] is the bin
+ * of dot dotlist[j], and hist[b*(nwgts+1)+k] holds the global sum of weight
+ * k (k < nwgts) and the global number of dots (k == nwgts) in bin b.
+ * Weights of dot i are read from wgts[i*wstride], or are uniformWeight if
+ * wgts is NULL.  hist must hold 2*histogram_bins*(nwgts+1) doubles; the
+ * second half is used for the local histogram.  All procs in local_comm
+ * must call this routine with the same interval and bin count. */
+int Zoltan_RB_histogram_reduce(
+  double *dots,
+  double *wgts,
+  double uniformWeight,
+  int nwgts,
+  int wstride,
+  int *dotlist,
+  int numlist,
+  double valuemin,
+  double valuemax,
+  int histogram_bins,
+  int *binidx,
+  double *hist,
+  MPI_Comm local_comm
+)
+{
+  int i, j, k, b;
+  int len = histogram_bins * (nwgts + 1);
+  double *local = hist + len;
+  double scale;
+
+  if (!(valuemax > valuemin)) return ZOLTAN_WARN;
+
+  scale = histogram_bins / (valuemax - valuemin);
+
+  /* Bin indices first, in a loop without data-dependent branches. */
+  for (j = 0; j < numlist; j++) {
+    b = (int) ((dots[dotlist[j]] - valuemin) * scale);
+    b = (b < 0 ? 0 : b);
+    binidx[j] = (b < histogram_bins ? b : histogram_bins - 1);
+  }
+
+  for (k = 0; k < len; k++) local[k] = 0.;
+
+  for (j = 0; j < numlist; j++) {
+    double *h = local + binidx[j] * (nwgts + 1);
+    i = dotlist[j];
+    if (wgts)
+      for (k = 0; k < nwgts; k++) h[k] += wgts[i*wstride+k];
+    else
+      h[0] += uniformWeight;
+    h[nwgts] += 1.;
+  }
+
+  MPI_Allreduce(local, hist, len, MPI_DOUBLE, MPI_SUM, local_comm);
+
+  return ZOLTAN_OK;
+}
+
+/*****************************************************************************/
+
+/* Keep only the dots in histogram bin target active.  Dots in lower bins are
+ * marked 0 and their weights added to weightlo; dots in higher bins are
+ * marked 1 and their weights added to weighthi.  dotlist is compacted to the
+ * remaining active dots and [valuemin, valuemax] shrunk to the bin. */
+void Zoltan_RB_histogram_apply(
+  int target,
+  int histogram_bins,
+  int nwgts,
+  double *hist,          /* global histogram from Zoltan_RB_histogram_reduce */
+  int *binidx,           /* bin of each active dot */
+  int *dotmark,
+  int *dotlist,
+  int *numlist,
+  double *valuemin,
+  double *valuemax,
+  double *weightlo,
+  double *weighthi
+)
+{
+  int j, k, n;
+  double width = (*valuemax - *valuemin) / histogram_bins;
+
+  for (n = j = 0; j < *numlist; j++) {
+    if (binidx[j] == target)
+      dotlist[n++] = dotlist[j];
+    else
+      dotmark[dotlist[j]] = (binidx[j] > target);
+  }
+  *numlist = n;
+
+  for (j = 0; j < histogram_bins; j++) {
+    if (j == target) continue;
+    for (k = 0; k < nwgts; k++) {
+      if (j < target)
+        weightlo[k] += hist[j*(nwgts+1)+k];
+      else
+        weighthi[k] += hist[j*(nwgts+1)+k];
+    }
+  }
+
+  if (target < histogram_bins - 1)
+    *valuemax = *valuemin + (target + 1) * width;
+  *valuemin = *valuemin + target * width;
+}
+
+/*****************************************************************************/
+
 /* merge median data structure */
 /* on input:
    in,inout->totallo, totalhi = weight in both partitions on this proc
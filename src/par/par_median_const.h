@@ -59,7 +59,7 @@ extern int Zoltan_RB_find_median(int, double *, double *, double, int *,
   int, int, double*, MPI_Comm,
   double *, int, int, int,
   int, int, int, double, double, double,
-  double *, double *, int *, int, int);
+  double *, double *, int *, int, int, int, int, int, double);
 
 extern int Zoltan_RB_find_median_randomized(int, double *, double *, double, int *,
   int, int, double*, MPI_Comm,
@@ -67,6 +67,14 @@ extern int Zoltan_RB_find_median_randomized(int, double *, double *, double, int
   int, int, int, double, double, double,
   double *, double *, int *, int, int);
 
+/* Histogram narrowing shared by find_median and find_bisector */
+#define HISTOGRAM_MAX_ROUNDS 3  /* Max. no. of histogram rounds used to narrow
+                                   the interval before the exact iteration. */
+extern int Zoltan_RB_histogram_reduce(double *, double *, double, int, int,
+  int *, int, double, double, int, int *, double *, MPI_Comm);
+extern void Zoltan_RB_histogram_apply(int, int, int, double *, int *, int *,
+  int *, int *, double *, double *, double *, double *);
+
 /* Prototype for function used with TFLOPS_SPECIAL */
 extern void Zoltan_RB_reduce(int, int, int, void*, void*,
                              int, int*, MPI_Datatype, MPI_Comm, 
@@ -665,6 +665,7 @@ int Zoltan_PHG_Initialize_Params(
                                    another param at least it will be 0 */
   
   Zoltan_Bind_Param(PHG_params, "HYPERGRAPH_PACKAGE", &hgp->hgraph_pkg);
+  Zoltan_Bind_Param(PHG_params, "PHG_PRESET", hgp->preset_str);
   Zoltan_Bind_Param(PHG_params, "PHG_MULTILEVEL", &hgp->useMultilevel);
   Zoltan_Bind_Param(PHG_params, "PHG_OUTPUT_LEVEL", &hgp->output_level);
   Zoltan_Bind_Param(PHG_params, "FINAL_OUTPUT", &hgp->final_output); 
@@ -691,6 +692,8 @@ int Zoltan_PHG_Initialize_Params(
                                 &hgp->fm_loop_limit);
   Zoltan_Bind_Param(PHG_params, "PHG_REFINEMENT_MAX_NEG_MOVE", 
                                 &hgp->fm_max_neg_move);  
+  Zoltan_Bind_Param(PHG_params, "PHG_FM_GAIN_BUCKETS", 
+                                &hgp->fm_gain_buckets);  
   Zoltan_Bind_Param(PHG_params, "PHG_REFINEMENT_QUALITY", 
                                 &hgp->refinement_quality);  
   Zoltan_Bind_Param(PHG_params, "PHG_COARSEPARTITION_METHOD", 
@@ -699,6 +702,14 @@ int Zoltan_PHG_Initialize_Params(
                                  (void*) &hgp->use_timers);  
   Zoltan_Bind_Param(PHG_params, "USE_TIMERS",
                                  (void*) &hgp->use_timers);  
+  Zoltan_Bind_Param(PHG_params, "PHG_NUM_THREADS",
+                                 (void*) &hgp->num_threads);  
+  Zoltan_Bind_Param(PHG_params, "PHG_COMPACT_LEVELS",
+                                 (void*) &hgp->compact_levels);  
+  Zoltan_Bind_Param(PHG_params, "PHG_COALESCE_IDENTICAL",
+                                 (void*) &hgp->coalesce_identical);  
+  Zoltan_Bind_Param(PHG_params, "PHG_COARSEPARTITION_TIME",
+                                 (void*) &hgp->coarse_time);  
   Zoltan_Bind_Param(PHG_params, "PHG_EDGE_SIZE_THRESHOLD",
                                  (void*) &hgp->EdgeSizeThreshold);  
   Zoltan_Bind_Param(PHG_params, "PHG_MATCH_EDGE_SIZE_THRESHOLD",
@@ -715,6 +726,8 @@ int Zoltan_PHG_Initialize_Params(
                                  (void *) edge_weight_op);
   Zoltan_Bind_Param(PHG_params, "PHG_RANDOMIZE_INPUT",
                                  (void*) &hgp->RandomizeInitDist);  
+  Zoltan_Bind_Param(PHG_params, "PHG_QUERY_PAGE_SIZE",
+                                 (void*) &hgp->query_page_size);  
   Zoltan_Bind_Param(PHG_params, "PHG_PROCESSOR_REDUCTION_LIMIT",
 		                 (void*) &hgp->ProRedL);
   Zoltan_Bind_Param(PHG_params, "PHG_REPART_MULTIPLIER",
@@ -727,6 +740,7 @@ int Zoltan_PHG_Initialize_Params(
   
   /* Set default values */
   strncpy(hgp->hgraph_pkg,           "phg", MAX_PARAM_STRING_LEN);
+  strncpy(hgp->preset_str,      "balanced", MAX_PARAM_STRING_LEN);
   strncpy(hgp->redm_str,             "agg", MAX_PARAM_STRING_LEN);
   hgp->match_array_type = 0;
   strncpy(hgp->redm_fast,          "l-ipm", MAX_PARAM_STRING_LEN);
@@ -749,6 +763,11 @@ int Zoltan_PHG_Initialize_Params(
     hgp->useMultilevel = 1;
 
   hgp->use_timers = 0;
+  hgp->num_threads = 1;
+  hgp->compact_levels = 0;
+  hgp->coalesce_identical = 0;
+  hgp->coarse_time = 0.;
+  hgp->coarse_rng = NULL;
   hgp->LocalCoarsePartition = 0;
   hgp->edge_scaling = 0;
   hgp->vtx_scaling = 0;
@@ -772,8 +791,10 @@ int Zoltan_PHG_Initialize_Params(
   hgp->geometric_levels = INT_MAX;
   hgp->fm_loop_limit = 10;
   hgp->fm_max_neg_move = 250;  
+  hgp->fm_gain_buckets = 0;
   hgp->refinement_quality = 1;
   hgp->RandomizeInitDist = 0;
+  hgp->query_page_size = 65536;
   hgp->EdgeSizeThreshold = 0.25;
   hgp->MatchEdgeSizeThreshold = 500;  
   hgp->hybrid_keep_factor = 0.;
@@ -784,6 +805,21 @@ int Zoltan_PHG_Initialize_Params(
   hgp->UseFixedVtx = 0;
   hgp->UsePrefPart = 0;
   
+  /* PHG_PRESET replaces the defaults above, so it is read in a first, quiet
+     pass; the second pass re-applies the application values on top of it. */
+  Zoltan_Assign_Param_Vals(zz->Params, PHG_params, 0, zz->Proc, zz->Debug_Proc);
+  if (!strcasecmp(hgp->preset_str, "fast")) {
+    /* Local matching, cheap coarse partitioning and half the FM effort */
+    strncpy(hgp->redm_str,             "l-ipm", MAX_PARAM_STRING_LEN);
+    strncpy(hgp->coarsepartition_str, "greedy", MAX_PARAM_STRING_LEN);
+    hgp->refinement_quality = 0.5;
+  }
+  else if (!strcasecmp(hgp->preset_str, "quality")) {
+    /* Twice the FM passes and negative moves; coarsen further */
+    hgp->refinement_quality = 2;
+    hgp->redl = MAX(2*zz->LB.Num_Global_Parts, 50);
+  }
+
   /* Get application values of parameters. */
   err = Zoltan_Assign_Param_Vals(zz->Params, PHG_params, zz->Debug_Level, 
           zz->Proc, zz->Debug_Proc);
@@ -865,6 +901,17 @@ int Zoltan_PHG_Initialize_Params(
     goto End;
   }
 
+  if (hgp->num_threads < 1)
+    hgp->num_threads = 1;
+#ifndef _OPENMP
+  if (hgp->num_threads > 1) {
+    if (zz->Proc == 0)
+      ZOLTAN_PRINT_WARN(zz->Proc, yo,
+        "PHG_NUM_THREADS ignored; Zoltan was not compiled with OpenMP");
+    hgp->num_threads = 1;
+  }
+#endif
+
   /* Adjust refinement parameters using hgp->refinement_quality */
   if (hgp->refinement_quality < 0.5/hgp->fm_loop_limit) 
     /* No refinement */
@@ -976,6 +1023,9 @@ int Zoltan_PHG_Set_Param(
   char *valid_pkg[] = {
         "ZOLTAN", "PHG", "PATOH",
          NULL };
+  char *valid_preset[] = {
+        "FAST", "BALANCED", "QUALITY",
+         NULL };
 
   status = Zoltan_Check_Param(name, val, PHG_params, &result, &index);
 
@@ -991,6 +1041,15 @@ int Zoltan_PHG_Set_Param(
         }
       }
     }
+    else if (strcasecmp(name, "PHG_PRESET") == 0){
+      status = 2;
+      for (i=0; valid_preset[i] != NULL; i++){
+        if (strcasecmp(val, valid_preset[i]) == 0){
+          status = 0;
+          break;
+        }
+      }
+    }
   }
   return(status);
 }
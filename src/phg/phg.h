@@ -81,6 +81,8 @@ typedef int ZOLTAN_PHG_REFINEMENT_FN(ZZ*, HGraph*, int, float *, Partition,
 struct PHGPartParamsStruct {
   char hgraph_pkg[MAX_PARAM_STRING_LEN];/* Package (Zoltan,PaToH,ParKway) */
   char hgraph_method[MAX_PARAM_STRING_LEN]; /* Operation(partition,repart,refine)*/
+  char preset_str[MAX_PARAM_STRING_LEN]; /* Parameter preset (fast, balanced,
+                                            quality) */
   int useMultilevel;             /* Flag indicating whether to use multilevel
                                     method */
   float bal_tol;                 /* Balance tolerance in % of average */
@@ -135,6 +137,8 @@ struct PHGPartParamsStruct {
   int fm_loop_limit;    /* Number of FM loops (if the refinement is FM) */
   int fm_max_neg_move;  /* Maximum number of vertex moves with negative gain;
                            an early stop condition. <0 means try all moves */
+  int fm_gain_buckets;  /* If set, FM keeps integer gains in buckets
+                           instead of heaps */
   float refinement_quality; /* Adjustment to refinement parameter settings; 
                                1 means the defaults, higher means more ref. */
     
@@ -163,6 +167,17 @@ struct PHGPartParamsStruct {
   int num_coarse_iter;  /* Number of coarse partitions to try on each proc. */
   int visit_order;      /* Vertex visit order. */
   int use_timers;       /* Flag indicating whether to time the PHG code. */
+  int num_threads;      /* Threads per process for inner product matching;
+                           1 unless Zoltan was compiled with OpenMP. */
+  int compact_levels;   /* If set, the pins of V-cycle levels not being
+                           worked on are kept compressed. */
+  int coalesce_identical; /* If set, identical vertices and hyperedges are
+                             merged before coarsening starts. */
+  float coarse_time;    /* Time budget (seconds) per proc for computing
+                           coarse partitioning candidates; 0 means a fixed
+                           number of candidates. */
+  unsigned int *coarse_rng; /* RNG state for the coarse partitioners;
+                               NULL means Zoltan's global RNG. */
   float EdgeSizeThreshold;  /* % of global vtxs beyond which an edge is 
                                considered to be dense. */
   ZOLTAN_GNO_TYPE MatchEdgeSizeThreshold;  /* Edges with sizes bigger than this threshold
@@ -178,6 +193,7 @@ struct PHGPartParamsStruct {
                         weight for the same edge: add, take max, flag error */
   int RandomizeInitDist;  /* Flag indicating whether to randomly distribute
                              vertices and edges passed as input to PHG. */
+  int query_page_size;    /* Pins per page requested from Get_HG_CS_Page. */
   float ProRedL;           /* V-cycle processor reduction limit in % of pins */
   float RepartMultiplier;  /* In PHG_REPART, multiply input edge weights by
                               RepartMultiplier, a parameter that should be 
@@ -217,6 +233,8 @@ int Zoltan_PHG_Vertex_Visit_Order (ZZ*, HGraph*, PHGPartParams*, int*);
 /**************/
 int Zoltan_PHG_Coarsening(ZZ*, HGraph*, ZOLTAN_GNO_TYPE *, HGraph*, ZOLTAN_GNO_TYPE *, int*, int*,
  int**, struct Zoltan_Comm_Obj**, PHGPartParams*);
+int Zoltan_PHG_Match_Identical(ZZ*, HGraph*, ZOLTAN_GNO_TYPE *, PHGPartParams*,
+ int*);
  
 /*********************************/
 /* Coarse Partitioning functions */
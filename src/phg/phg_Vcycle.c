@@ -233,7 +233,7 @@ int Zoltan_PHG_Partition (
 
   PHGComm *hgc = hg->comm;
   VCycle  *vcycle=NULL, *del=NULL;
-  int  i, err = ZOLTAN_OK, middle;
+  int  i, err = ZOLTAN_OK, middle, coalesce;
   ZOLTAN_GNO_TYPE origVpincnt; /* for processor reduction test */
   ZOLTAN_GNO_TYPE prevVcnt     = 2*hg->dist_x[hgc->nProc_x]; /* initialized so that the */
   ZOLTAN_GNO_TYPE prevVedgecnt = 2*hg->dist_y[hgc->nProc_y]; /* while loop will be entered
@@ -295,15 +295,20 @@ int Zoltan_PHG_Partition (
 
   /****** Coarsening ******/    
 #define COARSEN_FRACTION_LIMIT 0.9  /* Stop if we don't make much progress */
-  while ((hg->redl>0) && (hg->dist_x[hgc->nProc_x] > (ZOLTAN_GNO_TYPE)hg->redl)
+  /* With PHG_COALESCE_IDENTICAL, the first level only merges identical
+     vertices and hyperedges; it does not count towards the progress test. */
+  coalesce = hgp->coalesce_identical;
+  while ((coalesce || ((hg->redl>0) && (hg->dist_x[hgc->nProc_x] > (ZOLTAN_GNO_TYPE)hg->redl)
 	 && ((hg->dist_x[hgc->nProc_x] < (ZOLTAN_GNO_TYPE) (COARSEN_FRACTION_LIMIT * prevVcnt + 0.5)) /* prevVcnt initialized to 2*hg->dist_x[hgc->nProc_x] */
-	     || (hg->dist_y[hgc->nProc_y] < (ZOLTAN_GNO_TYPE) (COARSEN_FRACTION_LIMIT * prevVedgecnt + 0.5))) /* prevVedgecnt initialized to 2*hg->dist_y[hgc->nProc_y] */
+	     || (hg->dist_y[hgc->nProc_y] < (ZOLTAN_GNO_TYPE) (COARSEN_FRACTION_LIMIT * prevVedgecnt + 0.5))))) /* prevVedgecnt initialized to 2*hg->dist_y[hgc->nProc_y] */
     && hg->dist_y[hgc->nProc_y] && hgp->matching) {
       ZOLTAN_GNO_TYPE *match = NULL;
       VCycle *coarser=NULL, *redistributed=NULL;
         
-      prevVcnt     = hg->dist_x[hgc->nProc_x];
-      prevVedgecnt = hg->dist_y[hgc->nProc_y];
+      if (!coalesce) {
+        prevVcnt     = hg->dist_x[hgc->nProc_x];
+        prevVedgecnt = hg->dist_y[hgc->nProc_y];
+      }
 
 #ifdef _DEBUG      
       /* UVC: load balance stats */
@@ -351,7 +356,15 @@ int Zoltan_PHG_Partition (
         
       /* Calculate matching (packing or grouping) */
 
-      err = Zoltan_PHG_Matching (zz, hg, match, hgp);
+      if (coalesce) {
+        int merged;
+        coalesce = 0;
+        err = Zoltan_PHG_Match_Identical (zz, hg, match, hgp, &merged);
+        if (hgp->output_level >= PHG_DEBUG_LIST)
+          uprintf(hgc, "Identical vertices merged: %d\n", merged);
+      }
+      else
+        err = Zoltan_PHG_Matching (zz, hg, match, hgp);
 
       if (err != ZOLTAN_OK && err != ZOLTAN_WARN) {
         ZOLTAN_FREE (&match);
@@ -401,6 +414,11 @@ int Zoltan_PHG_Partition (
 
       ZOLTAN_FREE (&match);
 
+      /* hg is not needed again until uncoarsening comes back to it */
+      if (hgp->compact_levels
+       && (err = Zoltan_HG_Pack_Pins(zz, hg)) != ZOLTAN_OK)
+        goto End;
+
       if ((err=allocVCycle(coarser))!= ZOLTAN_OK)
         goto End;
       vcycle = coarser;
@@ -456,6 +474,9 @@ int Zoltan_PHG_Partition (
 
 	  if ((err=allocVCycle(redistributed))!= ZOLTAN_OK)
 	    goto End;
+	  if (hgp->compact_levels
+	   && (err = Zoltan_HG_Pack_Pins(zz, hg)) != ZOLTAN_OK)
+	    goto End;
 	  vcycle = redistributed;
 
 	  if (hgc->myProc < 0)
@@ -531,6 +552,8 @@ Refine:
   while (vcycle) {
     VCycle *finer = vcycle->finer;
     hg = vcycle->hg;
+    if (hg->packed_pins && (err = Zoltan_HG_Unpack_Pins(zz, hg)) != ZOLTAN_OK)
+      goto End;
 
     if (refine && hgc->myProc >= 0) {
       if (do_timing) {
@@ -712,6 +735,12 @@ Refine:
   }       /* while (vcycle) */
     
 End:
+  /* on errors the caller's hypergraph may still be packed */
+  for (vcycle = (del ? del : vcycle); vcycle && vcycle->finer;
+       vcycle = vcycle->finer);
+  if (vcycle && vcycle->hg->packed_pins)
+    Zoltan_HG_Unpack_Pins(zz, vcycle->hg);
+
   vcycle = del;
   while (vcycle) {
     if (vcycle_timing) {
@@ -64,6 +64,20 @@ static int edge_weight_operation(ZZ *zz, float *dest, float *src, int ew_dim, in
 static int Convert_To_CSR( ZZ *zz, int num_pins, int *col_ptr,
     int *num_lists, ZOLTAN_ID_PTR *vtx_GID, int **row_ptr, ZOLTAN_ID_PTR *edg_GID);
 
+static void Get_All_Pins(ZZ *zz, int nl, int np, int format,
+    ZOLTAN_ID_PTR lists, int *ptr, ZOLTAN_ID_PTR pins, int *ierr);
+
+static int phg_stream_edge_sizes(ZZ *zz, int format, int nlists, int npins,
+    int page_size, int *msg_tag, int *nrecv, ZOLTAN_ID_PTR *edge_gids,
+    ZOLTAN_ID_TYPE **edge_sizes, int **from_start, int **from_seq);
+static int phg_stream_pins(ZZ *zz, int format, int nlists, int npins,
+    int page_size, int *msg_tag, phg_GID_lookup *lookup, int nparts,
+    ZOLTAN_ID_PTR part_gids, ZOLTAN_ID_TYPE *part_sizes, int *from_start,
+    int *from_seq, int *pinIdx, ZOLTAN_ID_PTR pinGID);
+static int phg_stream_pin_gnos(ZZ *zz, int page_size, int *msg_tag, int npins,
+    ZOLTAN_ID_PTR pinGID, phg_GID_lookup *lookup, zoltan_temp_vertices *vtxs,
+    int *pinProcs, ZOLTAN_GNO_TYPE *pinGNO);
+
 /*****************************************************************************/
 int Zoltan_Get_Hypergraph_From_Queries(
                     ZZ *zz,                      /* input zoltan struct */
@@ -96,6 +110,7 @@ ZOLTAN_ID_TYPE *sendIdBuf = NULL, *recvIdBuf = NULL;
 int *procBuf= NULL;
 ZOLTAN_GNO_TYPE *edgeBuf= NULL;
 int *pinIdx = NULL;
+int *fromStart = NULL, *fromSeq = NULL;
 
 float *gid_weights = NULL;
 float *wgts = NULL;
@@ -127,6 +142,8 @@ ZOLTAN_GNO_TYPE tmpgno;
 MPI_Datatype zoltan_gno_mpi_type;
 
 int gno_size_for_dd;
+int nLists = 0, nListPins = 0, format = ZOLTAN_COMPRESSED_EDGE;
+int pageSize = (hgp->query_page_size > 0) ? hgp->query_page_size : 1;
 
 ZOLTAN_ID_PTR fromID, toID;
 
@@ -194,7 +211,7 @@ phg_GID_lookup       *lookup_myHshVtxs = NULL;
     goto End;
   }
 
-  if (zz->Get_HG_Size_CS && zz->Get_HG_CS){
+  if (zz->Get_HG_Size_CS && (zz->Get_HG_CS || zz->Get_HG_CS_Page)){
     hypergraph_callbacks = 1;
   }
   if ((zz->Get_Num_Edges != NULL || zz->Get_Num_Edges_Multi != NULL) &&
@@ -318,85 +335,119 @@ phg_GID_lookup       *lookup_myHshVtxs = NULL;
      * But more than one process may supply pins for the same edge.
      */
 
-    ierr = Zoltan_Hypergraph_Queries(zz, &myPins.nHedges,
-                 &myPins.numPins, &myPins.edgeGID, &pinIdx,
-                 &myPins.pinGID);
+    if (zz->Get_HG_CS_Page){
 
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
+      /*
+       * Get the pins a page at a time, so we never hold all of them at
+       * once.  The first pass only sends each (partial) edge's size to
+       * the edge's process, so it can allocate the edge's pins before
+       * the second pass below sends them.
+       */
 
-    if (myPins.nHedges){
-      myPins.esizes = (int *)ZOLTAN_MALLOC(sizeof(int) * myPins.nHedges);
-      if (!myPins.esizes) MEMORY_ERROR;
-    }
+      zz->Get_HG_Size_CS(zz->Get_HG_Size_CS_Data, &nLists, &nListPins, &format, &ierr);
 
-    for (i=0; i<myPins.nHedges; i++){
-      myPins.esizes[i] = pinIdx[i+1] - pinIdx[i];
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        FATAL_ERROR("Error returned from Get_HG_Size_CS");
+      }
+      if ((format != ZOLTAN_COMPRESSED_EDGE)&&(format != ZOLTAN_COMPRESSED_VERTEX)){
+        FATAL_ERROR("Invalid compression format returned in Get_HG_Size_CS");
+      }
+
+      msg_tag--;
+      ierr = phg_stream_edge_sizes(zz, format, nLists, nListPins, pageSize, &msg_tag,
+                                   &nRequests, &global_ids, &recvIdBuf,
+                                   &fromStart, &fromSeq);
+
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
     }
+    else{
 
-    ZOLTAN_FREE(&pinIdx);
+      ierr = Zoltan_Hypergraph_Queries(zz, &myPins.nHedges,
+                   &myPins.numPins, &myPins.edgeGID, &pinIdx,
+                   &myPins.pinGID);
 
-    /*
-     * Assign each edge global ID to a process using a hash function.
-     * Let that process gather all the pin information for the edge.
-     * This process will also return that edge in the ZHG structure.
-     */
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-    ierr = phg_map_GIDs_to_processes(zz, myPins.edgeGID, myPins.nHedges,
-               gid_size, &myPins.edgeHash, nProc);
+      if (myPins.nHedges){
+        myPins.esizes = (int *)ZOLTAN_MALLOC(sizeof(int) * myPins.nHedges);
+        if (!myPins.esizes) MEMORY_ERROR;
+      }
 
-    if (ierr != ZOLTAN_OK){
-      goto End;
-    }
+      for (i=0; i<myPins.nHedges; i++){
+        myPins.esizes[i] = pinIdx[i+1] - pinIdx[i];
+      }
 
-    msg_tag--;
-    ierr = Zoltan_Comm_Create(&plan, myPins.nHedges, myPins.edgeHash, comm, msg_tag, &nRequests);
+      ZOLTAN_FREE(&pinIdx);
 
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
+      /*
+       * Assign each edge global ID to a process using a hash function.
+       * Let that process gather all the pin information for the edge.
+       * This process will also return that edge in the ZHG structure.
+       */
 
-    /* send edge size and edge GID together */
+      ierr = phg_map_GIDs_to_processes(zz, myPins.edgeGID, myPins.nHedges,
+                 gid_size, &myPins.edgeHash, nProc);
 
-    cnt = 1 + gid_size;
+      if (ierr != ZOLTAN_OK){
+        goto End;
+      }
 
-    if (nRequests > 0){
-      recvIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * nRequests);
-      if (!recvIdBuf) MEMORY_ERROR;
-    }
-    if (myPins.nHedges > 0){
-      sendIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * myPins.nHedges);
-      if (!sendIdBuf) MEMORY_ERROR;
+      msg_tag--;
+      ierr = Zoltan_Comm_Create(&plan, myPins.nHedges, myPins.edgeHash, comm, msg_tag, &nRequests);
+
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-      for (i=0, j=0, k=0; i < myPins.nHedges; i++, j+= cnt, k += gid_size){
+      /* send edge size and edge GID together */
 
-        sendIdBuf[j] = (ZOLTAN_ID_TYPE)myPins.esizes[i];
-        ZOLTAN_SET_GID(zz, sendIdBuf + j + 1, myPins.edgeGID + k);
+      cnt = 1 + gid_size;
+
+      if (nRequests > 0){
+        recvIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * nRequests);
+        if (!recvIdBuf) MEMORY_ERROR;
       }
-    }
+      if (myPins.nHedges > 0){
+        sendIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * myPins.nHedges);
+        if (!sendIdBuf) MEMORY_ERROR;
 
-    msg_tag--;
-    ierr = Zoltan_Comm_Do(plan, msg_tag, (char *)sendIdBuf, sizeof(ZOLTAN_ID_TYPE) * cnt, (char *)recvIdBuf);
+        for (i=0, j=0, k=0; i < myPins.nHedges; i++, j+= cnt, k += gid_size){
 
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
+          sendIdBuf[j] = (ZOLTAN_ID_TYPE)myPins.esizes[i];
+          ZOLTAN_SET_GID(zz, sendIdBuf + j + 1, myPins.edgeGID + k);
+        }
+      }
 
-    ZOLTAN_FREE(&sendIdBuf);
+      msg_tag--;
+      ierr = Zoltan_Comm_Do(plan, msg_tag, (char *)sendIdBuf, sizeof(ZOLTAN_ID_TYPE) * cnt, (char *)recvIdBuf);
 
-    if (nRequests > 0){
-      global_ids = ZOLTAN_MALLOC_GID_ARRAY(zz, nRequests);
-      gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, nRequests);
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-      if (!global_ids || !gid_buf) MEMORY_ERROR;
+      ZOLTAN_FREE(&sendIdBuf);
+
+      if (nRequests > 0){
+        global_ids = ZOLTAN_MALLOC_GID_ARRAY(zz, nRequests);
+        if (!global_ids) MEMORY_ERROR;
 
-      for (i=0, j=0, k=0; i < nRequests; i++, j+= cnt, k += gid_size){
-        ZOLTAN_SET_GID(zz, global_ids + k, recvIdBuf + j + 1);
-        if (i){
-          recvIdBuf[i] = recvIdBuf[j];  /* edge size */
+        for (i=0, j=0, k=0; i < nRequests; i++, j+= cnt, k += gid_size){
+          ZOLTAN_SET_GID(zz, global_ids + k, recvIdBuf + j + 1);
+          if (i){
+            recvIdBuf[i] = recvIdBuf[j];  /* edge size */
+          }
         }
       }
+    }
+
+    if (nRequests > 0){
+      gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, nRequests);
+      if (!gid_buf) MEMORY_ERROR;
+
       /* need to save a copy of original global_ids array */
       memcpy(gid_buf, global_ids, sizeof(ZOLTAN_ID_TYPE)*nRequests*gid_size);
     }
@@ -462,8 +513,6 @@ phg_GID_lookup       *lookup_myHshVtxs = NULL;
       if (!pinIdx) MEMORY_ERROR;
     }
     if (zhg->nPins){
-      pin_gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, zhg->nPins);
-      if (!pin_gid_buf) MEMORY_ERROR;
       myHshEdges.pinGID = ZOLTAN_MALLOC_GID_ARRAY(zz, zhg->nPins);
       if (!myHshEdges.pinGID) MEMORY_ERROR;
       zhg->pinGNO = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(zhg->nPins * sizeof(ZOLTAN_GNO_TYPE));
@@ -472,23 +521,6 @@ phg_GID_lookup       *lookup_myHshVtxs = NULL;
       if (!zhg->Pin_Procs) MEMORY_ERROR;
     }
 
-    msg_tag--;
-    ierr = Zoltan_Comm_Resize(plan, myPins.esizes, msg_tag, &cnt);
-
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
-
-    msg_tag--;
-    ierr = Zoltan_Comm_Do(plan, msg_tag, (char *)myPins.pinGID, gid_chars, (char *)pin_gid_buf);
-
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
-
-    Zoltan_Comm_Destroy(&plan);
-    phg_free_pins(&myPins);
-
     if (zhg->nHedges > 0){
       pinIdx[0] = 0;
       for (i=1; i < zhg->nHedges; i++){
@@ -496,22 +528,59 @@ phg_GID_lookup       *lookup_myHshVtxs = NULL;
       }
     }
 
-    fromID = pin_gid_buf;
+    if (zz->Get_HG_CS_Page){
 
-    for (i=0; i < nRequests; i++){
+      /* Second pass: the pins go straight to their place in pinGID. */
 
-      j = phg_lookup_GID(lookup_myHshEdges, gid_buf + (i*gid_size));
-      if (j < 0) FATAL_ERROR("Invalid global edge ID received");
+      msg_tag--;
+      ierr = phg_stream_pins(zz, format, nLists, nListPins, pageSize, &msg_tag,
+                             lookup_myHshEdges, nRequests, gid_buf, recvIdBuf,
+                             fromStart, fromSeq, pinIdx, myHshEdges.pinGID);
+
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
+    }
+    else{
+      if (zhg->nPins){
+        pin_gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, zhg->nPins);
+        if (!pin_gid_buf) MEMORY_ERROR;
+      }
+
+      msg_tag--;
+      ierr = Zoltan_Comm_Resize(plan, myPins.esizes, msg_tag, &cnt);
+
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-      toID = myHshEdges.pinGID + (pinIdx[j] * gid_size);
+      msg_tag--;
+      ierr = Zoltan_Comm_Do(plan, msg_tag, (char *)myPins.pinGID, gid_chars, (char *)pin_gid_buf);
 
-      for (k=0;(ZOLTAN_ID_TYPE) k < recvIdBuf[i]; k++){
-        ZOLTAN_SET_GID(zz, toID , fromID);
-        toID += gid_size;
-        fromID += gid_size;
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
       }
 
-      pinIdx[j] += (int)recvIdBuf[i];
+      Zoltan_Comm_Destroy(&plan);
+      phg_free_pins(&myPins);
+
+      fromID = pin_gid_buf;
+
+      for (i=0; i < nRequests; i++){
+
+        j = phg_lookup_GID(lookup_myHshEdges, gid_buf + (i*gid_size));
+        if (j < 0) FATAL_ERROR("Invalid global edge ID received");
+
+        toID = myHshEdges.pinGID + (pinIdx[j] * gid_size);
+
+        for (k=0;(ZOLTAN_ID_TYPE) k < recvIdBuf[i]; k++){
+          ZOLTAN_SET_GID(zz, toID , fromID);
+          toID += gid_size;
+          fromID += gid_size;
+        }
+
+        pinIdx[j] += (int)recvIdBuf[i];
+      }
     }
 
     ZOLTAN_FREE(&recvIdBuf);
@@ -521,68 +590,87 @@ phg_GID_lookup       *lookup_myHshVtxs = NULL;
 
     /* For each edge, get the pin vertex global number and the process that owns the pin. */
 
-    ierr = phg_map_GIDs_to_processes(zz, myHshEdges.pinGID, zhg->nPins, gid_size, &myHshEdges.pinHash, nProc);
+    if (zz->Get_HG_CS_Page){
 
-    if ((ierr!=ZOLTAN_OK) && (ierr!=ZOLTAN_WARN)){
-       goto End;
-    }
+      /* Look the pins up a page at a time as well. */
 
-    msg_tag--;
-    ierr = Zoltan_Comm_Create(&plan, zhg->nPins, myHshEdges.pinHash, comm, msg_tag, &nRequests);
+      msg_tag--;
+      ierr = phg_stream_pin_gnos(zz, pageSize, &msg_tag, zhg->nPins,
+                                 myHshEdges.pinGID, lookup_myHshVtxs, &myHshVtxs,
+                                 zhg->Pin_Procs, zhg->pinGNO);
 
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-    if (nRequests){
-      gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, nRequests);
-      if (!gid_buf) MEMORY_ERROR;
-      sendGnoBuf = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(nRequests * sizeof(ZOLTAN_GNO_TYPE) * 2);
-      if (!sendGnoBuf) MEMORY_ERROR;
+      phg_free_temp_vertices(&myHshVtxs);
+      phg_free_GID_lookup_table(&lookup_myHshVtxs);
+      ZOLTAN_FREE(&myHshEdges.pinGID);
     }
+    else{
+      ierr = phg_map_GIDs_to_processes(zz, myHshEdges.pinGID, zhg->nPins, gid_size, &myHshEdges.pinHash, nProc);
 
-    msg_tag--;
+      if ((ierr!=ZOLTAN_OK) && (ierr!=ZOLTAN_WARN)){
+         goto End;
+      }
 
-    ierr = Zoltan_Comm_Do(plan, msg_tag, (char *)myHshEdges.pinGID, gid_chars, (char *)gid_buf);
+      msg_tag--;
+      ierr = Zoltan_Comm_Create(&plan, zhg->nPins, myHshEdges.pinHash, comm, msg_tag, &nRequests);
 
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-    for (i=0; i<nRequests; i++){
-      j = phg_lookup_GID(lookup_myHshVtxs, gid_buf + ( i * gid_size));
-      if (j < 0) FATAL_ERROR("Unexpected vertex GID received");
+      if (nRequests){
+        gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, nRequests);
+        if (!gid_buf) MEMORY_ERROR;
+        sendGnoBuf = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(nRequests * sizeof(ZOLTAN_GNO_TYPE) * 2);
+        if (!sendGnoBuf) MEMORY_ERROR;
+      }
 
-      sendGnoBuf[2*i] = (ZOLTAN_GNO_TYPE)myHshVtxs.vtxOwner[j];
-      sendGnoBuf[2*i + 1] = myHshVtxs.vtxGNO[j];
-    }
+      msg_tag--;
 
-    ZOLTAN_FREE(&gid_buf);
-    phg_free_temp_vertices(&myHshVtxs);
-    phg_free_GID_lookup_table(&lookup_myHshVtxs);
+      ierr = Zoltan_Comm_Do(plan, msg_tag, (char *)myHshEdges.pinGID, gid_chars, (char *)gid_buf);
 
-    if (zhg->nPins > 0){
-      recvGnoBuf = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(sizeof(ZOLTAN_GNO_TYPE) * 2 * zhg->nPins);
-      if (!recvGnoBuf) MEMORY_ERROR;
-    }
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
 
-    msg_tag--;
-    ierr = Zoltan_Comm_Do_Reverse(plan, msg_tag, (char *)sendGnoBuf, 
-                     sizeof(ZOLTAN_GNO_TYPE) * 2, NULL, (char *)recvGnoBuf);
+      for (i=0; i<nRequests; i++){
+        j = phg_lookup_GID(lookup_myHshVtxs, gid_buf + ( i * gid_size));
+        if (j < 0) FATAL_ERROR("Unexpected vertex GID received");
 
-    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
-      goto End;
-    }
+        sendGnoBuf[2*i] = (ZOLTAN_GNO_TYPE)myHshVtxs.vtxOwner[j];
+        sendGnoBuf[2*i + 1] = myHshVtxs.vtxGNO[j];
+      }
 
-    Zoltan_Comm_Destroy(&plan);
-    ZOLTAN_FREE(&sendGnoBuf);
+      ZOLTAN_FREE(&gid_buf);
+      phg_free_temp_vertices(&myHshVtxs);
+      phg_free_GID_lookup_table(&lookup_myHshVtxs);
 
-    for (i =0; i < zhg->nPins; i++){
-      zhg->Pin_Procs[i] = (int)recvGnoBuf[2*i];
-      zhg->pinGNO[i] = recvGnoBuf[2*i + 1];
-    }
+      if (zhg->nPins > 0){
+        recvGnoBuf = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(sizeof(ZOLTAN_GNO_TYPE) * 2 * zhg->nPins);
+        if (!recvGnoBuf) MEMORY_ERROR;
+      }
 
-    ZOLTAN_FREE(&recvGnoBuf);
+      msg_tag--;
+      ierr = Zoltan_Comm_Do_Reverse(plan, msg_tag, (char *)sendGnoBuf, 
+                       sizeof(ZOLTAN_GNO_TYPE) * 2, NULL, (char *)recvGnoBuf);
+
+      if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+        goto End;
+      }
+
+      Zoltan_Comm_Destroy(&plan);
+      ZOLTAN_FREE(&sendGnoBuf);
+
+      for (i =0; i < zhg->nPins; i++){
+        zhg->Pin_Procs[i] = (int)recvGnoBuf[2*i];
+        zhg->pinGNO[i] = recvGnoBuf[2*i + 1];
+      }
+
+      ZOLTAN_FREE(&recvGnoBuf);
+    }
 
     if (need_pin_weights){
 
@@ -1320,6 +1408,8 @@ End:
   ZOLTAN_FREE(&sendIdBuf);
   ZOLTAN_FREE(&recvIdBuf);
   ZOLTAN_FREE(&pinIdx);
+  ZOLTAN_FREE(&fromStart);
+  ZOLTAN_FREE(&fromSeq);
 
   ZOLTAN_FREE(&gid_weights);
   ZOLTAN_FREE(&calcVwgt);
@@ -1469,7 +1559,7 @@ int *rptr=NULL, *cptr=NULL;
   *row_ptr = NULL;
   *num_lists = *num_pins = 0;
 
-  if (!zz->Get_HG_Size_CS || !zz->Get_HG_CS){
+  if (!zz->Get_HG_Size_CS || (!zz->Get_HG_CS && !zz->Get_HG_CS_Page)){
     ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Hypergraph query functions undefined");
     ZOLTAN_TRACE_EXIT(zz, yo);
     return ZOLTAN_FATAL;
@@ -1505,8 +1595,7 @@ int *rptr=NULL, *cptr=NULL;
         ZOLTAN_TRACE_EXIT(zz, yo);
         return ZOLTAN_FATAL;
       }
-      zz->Get_HG_CS(zz->Get_HG_CS_Data, zz->Num_GID,
-               nl, np, format, vid, cptr, eid, &ierr);
+      Get_All_Pins(zz, nl, np, format, vid, cptr, eid, &ierr);
       cptr[nl] = np;
 
       ZOLTAN_TRACE_DETAIL(zz, yo, "done with Get_HG_CS");
@@ -1536,8 +1625,7 @@ int *rptr=NULL, *cptr=NULL;
         return ZOLTAN_FATAL;
       }
 
-      zz->Get_HG_CS(zz->Get_HG_CS_Data, zz->Num_GID,
-                 nl, np, format, eid, rptr, vid, &ierr);
+      Get_All_Pins(zz, nl, np, format, eid, rptr, vid, &ierr);
 
       ZOLTAN_TRACE_DETAIL(zz, yo, "done with Get_HG_CS");
       rptr[nl] = np;
@@ -1873,6 +1961,679 @@ End:
   return ierr;
 }
 /*****************************************************************************/
+/*
+ * Fill in the whole compressed storage, with Get_HG_CS if the application
+ * defined it and otherwise with as many Get_HG_CS_Page calls as it takes.
+ */
+
+static void Get_All_Pins(ZZ *zz, int nl, int np, int format,
+    ZOLTAN_ID_PTR lists, int *ptr, ZOLTAN_ID_PTR pins, int *ierr)
+{
+static char *yo = "Get_All_Pins";
+int gid_size = zz->Num_GID;
+int first, n, i, done, page_pins;
+
+  if (zz->Get_HG_CS){
+    zz->Get_HG_CS(zz->Get_HG_CS_Data, gid_size, nl, np, format,
+                  lists, ptr, pins, ierr);
+    return;
+  }
+
+  *ierr = ZOLTAN_OK;
+
+  for (first=0, done=0; first < nl; first += n, done += page_pins){
+    n = 0;
+    zz->Get_HG_CS_Page(zz->Get_HG_CS_Page_Data, gid_size, format, first,
+                       nl - first, np - done, &n, lists + first * gid_size,
+                       ptr + first, pins + done * gid_size, ierr);
+
+    if ((*ierr != ZOLTAN_OK) && (*ierr != ZOLTAN_WARN)) return;
+
+    if ((n < 1) || (n > nl - first) || (ptr[first + n] > np - done)){
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+        "Get_HG_CS_Page pages do not match Get_HG_Size_CS");
+      *ierr = ZOLTAN_FATAL;
+      return;
+    }
+
+    page_pins = ptr[first + n];   /* overwritten by the next page */
+    for (i=first; i < first + n; i++){
+      ptr[i] += done;
+    }
+  }
+}
+/*****************************************************************************/
+/*
+ * The pins were registered with Zoltan_Set_HG_CSR: a page is a run of
+ * whole hyperedges whose pins fit in page_size (or a single larger 
+ * hyperedge), read in place from the application's arrays.  Only the
+ * edge sizes and hash values are allocated.
+ */
+
+static int phg_get_csr_page(ZZ *zz, int nlists, int page_size,
+                            int *first, int *done, zoltan_pins *page)
+{
+static char *yo = "phg_get_csr_page";
+ZOLTAN_HG_CSR *csr = &(zz->HG_CSR);
+int gid_size = zz->Num_GID;
+int *ptr = csr->Edge_Ptr + *first;
+int nl, i;
+int ierr = ZOLTAN_OK;
+
+  if (nlists != csr->Num_Edges){
+    FATAL_ERROR("Hypergraph arrays changed during partitioning");
+  }
+
+  for (nl=1; *first + nl < nlists; nl++){
+    if (ptr[nl + 1] - ptr[0] > page_size) break;
+  }
+
+  page->esizes = (int *)ZOLTAN_MALLOC(nl * sizeof(int));
+  if (!page->esizes) MEMORY_ERROR;
+
+  for (i=0; i < nl; i++){
+    page->esizes[i] = ptr[i+1] - ptr[i];
+  }
+
+  page->inPlace = 1;
+  page->nHedges = nl;
+  page->numPins = ptr[nl] - ptr[0];
+  page->edgeGID = csr->Edge_GID + *first * gid_size;
+  page->pinGID = csr->Pin_GID + ptr[0] * gid_size;
+
+  *first += nl;
+  *done += page->numPins;
+
+  ierr = phg_map_GIDs_to_processes(zz, page->edgeGID, nl, gid_size,
+                                   &page->edgeHash, zz->Num_Proc);
+
+End:
+  if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+    phg_free_pins(page);
+  }
+
+  return ierr;
+}
+/*****************************************************************************/
+/*
+ * Get the next page of the application's pins with Get_HG_CS_Page, 
+ * starting at list *first (and pin *done), and return it as (partial)
+ * hyperedges along with the process each hyperedge is hashed to.  Pages
+ * supplied in compressed vertex format are converted one page at a time.
+ */
+
+static int phg_get_pin_page(ZZ *zz, int format, int nlists, int npins,
+                            int page_size, int *first, int *done,
+                            zoltan_pins *page)
+{
+static char *yo = "phg_get_pin_page";
+int gid_size = zz->Num_GID;
+int max_lists, max_pins, nl, np, i;
+int ierr = ZOLTAN_OK;
+int *ptr = NULL, *rptr = NULL;
+ZOLTAN_ID_PTR lists = NULL, pins = NULL;
+
+  memset(page, 0, sizeof(zoltan_pins));
+
+  if (Zoltan_HG_CSR_Active(zz)){
+    return phg_get_csr_page(zz, nlists, page_size, first, done, page);
+  }
+
+  max_lists = nlists - *first;
+  if (max_lists > page_size) max_lists = page_size;
+  max_pins = npins - *done;
+  if (max_pins > page_size) max_pins = page_size;
+  if (max_pins < 1) max_pins = 1;
+
+  lists = ZOLTAN_MALLOC_GID_ARRAY(zz, max_lists);
+  ptr = (int *)ZOLTAN_MALLOC((max_lists + 1) * sizeof(int));
+  pins = ZOLTAN_MALLOC_GID_ARRAY(zz, max_pins);
+  if (!lists || !ptr || !pins) MEMORY_ERROR;
+
+  while (1){
+    nl = 0;
+    ptr[0] = ptr[1] = 0;
+    zz->Get_HG_CS_Page(zz->Get_HG_CS_Page_Data, gid_size, format, *first,
+                       max_lists, max_pins, &nl, lists, ptr, pins, &ierr);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      FATAL_ERROR("Error returned from Get_HG_CS_Page");
+    }
+    if (nl > 0) break;
+
+    /* The first list does not fit; the application gave us its size. */
+
+    if (ptr[1] <= max_pins) FATAL_ERROR("Get_HG_CS_Page returned no lists");
+
+    max_pins = ptr[1];
+    ZOLTAN_FREE(&pins);
+    pins = ZOLTAN_MALLOC_GID_ARRAY(zz, max_pins);
+    if (!pins) MEMORY_ERROR;
+  }
+
+  if ((nl > max_lists) || (ptr[nl] > max_pins)){
+    FATAL_ERROR("Get_HG_CS_Page returned more than was asked for");
+  }
+
+  np = ptr[nl];
+  *first += nl;
+  *done += np;
+
+  if ((format == ZOLTAN_COMPRESSED_VERTEX) && (np == 0)){
+    nl = 0;    /* vertices without pins give us no hyperedges */
+  }
+  else if (format == ZOLTAN_COMPRESSED_VERTEX){
+    ierr = Convert_To_CSR(zz, np, ptr, &nl, &lists, &rptr, &pins);
+    if (ierr != ZOLTAN_OK) goto End;
+
+    ZOLTAN_FREE(&ptr);
+    ptr = rptr;
+    rptr = NULL;
+
+    /* lists now holds the pin vertices and pins the edge IDs */
+    page->edgeGID = pins;
+    page->pinGID = lists;
+    pins = lists = NULL;
+  }
+  else{
+    page->edgeGID = lists;
+    page->pinGID = pins;
+    pins = lists = NULL;
+  }
+
+  /* edge sizes, computed in place */
+
+  for (i=0; i < nl; i++){
+    ptr[i] = ptr[i+1] - ptr[i];
+  }
+
+  page->nHedges = nl;
+  page->numPins = np;
+  page->esizes = ptr;
+  ptr = NULL;
+
+  ierr = phg_map_GIDs_to_processes(zz, page->edgeGID, nl, gid_size,
+                                   &page->edgeHash, zz->Num_Proc);
+
+End:
+  Zoltan_Multifree(__FILE__, __LINE__, 4, &lists, &pins, &ptr, &rptr);
+
+  if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+    phg_free_pins(page);
+  }
+
+  return ierr;
+}
+/*****************************************************************************/
+/*
+ * Every process takes part in every round of a paged pin exchange, until
+ * none has pins left.  Returns 1 with the next page (possibly empty) if
+ * there is another round.  On entry *ierr is this process' status from the
+ * previous round; a failure there or in getting the page on any process
+ * ends the exchange on all of them with an error in *ierr.
+ */
+
+static int phg_next_pin_page(ZZ *zz, int format, int nlists, int npins,
+                             int page_size, int *first, int *done,
+                             zoltan_pins *page, int *ierr)
+{
+int flags[2], gflags[2];
+
+  phg_free_pins(page);
+  memset(page, 0, sizeof(zoltan_pins));
+
+  flags[1] = ((*ierr != ZOLTAN_OK) && (*ierr != ZOLTAN_WARN));
+  flags[0] = (!flags[1] && (*first < nlists));
+
+  if (flags[0]){
+    *ierr = phg_get_pin_page(zz, format, nlists, npins, page_size,
+                             first, done, page);
+    flags[1] = ((*ierr != ZOLTAN_OK) && (*ierr != ZOLTAN_WARN));
+  }
+
+  MPI_Allreduce(flags, gflags, 2, MPI_INT, MPI_MAX, zz->Communicator);
+
+  if (gflags[1] && !flags[1]){
+    *ierr = ZOLTAN_FATAL;
+  }
+
+  return (gflags[0] && !gflags[1]);
+}
+/*****************************************************************************/
+/*
+ * First pass over the pin pages: send the global ID and size of each
+ * (partial) hyperedge to the process the ID hashes to.  Returns what was
+ * received, as edge IDs and sizes, in the order the non-paged build
+ * receives them: by sending process, and in the sender's order.  Each
+ * partial edge is tagged with the sender's running count of partial edges,
+ * so the second pass can put its pins in the same place; from_seq holds
+ * these numbers and from_start[p] the first partial edge received from
+ * process p.
+ */
+
+static int phg_stream_edge_sizes(ZZ *zz, int format, int nlists, int npins,
+    int page_size, int *msg_tag, int *nrecv, ZOLTAN_ID_PTR *edge_gids,
+    ZOLTAN_ID_TYPE **edge_sizes, int **from_start, int **from_seq)
+{
+static char *yo = "phg_stream_edge_sizes";
+int gid_size = zz->Num_GID;
+int nProc = zz->Num_Proc;
+int cnt = 3 + gid_size;
+int first = 0, done = 0, nreq, total = 0, space = 0, nsent = 0;
+int i, j, k;
+int ierr = ZOLTAN_OK;
+int *from = NULL, *seq = NULL, *start = NULL, *sorted_seq = NULL;
+zoltan_pins page;
+ZOLTAN_COMM_OBJ *plan = NULL;
+ZOLTAN_ID_TYPE *sendIdBuf = NULL, *recvIdBuf = NULL, *sizes = NULL;
+ZOLTAN_ID_TYPE *sorted_sizes = NULL;
+ZOLTAN_ID_PTR gids = NULL, sorted_gids = NULL;
+
+  memset(&page, 0, sizeof(zoltan_pins));
+
+  *nrecv = 0;
+  *edge_gids = NULL;
+  *edge_sizes = NULL;
+  *from_start = NULL;
+  *from_seq = NULL;
+
+  while (phg_next_pin_page(zz, format, nlists, npins, page_size, &first, &done,
+                           &page, &ierr)){
+
+    ierr = Zoltan_Comm_Create(&plan, page.nHedges, page.edgeHash, 
+                              zz->Communicator, *msg_tag, &nreq);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    if (total + nreq > space){
+      space = 2 * (total + nreq);
+      gids = (ZOLTAN_ID_PTR)ZOLTAN_REALLOC(gids, 
+                             space * gid_size * sizeof(ZOLTAN_ID_TYPE));
+      sizes = (ZOLTAN_ID_TYPE *)ZOLTAN_REALLOC(sizes, 
+                             space * sizeof(ZOLTAN_ID_TYPE));
+      from = (int *)ZOLTAN_REALLOC(from, space * sizeof(int));
+      seq = (int *)ZOLTAN_REALLOC(seq, space * sizeof(int));
+      if (!gids || !sizes || !from || !seq) MEMORY_ERROR;
+    }
+
+    if (page.nHedges > 0){
+      sendIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * page.nHedges);
+      if (!sendIdBuf) MEMORY_ERROR;
+
+      for (i=0, j=0; i < page.nHedges; i++, j += cnt){
+        sendIdBuf[j] = (ZOLTAN_ID_TYPE)page.esizes[i];
+        sendIdBuf[j + 1] = (ZOLTAN_ID_TYPE)zz->Proc;
+        sendIdBuf[j + 2] = (ZOLTAN_ID_TYPE)(nsent + i);
+        ZOLTAN_SET_GID(zz, sendIdBuf + j + 3, page.edgeGID + i * gid_size);
+      }
+      nsent += page.nHedges;
+    }
+    if (nreq > 0){
+      recvIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * nreq);
+      if (!recvIdBuf) MEMORY_ERROR;
+    }
+
+    ierr = Zoltan_Comm_Do(plan, *msg_tag - 1, (char *)sendIdBuf, 
+                          sizeof(ZOLTAN_ID_TYPE) * cnt, (char *)recvIdBuf);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    for (i=0, j=0; i < nreq; i++, j += cnt){
+      sizes[total + i] = recvIdBuf[j];
+      from[total + i] = (int)recvIdBuf[j + 1];
+      seq[total + i] = (int)recvIdBuf[j + 2];
+      ZOLTAN_SET_GID(zz, gids + (total + i) * gid_size, recvIdBuf + j + 3);
+    }
+    total += nreq;
+
+    ZOLTAN_FREE(&sendIdBuf);
+    ZOLTAN_FREE(&recvIdBuf);
+    Zoltan_Comm_Destroy(&plan);
+  }
+
+  if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+    goto End;
+  }
+
+  /* Group by sender.  Each sender's partial edges arrive in its order, so
+     a stable counting sort is enough. */
+
+  start = (int *)ZOLTAN_CALLOC(nProc + 1, sizeof(int));
+  if (!start) MEMORY_ERROR;
+
+  if (total > 0){
+    sorted_gids = ZOLTAN_MALLOC_GID_ARRAY(zz, total);
+    sorted_sizes = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(total * sizeof(ZOLTAN_ID_TYPE));
+    sorted_seq = (int *)ZOLTAN_MALLOC(total * sizeof(int));
+    if (!sorted_gids || !sorted_sizes || !sorted_seq) MEMORY_ERROR;
+  }
+
+  for (i=0; i < total; i++){
+    start[from[i] + 1]++;
+  }
+  for (k=0; k < nProc; k++){
+    start[k + 1] += start[k];
+  }
+  for (i=0; i < total; i++){
+    j = start[from[i]]++;
+    sorted_sizes[j] = sizes[i];
+    sorted_seq[j] = seq[i];
+    ZOLTAN_SET_GID(zz, sorted_gids + j * gid_size, gids + i * gid_size);
+  }
+  for (k=nProc; k > 0; k--){
+    start[k] = start[k - 1];
+  }
+  start[0] = 0;
+
+  *nrecv = total;
+  *edge_gids = sorted_gids;
+  *edge_sizes = sorted_sizes;
+  *from_start = start;
+  *from_seq = sorted_seq;
+  sorted_gids = NULL;
+  sorted_sizes = NULL;
+  start = sorted_seq = NULL;
+
+End:
+  *msg_tag -= 2;
+
+  Zoltan_Comm_Destroy(&plan);
+  phg_free_pins(&page);
+  Zoltan_Multifree(__FILE__, __LINE__, 10, &sendIdBuf, &recvIdBuf, &gids, &sizes,
+                   &from, &seq, &start, &sorted_gids, &sorted_sizes,
+                   &sorted_seq);
+
+  return ierr;
+}
+/*****************************************************************************/
+/*
+ * Second pass over the pin pages: send each page's pins to the processes
+ * that own its hyperedges, which copy them straight into place in pinGID.
+ * The part_* and from_* arrays are what phg_stream_edge_sizes returned;
+ * hyperedge k's pins start at pinIdx[k], and the partial edges fill it in
+ * the order listed there, as in the non-paged build.
+ */
+
+static int phg_stream_pins(ZZ *zz, int format, int nlists, int npins,
+    int page_size, int *msg_tag, phg_GID_lookup *lookup, int nparts,
+    ZOLTAN_ID_PTR part_gids, ZOLTAN_ID_TYPE *part_sizes, int *from_start,
+    int *from_seq, int *pinIdx, ZOLTAN_ID_PTR pinGID)
+{
+static char *yo = "phg_stream_pins";
+int gid_size = zz->Num_GID;
+int gid_chars = zz->Num_GID * sizeof(ZOLTAN_ID_TYPE);
+int cnt = 3 + gid_size;
+int first = 0, done = 0, nreq, nrecv_pins, size, nsent = 0;
+int i, j, k, lo, hi, mid, src, sq, flag, gflag;
+int ierr = ZOLTAN_OK;
+int *pos = NULL;
+zoltan_pins page;
+ZOLTAN_COMM_OBJ *plan = NULL;
+ZOLTAN_ID_TYPE *sendIdBuf = NULL, *recvIdBuf = NULL;
+ZOLTAN_ID_PTR pin_gid_buf = NULL, fromID;
+
+  memset(&page, 0, sizeof(zoltan_pins));
+
+  /* Errors found between rounds are passed to phg_next_pin_page, so that
+     all processes leave the loop together. */
+
+  /* pos[i]: where partial edge i's pins go in pinGID, -1 once received */
+
+  if (nparts > 0){
+    pos = (int *)ZOLTAN_MALLOC(nparts * sizeof(int));
+    if (!pos){
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Memory error.");
+      ierr = ZOLTAN_MEMERR;
+    }
+  }
+
+  for (i=0; pos && i < nparts; i++){
+    k = phg_lookup_GID(lookup, part_gids + i * gid_size);
+    if (k < 0){
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Invalid global edge ID received");
+      ierr = ZOLTAN_FATAL;
+      break;
+    }
+    pos[i] = pinIdx[k];
+    pinIdx[k] += (int)part_sizes[i];
+  }
+
+  while (phg_next_pin_page(zz, format, nlists, npins, page_size, &first, &done,
+                           &page, &ierr)){
+
+    ierr = Zoltan_Comm_Create(&plan, page.nHedges, page.edgeHash, 
+                              zz->Communicator, *msg_tag, &nreq);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    if (page.nHedges > 0){
+      sendIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * page.nHedges);
+      if (!sendIdBuf) MEMORY_ERROR;
+
+      for (i=0, j=0; i < page.nHedges; i++, j += cnt){
+        sendIdBuf[j] = (ZOLTAN_ID_TYPE)page.esizes[i];
+        sendIdBuf[j + 1] = (ZOLTAN_ID_TYPE)zz->Proc;
+        sendIdBuf[j + 2] = (ZOLTAN_ID_TYPE)(nsent + i);
+        ZOLTAN_SET_GID(zz, sendIdBuf + j + 3, page.edgeGID + i * gid_size);
+      }
+      nsent += page.nHedges;
+    }
+    if (nreq > 0){
+      recvIdBuf = (ZOLTAN_ID_TYPE *)ZOLTAN_MALLOC(cnt * sizeof(ZOLTAN_ID_TYPE) * nreq);
+      if (!recvIdBuf) MEMORY_ERROR;
+    }
+
+    ierr = Zoltan_Comm_Do(plan, *msg_tag - 1, (char *)sendIdBuf, 
+                          sizeof(ZOLTAN_ID_TYPE) * cnt, (char *)recvIdBuf);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    ZOLTAN_FREE(&sendIdBuf);
+
+    ierr = Zoltan_Comm_Resize(plan, page.esizes, *msg_tag - 2, &nrecv_pins);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    if (nrecv_pins > 0){
+      pin_gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, nrecv_pins);
+      if (!pin_gid_buf) MEMORY_ERROR;
+    }
+
+    ierr = Zoltan_Comm_Do(plan, *msg_tag - 3, (char *)page.pinGID, gid_chars, 
+                          (char *)pin_gid_buf);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    Zoltan_Comm_Destroy(&plan);
+    phg_free_pins(&page);
+
+    fromID = pin_gid_buf;
+
+    for (i=0, j=0; i < nreq; i++, j += cnt){
+      size = (int)recvIdBuf[j];
+      src = (int)recvIdBuf[j + 1];
+      sq = (int)recvIdBuf[j + 2];
+
+      /* find the partial edge the first pass received from src as sq */
+      k = -1;
+      if ((src >= 0) && (src < zz->Num_Proc)){
+        lo = from_start[src];
+        hi = from_start[src + 1] - 1;
+        while (lo <= hi){
+          mid = (lo + hi) / 2;
+          if (from_seq[mid] == sq) { k = mid; break; }
+          if (from_seq[mid] < sq) lo = mid + 1;
+          else hi = mid - 1;
+        }
+      }
+
+      if ((k < 0) || (pos[k] < 0) || (size != (int)part_sizes[k]) ||
+          !ZOLTAN_EQ_GID(zz, recvIdBuf + j + 3, part_gids + k * gid_size)){
+        ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+          "Get_HG_CS_Page returned different pages on each pass");
+        ierr = ZOLTAN_FATAL;
+        break;
+      }
+
+      memcpy(pinGID + pos[k] * gid_size, fromID, size * gid_chars);
+      fromID += size * gid_size;
+      pos[k] = -1;
+    }
+
+    ZOLTAN_FREE(&recvIdBuf);
+    ZOLTAN_FREE(&pin_gid_buf);
+  }
+
+  if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+    goto End;
+  }
+
+  for (k=0; k < nparts; k++){
+    if (pos[k] >= 0) break;
+  }
+
+  flag = (k < nparts);
+  if (flag){
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+      "Get_HG_CS_Page returned different pages on each pass");
+  }
+  MPI_Allreduce(&flag, &gflag, 1, MPI_INT, MPI_MAX, zz->Communicator);
+  if (gflag){
+    ierr = ZOLTAN_FATAL;
+  }
+
+End:
+  *msg_tag -= 4;
+
+  Zoltan_Comm_Destroy(&plan);
+  phg_free_pins(&page);
+  Zoltan_Multifree(__FILE__, __LINE__, 4, &sendIdBuf, &recvIdBuf, &pin_gid_buf, &pos);
+
+  return ierr;
+}
+/*****************************************************************************/
+/*
+ * Get the global number of each pin's vertex and the process that owns
+ * it, one page of pins at a time, writing the answers straight into
+ * pinProcs and pinGNO.  A vertex ID that is not found still gets an
+ * answer (-1), and the error ends the loop on all processes at the start
+ * of the next page.
+ */
+
+static int phg_stream_pin_gnos(ZZ *zz, int page_size, int *msg_tag, int npins,
+    ZOLTAN_ID_PTR pinGID, phg_GID_lookup *lookup, zoltan_temp_vertices *vtxs,
+    int *pinProcs, ZOLTAN_GNO_TYPE *pinGNO)
+{
+static char *yo = "phg_stream_pin_gnos";
+int gid_size = zz->Num_GID;
+int gid_chars = zz->Num_GID * sizeof(ZOLTAN_ID_TYPE);
+int first, n, nreq, flags[2], gflags[2];
+int i, j;
+int ierr = ZOLTAN_OK, lerr = ZOLTAN_OK;
+int *procs = NULL;
+ZOLTAN_COMM_OBJ *plan = NULL;
+ZOLTAN_ID_PTR gid_buf = NULL;
+ZOLTAN_GNO_TYPE *sendGnoBuf = NULL, *recvGnoBuf = NULL;
+
+  for (first=0; ; first += n){
+
+    n = npins - first;
+    if (n > page_size) n = page_size;
+
+    flags[0] = (n > 0);
+    flags[1] = (lerr != ZOLTAN_OK);
+    MPI_Allreduce(flags, gflags, 2, MPI_INT, MPI_MAX, zz->Communicator);
+    if (gflags[1]){
+      ierr = (flags[1] ? lerr : ZOLTAN_FATAL);
+      goto End;
+    }
+    if (!gflags[0]) break;
+
+    ierr = phg_map_GIDs_to_processes(zz, pinGID + first * gid_size, n, gid_size,
+                                     &procs, zz->Num_Proc);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    ierr = Zoltan_Comm_Create(&plan, n, procs, zz->Communicator, *msg_tag, &nreq);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    if (nreq > 0){
+      gid_buf = ZOLTAN_MALLOC_GID_ARRAY(zz, nreq);
+      sendGnoBuf = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(nreq * sizeof(ZOLTAN_GNO_TYPE) * 2);
+      if (!gid_buf || !sendGnoBuf) MEMORY_ERROR;
+    }
+
+    ierr = Zoltan_Comm_Do(plan, *msg_tag - 1, (char *)(pinGID + first * gid_size),
+                          gid_chars, (char *)gid_buf);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    for (i=0; i < nreq; i++){
+      j = phg_lookup_GID(lookup, gid_buf + (i * gid_size));
+      if (j < 0){
+        if (lerr == ZOLTAN_OK){
+          ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Unexpected vertex GID received");
+        }
+        lerr = ZOLTAN_FATAL;
+        sendGnoBuf[2*i] = sendGnoBuf[2*i + 1] = -1;
+        continue;
+      }
+
+      sendGnoBuf[2*i] = (ZOLTAN_GNO_TYPE)vtxs->vtxOwner[j];
+      sendGnoBuf[2*i + 1] = vtxs->vtxGNO[j];
+    }
+
+    ZOLTAN_FREE(&gid_buf);
+
+    if (n > 0){
+      recvGnoBuf = (ZOLTAN_GNO_TYPE *)ZOLTAN_MALLOC(sizeof(ZOLTAN_GNO_TYPE) * 2 * n);
+      if (!recvGnoBuf) MEMORY_ERROR;
+    }
+
+    ierr = Zoltan_Comm_Do_Reverse(plan, *msg_tag - 2, (char *)sendGnoBuf, 
+                     sizeof(ZOLTAN_GNO_TYPE) * 2, NULL, (char *)recvGnoBuf);
+
+    if ((ierr != ZOLTAN_OK) && (ierr != ZOLTAN_WARN)){
+      goto End;
+    }
+
+    for (i=0; i < n; i++){
+      pinProcs[first + i] = (int)recvGnoBuf[2*i];
+      pinGNO[first + i] = recvGnoBuf[2*i + 1];
+    }
+
+    Zoltan_Comm_Destroy(&plan);
+    Zoltan_Multifree(__FILE__, __LINE__, 3, &procs, &sendGnoBuf, &recvGnoBuf);
+  }
+
+End:
+  *msg_tag -= 3;
+
+  Zoltan_Comm_Destroy(&plan);
+  Zoltan_Multifree(__FILE__, __LINE__, 4, &procs, &gid_buf, &sendGnoBuf, &recvGnoBuf);
+
+  return ierr;
+}
+/*****************************************************************************/
 
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
@@ -67,8 +67,6 @@ extern "C" {
 #define _DEBUG1
 #endif
 
-#define BITSET(data, elem)       ((data)[(elem) >> 5] |=( 1 << ((elem) & 31)))
-#define BITCHECK(data, elem)     ((data)[(elem) >> 5] & (1 << ((elem) & 31)))
     
 
 static unsigned int hashValue(HGraph *hg, int n, int *ar)
@@ -115,11 +113,10 @@ int Zoltan_PHG_Coarsening
   int   ierr=ZOLTAN_OK, i, j, count, size, me=hgc->myProc_x, idx, ni;
   int   *vmark=NULL, *listlno=NULL, *listproc=NULL, *ip=NULL;
   int   *ahindex=NULL, *hlsize=NULL, *hsize=NULL, *ids=NULL, *iden;
-  int   *emptynets=NULL, emptynetsize, *idennets=NULL, *allemptynets=NULL, *allidennets=NULL,
+  int   *idennets=NULL;
 #ifdef _DEBUG1
-      emptynetcnt, 
+  int   emptynetcnt;
 #endif
-      *idennetdest=NULL, rootRank;
   int   *extmatchsendcnt=NULL, extmatchrecvcnt=0, *extmatchrecvcounts=NULL;
   float *c_ewgt=NULL;
   unsigned int *hash=NULL, *lhash=NULL;
@@ -709,72 +706,39 @@ if (VTX_LNO_TO_GNO(hg, i) == 35 || VTX_LNO_TO_GNO(hg, i) == 65 || VTX_LNO_TO_GNO
   t_iden = -t_cur;
 #endif
 
-  emptynetsize = (size >> 5)+1;
-  emptynets = (int*) ZOLTAN_CALLOC(emptynetsize, sizeof(int));
-  idennets = (int *) ZOLTAN_MALLOC(size*sizeof(int));
-
-  if ((emptynetsize && !emptynets) || (size && !idennets)) MEMORY_ERROR;
-
+  /* Nets with the same global hash and size are candidates; every net is
+     compared against the candidate with the smallest id in its run.  Each
+     proc in the row checks its own slice of the pins, and a net is
+     identical to its candidate only if the slices match on every proc.
+     All procs in a row hold the same nets in the same order here, so they
+     agree on the candidates without any further communication. */
   iden = listproc; /* just better variable name */
+  if (size && !(idennets = (int *) ZOLTAN_MALLOC(size*sizeof(int))))
+      MEMORY_ERROR;
 #ifdef _DEBUG1
   emptynetcnt=0;
 #endif
-  for (j=0; j<size; ++j) {
-      if (hlsize[j])
-          iden[j] = 0;
-      else {
-          iden[j] = -1;
-          BITSET(emptynets, j);
-#ifdef _DEBUG1          
-          ++emptynetcnt;
-#endif
-      }
-  }
-
-  count = idx = 0;
-  for (j=0; j<size; ++j) {
+  count = 0;
+  for (j=0; j<size; j=i) {
       int n1=ids[j];
-      if (!iden[n1]) {
-          int last=1+n1, minv=last;
 
-          for (i = j+1; i<size && lhash[n1] == lhash[ids[i]] && hsize[n1]==hsize[ids[i]]; ++i) {
-              int n2=ids[i];
-              
-              if (!iden[n2] && hlsize[n1]==hlsize[n2]
-                  && !memcmp(&ahvertex[ahindex[n1]], &ahvertex[ahindex[n2]], sizeof(int)*hlsize[n1])) {
-                  iden[n2] = last; /* n2 is potentially identical to n1 */
-                  last = 1+n2;
-                  minv = (last<minv) ? last : minv;
-                  ++count;
-              }                  
-          }
-          /* iden[last] is a link list (in array) now make the
-             all identical nets to point the same net with the smallest id;
-             it will be needed in identicalOperator; we'll zero(clear) the
-             original net (net with the smallest id) after this loop */
-          if (last!=1+n1) {  /* some nets are identical to n1 */
-              idennets[idx++] = -minv; /* we need to first write minv */
-              if (minv!=1+n1)     /* then we write n1 if it is not minv itself */
-                  idennets[idx++] = 1+n1;
-          }
-          while (last!=1+n1) {
-              int prev=iden[last-1];
+      for (i=j+1; i<size && lhash[n1] == lhash[ids[i]] && hsize[n1]==hsize[ids[i]]; ++i)
+          n1 = MIN(n1, ids[i]);
+      for (idx=j; idx<i; ++idx) {
+          int n2=ids[idx];
 
-              if (last!=minv)
-                  idennets[idx++] = last;
-              iden[last-1] = minv;
-              last = prev;
-          }
-          iden[n1] = minv;
+          iden[n2] = 1+n1;
+          idennets[n2] = (hlsize[n1]==hlsize[n2]
+              && !memcmp(&ahvertex[ahindex[n1]], &ahvertex[ahindex[n2]], sizeof(int)*hlsize[n1]));
+#ifdef _DEBUG1
+          if (!hlsize[n2])
+              ++emptynetcnt;
+          else if (n2!=n1 && idennets[n2])
+              ++count;
+#endif
       }
   }
-  
-  for (i=0; i<size; ++i){
-      if (iden[i]==1+i) /* original net; clear iden */
-          iden[i] = 0;
-  }
 
-  
 #ifdef _DEBUG1
   MPI_Barrier(hgc->Communicator);
   t_cur = MPI_Wtime();
@@ -784,96 +748,16 @@ if (VTX_LNO_TO_GNO(hg, i) == 35 || VTX_LNO_TO_GNO(hg, i) == 65 || VTX_LNO_TO_GNO
 #ifndef _DEBUG2
   if (!hgc->myProc)
 #endif
-  uprintf(hgc, "#Loc.Iden= %7d   (Computed= %d)   #Comp.PerNet= %.2lf     ElapT= %.3lf\n", count+emptynetcnt, count, (double) idx / (double) size, MPI_Wtime()-t_all);
+  uprintf(hgc, "#Loc.Iden= %7d   (Computed= %d)     ElapT= %.3lf\n", count+emptynetcnt, count, MPI_Wtime()-t_all);
 #endif
 
-
-  /* a simple message size opt; proc with largest message is root; so it won't sent it */
-  Zoltan_PHG_Find_Root(idx+emptynetsize, hgc->myProc_x, hgc->row_comm, 
-                       &i, &rootRank); 
-  
-  /* communicate empty-nets to row-root */
-  if (hgc->myProc_x == rootRank){ 
-      allemptynets = (int *) ZOLTAN_MALLOC(emptynetsize*hgc->nProc_x*sizeof(int));
-      if ((emptynetsize*hgc->nProc_x > 0) && !allemptynets) MEMORY_ERROR;
-  }
-  MPI_Gather(emptynets, emptynetsize, MPI_INT, allemptynets, emptynetsize, MPI_INT, rootRank, hgc->row_comm);
-
-  /* communicate identical nets to row-root */
-  MPI_Gather(&idx, 1, MPI_INT, msg_size, 1, MPI_INT, rootRank, hgc->row_comm);
-  if (hgc->myProc_x == rootRank) {
-      int recsize = 0;
-      for (i = 0; i < hgc->nProc_x; i++) 
-          recsize += msg_size[i];
-
-      allidennets = (int *) ZOLTAN_MALLOC(recsize*sizeof(int));
-      idennetdest = (int *) ZOLTAN_MALLOC(hgc->nProc_x*sizeof(int));
-
-      if ((recsize && !allidennets) || (hgc->nProc_x && !idennetdest)) MEMORY_ERROR;
-      
-      idennetdest[0] = 0;
-      for (i = 1; i < hgc->nProc_x; i++)
-          idennetdest[i] = idennetdest[i-1] + msg_size[i-1];
-  }  
-  MPI_Gatherv (idennets, idx, MPI_INT, allidennets, msg_size, idennetdest, MPI_INT, rootRank, hgc->row_comm);
-
-  
-  ip = (int *) lhash;
-  if (hgc->myProc_x == rootRank) {
-      for (j=0; j<hgc->nProc_x; ++j) {
-          if (j!=rootRank) {
-              int *enets=allemptynets+j*emptynetsize;
-              int *inets=allidennets+idennetdest[j], rootnet=-1;
-              int *x, *y, *a, *b;
-
-              for (i=0; i<size; ++i) {
-                  ip[i] = BITCHECK(enets, i) ? -1 : 0;
-              }
-
-              for (i=0; i<msg_size[j]; ++i) {
-                  if (inets[i] < 0) 
-                      rootnet = -inets[i];
-                  else 
-                      ip[inets[i]-1] = rootnet;
-              }
-
-              /* merge received identical net info with the local one */
-              /*
-                identical operator:
-                a[i]  b[i]     res[i]
-                -1    -1       -1  : -1 means no edge in that proc; identical to everything :)
-                -1    y        -1==a[y] ? y : 0   --> UVC note that this is same as x < y
-                x     -1       -1==b[x] ? x : 0   --> UVC note that this is same as y < x
-                0     y        0   : 0 means not identical to anyone in this proc; hence not identical anyone in all
-                x     0        0   
-                x     x        x   : they are identical to same net
-                x <   y       x==a[y] ? y : 0
-                x >   y       y==b[x] ? x : 0
-              */
-              
-              x = ip;   y = iden;
-              memcpy(ids, iden, size*sizeof(int));
-              a = ip-1; b=ids-1; /* net ids in the a and b are base-1 numbers */
-              for (i=0; i < size; ++i, ++x, ++y) {
-                  if (*x == -1 && *y == -1)
-                      ; /* no op *y = *y */
-                  else if (*x==0 || *y == 0)
-                      *y = 0;
-                  else if (*x==*y)
-                      ; /* no op */
-                  else if (*x < *y)
-                      *y = (*x==a[*y]) ? *y : 0;
-                  else /* *x > *y */ 
-                      *y = (*y==b[*x]) ? *x : 0;
-              }
-          }
-      }
-      ip = iden;
-  }
-  ZOLTAN_FREE(&ids); 
-  MPI_Bcast(ip, size, MPI_INT, rootRank, hgc->row_comm);
-
-  Zoltan_Multifree(__FILE__, __LINE__, 5, &idennets, &emptynets, &allemptynets, &allidennets, &idennetdest);
+  ip = (int *) lhash;  /* global hashes are not needed anymore */
+  if (size)
+      MPI_Allreduce(idennets, ip, size, MPI_INT, MPI_MIN, hgc->row_comm);
+  for (i=0; i<size; ++i)
+      ip[i] = (ip[i] && iden[i]!=1+i) ? iden[i] : 0;
+  ZOLTAN_FREE(&ids);
+  ZOLTAN_FREE(&idennets);
 #ifdef _DEBUG1  
   MPI_Barrier(hgc->Communicator);
   t_cur = MPI_Wtime();
@@ -1011,11 +895,11 @@ if (VTX_LNO_TO_GNO(hg, i) == 35 || VTX_LNO_TO_GNO(hg, i) == 65 || VTX_LNO_TO_GNO
 #ifdef _DEBUG1
   t_mirror -= MPI_Wtime();
 #endif
-  Zoltan_Multifree (__FILE__, __LINE__, 19,
+  Zoltan_Multifree (__FILE__, __LINE__, 16,
                     &listgno, &listlno, &listproc, &msg_size,
                     &buffer, &rbuffer, &ahindex, &ahvertex, &vmark,
                     &hlsize, &hsize, &lhash, &hash, &c_ewgt,
-                    &idennets, &emptynets, &allemptynets, &allidennets, &idennetdest
+                    &idennets, &ids
                     );
 #ifdef _DEBUG1
 
@@ -1034,6 +918,105 @@ if (VTX_LNO_TO_GNO(hg, i) == 35 || VTX_LNO_TO_GNO(hg, i) == 65 || VTX_LNO_TO_GNO
   return ierr;
 }
 
+
+/* Procedure to group vertices that have identical hyperedge lists (and the
+   same fixed and preferred parts) so that Zoltan_PHG_Coarsening merges each
+   group into a single vertex; it also collapses the identical hyperedges of
+   the result.  Only vertices of the same processor column are grouped.  As
+   for hyperedges in Zoltan_PHG_Coarsening, vertices with the same global
+   hash and degree are candidates; each one is compared with the candidate
+   of smallest lno, every proc of the column checking its own edges. 
+   On return *ngroups is the number of vertices merged into another one,
+   summed over the processor row (the procs of a column find the same
+   groups). */
+int Zoltan_PHG_Match_Identical
+( ZZ     *zz,         /* the Zoltan data structure */
+  HGraph *hg,         /* information about hypergraph, weights, etc. */
+  ZOLTAN_GNO_TYPE *match,  /* output: Matching array */
+  PHGPartParams *hgp,
+  int    *ngroups
+    )
+{
+  char     *yo = "Zoltan_PHG_Match_Identical";
+  PHGComm  *hgc = hg->comm;
+  int   ierr=ZOLTAN_OK, i, j, k, n=hg->nVtx, cnt=0;
+  int   *ids=NULL, *deg=NULL, *gdeg=NULL, *cand=NULL, *same=NULL, *gsame=NULL;
+  unsigned int *lhash=NULL, *ghash=NULL;
+
+  ZOLTAN_TRACE_ENTER(zz, yo);
+
+  if (n && (
+       !(ids   = (int *) ZOLTAN_MALLOC(6 * n * sizeof(int)))
+    || !(lhash = (unsigned int *) ZOLTAN_MALLOC(2 * n * sizeof(unsigned int)))))
+      MEMORY_ERROR;
+  deg = ids + n;  gdeg = deg + n;  cand = gdeg + n;  same = cand + n;
+  gsame = same + n;
+  ghash = lhash + n;
+
+  for (i = 0; i < n; i++) {
+    unsigned int l = 0;
+
+    /* Chris Torek's hash function */
+    for (j = hg->vindex[i]; j < hg->vindex[i+1]; j++) {
+      l *= 33;
+      l += (unsigned int) EDGE_LNO_TO_GNO(hg, hg->vedge[j]);
+    }
+    lhash[i] = l;
+    deg[i] = hg->vindex[i+1] - hg->vindex[i];
+    ids[i] = i;
+  }
+  if (n) {
+    MPI_Allreduce(lhash, ghash, n, MPI_UNSIGNED, MPI_SUM, hgc->col_comm);
+    MPI_Allreduce(deg, gdeg, n, MPI_INT, MPI_SUM, hgc->col_comm);
+  }
+
+  Zoltan_quicksort_pointer_inc_int_int(ids, (int *)ghash, gdeg, 0, n-1);
+
+  for (j = 0; j < n; j = i) {
+    int v1 = ids[j];
+
+    for (i = j+1; i < n && ghash[v1] == ghash[ids[i]] && gdeg[v1] == gdeg[ids[i]]; ++i)
+      v1 = MIN(v1, ids[i]);
+    for (k = j; k < i; ++k) {
+      int v2 = ids[k];
+
+      cand[v2] = v1;
+      same[v2] = (v2 != v1 && gdeg[v1] > 0 && deg[v1] == deg[v2]
+       && (!hg->fixed_part || hg->fixed_part[v1] == hg->fixed_part[v2])
+       && (!hg->pref_part || hg->pref_part[v1] == hg->pref_part[v2])
+       && !memcmp(&hg->vedge[hg->vindex[v1]], &hg->vedge[hg->vindex[v2]],
+                  deg[v1] * sizeof(int)));
+    }
+  }
+  if (n)
+    MPI_Allreduce(same, gsame, n, MPI_INT, MPI_MIN, hgc->col_comm);
+
+  if (hgp->match_array_type == 0) {
+    /* old style: local groups are cycles of lnos */
+    for (i = 0; i < n; i++)
+      match[i] = i;
+    for (i = 0; i < n; i++)
+      if (gsame[i]) {   /* insert i after its candidate */
+        match[i] = match[cand[i]];
+        match[cand[i]] = i;
+        ++cnt;
+      }
+  }
+  else
+    for (i = 0; i < n; i++) {
+      match[i] = VTX_LNO_TO_GNO(hg, gsame[i] ? cand[i] : i);
+      if (gsame[i])
+        ++cnt;
+    }
+
+  MPI_Allreduce(&cnt, ngroups, 1, MPI_INT, MPI_SUM, hgc->row_comm);
+
+ End:
+  Zoltan_Multifree(__FILE__, __LINE__, 2, &ids, &lhash);
+  ZOLTAN_TRACE_EXIT(zz, yo);
+  return ierr;
+}
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
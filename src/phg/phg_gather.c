@@ -299,6 +299,7 @@ int max_nProc_xy = MAX(nProc_x, nProc_y);
      * Don't need a gather across the row; just set pointers appropriately
      * in shg.
      */
+    shg->nPins = col_nPin;
     shg->vindex = col_vindex;
     shg->vedge = col_vedge;
     shg->hindex = col_hindex;
@@ -82,6 +82,9 @@ void Zoltan_HG_HGraph_Init(
   phg->hvertex = NULL;
   phg->vindex  = NULL;
   phg->vedge   = NULL;
+  phg->packed_pins = NULL;
+  phg->packed_size = 0;
+  phg->packed_dir  = 0;
   phg->dist_x  = NULL;
   phg->dist_y  = NULL;
   phg->vmap    = NULL;
@@ -114,6 +117,9 @@ int Zoltan_HG_HGraph_Free(
     ZOLTAN_FREE(&hg->hvertex); 
     ZOLTAN_FREE(&hg->vindex); 
     ZOLTAN_FREE(&hg->vedge); 
+    ZOLTAN_FREE(&hg->packed_pins); 
+    hg->packed_size = 0;
+    hg->packed_dir  = 0;
     ZOLTAN_FREE(&hg->dist_x);
     ZOLTAN_FREE(&hg->dist_y); 
     ZOLTAN_FREE(&hg->vmap); 
@@ -376,6 +382,189 @@ int Zoltan_HG_Create_Mirror (
 }
 
 /*****************************************************************************/
+/* Compressed pin storage for V-cycle levels that are not being worked on.
+ * Only one side of the pin structure is kept: every list length followed by
+ * the zigzag-encoded deltas between consecutive entries of the list, all as
+ * LEB128 varints in a single arena.  The other side is rebuilt by
+ * Zoltan_HG_Mirror, which lists entries in increasing order; so the side we
+ * drop must already be in that order for the round trip to be exact.
+ */
+
+#define ZIGZAG(d)   ((((unsigned int)(d)) << 1) ^ (unsigned int)((d) >> 31))
+#define UNZIGZAG(u) ((int)((u) >> 1) ^ -(int)((u) & 1))
+
+static size_t varint_size(unsigned int u)
+{
+size_t n = 1;
+  while (u >= 0x80) {
+    u >>= 7;
+    n++;
+  }
+  return n;
+}
+
+static unsigned char *varint_put(unsigned char *p, unsigned int u)
+{
+  while (u >= 0x80) {
+    *p++ = (unsigned char) (u | 0x80);
+    u >>= 7;
+  }
+  *p++ = (unsigned char) u;
+  return p;
+}
+
+static const unsigned char *varint_get(const unsigned char *p, unsigned int *u)
+{
+unsigned int val = 0;
+int shift = 0;
+  while (*p & 0x80) {
+    val |= (unsigned int) (*p++ & 0x7f) << shift;
+    shift += 7;
+  }
+  *u = val | ((unsigned int) *p++ << shift);
+  return p;
+}
+
+static int lists_ascending(int n, int *index, int *data)
+{
+int i, j;
+  for (i = 0; i < n; i++)
+    for (j = index[i] + 1; j < index[i+1]; j++)
+      if (data[j] <= data[j-1])
+        return 0;
+  return 1;
+}
+
+static size_t packed_lists_size(int n, int *index, int *data)
+{
+int i, j, prev;
+size_t size = 0;
+  for (i = 0; i < n; i++) {
+    size += varint_size((unsigned int) (index[i+1] - index[i]));
+    for (prev = 0, j = index[i]; j < index[i+1]; prev = data[j++])
+      size += varint_size(ZIGZAG(data[j] - prev));
+  }
+  return size;
+}
+
+static void pack_lists(int n, int *index, int *data, unsigned char *p)
+{
+int i, j, prev;
+  for (i = 0; i < n; i++) {
+    p = varint_put(p, (unsigned int) (index[i+1] - index[i]));
+    for (prev = 0, j = index[i]; j < index[i+1]; prev = data[j++])
+      p = varint_put(p, ZIGZAG(data[j] - prev));
+  }
+}
+
+static void unpack_lists(int n, const unsigned char *p, int *index, int *data)
+{
+int i, j, prev;
+unsigned int u;
+  index[0] = 0;
+  for (i = 0; i < n; i++) {
+    p = varint_get(p, &u);
+    index[i+1] = index[i] + (int) u;
+    for (prev = 0, j = index[i]; j < index[i+1]; j++) {
+      p = varint_get(p, &u);
+      prev = data[j] = prev + UNZIGZAG(u);
+    }
+  }
+}
+
+
+
+/****************************************************************************/
+/* Replace the pin arrays of hg (hindex, hvertex, vindex, vedge) by a single
+ * compressed copy of one side; Zoltan_HG_Unpack_Pins restores all four.
+ * If neither side can be rebuilt exactly from the other, hg is left alone. */
+
+int Zoltan_HG_Pack_Pins(
+  ZZ *zz,
+  HGraph *hg
+)
+{
+  int n, *index, *data;
+  size_t size;
+  char *yo = "Zoltan_HG_Pack_Pins";
+
+  if (hg->packed_pins || !hg->hindex || !hg->vindex
+   || (hg->nPins > 0 && (!hg->hvertex || !hg->vedge)))
+    return ZOLTAN_OK;
+
+  if (lists_ascending(hg->nVtx, hg->vindex, hg->vedge)) {
+    hg->packed_dir = PACKED_EDGES;
+    n = hg->nEdge;
+    index = hg->hindex;
+    data = hg->hvertex;
+  }
+  else if (lists_ascending(hg->nEdge, hg->hindex, hg->hvertex)) {
+    hg->packed_dir = PACKED_VERTICES;
+    n = hg->nVtx;
+    index = hg->vindex;
+    data = hg->vedge;
+  }
+  else
+    return ZOLTAN_OK;
+
+  size = packed_lists_size(n, index, data);
+  if (!(hg->packed_pins = (unsigned char *) ZOLTAN_MALLOC(MAX(size, 1)))) {
+    hg->packed_dir = 0;
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+    return ZOLTAN_MEMERR;
+  }
+  pack_lists(n, index, data, hg->packed_pins);
+  hg->packed_size = size;
+
+  Zoltan_Multifree(__FILE__, __LINE__, 4, &hg->hindex, &hg->hvertex,
+                   &hg->vindex, &hg->vedge);
+  return ZOLTAN_OK;
+}
+
+
+
+/****************************************************************************/
+/* Restore the pin arrays of a hypergraph packed by Zoltan_HG_Pack_Pins. */
+
+int Zoltan_HG_Unpack_Pins(
+  ZZ *zz,
+  HGraph *hg
+)
+{
+  int n, **index, **data;
+  char *yo = "Zoltan_HG_Unpack_Pins";
+
+  if (!hg->packed_pins)
+    return ZOLTAN_OK;
+
+  if (hg->packed_dir == PACKED_EDGES) {
+    n = hg->nEdge;
+    index = &hg->hindex;
+    data = &hg->hvertex;
+  }
+  else {
+    n = hg->nVtx;
+    index = &hg->vindex;
+    data = &hg->vedge;
+  }
+
+  *index = (int *) ZOLTAN_MALLOC((n+1) * sizeof(int));
+  *data = (int *) ZOLTAN_MALLOC(hg->nPins * sizeof(int));
+  if (!*index || (hg->nPins > 0 && !*data)) {
+    Zoltan_Multifree(__FILE__, __LINE__, 2, index, data);
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+    return ZOLTAN_MEMERR;
+  }
+  unpack_lists(n, hg->packed_pins, *index, *data);
+
+  ZOLTAN_FREE(&hg->packed_pins);
+  hg->packed_size = 0;
+  hg->packed_dir = 0;
+
+  return Zoltan_HG_Create_Mirror(zz, hg);
+}
+
+/*****************************************************************************/
 
 
 
@@ -95,6 +95,12 @@ typedef struct {
   int *vindex;      /* length nVtx+1 index into vedge, last is nPins */
   int *vedge;       /* length nPins array containing associated hyperedges */
 
+  /* compressed pins of an inactive V-cycle level; see Zoltan_HG_Pack_Pins */
+  unsigned char *packed_pins; /* varint list lengths and pin deltas, or NULL */
+  size_t packed_size;         /* bytes used by packed_pins */
+  int packed_dir;             /* PACKED_EDGES: hindex/hvertex were packed;
+                                 PACKED_VERTICES: vindex/vedge were packed */
+
   /* UVCUVC: todo vmap, ratio and redl should be removed from HGraph
      and some could go to VCycle struct in RB code */
   int *vmap;        /* used when recursively dividing for p > 2 */
@@ -128,6 +134,9 @@ typedef struct {
   ZOLTAN_GNO_TYPE *dist_y;    /* distribution of hyperedges to processor rows as above */    
 } HGraph;
 
+/* Values of HGraph packed_dir */
+#define PACKED_EDGES    1
+#define PACKED_VERTICES 2
 
 
 /************************************************/
@@ -248,6 +257,8 @@ extern void Zoltan_HG_HGraph_Init (HGraph*);
 extern int Zoltan_HG_HGraph_Free  (HGraph*);
 extern int Zoltan_HG_Create_Mirror(ZZ*, HGraph*);
 extern void Zoltan_HG_Mirror(int, int*, int*, int, int*, int*);
+extern int Zoltan_HG_Pack_Pins(ZZ*, HGraph*);
+extern int Zoltan_HG_Unpack_Pins(ZZ*, HGraph*);
 
 extern int Zoltan_HG_Info         (ZZ*, HGraph*);
 extern int Zoltan_HG_Check        (ZZ*, HGraph*);
@@ -62,6 +62,9 @@ void phg_free_objects(zoltan_objects *zo)
 void phg_free_pins(zoltan_pins *zp)
 {
   if (zp == NULL) return;
+  if (zp->inPlace){
+    zp->edgeGID = zp->pinGID = NULL;
+  }
   ZOLTAN_FREE(&(zp->edgeGID));
   ZOLTAN_FREE(&(zp->esizes));
   ZOLTAN_FREE(&(zp->pinGID));
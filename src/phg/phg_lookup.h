@@ -73,6 +73,8 @@ typedef struct _myPin{      /* Pins returned by hypergraph query functions */
   ZOLTAN_ID_PTR pinGID;     /* global ID of pin vertex */
   int           numPins;    /* sum of esizes array */
   int           *edgeHash;  /* process assigned edgeGID by hash function */
+  int           inPlace;    /* edgeGID and pinGID point into the 
+                               application's arrays; don't free them */
 }zoltan_pins;
 
 typedef struct _myEW{     /* Values returned by edge weight query functions */
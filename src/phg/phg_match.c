@@ -51,6 +51,9 @@ extern "C" {
 #endif
 
 #include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "phg.h"
 #include "g2l_hash.h"
 #include "zz_util_const.h"
@@ -591,16 +594,28 @@ static int pmatching_hybrid_ipm(
 static int communication_by_plan (ZZ* zz, int sendcnt, int* dest, int* size, 
  int scale, char * send, int* reccnt, int* recsize, int* nRec, char ** rec,
  MPI_Comm comm, int tag);
+static int communication_by_plan_post (ZZ* zz, int sendcnt, int* dest,
+ int* size, int scale, char * send, int* reccnt, int* recsize, int* nRec,
+ char ** rec, MPI_Comm comm, int tag, ZOLTAN_COMM_OBJ **plan);
+static int communication_by_plan_wait (ZZ* zz, ZOLTAN_COMM_OBJ **plan,
+ int* size, int scale, char * send, char * rec, int tag);
+
+/* MPI-3 non-blocking collectives let a kstart loop's reduction proceed */
+/* while the next candidates' partial sums are computed (lookahead).   */
+#if defined(MPI_VERSION) && (MPI_VERSION >= 3)
+#define IPM_NONBLOCKING_COLLECTIVES
+#endif
 
 
-/* Actual inner product calculations between candidates (in rec buffer)    */
-/* and local vertices.  Not inlined because ARG is changing for each edge */
-/* in inner loop and also uses hgp->MatchEdgeSizeThreshold */
-#define INNER_PRODUCT1(ARG)\
+/* Actual inner product calculations between a candidate, given by its list */
+/* of local edges, and the local vertices.  Not inlined because ARG is      */
+/* changing for each edge in inner loop; edges with EW <= 0 or larger than  */
+/* hgp->MatchEdgeSizeThreshold are skipped.                                 */
+#define INNER_PRODUCT1(EW, ARG)\
   for (i = 0; i < count; intptr++, i++) {\
-    if (((ARG)>0.0) && (hg->esize[*intptr] < hgp->MatchEdgeSizeThreshold)) {\
+    if (((EW)>0.0) && (hg->esize[*intptr] < hgp->MatchEdgeSizeThreshold)) {\
       for (j = hg->hindex[*intptr]; j < hg->hindex[*intptr + 1]; j++) {\
-        if (cmatch[hg->hvertex[j]] == hg->hvertex[j])  {\
+        if (c->cmatch[hg->hvertex[j]] == hg->hvertex[j])  {\
           if (sums[hg->hvertex[j]] == 0.0)\
             index[m++] = hg->hvertex[j];\
           sums[hg->hvertex[j]] += (ARG);\
@@ -613,30 +628,245 @@ static int communication_by_plan (ZZ* zz, int sendcnt, int* dest, int* size,
   for (i = 0; i < count; intptr++, i++) {\
     if (((ARG)>0.0) && (hg->esize[*intptr]<hgp->MatchEdgeSizeThreshold)) {\
       for (j = hg->hindex[*intptr]; j < hg->hindex[*intptr + 1]; j++) {\
-        int v=lhead[hg->hvertex[j]];\
+        int v=c->lhead[hg->hvertex[j]];\
         if (sums[v] == 0.0)\
-          aux[m++] = v;\
+          index[m++] = v;\
         sums[v] += (ARG);\
       }\
     }\
   }
-  
 
-/* Mostly identical inner product calculation to above for c-ipm variant. Here */
-/* candidates are a subset of local vertices and are not in a separate buffer  */
-#define INNER_PRODUCT2(ARG)\
-   for (i = hg->vindex[candidate_gno]; i < hg->vindex[candidate_gno+1]; i++)  {\
-     edge = hg->vedge[i];\
-     if (((ARG)>0.0) && (hg->esize[edge]<hgp->MatchEdgeSizeThreshold)) {\
-       for (j = hg->hindex[edge]; j < hg->hindex[edge+1]; j++)  {\
-         if (cmatch[hg->hvertex[j]] == hg->hvertex[j])    {\
-           if (sums[hg->hvertex[j]] == 0.0)\
-             index[m++] = hg->hvertex[j];\
-           sums[hg->hvertex[j]] += (ARG);\
-         }\
-       }\
-     }\
-   }  
+
+/* Where the candidates of a kstart loop come from, for the phase 2       */
+/* helpers below which are shared by pmatching_ipm and pmatching_agg_ipm. */
+typedef struct {
+  int cFLAG;                 /* c-ipm: candidates are local vertices */
+  int agg;                   /* agg-ipm: sum up over clusters (lhead) */
+  int *select, *permute;     /* candidate k is permute[select[k]] */
+  char *edgebuf;             /* candidates with their edges (not c-ipm) */
+  intptr_t *gno_locs;        /* offsets of the candidates in edgebuf */
+  ZOLTAN_GNO_TYPE *cmatch;   /* ipm: working copy of match array */
+  int *lhead, *lheadpref;    /* agg-ipm: cluster heads and their parts */
+} IPM_Candidates;
+
+/* Per-thread storage to compute the partial inner products of a block of */
+/* candidates concurrently (PHG_NUM_THREADS > 1). Each thread appends the  */
+/* partial sums of its candidates to its own lists; they are then packed   */
+/* into messages in candidate order, exactly as without threads.  The same */
+/* storage holds the block computed ahead while a kstart loop's messages   */
+/* are in flight (lookahead), with one thread or more.                     */
+#define IPM_THREAD_BLOCK 64   /* candidates per thread in a block */
+
+typedef struct {
+  int nThreads;
+  int cap;                   /* capacity of each thread's lno/psum lists */
+  float *sums;               /* nThreads x nVtx inner product accumulators */
+  int *index;                /* nThreads x nVtx touched vertices */
+  int *lno;                  /* nThreads x cap lnos of partial sums */
+  float *psum;               /* nThreads x cap partial sums */
+  int *used;                 /* length of each thread's lists */
+  int start, end;            /* block [start, end) of candidates computed */
+  int *first, *count, *thread; /* per candidate of the block: its lists'
+                                offset, length (-1 if not computed) and
+                                thread */
+} IPM_Threads;
+
+
+/* Finds candidate k; returns its local edges or NULL if it is missing. */
+static int *ipm_candidate (HGraph *hg, PHGPartParams *hgp, IPM_Candidates *c,
+ int k, ZOLTAN_GNO_TYPE *gno, int *cindex, int *pref, int *count, int *self)
+{
+  ZOLTAN_GNO_TYPE *gnoptr;
+  int *intptr, n = c->permute[c->select[k]];
+
+  if (n == -1)
+    return NULL;               /* don't have this sparse candidate locally */
+
+  if (c->cFLAG)  {             /* here gno is really a local id */
+    *gno    = c->permute[k];
+    *cindex = k;
+    if (hgp->UsePrefPart)
+      *pref = hg->pref_part[*gno];
+    *count = hg->vindex[*gno+1] - hg->vindex[*gno];
+    *self  = (int) *gno;
+    return hg->vedge + hg->vindex[*gno];
+  }
+
+  gnoptr = (ZOLTAN_GNO_TYPE *)(c->edgebuf + c->gno_locs[n]);
+  intptr = (int *)(gnoptr + 1);
+
+  *gno    = *gnoptr;
+  *cindex = *intptr++;                  /* candidate_index of vertex */
+  if (hgp->UsePrefPart)
+    *pref = *intptr++;                  /* pref vertex information */
+  *count  = *intptr++;                  /* count of following hyperedges */
+  *self   = (VTX_TO_PROC_X(hg, *gno) == hg->comm->myProc_x)
+          ? VTX_GNO_TO_LNO(hg, *gno) : -1;
+  return intptr;
+}
+
+
+/* Computes the row's nVtx inner products of a candidate with edges[count]; */
+/* the partial sums exceeding PSUM_THRESHOLD are returned in lno and psum,  */
+/* and sums is left zeroed. lno may be the same array as index.             */
+static int ipm_partial_sums (HGraph *hg, PHGPartParams *hgp, IPM_Candidates *c,
+ int *edges, int count, int self, int pref, float *sums, int *index,
+ int *lno, float *psum)
+{
+  int i, j, m = 0, n, *intptr = edges;
+
+  if (c->agg) {
+    if (hg->ewgt != NULL) 
+      AGG_INNER_PRODUCT1(hg->ewgt[*intptr])
+    else 
+      AGG_INNER_PRODUCT1(1.0)
+  }
+  else if ((hg->ewgt != NULL) && (hgp->vtx_scal == NULL))
+    INNER_PRODUCT1(hg->ewgt[*intptr], hg->ewgt[*intptr])
+  else if ((hg->ewgt == NULL) && (hgp->vtx_scal == NULL))
+    INNER_PRODUCT1(1.0, 1.0)
+  else if ((hg->ewgt != NULL) && (hgp->vtx_scal != NULL))
+    INNER_PRODUCT1(hg->ewgt[*intptr],
+                   hgp->vtx_scal[hg->hvertex[j]] * hg->ewgt[*intptr])
+  else
+    INNER_PRODUCT1(1.0, hgp->vtx_scal[hg->hvertex[j]])
+
+  /* if local vtx, remove self inner product (useless maximum) */
+  if (self >= 0)
+    sums[self] = 0.0;
+
+  n = 0;
+  if (c->agg) {
+    /* if it is partitioning with preferred parts and/or fixed vertices
+       check if matches are OK also eliminate sending value 0.0*/
+    while (n < m)
+      if (sums[index[n]] > PSUM_THRESHOLD
+          && AGG_MATCH_OK(hgp, hg, pref, c->lheadpref[index[n]]))
+        ++n;
+      else {
+        sums[index[n]] = 0.0;
+        index[n] = index[--m];
+      }
+    for (i = 0; i < n; i++) {
+      lno[i] = index[i];
+      psum[i] = sums[lno[i]];
+      sums[lno[i]] = 0.0;
+    }
+  }
+  else
+    /* keep partial sums exceeding PSUM_THRESHOLD, clear the others */
+    for (i = 0; i < m; i++) {
+      j = index[i];
+      if (sums[j] > PSUM_THRESHOLD && MATCH_OK(hgp, hg, hg->pref_part[j], pref)) {
+        lno[n]    = j;
+        psum[n++] = sums[j];
+      }
+      sums[j] = 0.0;
+    }
+  return n;
+}
+
+
+static int ipm_threads_init (ZZ *zz, IPM_Threads *t, int nThreads,
+ int lookahead, int nVtx)
+{
+  size_t nv = (size_t) nThreads * nVtx;
+
+  memset(t, 0, sizeof(IPM_Threads));
+  t->nThreads = nThreads;
+  if (nThreads < 2 && !lookahead)
+    return ZOLTAN_OK;
+
+  t->cap = 2 * nVtx + 1024;
+  t->sums  = (float*) ZOLTAN_CALLOC (nv ? nv : 1, sizeof(float));
+  t->index = (int*)   ZOLTAN_MALLOC ((nv ? nv : 1) * sizeof(int));
+  t->lno   = (int*)   ZOLTAN_MALLOC ((size_t) nThreads * t->cap * sizeof(int));
+  t->psum  = (float*) ZOLTAN_MALLOC ((size_t) nThreads * t->cap * sizeof(float));
+  t->used  = (int*)   ZOLTAN_MALLOC (nThreads * sizeof(int));
+  t->first = (int*)   ZOLTAN_MALLOC (3 * IPM_THREAD_BLOCK * nThreads * sizeof(int));
+  if (!t->sums || !t->index || !t->lno || !t->psum || !t->used || !t->first) {
+    ZOLTAN_PRINT_ERROR (zz->Proc, "ipm_threads_init", "Insufficient memory.");
+    return ZOLTAN_MEMERR;
+  }
+  t->count  = t->first + IPM_THREAD_BLOCK * nThreads;
+  t->thread = t->count + IPM_THREAD_BLOCK * nThreads;
+  return ZOLTAN_OK;
+}
+
+
+static void ipm_threads_free (IPM_Threads *t)
+{
+  Zoltan_Multifree (__FILE__, __LINE__, 6, &t->sums, &t->index, &t->lno,
+   &t->psum, &t->used, &t->first);
+}
+
+
+/* Computes the partial sums of candidates [kstart, kend) concurrently.     */
+/* Candidates whose sums may not fit in their thread's lists are left for  */
+/* the caller (count -1).                                                  */
+static void ipm_threaded_sums (HGraph *hg, PHGPartParams *hgp,
+ IPM_Candidates *c, IPM_Threads *t, int kstart, int kend)
+{
+  int b;
+
+  t->start = kstart;
+  t->end   = kend;
+  for (b = 0; b < t->nThreads; b++)
+    t->used[b] = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(t->nThreads) schedule(dynamic, 4)
+#endif
+  for (b = 0; b < kend - kstart; b++) {
+#ifdef _OPENMP
+    int tid = omp_get_thread_num(), cindex, pref = 0, count, self, bound, i;
+#else
+    int tid = 0, cindex, pref = 0, count, self, bound, i;
+#endif
+    int *edges;
+    size_t off = (size_t) tid * t->cap;
+    ZOLTAN_GNO_TYPE gno;
+
+    t->count[b] = -1;
+    edges = ipm_candidate (hg, hgp, c, kstart + b, &gno, &cindex, &pref,
+                           &count, &self);
+    if (edges == NULL)
+      continue;
+
+    for (bound = i = 0; i < count && bound < hg->nVtx; i++)
+      bound += hg->hindex[edges[i]+1] - hg->hindex[edges[i]];
+    if (t->used[tid] + MIN(bound, hg->nVtx) > t->cap)
+      continue;
+
+    t->thread[b] = tid;
+    t->first[b]  = t->used[tid];
+    t->count[b]  = ipm_partial_sums (hg, hgp, c, edges, count, self, pref,
+                    t->sums + (size_t) tid * hg->nVtx,
+                    t->index + (size_t) tid * hg->nVtx,
+                    t->lno + off + t->used[tid], t->psum + off + t->used[tid]);
+    t->used[tid] += t->count[b];
+  }
+}
+
+
+/* Partial sums of candidate k: computed by a thread if possible, else now. */
+static int ipm_candidate_sums (HGraph *hg, PHGPartParams *hgp,
+ IPM_Candidates *c, IPM_Threads *t, int k, int *edges, int count, int self,
+ int pref, float *sums, int *index, int *lno, float *psum,
+ int **plno, float **ppsum)
+{
+  int b = k - t->start;
+
+  if (t->cap > 0 && b >= 0 && k < t->end && t->count[b] >= 0) {
+    *plno  = t->lno  + (size_t) t->thread[b] * t->cap + t->first[b];
+    *ppsum = t->psum + (size_t) t->thread[b] * t->cap + t->first[b];
+    return t->count[b];
+  }
+  *plno  = lno;
+  *ppsum = psum;
+  return ipm_partial_sums (hg, hgp, c, edges, count, self, pref, sums, index,
+                           lno, psum);
+}
 
 
 
@@ -688,7 +918,7 @@ static int pmatching_ipm (ZZ *zz,
   ZOLTAN_GNO_TYPE *match,
   PHGPartParams *hgp)
 {
-  int k, kstart, old_kstart, edge;
+  int k, kstart, old_kstart;
   int i, j = 0, n, m, round, vindex;                    /* loop counters  */
   int lno, bestlno, count = 0;                        /* temp variables */
   int nRounds;                /* # of matching rounds to be performed;       */
@@ -734,6 +964,15 @@ static int pmatching_ipm (ZZ *zz,
 
   float f, bestsum;      /* holds current best inner product */
   float *sums = NULL; /* holds candidate's inner products with each local vtx */
+  float *psums = NULL, *ppsum;   /* candidate's partial sums to send */
+  int *plno, self;
+  IPM_Candidates cand;
+  IPM_Threads ipmt;
+  int lookahead;                /* compute sums ahead while messages move */
+  ZOLTAN_COMM_OBJ *plan = NULL;
+#ifdef IPM_NONBLOCKING_COLLECTIVES
+  MPI_Request kreq;
+#endif
   PHGComm *hgc = hg->comm;
   int ierr = ZOLTAN_OK;
   int max_nPins, max_nVtx;       /* Global max # pins/proc and vtx/proc */
@@ -750,6 +989,7 @@ static int pmatching_ipm (ZZ *zz,
   
    
   ZOLTAN_TRACE_ENTER (zz, yo);
+  memset (&ipmt, 0, sizeof(IPM_Threads));
   MACRO_TIMER_START (0, "matching setup", 0);
   zoltan_gno_mpi_type = Zoltan_mpi_gno_type();
   Zoltan_Srand_Sync (Zoltan_Rand(NULL), &(hgc->RNGState_col), hgc->col_comm);
@@ -799,9 +1039,21 @@ static int pmatching_ipm (ZZ *zz,
     if (!(cmatch = (ZOLTAN_GNO_TYPE*)   ZOLTAN_MALLOC (hg->nVtx * sizeof(ZOLTAN_GNO_TYPE)))
      || !(visit  = (int*)   ZOLTAN_MALLOC (hg->nVtx * sizeof(int)))
      || !(aux    = (int*)   ZOLTAN_MALLOC (hg->nVtx * sizeof(int)))     
+     || !(psums  = (float*) ZOLTAN_MALLOC (hg->nVtx * sizeof(float)))
      || !(sums   = (float*) ZOLTAN_CALLOC (hg->nVtx,  sizeof(float))))
         MEMORY_ERROR;
 
+  /* Lookahead only pays when the column exchanges partial sums, and is */
+  /* only exact off the master row, whose cmatch changes in phase 2.     */
+  lookahead = (hgc->nProc_y > 1 && hgc->myProc_y != 0);
+  if ((ierr = ipm_threads_init (zz, &ipmt, hgp->num_threads, lookahead,
+   hg->nVtx)) != ZOLTAN_OK)
+    goto End;
+  cand.cFLAG     = cFLAG;
+  cand.agg       = 0;
+  cand.cmatch    = cmatch;
+  cand.lhead     = cand.lheadpref = NULL;
+
   if (!cFLAG && total_nCandidates && (hgc->myProc_y == 0)) {  /* Master row */
     if (!(master_data=(Triplet*)ZOLTAN_CALLOC(total_nCandidates,sizeof(Triplet)))
      || !(global_best=(Triplet*)ZOLTAN_CALLOC(total_nCandidates,sizeof(Triplet))))
@@ -974,8 +1226,13 @@ static int pmatching_ipm (ZZ *zz,
       
     /* for each candidate vertex, compute all local partial inner products */    
 
+    cand.select   = select;
+    cand.permute  = permute;
+    cand.edgebuf  = edgebuf;
+    cand.gno_locs = gno_locs;
 
     kstart = old_kstart = 0;         /* next candidate (of nTotal) to process */
+    ipmt.start = ipmt.end = 0;       /* sums computed so far are for old candidates */
     while (kstart < total_nCandidates) {
 
       MACRO_TIMER_START (2, "Matching kstart A", 0);
@@ -985,78 +1242,24 @@ static int pmatching_ipm (ZZ *zz,
       sendcnt  = 0;                    /* count of messages in send buffer */
       s = sendbuf;
 
+      if (hgc->myProc_y == 0)
+        ipmt.start = ipmt.end = kstart;   /* cmatch may have changed */
+
       for (k = kstart; k < total_nCandidates; k++)  {
 
-        n = permute[select[k]];
+        if (ipmt.nThreads > 1 && (k >= ipmt.end || k < ipmt.start))
+          ipm_threaded_sums (hg, hgp, &cand, &ipmt, k,
+           MIN (k + IPM_THREAD_BLOCK * ipmt.nThreads, total_nCandidates));
 
-        if (n == -1) 
+        intptr = ipm_candidate (hg, hgp, &cand, k, &candidate_gno,
+                                &candidate_index, &pref, &count, &self);
+        if (intptr == NULL) 
           continue;                /* don't have this sparse candidate locally */
-        
-        if (!cFLAG)  {
-
-          gnoptr = (ZOLTAN_GNO_TYPE *)(edgebuf + gno_locs[n]);
-          intptr = (int *)(gnoptr + 1);
-
-          candidate_gno = *gnoptr;
-
-          candidate_index = *intptr++;          /* candidate_index of vertex */
-          if (hgp->UsePrefPart)          
-              pref = *intptr++;                 /* pref vertex information */          
-          count           = *intptr++;          /* count of following hyperedges */
-
-        }
-        else  {
-          candidate_index = k;
-          candidate_gno   = permute[k];  /* need to use next local vertex */
-
-          if (hgp->UsePrefPart)          
-              pref = hg->pref_part[candidate_gno];          
-        }                          /* here candidate_gno is really a local id */
-
                   
         /* now compute the row's nVtx inner products for kth candidate */
-        m = 0;
-        if (!cFLAG) {
-          if ((hg->ewgt != NULL) && (hgp->vtx_scal == NULL)){
-            INNER_PRODUCT1(hg->ewgt[*intptr])
-
-          }
-          else if ((hg->ewgt == NULL) && (hgp->vtx_scal == NULL)){
-            INNER_PRODUCT1(1.0)
-          }
-          else if ((hg->ewgt != NULL) && (hgp->vtx_scal != NULL)){
-            INNER_PRODUCT1(hgp->vtx_scal[hg->hvertex[j]] * hg->ewgt[*intptr])
-          }
-          else {/* UVC: no need: if ((hg->ewgt == NULL) && (hgp->vtx_scal != NULL)) */
-            INNER_PRODUCT1(hgp->vtx_scal[hg->hvertex[j]])
-          }
-        } else   {                                            /* cFLAG */
-          if      ((hg->ewgt == NULL) && (hgp->vtx_scal == NULL))
-            INNER_PRODUCT2(1.0)
-          else if ((hg->ewgt == NULL) && (hgp->vtx_scal != NULL))
-            INNER_PRODUCT2(hgp->vtx_scal[hg->hvertex[j]])
-          else if ((hg->ewgt != NULL) && (hgp->vtx_scal == NULL))
-            INNER_PRODUCT2(hg->ewgt[edge])
-          else if ((hg->ewgt != NULL) && (hgp->vtx_scal != NULL))
-            INNER_PRODUCT2(hgp->vtx_scal[hg->hvertex[j]] * hg->ewgt[edge])
-        }
-          
-        /* if local vtx, remove self inner product (useless maximum) */
-        if (cFLAG)
-          sums[candidate_gno] = 0.0;     /* since candidate_gno is really lno */
-        else if (VTX_TO_PROC_X(hg, candidate_gno) == hgc->myProc_x)
-          sums[VTX_GNO_TO_LNO(hg, candidate_gno)] = 0.0;
-         
-        /* count partial sums exceeding PSUM_THRESHOLD */   
-        count = 0;
-        for (i = 0; i < m; i++)  {
-          lno = index[i];
-          if (sums[lno] > PSUM_THRESHOLD
-              && MATCH_OK(hgp, hg, hg->pref_part[lno], pref))
-            aux[count++] = lno;      /* save lno for significant partial sum */
-          else
-            sums[lno] = 0.0;         /* clear unwanted entries */  
-        }     
+        /* and keep the partial sums exceeding PSUM_THRESHOLD */
+        count = ipm_candidate_sums (hg, hgp, &cand, &ipmt, k, intptr, count,
+                 self, pref, sums, index, aux, psums, &plno, &ppsum);
         if (count == 0)
           continue;         /* no partial sums to append to message */       
 
@@ -1095,35 +1298,55 @@ static int pmatching_ipm (ZZ *zz,
           *gnoptr++ = candidate_gno;
           *intptr++ = candidate_index;        
           *intptr++ = count;
-          for (i = 0; i < count; i++)  {          
-            *intptr++ = aux[i];                   /* lno of partial sum */
-          }
-          for (i = 0; i < count; i++)  {          
-            *floatptr++ = sums[aux[i]];           /* partial sum */
-            sums[aux[i]] = 0.0;
-          }
+          memcpy (intptr, plno, count * sizeof(int));     /* lno of partial sum */
+          memcpy (floatptr, ppsum, count * sizeof(float));      /* partial sum */
           sendsize       += msgsize;          /* cummulative size of message */
         }
-        else  {           /* psum message doesn't fit into buffer */
-          for (i = 0; i < count; i++)              
-            sums[aux[i]] = 0.0;
+        else              /* psum message doesn't fit into buffer */
           break;   
-        }  
       }                  /* DONE: loop over k */                    
 
       MACRO_TIMER_STOP (2);
       MACRO_TIMER_START (3, "Matching kstart B", 0);
     
-      /* synchronize all rows in this column to next kstart value */
+      /* synchronize all rows in this column to next kstart value, */
+      /* overlapped with setting up the messages below               */
       old_kstart = kstart;
+#ifdef IPM_NONBLOCKING_COLLECTIVES
+      MPI_Iallreduce (&k, &kstart, 1, MPI_INT, MPI_MIN, hgc->col_comm, &kreq);
+#else
       MPI_Allreduce (&k, &kstart, 1, MPI_INT, MPI_MIN, hgc->col_comm);
+#endif
 
       /* Send inner product data in send buffer to appropriate rows */
-      ierr = communication_by_plan (zz, sendcnt, dest, size, 1, sendbuf, &reccnt, 
-       &recsize, &nRec, &recvbuf, hgc->col_comm, IPM_TAG);
+      ierr = communication_by_plan_post (zz, sendcnt, dest, size, 1, sendbuf,
+       &reccnt, &recsize, &nRec, &recvbuf, hgc->col_comm, IPM_TAG, &plan);
 
+#ifdef IPM_NONBLOCKING_COLLECTIVES
+      MPI_Wait (&kreq, MPI_STATUS_IGNORE);
+#endif
       if (ierr != ZOLTAN_OK)
         goto End;
+      MACRO_TIMER_STOP (3);
+
+      /* While the partial sums arrive, compute those of the next kstart */
+      /* loop's first candidates.  Off the master row cmatch is fixed    */
+      /* during phase 2, so the loop picks them up unchanged.            */
+      MACRO_TIMER_START (7, "Matching kstart lookahead", 0);
+      if (lookahead && kstart < total_nCandidates
+       && (kstart < ipmt.start || kstart >= ipmt.end))
+        ipm_threaded_sums (hg, hgp, &cand, &ipmt, kstart,
+         MIN (kstart + IPM_THREAD_BLOCK * ipmt.nThreads, total_nCandidates));
+      MACRO_TIMER_STOP (7);
+
+      MACRO_TIMER_START (8, "Matching kstart wait", 0);
+      ierr = communication_by_plan_wait (zz, &plan, size, 1, sendbuf, recvbuf,
+       IPM_TAG);
+      MACRO_TIMER_STOP (8);
+
+      if (ierr != ZOLTAN_OK)
+        goto End;
+      MACRO_TIMER_START (3, "Matching kstart B", 0);
     
       /* build index into receive buffer pointer for each proc's row of data */
       for (i = 0; i < hgc->nProc_y; i++)
@@ -1426,9 +1649,11 @@ End:
     ZOLTAN_FREE(&master_data);
   }
 
-  Zoltan_Multifree (__FILE__, __LINE__, 15, &cmatch, &visit, &sums, &sendbuf,
+  Zoltan_Multifree (__FILE__, __LINE__, 16, &cmatch, &visit, &sums, &sendbuf,
    &dest, &size, &recvbuf, &index, &aux, &permute, &edgebuf, &select, &rows,
-   &gno_locs, &master_procs);
+   &gno_locs, &master_procs, &psums);
+  Zoltan_Comm_Destroy (&plan);
+  ipm_threads_free (&ipmt);
   ZOLTAN_TRACE_EXIT(zz, yo);
   return ierr;
 }
@@ -1443,10 +1668,30 @@ static int communication_by_plan (ZZ* zz, int sendcnt, int* dest, int* size,
 {
    ZOLTAN_COMM_OBJ *plan = NULL;
    int err;
+
+   err = communication_by_plan_post (zz, sendcnt, dest, size, scale, send,
+          reccnt, recsize, nRec, rec, comm, tag, &plan);
+   if (err != ZOLTAN_OK) {
+     Zoltan_Comm_Destroy (&plan);
+     return err;
+   }
+
+   return communication_by_plan_wait (zz, &plan, size, scale, send, *rec, tag);
+}
+
+
+
+/* First half of communication_by_plan: the messages are sent and the     */
+/* receives posted; the rec buffer must not be touched until the wait.    */
+static int communication_by_plan_post (ZZ* zz, int sendcnt, int* dest,
+ int* size, int scale, char * send, int* reccnt, int* recsize, int* nRec,
+ char ** rec, MPI_Comm comm, int tag, ZOLTAN_COMM_OBJ **plan)
+{
+   int err;
    char *yo = "communication_by_plan";
    
    /* communicate send buffer messages to other row/columns in my comm */  
-   err = Zoltan_Comm_Create (&plan, sendcnt, dest, comm, tag, reccnt);
+   err = Zoltan_Comm_Create (plan, sendcnt, dest, comm, tag, reccnt);
    if (err != ZOLTAN_OK) {
      ZOLTAN_PRINT_ERROR (zz->Proc, yo, "failed to create plan");
      return err;
@@ -1454,7 +1699,7 @@ static int communication_by_plan (ZZ* zz, int sendcnt, int* dest, int* size,
         
    /* resize plan if necessary */
    if (size != NULL) {
-     err = Zoltan_Comm_Resize (plan, size, tag+1, recsize);
+     err = Zoltan_Comm_Resize (*plan, size, tag+1, recsize);
      if (err != ZOLTAN_OK) {
        ZOLTAN_PRINT_ERROR (zz->Proc, yo, "failed to resize plan");
        return err;
@@ -1474,14 +1719,34 @@ static int communication_by_plan (ZZ* zz, int sendcnt, int* dest, int* size,
    }
    
    /* send messages from send buffer to destinations */      
-   err = Zoltan_Comm_Do (plan, tag+2, (char*) send, scale * sizeof(char), (char*) *rec);
+   err = Zoltan_Comm_Do_Post (*plan, tag+2, (char*) send, scale * sizeof(char), *rec);
+   if (err != ZOLTAN_OK)  {
+     ZOLTAN_PRINT_ERROR (zz->Proc, yo, "failed in Comm_Do");
+     return err;
+   }
+   return ZOLTAN_OK;
+}
+
+
+
+/* Second half: waits for the messages, then frees the plan. */
+static int communication_by_plan_wait (ZZ* zz, ZOLTAN_COMM_OBJ **plan,
+ int* size, int scale, char * send, char * rec, int tag)
+{
+   int err;
+   char *yo = "communication_by_plan";
+
+   if (size != NULL)
+     scale = 1;
+
+   err = Zoltan_Comm_Do_Wait (*plan, tag+2, send, scale * sizeof(char), rec);
    if (err != ZOLTAN_OK)  {
      ZOLTAN_PRINT_ERROR (zz->Proc, yo, "failed in Comm_Do");
      return err;
    }
    
    /* free memory associated with the plan */
-   Zoltan_Comm_Destroy (&plan); 
+   Zoltan_Comm_Destroy (plan); 
    return ZOLTAN_OK;
 }
 
@@ -1551,7 +1816,18 @@ static int pmatching_agg_ipm (ZZ *zz,
 
   intptr_t *gno_locs=NULL;
 
+  float *psums = NULL, *ppsum;   /* candidate's partial sums to send */
+  int *plno, self;
+  IPM_Candidates cand;
+  IPM_Threads ipmt;
+  int lookahead;                /* compute sums ahead while messages move */
+  ZOLTAN_COMM_OBJ *plan = NULL;
+#ifdef IPM_NONBLOCKING_COLLECTIVES
+  MPI_Request kreq;
+#endif
+
   ZOLTAN_TRACE_ENTER (zz, yo);
+  memset (&ipmt, 0, sizeof(IPM_Threads));
   MACRO_TIMER_START (0, "matching setup", 0);
   Zoltan_Srand_Sync (Zoltan_Rand(NULL), &(hgc->RNGState_col), hgc->col_comm);
   
@@ -1607,9 +1883,20 @@ static int pmatching_agg_ipm (ZZ *zz,
         || !(cw     = (float*) ZOLTAN_MALLOC (VtxDim * hg->nVtx * sizeof(float)))
         || !(visit  = (int*)   ZOLTAN_MALLOC (hg->nVtx * sizeof(int)))
         || !(aux    = (int*)   ZOLTAN_MALLOC (hg->nVtx * sizeof(int)))     
+        || !(psums  = (float*) ZOLTAN_MALLOC (hg->nVtx * sizeof(float)))
         || !(sums   = (float*) ZOLTAN_CALLOC (hg->nVtx,  sizeof(float))))
       MEMORY_ERROR;
 
+  lookahead = (hgc->nProc_y > 1);   /* see pmatching_ipm */
+  if ((ierr = ipm_threads_init (zz, &ipmt, hgp->num_threads, lookahead,
+   hg->nVtx)) != ZOLTAN_OK)
+    goto End;
+  cand.cFLAG     = 0;
+  cand.agg       = 1;
+  cand.cmatch    = NULL;
+  cand.lhead     = lhead;
+  cand.lheadpref = lheadpref;
+
   if (VtxDim) 
     if (!(tw = (float*) ZOLTAN_MALLOC (VtxDim * sizeof(float)))
         || !(maxw = (float*) ZOLTAN_MALLOC (VtxDim * sizeof(float))))
@@ -1821,7 +2108,13 @@ static int pmatching_agg_ipm (ZZ *zz,
       
     /* for each candidate vertex, compute all local partial inner products */    
 
+    cand.select   = candvisit;
+    cand.permute  = idxptr;
+    cand.edgebuf  = edgebuf;
+    cand.gno_locs = gno_locs;
+
     kstart = old_kstart = 0;         /* next candidate (of nTotal) to process */
+    ipmt.start = ipmt.end = 0;       /* lhead may have changed; recompute sums */
     while (kstart < total_nCandidates) {
       MACRO_TIMER_START (2, "Matching kstart A", 0);
       for (i = 0; i < hgc->nProc_y; i++)
@@ -1832,43 +2125,18 @@ static int pmatching_agg_ipm (ZZ *zz,
 
       for (k = kstart; k < total_nCandidates; k++)  {
 
-        n = idxptr[candvisit[k]];
+        if (ipmt.nThreads > 1 && (k >= ipmt.end || k < ipmt.start))
+          ipm_threaded_sums (hg, hgp, &cand, &ipmt, k,
+           MIN (k + IPM_THREAD_BLOCK * ipmt.nThreads, total_nCandidates));
 
-        if (n == -1) 
+        intptr = ipm_candidate (hg, hgp, &cand, k, &candidate_gno,
+                                &candidate_index, &pref, &count, &self);
+        if (intptr == NULL) 
           continue;                /* don't have this sparse candidate locally */
 
-        gnoptr = (ZOLTAN_GNO_TYPE *)(edgebuf + gno_locs[n]);
-
-        intptr = (int *)(gnoptr + 1);
-
-        candidate_gno   = *gnoptr;          /* gno of candidate vertex */
-        candidate_index = *intptr++;          /* candidate_index of vertex */
-        if (hgp->UsePrefPart)          
-          pref = *intptr++;     /* pref vertex information */          
-    
-        count = *intptr++;      /* intptr points to edge lnos */
-
         /* now compute the row's nVtx inner products for kth candidate */
-        m = 0;
-        if (hg->ewgt != NULL) 
-          AGG_INNER_PRODUCT1(hg->ewgt[*intptr])
-        else 
-          AGG_INNER_PRODUCT1(1.0)
-
-           /* if local vtx, remove self inner product (useless maximum) */
-        if (VTX_TO_PROC_X(hg, candidate_gno) == hgc->myProc_x)
-          sums[VTX_GNO_TO_LNO(hg, candidate_gno)] = 0.0;
-        
-        /* if it is partitioning with preferred parts and/or fixed vertices
-           check if matches are OK also eliminate sending value 0.0*/
-        for (count=0; count<m; ) 
-            if (sums[aux[count]]>PSUM_THRESHOLD
-                && AGG_MATCH_OK(hgp, hg, pref, lheadpref[aux[count]]))
-                ++count;
-            else {
-                sums[aux[count]] = 0.0;
-                aux[count] = aux[--m];
-            }
+        count = ipm_candidate_sums (hg, hgp, &cand, &ipmt, k, intptr, count,
+                 self, pref, sums, aux, aux, psums, &plno, &ppsum);
         if (count == 0)
           continue;         /* no partial sums to append to message */       
 
@@ -1899,15 +2167,10 @@ static int pmatching_agg_ipm (ZZ *zz,
           *gnoptr++ = candidate_gno;
           *intptr++ = candidate_index;        
           *intptr++ = count;
-          for (i = 0; i < count; i++)  {          
-            *intptr++ = aux[i];                          /* lno of partial sum */
-            *floatptr++ = sums[aux[i]];                      /* partial sum */           
-            sums[aux[i]] = 0.0;
-          }          
+          memcpy (intptr, plno, count * sizeof(int));     /* lno of partial sum */
+          memcpy (floatptr, ppsum, count * sizeof(float));      /* partial sum */
         }
         else  {           /* psum message doesn't fit into buffer */
-          for (i = 0; i < count; i++)              
-            sums[aux[i]] = 0.0;
 /*          uprintf(hgc, "WARYNING: psum msg doesn't fit into buffer!!!! sub-phases!!!!!\n"); */
           break;   
         }  
@@ -1916,15 +2179,43 @@ static int pmatching_agg_ipm (ZZ *zz,
       MACRO_TIMER_STOP (2);
       MACRO_TIMER_START (3, "Matching kstart B", 0);
     
-      /* synchronize all rows in this column to next kstart value */
+      /* synchronize all rows in this column to next kstart value, */
+      /* overlapped with setting up the messages below               */
       old_kstart = kstart;
+#ifdef IPM_NONBLOCKING_COLLECTIVES
+      MPI_Iallreduce (&k, &kstart, 1, MPI_INT, MPI_MIN, hgc->col_comm, &kreq);
+#else
       MPI_Allreduce (&k, &kstart, 1, MPI_INT, MPI_MIN, hgc->col_comm);
+#endif
 
       /* Send inner product data in send buffer to appropriate rows */
-      ierr = communication_by_plan (zz, sendcnt, dest, size, 1, sendbuf, &reccnt, 
-                                    &recsize, &nRec, &recvbuf, hgc->col_comm, IPM_TAG);
+      ierr = communication_by_plan_post (zz, sendcnt, dest, size, 1, sendbuf,
+       &reccnt, &recsize, &nRec, &recvbuf, hgc->col_comm, IPM_TAG, &plan);
+
+#ifdef IPM_NONBLOCKING_COLLECTIVES
+      MPI_Wait (&kreq, MPI_STATUS_IGNORE);
+#endif
       if (ierr != ZOLTAN_OK)
         goto End;
+      MACRO_TIMER_STOP (3);
+
+      /* While the partial sums arrive, compute those of the next kstart */
+      /* loop's first candidates; lhead is fixed during phase 2.         */
+      MACRO_TIMER_START (7, "Matching kstart lookahead", 0);
+      if (lookahead && kstart < total_nCandidates
+       && (kstart < ipmt.start || kstart >= ipmt.end))
+        ipm_threaded_sums (hg, hgp, &cand, &ipmt, kstart,
+         MIN (kstart + IPM_THREAD_BLOCK * ipmt.nThreads, total_nCandidates));
+      MACRO_TIMER_STOP (7);
+
+      MACRO_TIMER_START (8, "Matching kstart wait", 0);
+      ierr = communication_by_plan_wait (zz, &plan, size, 1, sendbuf, recvbuf,
+       IPM_TAG);
+      MACRO_TIMER_STOP (8);
+
+      if (ierr != ZOLTAN_OK)
+        goto End;
+      MACRO_TIMER_START (3, "Matching kstart B", 0);
     
       /* build index into receive buffer pointer for each proc's row of data */
       for (i = 0; i < hgc->nProc_y; i++)
@@ -2306,7 +2597,7 @@ static int pmatching_agg_ipm (ZZ *zz,
     
     i = vindex < hg->nVtx;
     MPI_Allreduce(&i, &nRounds, 1, MPI_INT, MPI_SUM, hgc->row_comm);
-    MACRO_TIMER_STOP (5);                       /* end of phase 4 */
+    MACRO_TIMER_STOP (4);                       /* end of phase 4 */
   }                                             /* DONE: loop over rounds */
 
  End:
@@ -2329,6 +2620,9 @@ ZOLTAN_FREE(&lheadpref);
 ZOLTAN_FREE(&visit);
 ZOLTAN_FREE(&visited);
 ZOLTAN_FREE(&sums);
+ZOLTAN_FREE(&psums);
+Zoltan_Comm_Destroy(&plan);
+ipm_threads_free(&ipmt);
 ZOLTAN_FREE(&sendbuf);
 ZOLTAN_FREE(&dest);
 ZOLTAN_FREE(&size);
@@ -60,6 +60,8 @@ static PARAM_VARS PHG_params[] = {
   /* Add parameters here. */
   {"HYPERGRAPH_PACKAGE",              NULL,  "STRING", 0},
     /* Software package: PHG (Zoltan) or Patoh */
+  {"PHG_PRESET",                      NULL,  "STRING", 0},
+    /* Default parameter set: fast, balanced or quality */
   {"PHG_MULTILEVEL",                  NULL,  "INT", 0},
     /* Indicate whether or not to use multilevel method (1/0) */
   {"PHG_CUT_OBJECTIVE",               NULL,  "STRING", 0},
@@ -100,12 +102,22 @@ static PARAM_VARS PHG_params[] = {
     /* Max no. of loops in KL/FM. */
   {"PHG_REFINEMENT_MAX_NEG_MOVE",     NULL,  "INT",    0},    
     /* Max. no. of negative moves allowed before exiting refinement. */
+  {"PHG_FM_GAIN_BUCKETS",             NULL,  "INT",    0},
+    /* 1: use gain buckets instead of heaps in FM if gains are integers. */
   {"PHG_REFINEMENT_QUALITY",          NULL,  "FLOAT",  0},
     /* 1.0 is default; higher (lower) value gives more (less) refinement. */
   {"PHG_USE_TIMERS",                  NULL,  "INT",    0},    
     /* Same as USE_TIMERS. */
   {"USE_TIMERS",                      NULL,  "INT",    0},    
     /* Same as PHG_USE_TIMERS. */
+  {"PHG_NUM_THREADS",                 NULL,  "INT",    0},    
+    /* Threads per process (OpenMP builds only). */
+  {"PHG_COMPACT_LEVELS",              NULL,  "INT",    0},
+    /* Compress pins of inactive V-cycle levels. */
+  {"PHG_COALESCE_IDENTICAL",          NULL,  "INT",    0},
+    /* Merge identical vertices and hyperedges before coarsening. */
+  {"PHG_COARSEPARTITION_TIME",        NULL,  "FLOAT",  0},
+    /* Time budget for coarse partitioning candidates. */
   {"PHG_EDGE_SIZE_THRESHOLD",         NULL,  "FLOAT",  0},
     /* Ignore hyperedges larger than this threshold times nvertex */
     /* If PHG_EDGE_SIZE_THRESHOLD>1, interpret it as absolute value. */
@@ -122,6 +134,8 @@ static PARAM_VARS PHG_params[] = {
   {"PHG_RANDOMIZE_INPUT",             NULL,  "INT",    0},    
     /* Randomizing input often improves load balance within PHG but destroys 
        locality, so may produce lower quality partitions  */
+  {"PHG_QUERY_PAGE_SIZE",             NULL,  "INT",    0},
+    /* Pins per page when pins are queried with Get_HG_CS_Page. */
   {"PHG_PROCESSOR_REDUCTION_LIMIT",   NULL,  "FLOAT",  0},
     /* When to move data to fewer processors. */
   {"PHG_REPART_MULTIPLIER",           NULL,  "FLOAT",  0},
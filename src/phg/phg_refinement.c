@@ -53,6 +53,7 @@ extern "C" {
 #include <float.h>
 #include "phg.h"
 #include "zz_heap.h"
+#include "zz_sort.h"
 #include "zz_const.h"
 
 #define BADBALANCE  2.0
@@ -71,6 +72,7 @@ extern "C" {
     
 static ZOLTAN_PHG_REFINEMENT_FN refine_no;
 static ZOLTAN_PHG_REFINEMENT_FN refine_fm2;
+static ZOLTAN_PHG_REFINEMENT_FN refine_kway;
 
 /****************************************************************************/
 
@@ -79,6 +81,8 @@ ZOLTAN_PHG_REFINEMENT_FN *Zoltan_PHG_Set_Refinement_Fn(char *str)
   
   if      (!strcasecmp(str, "fm"))             return refine_fm2;  
   else if (!strcasecmp(str, "fm2"))            return refine_fm2;  
+  else if (!strcasecmp(str, "kway"))           return refine_kway;
+  else if (!strcasecmp(str, "lp"))             return refine_kway;
   else if (!strcasecmp(str, "no"))             return refine_no;
   else if (!strcasecmp(str, "none"))           return refine_no;
   else                                         return NULL;
@@ -110,6 +114,49 @@ static int refine_no (ZZ *zz,     /* Zoltan data structure */
 
 
 
+/****************************************************************************/
+
+/* If all edge weights are integers, so are the FM gains, and a vertex's
+ * gain is bounded by the total weight of its nets. In that case return
+ * that bound (summed over the procs of comm, whose partial gains are
+ * added up) so the heaps can be gain buckets; otherwise return -1. */
+
+#define MAX_GAIN_BUCKETS(hg) MAX(4*(hg)->nVtx, 1024)
+
+static int fm_gain_bound (HGraph *hg, MPI_Comm comm)
+{
+int    i, j;
+double w, local[2], global[2];
+
+  local[0] = local[1] = 0.0;
+  for (i = 0; i < hg->nVtx; i++) {
+     if (hg->ewgt) {
+        for (w = 0.0, j = hg->vindex[i]; j < hg->vindex[i+1]; j++)
+           w += hg->ewgt[hg->vedge[j]];
+     }
+     else
+        w = (double) (hg->vindex[i+1] - hg->vindex[i]);
+     local[0] = MAX(local[0], w);
+  }
+  if (hg->ewgt)
+     for (i = 0; i < hg->nEdge; i++)
+        if (hg->ewgt[i] != floor(hg->ewgt[i])) {
+           local[1] = 1.0;
+           break;
+        }
+
+  if (comm != MPI_COMM_NULL)
+     MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, comm);
+  else
+     global[0] = local[0], global[1] = local[1];
+
+  if (global[1] > 0.0 || 2.0*global[0]+1.0 > (double) MAX_GAIN_BUCKETS(hg))
+     return -1;
+  return (int) global[0];
+}
+
+
+
 #ifdef USE_SERIAL_REFINEMENT_ON_ONE_PROC
 
 
@@ -200,7 +247,7 @@ int    part_dim = (hg->VtxWeightDim ? hg->VtxWeightDim : 1);
 #endif
 
 double error, best_error;
-int    best_imbalance, imbalance;
+int    best_imbalance, imbalance, maxgain;
 
   if (p != 2) {
      ZOLTAN_PRINT_ERROR(zz->Proc, yo, "p!=2 not allowed for local_fm2.");
@@ -254,9 +301,17 @@ int    best_imbalance, imbalance;
            gain[i] -= (hg->ewgt ? hg->ewgt[edge] : 1.0);
      }
 
-  /* Initialize the heaps and fill them with the gain values */
-  Zoltan_Heap_Init(zz, &heap[0], hg->nVtx);
-  Zoltan_Heap_Init(zz, &heap[1], hg->nVtx);  
+  /* Initialize the heaps (gain buckets if gains are small integers)
+     and fill them with the gain values */
+  maxgain = hgp->fm_gain_buckets ? fm_gain_bound(hg, MPI_COMM_NULL) : -1;
+  if (maxgain >= 0) {
+     Zoltan_Heap_Init_Buckets(zz, &heap[0], hg->nVtx, maxgain);
+     Zoltan_Heap_Init_Buckets(zz, &heap[1], hg->nVtx, maxgain);
+  }
+  else {
+     Zoltan_Heap_Init(zz, &heap[0], hg->nVtx);
+     Zoltan_Heap_Init(zz, &heap[1], hg->nVtx);  
+  }
   for (i = 0; i < hg->nVtx; i++)
       if (!hgp->UseFixedVtx || hg->fixed_part[i]<0) {
 #ifdef HANDLE_ISOLATED_VERTICES          
@@ -562,7 +617,7 @@ static int refine_fm2 (ZZ *zz,
 #endif
 #endif
     PHGComm *hgc=hg->comm;
-    int rootRank;
+    int rootRank, maxgain;
     
     struct phg_timer_indices *timer = Zoltan_PHG_LB_Data_timers(zz);
     int do_timing = (hgp->use_timers > 2);
@@ -570,10 +625,9 @@ static int refine_fm2 (ZZ *zz,
 
     ZOLTAN_TRACE_ENTER(zz, yo);
 
-    if (p != 2) {
-        ZOLTAN_PRINT_ERROR(zz->Proc, yo, "p!=2 not allowed for refine_fm2.");
+    if (p != 2) {  /* direct k-way partitioning */
         ZOLTAN_TRACE_EXIT(zz, yo);
-        return ZOLTAN_FATAL;
+        return refine_kway(zz, hg, p, part_sizes, part, hgp, bal_tol);
     }
 
     /* return only if globally there is no edge or vertex */
@@ -701,14 +755,24 @@ static int refine_fm2 (ZZ *zz,
         lpins[1] = &(lpins[0][hg->nEdge]);
     }
 
+    /* root's gains are sums over the column; use gain buckets if they
+       are integers within a small range */
+    maxgain = hgp->fm_gain_buckets ? fm_gain_bound(hg, hgc->col_comm) : -1;
+
     if (hgc->myProc_y==rootRank) { /* only root needs mark, adj, gain and heaps*/
         if (hg->nVtx &&
             (!(mark     = (int*)   ZOLTAN_CALLOC(hg->nVtx, sizeof(int)))
              || !(adj   = (int*)   ZOLTAN_MALLOC(hg->nVtx * sizeof(int)))   
              || !(gain  = (float*) ZOLTAN_MALLOC(hg->nVtx * sizeof(float)))))
             MEMORY_ERROR;
-        Zoltan_Heap_Init(zz, &heap[0], hg->nVtx);
-        Zoltan_Heap_Init(zz, &heap[1], hg->nVtx);  
+        if (maxgain >= 0) {
+            Zoltan_Heap_Init_Buckets(zz, &heap[0], hg->nVtx, maxgain);
+            Zoltan_Heap_Init_Buckets(zz, &heap[1], hg->nVtx, maxgain);
+        }
+        else {
+            Zoltan_Heap_Init(zz, &heap[0], hg->nVtx);
+            Zoltan_Heap_Init(zz, &heap[1], hg->nVtx);  
+        }
     }
 
     /* Initial calculation of the local pin distribution (sigma in UVC's papers)  */
@@ -1112,6 +1176,498 @@ static int refine_fm2 (ZZ *zz,
 
 
 
+/*****************************************************************************/
+/* Parallel k-way refinement: size-constrained label propagation.
+ * In each pass every vertex picks the neighboring part with the best gain;
+ * the root of each processor column applies the positive-gain moves in
+ * decreasing gain order, as long as they fit in the column's share of the
+ * free capacity of the target part.  Passes alternate between moves to
+ * higher and to lower part numbers so that neighbors do not swap back and
+ * forth.  Vertices of overweight parts may also move with a non-positive
+ * gain.  A pass that increases the overweight or, at equal overweight, the
+ * cut is undone.  No data movement, just relabeling of vertices.           */
+/*****************************************************************************/
+
+/* Computes, for each local net, the global list of parts it touches and the
+ * number of pins in each of them.  Parts and counts of net n are
+ * (*plist)[(*start)[n]..(*start)[n+1]-1] and (*clist)[...].  The lists of a
+ * net are merged across the processor row by the proc owning the net
+ * (n % nProc_x) and then shared with the whole row.  scratch must be an
+ * array of p zeros; it is zero on return.                                   */
+static int kway_net_parts(ZZ *zz, HGraph *hg, int p, Partition part,
+                          int *scratch, int **start, int **plist, int **clist)
+{
+    char    *yo="kway_net_parts";
+    PHGComm *hgc=hg->comm;
+    int     nProc_x=hgc->nProc_x, me=hgc->myProc_x;
+    int     ierr=ZOLTAN_OK, i, j, k, n, cnt, len;
+    int     *lstart=NULL, *lpart=NULL, *lcnt=NULL;
+    int     *sendcnt=NULL, *senddsp=NULL, *recvcnt=NULL, *recvdsp=NULL;
+    int     *sendbuf=NULL, *recvbuf=NULL, *ostart=NULL;
+    int     *obucket=NULL, *gbuf=NULL;
+    int     nowned, nsend, nrecv, nout, ntotal;
+
+    *start = *plist = *clist = NULL;
+
+    /* Local lists, parts in order of first appearance */
+    if (!(lstart = (int*) ZOLTAN_MALLOC((hg->nEdge+1) * sizeof(int)))
+     || (hg->nPins && (!(lpart = (int*) ZOLTAN_MALLOC(hg->nPins * sizeof(int)))
+                    || !(lcnt  = (int*) ZOLTAN_MALLOC(hg->nPins * sizeof(int))))))
+        MEMORY_ERROR;
+    cnt = 0;
+    for (n = 0; n < hg->nEdge; ++n) {
+        lstart[n] = cnt;
+        for (j = hg->hindex[n]; j < hg->hindex[n+1]; ++j) {
+            int b = part[hg->hvertex[j]];
+            if (!scratch[b]++)
+                lpart[cnt++] = b;
+        }
+        for (k = lstart[n]; k < cnt; ++k) {
+            lcnt[k] = scratch[lpart[k]];
+            scratch[lpart[k]] = 0;
+        }
+    }
+    lstart[hg->nEdge] = cnt;
+
+    if (nProc_x == 1) {
+        *start = lstart;
+        *plist = lpart;
+        *clist = lcnt;
+        return ZOLTAN_OK;
+    }
+
+    /* Send each net's local list to its owner as (net, len, part, count...) */
+    if (!(sendcnt = (int*) ZOLTAN_CALLOC(4 * nProc_x, sizeof(int))))
+        MEMORY_ERROR;
+    senddsp = sendcnt + nProc_x;
+    recvcnt = senddsp + nProc_x;
+    recvdsp = recvcnt + nProc_x;
+
+    for (n = 0; n < hg->nEdge; ++n)
+        if (lstart[n+1] > lstart[n])
+            sendcnt[n % nProc_x] += 2 + 2 * (lstart[n+1] - lstart[n]);
+    MPI_Alltoall(sendcnt, 1, MPI_INT, recvcnt, 1, MPI_INT, hgc->row_comm);
+    nsend = nrecv = 0;
+    for (i = 0; i < nProc_x; ++i) {
+        senddsp[i] = nsend;  nsend += sendcnt[i];
+        recvdsp[i] = nrecv;  nrecv += recvcnt[i];
+    }
+    if ((nsend && !(sendbuf = (int*) ZOLTAN_MALLOC(nsend * sizeof(int))))
+     || (nrecv && !(recvbuf = (int*) ZOLTAN_MALLOC(nrecv * sizeof(int)))))
+        MEMORY_ERROR;
+    for (n = 0; n < hg->nEdge; ++n)
+        if ((len = lstart[n+1] - lstart[n]) > 0) {
+            int *s = sendbuf + senddsp[n % nProc_x];
+            *s++ = n;
+            *s++ = len;
+            for (k = lstart[n]; k < lstart[n+1]; ++k) {
+                *s++ = lpart[k];
+                *s++ = lcnt[k];
+            }
+            senddsp[n % nProc_x] += 2 + 2 * len;
+        }
+    for (i = 0; i < nProc_x; ++i)
+        senddsp[i] -= sendcnt[i];
+    MPI_Alltoallv(sendbuf, sendcnt, senddsp, MPI_INT,
+                  recvbuf, recvcnt, recvdsp, MPI_INT, hgc->row_comm);
+    ZOLTAN_FREE(&sendbuf);
+
+    /* Owner merges the lists of its nets (n = me + k*nProc_x) */
+    nowned = (hg->nEdge > me) ? (hg->nEdge - me + nProc_x - 1) / nProc_x : 0;
+    if (!(ostart = (int*) ZOLTAN_CALLOC(nowned+1, sizeof(int)))
+     || (nrecv && !(obucket = (int*) ZOLTAN_MALLOC(nrecv * sizeof(int)))))
+        MEMORY_ERROR;
+    for (i = 0; i < nrecv; i += 2 + 2 * recvbuf[i+1])
+        ostart[recvbuf[i] / nProc_x + 1] += recvbuf[i+1];
+    for (k = 0; k < nowned; ++k)
+        ostart[k+1] += ostart[k];
+    for (i = 0; i < nrecv; i += 2 + 2 * recvbuf[i+1]) {
+        int o = recvbuf[i] / nProc_x;
+        for (j = 0; j < recvbuf[i+1]; ++j) {
+            obucket[2*ostart[o]]   = recvbuf[i+2+2*j];
+            obucket[2*ostart[o]+1] = recvbuf[i+3+2*j];
+            ++ostart[o];
+        }
+    }
+    for (k = nowned; k > 0; --k)
+        ostart[k] = ostart[k-1];
+    ostart[0] = 0;
+    /* merged records (net, len, part, count...) are written over recvbuf */
+    nout = 0;
+    for (k = 0; k < nowned; ++k) {
+        int first = nout;
+        if (ostart[k+1] == ostart[k])
+            continue;
+        recvbuf[nout++] = me + k * nProc_x;
+        recvbuf[nout++] = 0;
+        for (j = ostart[k]; j < ostart[k+1]; ++j) {
+            int b = obucket[2*j];
+            if (!scratch[b])
+                recvbuf[nout + 2 * recvbuf[first+1]++] = b;
+            scratch[b] += obucket[2*j+1];
+        }
+        for (j = 0; j < recvbuf[first+1]; ++j) {
+            recvbuf[nout+1] = scratch[recvbuf[nout]];
+            scratch[recvbuf[nout]] = 0;
+            nout += 2;
+        }
+    }
+
+    /* Share the merged lists with the row */
+    MPI_Allgather(&nout, 1, MPI_INT, recvcnt, 1, MPI_INT, hgc->row_comm);
+    ntotal = 0;
+    for (i = 0; i < nProc_x; ++i) {
+        recvdsp[i] = ntotal;
+        ntotal += recvcnt[i];
+    }
+    if (ntotal && !(gbuf = (int*) ZOLTAN_MALLOC(ntotal * sizeof(int))))
+        MEMORY_ERROR;
+    MPI_Allgatherv(recvbuf, nout, MPI_INT, gbuf, recvcnt, recvdsp, MPI_INT,
+                   hgc->row_comm);
+
+    /* Unpack into the local arrays (reallocated to the global sizes) */
+    for (n = 0; n <= hg->nEdge; ++n)
+        lstart[n] = 0;
+    for (i = 0; i < ntotal; i += 2 + 2 * gbuf[i+1])
+        lstart[gbuf[i]+1] = gbuf[i+1];
+    for (n = 0; n < hg->nEdge; ++n)
+        lstart[n+1] += lstart[n];
+    cnt = lstart[hg->nEdge];
+    ZOLTAN_FREE(&lpart);
+    ZOLTAN_FREE(&lcnt);
+    if (cnt && (!(lpart = (int*) ZOLTAN_MALLOC(cnt * sizeof(int)))
+             || !(lcnt  = (int*) ZOLTAN_MALLOC(cnt * sizeof(int)))))
+        MEMORY_ERROR;
+    for (i = 0; i < ntotal; i += 2 + 2 * gbuf[i+1])
+        for (j = 0, k = lstart[gbuf[i]]; j < gbuf[i+1]; ++j, ++k) {
+            lpart[k] = gbuf[i+2+2*j];
+            lcnt[k]  = gbuf[i+3+2*j];
+        }
+
+    *start = lstart;
+    *plist = lpart;
+    *clist = lcnt;
+    lstart = lpart = lcnt = NULL;
+
+ End:
+    Zoltan_Multifree(__FILE__, __LINE__, 9, &lstart, &lpart, &lcnt, &sendcnt,
+                     &sendbuf, &recvbuf, &ostart, &obucket, &gbuf);
+    return ierr;
+}
+
+
+
+static int refine_kway (ZZ *zz,
+                        HGraph *hg,
+                        int p,
+                        float *part_sizes,
+                        Partition part,
+                        PHGPartParams *hgp,
+                        float bal_tol
+    )
+{
+    char    *yo="refine_kway";
+    PHGComm *hgc=hg->comm;
+    int     ierr=ZOLTAN_OK, i, j, k, v, n, b, passcnt, successivefails=0;
+    int     part_dim = (hg->VtxWeightDim ? hg->VtxWeightDim : 1);
+    int     rootRank, ntrip, maxtrip=0, rtrip, ncand, nmoves, gmoves, roomiest;
+    int     *scratch=NULL, *oldpart=NULL, *moves=NULL, *cand=NULL, *idx=NULL;
+    int     *estart=NULL, *epart=NULL, *ecnt=NULL, *esize=NULL;
+    int     *tv=NULL, *rv=NULL, *vpart=NULL, *vstart=NULL, *rcnt=NULL, *rdsp=NULL;
+    float   *tw=NULL, *rw=NULL, *vw=NULL;
+    double  *lweights=NULL, *weights, *max_weight, *budget;
+    double  *lbase=NULL, *base, *conn=NULL, *gain=NULL;
+    double  total_weight, overweight, cutsize, lcut;
+    double  best_overweight=0.0, best_cutsize=0.0;
+    struct phg_timer_indices *timer = Zoltan_PHG_LB_Data_timers(zz);
+    int     do_timing = (hgp->use_timers > 2);
+
+    ZOLTAN_TRACE_ENTER(zz, yo);
+
+    /* return only if globally there is no edge or vertex */
+    if (p < 2 || !hg->dist_y[hgc->nProc_y] || hg->dist_x[hgc->nProc_x] == 0) {
+        ZOLTAN_TRACE_EXIT(zz, yo);
+        return ZOLTAN_OK;
+    }
+
+    if (do_timing) { 
+        if (timer->rfrefine < 0) 
+            timer->rfrefine = Zoltan_Timer_Init(zz->ZTime, 1, "Ref_P_Total");
+        ZOLTAN_TIMER_START(zz->ZTime, timer->rfrefine, hgc->Communicator);
+    }
+
+    /* the proc with the most pins in the column selects the moves */
+    Zoltan_PHG_Find_Root(hg->nPins, hgc->myProc_y, hgc->col_comm, 
+                         &i, &rootRank);
+
+    if (!(scratch = (int*) ZOLTAN_CALLOC(p, sizeof(int)))
+     || !(lweights = (double*) ZOLTAN_MALLOC(4 * p * sizeof(double)))
+     || !(conn = (double*) ZOLTAN_CALLOC(p, sizeof(double)))
+     || !(rcnt = (int*) ZOLTAN_MALLOC(2 * hgc->nProc_y * sizeof(int)))
+     || !(vstart = (int*) ZOLTAN_MALLOC((hg->nVtx+1) * sizeof(int)))
+     || (hg->nEdge && !(esize = (int*) ZOLTAN_MALLOC(hg->nEdge * sizeof(int))))
+     || (hg->nVtx && (!(oldpart = (int*) ZOLTAN_MALLOC(hg->nVtx * sizeof(int)))
+                   || !(moves = (int*) ZOLTAN_MALLOC(4 * hg->nVtx * sizeof(int)))
+                   || !(idx = (int*) ZOLTAN_MALLOC(hg->nVtx * sizeof(int)))
+                   || !(gain = (double*) ZOLTAN_MALLOC(hg->nVtx * sizeof(double)))
+                   || !(lbase = (double*) ZOLTAN_MALLOC(2 * hg->nVtx * sizeof(double))))))
+        MEMORY_ERROR;
+    weights = lweights + p;
+    max_weight = weights + p;
+    budget = max_weight + p;
+    base = lbase + hg->nVtx;
+    cand = moves + 2 * hg->nVtx;
+    rdsp = rcnt + hgc->nProc_y;
+
+    for (passcnt = 0; ; ++passcnt) {
+        int dir = passcnt % 2;   /* 0: moves to higher parts, 1: to lower */
+
+        /* Global part weights and overweight */
+        for (b = 0; b < p; ++b)
+            lweights[b] = 0.0;
+        for (v = 0; v < hg->nVtx; ++v)
+            lweights[part[v]] += (hg->vwgt ? hg->vwgt[v*hg->VtxWeightDim] : 1.0);
+        MPI_Allreduce(lweights, weights, p, MPI_DOUBLE, MPI_SUM, hgc->row_comm);
+        total_weight = 0.0;
+        for (b = 0; b < p; ++b)
+            total_weight += weights[b];
+        overweight = 0.0;
+        roomiest = 0;
+        for (b = 0; b < p; ++b) {
+            max_weight[b] = total_weight * bal_tol * part_sizes[b*part_dim];
+            if (weights[b] > max_weight[b])
+                overweight += weights[b] - max_weight[b];
+            /* each column may fill its share of the free weight */
+            budget[b] = (max_weight[b] - weights[b]) / hgc->nProc_x;
+            if (budget[b] > budget[roomiest])
+                roomiest = b;
+        }
+
+        /* Global part lists of nets, and the cut */
+        Zoltan_Multifree(__FILE__, __LINE__, 3, &estart, &epart, &ecnt);
+        ierr = kway_net_parts(zz, hg, p, part, scratch, &estart, &epart, &ecnt);
+        if (ierr != ZOLTAN_OK)
+            goto End;
+        lcut = 0.0;
+        for (n = 0; n < hg->nEdge; ++n) {
+            int lambda = estart[n+1] - estart[n];
+            esize[n] = 0;
+            for (k = estart[n]; k < estart[n+1]; ++k)
+                esize[n] += ecnt[k];
+            if (lambda > 1)
+                lcut += (hg->ewgt ? hg->ewgt[n] : 1.0)
+                      * (hgp->connectivity_cut ? lambda-1 : 1);
+        }
+        MPI_Allreduce(&lcut, &cutsize, 1, MPI_DOUBLE, MPI_SUM, hgc->col_comm);
+
+        /* room for the (v, b, weight) triples: at most lambda per pin */
+        for (ntrip = 0, j = 0; j < hg->nPins; ++j) {
+            n = hg->vedge[j];
+            ntrip += estart[n+1] - estart[n];
+        }
+        if (ntrip > maxtrip) {
+            maxtrip = ntrip;
+            Zoltan_Multifree(__FILE__, __LINE__, 2, &tv, &tw);
+            if (!(tv = (int*) ZOLTAN_MALLOC(2 * maxtrip * sizeof(int)))
+             || !(tw = (float*) ZOLTAN_MALLOC(maxtrip * sizeof(float))))
+                MEMORY_ERROR;
+        }
+
+        if (hgp->output_level >= PHG_DEBUG_ALL)
+            printf("%s KWAY Pass %d Cut=%.2f OverW=%.1f\n", uMe(hgc), passcnt,
+                   cutsize, overweight);
+
+        /* Undo the last pass if it made things worse */
+        if (passcnt && (overweight > best_overweight || 
+                        (overweight == best_overweight && cutsize > best_cutsize))) {
+            memcpy(part, oldpart, hg->nVtx * sizeof(int));
+            break;
+        }
+        best_overweight = overweight;
+        best_cutsize = cutsize;
+        if (successivefails >= 2 || passcnt >= hgp->fm_loop_limit)
+            break;
+        memcpy(oldpart, part, hg->nVtx * sizeof(int));
+
+        /* Local gains: gain(v,b) = base[v] + conn(v,b) summed over the
+           column, where conn is sent as (v, b, weight) triples */
+        ntrip = 0;
+        for (v = 0; v < hg->nVtx; ++v) {
+            int a = part[v], first = ntrip;
+            lbase[v] = 0.0;
+            if (hgp->UseFixedVtx && hg->fixed_part[v] >= 0)
+                continue;
+            for (j = hg->vindex[v]; j < hg->vindex[v+1]; ++j) {
+                int   e = hg->vedge[j], cnta = 0;
+                float w = (hg->ewgt ? hg->ewgt[e] : 1.0);
+
+                if (esize[e] < 2)  /* size 1 net; it is never cut */
+                    continue;
+                for (k = estart[e]; k < estart[e+1]; ++k)
+                    if (epart[k] == a)
+                        cnta = ecnt[k];
+                if (hgp->connectivity_cut) {
+                    /* leaving a helps if v is a's last pin; joining b
+                       costs unless b is already there */
+                    lbase[v] += w * ((cnta == 1) - 1);
+                    for (k = estart[e]; k < estart[e+1]; ++k)
+                        if ((b = epart[k]) != a) {
+                            if (!scratch[b]++)
+                                tv[2 * ntrip++ + 1] = b;
+                            conn[b] += w;
+                        }
+                }
+                else if (cnta == esize[e])  /* uncut net becomes cut */
+                    lbase[v] -= w;
+                else if (cnta == 1 && estart[e+1] - estart[e] == 2) {
+                    /* net becomes uncut if v joins the other part */
+                    b = epart[estart[e]] == a ? epart[estart[e]+1] : epart[estart[e]];
+                    if (!scratch[b]++)
+                        tv[2 * ntrip++ + 1] = b;
+                    conn[b] += w;
+                }
+            }
+            for (k = first; k < ntrip; ++k) {
+                b = tv[2*k+1];
+                tv[2*k] = v;
+                tw[k] = conn[b];
+                conn[b] = 0.0;
+                scratch[b] = 0;
+            }
+        }
+
+        /* Column root sums the gains */
+        if (hg->nVtx)
+            MPI_Reduce(lbase, base, hg->nVtx, MPI_DOUBLE, MPI_SUM, rootRank,
+                       hgc->col_comm);
+        MPI_Gather(&ntrip, 1, MPI_INT, rcnt, 1, MPI_INT, rootRank, hgc->col_comm);
+        rtrip = 0;
+        if (hgc->myProc_y == rootRank)
+            for (i = 0; i < hgc->nProc_y; ++i) {
+                rdsp[i] = rtrip;
+                rtrip += rcnt[i];
+            }
+        if (rtrip && (!(rv = (int*) ZOLTAN_MALLOC(3 * rtrip * sizeof(int)))
+                   || !(rw = (float*) ZOLTAN_MALLOC(2 * rtrip * sizeof(float)))))
+            MEMORY_ERROR;
+        MPI_Gatherv(tw, ntrip, MPI_FLOAT, rw, rcnt, rdsp, MPI_FLOAT, rootRank,
+                    hgc->col_comm);
+        if (hgc->myProc_y == rootRank)
+            for (i = 0; i < hgc->nProc_y; ++i) {
+                rcnt[i] *= 2;
+                rdsp[i] *= 2;
+            }
+        MPI_Gatherv(tv, 2*ntrip, MPI_INT, rv, rcnt, rdsp, MPI_INT, rootRank,
+                    hgc->col_comm);
+
+        nmoves = 0;
+        if (hgc->myProc_y == rootRank) {
+            /* bucket the triples by vertex */
+            vpart = rv + 2 * rtrip;
+            vw = rw + rtrip;
+            for (v = 0; v <= hg->nVtx; ++v)
+                vstart[v] = 0;
+            for (i = 0; i < rtrip; ++i)
+                ++vstart[rv[2*i]+1];
+            for (v = 0; v < hg->nVtx; ++v)
+                vstart[v+1] += vstart[v];
+            for (i = 0; i < rtrip; ++i) {
+                k = vstart[rv[2*i]]++;
+                vpart[k] = rv[2*i+1];
+                vw[k] = rw[i];
+            }
+            for (v = hg->nVtx; v > 0; --v)
+                vstart[v] = vstart[v-1];
+            vstart[0] = 0;
+
+            /* best target of each vertex */
+            ncand = 0;
+            for (v = 0; v < hg->nVtx; ++v) {
+                int    a = part[v], best = -1, over = (weights[a] > max_weight[a]);
+                double bestgain = 0.0;
+                double w = (hg->vwgt ? hg->vwgt[v*hg->VtxWeightDim] : 1.0);
+
+                if (hgp->UseFixedVtx && hg->fixed_part[v] >= 0)
+                    continue;
+                for (k = vstart[v]; k < vstart[v+1]; ++k) {
+                    conn[vpart[k]] += vw[k];
+                    scratch[vpart[k]] = 1;
+                }
+                for (k = vstart[v]; k < vstart[v+1]; ++k) {
+                    b = vpart[k];
+                    if (scratch[b]) {
+                        double g = base[v] + conn[b];
+                        if ((over || (dir ? b < a : b > a)) && budget[b] >= w &&
+                            (best < 0 || g > bestgain)) {
+                            best = b;
+                            bestgain = g;
+                        }
+                        scratch[b] = 0;
+                        conn[b] = 0.0;
+                    }
+                }
+                if (over && best < 0 && roomiest != a && budget[roomiest] >= w) {
+                    best = roomiest;
+                    bestgain = base[v];
+                }
+                if (best >= 0 && (over || bestgain > 0.0)) {
+                    cand[2*ncand] = v;
+                    cand[2*ncand+1] = best;
+                    gain[ncand] = bestgain;
+                    idx[ncand] = ncand;
+                    ++ncand;
+                }
+            }
+
+            /* take the candidates by decreasing gain while they fit; moves
+               without gain only while their part is still overweight */
+            Zoltan_quicksort_pointer_dec_double(idx, gain, 0, ncand-1);
+            for (i = 0; i < ncand; ++i) {
+                int    c = idx[i];
+                double w;
+                v = cand[2*c];
+                b = cand[2*c+1];
+                w = (hg->vwgt ? hg->vwgt[v*hg->VtxWeightDim] : 1.0);
+                if (budget[b] < w || (gain[c] <= 0.0 && budget[part[v]] >= 0.0))
+                    continue;
+                budget[b] -= w;
+                budget[part[v]] += w;
+                moves[2*nmoves] = v;
+                moves[2*nmoves+1] = b;
+                ++nmoves;
+            }
+        }
+        Zoltan_Multifree(__FILE__, __LINE__, 2, &rv, &rw);
+
+        /* root bcast moves to column procs */
+        MPI_Bcast(&nmoves, 1, MPI_INT, rootRank, hgc->col_comm);
+        if (nmoves)
+            MPI_Bcast(moves, 2*nmoves, MPI_INT, rootRank, hgc->col_comm);
+        for (i = 0; i < nmoves; ++i)
+            part[moves[2*i]] = moves[2*i+1];
+
+        MPI_Allreduce(&nmoves, &gmoves, 1, MPI_INT, MPI_SUM, hgc->row_comm);
+        if (gmoves)
+            successivefails = 0;
+        else
+            ++successivefails;
+    }
+
+ End:
+    Zoltan_Multifree(__FILE__, __LINE__, 17, &scratch, &oldpart, &moves, &idx,
+                     &estart, &epart, &ecnt, &esize, &tv, &tw, &rv, &rw,
+                     &vstart, &rcnt, &lweights, &lbase, &conn);
+    ZOLTAN_FREE(&gain);
+
+    if (do_timing) 
+        ZOLTAN_TIMER_STOP(zz->ZTime, timer->rfrefine, hgc->Communicator);
+
+    ZOLTAN_TRACE_EXIT(zz, yo);
+    return ierr;
+}
+
+
+
 
 
 #ifdef __cplusplus
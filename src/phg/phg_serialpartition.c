@@ -49,10 +49,14 @@
 extern "C" {
 #endif
 
+#include <float.h>
 #include "zz_sort.h"
 #include "zz_heap.h"
 #include "phg.h"
 #include "zz_const.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
     
 /* If adding a new coarse partitioning fn, add prototype here 
  * AND add entry to CoarsePartitionFns array 
@@ -74,6 +78,12 @@ static int local_coarse_partitioner(ZZ *, HGraph *, int, float *, Partition,
   PHGPartParams *, ZOLTAN_PHG_COARSEPARTITION_FN *);
 
 static int pick_best(ZZ*, PHGPartParams*, PHGComm*, HGraph*, int, int, int*, float*);
+#ifdef _OPENMP
+static int coarse_threads_ok(void);
+#endif
+static int threaded_coarse_starts(ZZ*, HGraph*, int, float*,
+  ZOLTAN_PHG_COARSEPARTITION_FN*, PHGPartParams*, int, int, double, int*,
+  float*);
 
 /****************************************************************************/
 
@@ -146,8 +156,9 @@ HGraph *shg = NULL;            /* Serial hypergraph gathered from phg */
 int *spart = NULL;             /* Partition vectors for shg. */
 int *new_part = NULL;          /* Ptr to new partition vector. */
 float *bestvals = NULL;        /* Best cut values found so far */
-int worst, new_cand;
+int worst, new_cand, nt;
 float bal, cut, worst_cut;
+double t0;
 int fine_timing = (hgp->use_timers > 2);
 struct phg_timer_indices *timer = Zoltan_PHG_LB_Data_timers(zz);
 int local_coarse_part = hgp->LocalCoarsePartition;
@@ -246,6 +257,9 @@ const int num_coarse_iter = 1 + 9/zz->Num_Proc;
       /* Select a coarse partitioner from the array of coarse partitioners */
       CoarsePartition = CoarsePartitionFns[phg->comm->myProc % 
                                            NUM_COARSEPARTITION_FNS];
+      if (numPart > 2 && CoarsePartition == coarse_part_greedy)
+        /* greedy only bisects; use the others for direct k-way */
+        CoarsePartition = CoarsePartitionFns[1 + phg->comm->myProc % 2];
     }
 
 
@@ -315,7 +329,25 @@ const int num_coarse_iter = 1 + 9/zz->Num_Proc;
 
     new_cand = 0;
     new_part = spart;
-
+    t0 = MPI_Wtime();
+
+    /* With threads or PHG_COARSEPARTITION_TIME, each candidate gets its
+       own random number stream, so that the result does not depend on the
+       number of threads. */
+    nt = (hgp->coarse_time > 0.) ? 1 : 0;
+#ifdef _OPENMP
+    if (hgp->num_threads > 1 && coarse_threads_ok())
+      nt = hgp->num_threads;
+#endif
+    if (nt > 0) {
+      /* Return the best candidate as the last one, as the loop does. */
+      ierr = threaded_coarse_starts(zz, shg, numPart, part_sizes,
+               CoarsePartition, hgp, nt, num_coarse_iter, t0,
+               spart+NUM_PART_KEEP*(shg->nVtx), &bestvals[NUM_PART_KEEP]);
+      if (ierr < 0)
+        goto End;
+    }
+    else
     for (i=0; i< num_coarse_iter; i++){
       int savefmlooplimit=hgp->fm_loop_limit;
         
@@ -424,6 +456,150 @@ End:
   return ierr;
 }
 
+/****************************************************************************/
+#ifdef _OPENMP
+/* Threads may only compute coarse partitioning candidates if MPI may be
+ * called from any thread and Zoltan's memory debugging keeps no list of
+ * allocations (DEBUG_MEMORY <= 1); the list is not thread-safe. */
+static int coarse_threads_ok(void)
+{
+int provided;
+
+  MPI_Query_thread(&provided);
+  return (provided == MPI_THREAD_MULTIPLE && Zoltan_Memory_Get_Debug() <= 1);
+}
+#endif
+
+/* Computes the coarse partitioning candidates of Zoltan_PHG_CoarsePartition
+ * on nt threads (nt is 1 without OpenMP) and returns the best one in best
+ * (with its objective in *bestval).  Candidate i uses its own random number
+ * stream and ties go to the lowest i, so for a fixed number of candidates
+ * the result does not depend on the number of threads.  The refinement and
+ * the cut/balance computations call MPI on the serial communicators, so
+ * each thread gets its own duplicate of MPI_COMM_SELF; with nt > 1 this
+ * needs MPI_THREAD_MULTIPLE.
+ */
+static int threaded_coarse_starts(
+  ZZ *zz,
+  HGraph *shg,           /* Input:  serial hypergraph */
+  int numPart,
+  float *part_sizes,
+  ZOLTAN_PHG_COARSEPARTITION_FN *CoarsePartition,
+  PHGPartParams *hgp,
+  int nt,                /* Input:  number of threads */
+  int num_coarse_iter,   /* Input:  minimum number of candidates */
+  double t0,             /* Input:  start time of the time budget */
+  int *best,             /* Output: best partition vector */
+  float *bestval         /* Output: its objective value */
+)
+{
+char *yo = "threaded_coarse_starts";
+int ierr = ZOLTAN_OK;
+int n = shg->nVtx, next = 0, t, bt;
+unsigned int seed = Zoltan_Rand(NULL);
+MPI_Comm *comms = NULL;
+int *parts = NULL, *bestidx = NULL, **bestpart = NULL;
+float *vals = NULL;
+
+  comms = (MPI_Comm *) ZOLTAN_MALLOC(nt * sizeof(MPI_Comm));
+  parts = (int *) ZOLTAN_MALLOC(2 * nt * MAX(n, 1) * sizeof(int));
+  bestidx = (int *) ZOLTAN_MALLOC(nt * sizeof(int));
+  bestpart = (int **) ZOLTAN_MALLOC(nt * sizeof(int *));
+  vals = (float *) ZOLTAN_MALLOC(nt * sizeof(float));
+  if (!comms || !parts || !bestidx || !bestpart || !vals) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Out of memory.");
+    ierr = ZOLTAN_MEMERR;
+    goto End;
+  }
+  for (t = 0; t < nt; t++)
+    MPI_Comm_dup(MPI_COMM_SELF, &comms[t]);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt) private(t)
+#endif
+  {
+    PHGComm tcomm = *shg->comm;
+    HGraph thg = *shg;
+    PHGPartParams thgp = *hgp;
+    unsigned int rng;
+    int i, err, *cand, *tbest;
+    float bal, cut, val;
+
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#else
+    t = 0;
+#endif
+    cand = parts + 2*t*MAX(n, 1);
+    tbest = cand + MAX(n, 1);
+    tcomm.Communicator = tcomm.row_comm = tcomm.col_comm = comms[t];
+    thg.comm = &tcomm;
+    thgp.use_timers = 0;
+    thgp.num_threads = 1;
+    thgp.coarse_rng = &rng;
+    vals[t] = FLT_MAX;
+    bestidx[t] = -1;
+    bestpart[t] = tbest;
+
+    for (;;) {
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+      i = next++;
+      if (i >= num_coarse_iter
+       && (hgp->coarse_time <= 0. || MPI_Wtime() - t0 >= hgp->coarse_time))
+        break;
+
+      rng = seed + 2654435761U * (unsigned int) i;
+      tcomm.RNGState = tcomm.RNGState_row = tcomm.RNGState_col = rng;
+      err = CoarsePartition(zz, &thg, numPart, part_sizes, cand, &thgp);
+      if (err < 0) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        ierr = err;
+        break;
+      }
+
+      /* Refine new candidate: only one pass is enough. */
+      thgp.fm_loop_limit = 1;
+      Zoltan_PHG_Refinement(zz, &thg, numPart, part_sizes, cand, &thgp);
+      thgp.fm_loop_limit = hgp->fm_loop_limit;
+
+      bal = Zoltan_PHG_Compute_Balance(zz, &thg, part_sizes, 0, numPart, cand);
+      cut = Zoltan_PHG_Compute_ConCut(&tcomm, &thg, cand, numPart, &err);
+      val = cut/(MAX(2.-bal, 0.0001));
+      if (bestidx[t] < 0 || val < vals[t]
+       || (val == vals[t] && i < bestidx[t])) {
+        int *tmp = cand;
+        cand = bestpart[t];
+        bestpart[t] = tmp;
+        vals[t] = val;
+        bestidx[t] = i;
+      }
+    }
+  }
+
+  for (t = 0; t < nt; t++)
+    MPI_Comm_free(&comms[t]);
+  if (ierr < 0) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Error returned from CoarsePartition.");
+    goto End;
+  }
+
+  for (bt = -1, t = 0; t < nt; t++)
+    if (bestidx[t] >= 0 && (bt < 0 || vals[t] < vals[bt]
+     || (vals[t] == vals[bt] && bestidx[t] < bestidx[bt])))
+      bt = t;
+  memcpy(best, bestpart[bt], n * sizeof(int));
+  *bestval = vals[bt];
+
+End:
+  Zoltan_Multifree(__FILE__, __LINE__, 5, &comms, &parts, &bestidx, &bestpart,
+                   &vals);
+  return ierr;
+}
+
 /****************************************************************************/
 
 static int local_coarse_partitioner(
@@ -448,7 +624,7 @@ int err=0;
 int rootnpins, rootrank;
 
   if (CoarsePartition == NULL) { /* PHG_COARSEPARTITION_METHOD = "auto" */
-    CoarsePartition = coarse_part_greedy;
+    CoarsePartition = (numPart > 2) ? coarse_part_linear : coarse_part_greedy;
   }
 
   /* The column processor with the most pins will be our root.  */
@@ -627,7 +803,7 @@ static int coarse_part_linear (
     if (zz->Proc == 0)
       offset = 0;  /* Special case for proc 0 is not really necessary */
     else
-      offset = Zoltan_Rand(NULL) % (hg->nVtx);
+      offset = Zoltan_Rand(hgp->coarse_rng) % (hg->nVtx);
 
     for (i=0; i<hg->nVtx; i++) {
         order[i] = offset + i;
@@ -668,7 +844,7 @@ static int coarse_part_random (
     }
 
     /* Randomly permute order array */
-    Zoltan_Rand_Perm_Int (order, hg->nVtx, NULL);
+    Zoltan_Rand_Perm_Int (order, hg->nVtx, hgp->coarse_rng);
         
     /* Call sequence partitioning with random order array. */
     err = seq_part (zz, hg, order, p, part_sizes, part, hgp);
@@ -853,7 +1029,7 @@ static int coarse_part_greedy (
         scaling = hgp->edge_scaling;
       else
         /* Pick a random scaling. */
-        scaling = Zoltan_Rand(NULL) % 4; /* scaling is in [0,3] */
+        scaling = Zoltan_Rand(hgp->coarse_rng) % 4; /* scaling is in [0,3] */
       /* Temporarily scale the edge weights (save old weights) */
       Zoltan_PHG_Scale_Edges (zz, hg, new_ewgt, scaling);
       old_ewgt = hg->ewgt;
@@ -863,7 +1039,7 @@ static int coarse_part_greedy (
 #endif
 
   /* Start at random vertex */
-  start = Zoltan_Rand(NULL) % (hg->nVtx);
+  start = Zoltan_Rand(hgp->coarse_rng) % (hg->nVtx);
 
   if (p==2)
     /* Call greedy method. */
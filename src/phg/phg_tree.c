@@ -151,6 +151,74 @@ int Zoltan_PHG_Copy_Structure(ZZ *to, ZZ const *from)
   return ZOLTAN_OK;
 }
 
+/*****************************************************************************/
+
+/* Serialization for Zoltan_LB_Serialize:  a flag telling whether the tree
+ * is present, then its size and 2*size entries.  Timer indices refer to
+ * timers of the running process and are not saved. */
+
+size_t Zoltan_PHG_Serialize_Structure_Size(ZZ const *zz)
+{
+  Zoltan_PHG_Tree *tree = Zoltan_PHG_LB_Data_tree(zz);
+  size_t size = sizeof(int);
+
+  if (tree != NULL)
+    size += (1 + 2 * tree->size) * sizeof(int);
+  return size;
+}
+
+int Zoltan_PHG_Serialize_Structure(ZZ const *zz, char **buf)
+{
+  Zoltan_PHG_Tree *tree = Zoltan_PHG_LB_Data_tree(zz);
+  int flag = (tree != NULL);
+
+  Zoltan_Serialize_Int(buf, &flag, 1);
+  if (flag) {
+    Zoltan_Serialize_Int(buf, &(tree->size), 1);
+    Zoltan_Serialize_Int(buf, tree->array + 2, 2 * tree->size);
+  }
+  return ZOLTAN_OK;
+}
+
+int Zoltan_PHG_Deserialize_Structure(ZZ *zz, char **buf, size_t *avail)
+{
+  char *yo = "Zoltan_PHG_Deserialize_Structure";
+  Zoltan_PHG_LB_Data *ptr;
+  Zoltan_PHG_Tree *tree;
+  int flag, size, ierr;
+
+  ptr = (Zoltan_PHG_LB_Data*) Zoltan_PHG_LB_Data_alloc();
+  if (ptr == NULL) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+    return (ZOLTAN_MEMERR);
+  }
+  zz->LB.Data_Structure = (void*)ptr;
+
+  ierr = Zoltan_Deserialize_Int(buf, avail, &flag, 1);
+  if (!ierr && flag)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &size, 1);
+  if (!ierr && flag) {
+    tree = ptr->tree = (Zoltan_PHG_Tree*) ZOLTAN_MALLOC(sizeof(Zoltan_PHG_Tree));
+    if (tree == NULL)
+      ierr = ZOLTAN_MEMERR;
+    else {
+      tree->size = size;
+      ierr = Zoltan_PHG_Tree_init(tree);
+      if (ierr != ZOLTAN_OK)
+        ZOLTAN_FREE(&(ptr->tree));
+      else
+        ierr = Zoltan_Deserialize_Int(buf, avail, tree->array + 2, 2 * size);
+    }
+  }
+
+  if (ierr != ZOLTAN_OK) {
+    Zoltan_PHG_Free_Structure(zz);
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, (ierr == ZOLTAN_MEMERR 
+                       ? "Insufficient memory." : "Buffer is truncated."));
+  }
+  return (ierr);
+}
+
 
 
   /* The tree is a list of couple (-min, max) but only declare as an array of int */
@@ -423,7 +491,7 @@ Zoltan_PHG_Timers_init(ZZ* zz)
 /*   timer->cpart = */
 /*   timer->cpgather = */
 /*   timer->cprefine = -1; */
-/*   for (i = 0; i < 7; i++) timer->matchstage[i] = -1; */
+/*   for (i = 0; i < 9; i++) timer->matchstage[i] = -1; */
 }
 
 /******************************************************************************/
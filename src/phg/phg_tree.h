@@ -84,7 +84,7 @@ struct phg_timer_indices {
   int coshuffle;   /* Part of coarsening */
   int coremove;   /* Part of coarsening */
   int cotheend;   /* Part of coarsening */
-  int matchstage[7];  /* Matching stages */
+  int matchstage[9];  /* Matching stages */
   int rdrdivide;  /* Rdivide time. */
   int rdbefore;   /* Part of Rdivide */
   int rdafter;    /* Part of Rdivide */
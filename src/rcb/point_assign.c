@@ -52,11 +52,30 @@ extern "C" {
 
 
 #include <stdio.h>
+#include <math.h>
 #include "zz_const.h"
 #include "zz_util_const.h"
 #include "rcb.h"
 #include "rib.h"
 
+/* Number of points that Zoltan_RB_Point_Assign_Multi moves down the RCB tree
+   together, one level per sweep, so that the tree lookups of different
+   points overlap.  Blocks are distributed over threads with OpenMP. */
+#define RB_ASSIGN_BLOCK 128
+
+static void rcb_assign_block(ZZ *, RCB_STRUCT *, int, int, double *, int *,
+  int *);
+static void rib_assign_block(ZZ *, RIB_STRUCT *, int, double *, int *, int *);
+static void assign_parts(ZZ *, int, int *, int *, int *);
+static int rcb_locate(struct RB_Locator *, double *);
+static int rib_locate(struct RB_Locator *, double *);
+static int rcb_tree_depth(struct rcb_tree *, int, int);
+static int rib_tree_depth(struct rib_tree *, int, int);
+static void rcb_fill_locator(struct RB_Locator *, struct rcb_tree *, int, int,
+  int);
+static void rib_fill_locator(struct RB_Locator *, struct rib_tree *, int, int,
+  int);
+
 int Zoltan_RB_Point_Assign(
 ZZ       *zz,                   /* The Zoltan structure */
 double   *coords,
@@ -105,13 +124,17 @@ int      *part                  /* part that point lands in;
           c = cnew;
         }
 
-        partmid = treept[0].right_leaf;
+        if (rcb->Locator.Cut != NULL)
+           partmid = -rcb_locate(&(rcb->Locator), c);
+        else {
+           partmid = treept[0].right_leaf;
 
-        while (partmid > 0)
-           if (c[treept[partmid].dim] <= treept[partmid].cut)
-              partmid = treept[partmid].left_leaf;
-           else
-              partmid = treept[partmid].right_leaf;
+           while (partmid > 0)
+              if (c[treept[partmid].dim] <= treept[partmid].cut)
+                 partmid = treept[partmid].left_leaf;
+              else
+                 partmid = treept[partmid].right_leaf;
+        }
      }
      else if (zz->LB.Method == RIB) {
         rib = (RIB_STRUCT *) (zz->LB.Data_Structure);
@@ -133,7 +156,9 @@ int      *part                  /* part that point lands in;
           num_geom = rib->Num_Geom;
         }
 
-        switch (num_geom) {
+        if (rib->Locator.Cut != NULL)
+           partmid = -rib_locate(&(rib->Locator), c);
+        else switch (num_geom) {
            case 3:
               while (partmid > 0) {
                  t = ((c[0] - itree[partmid].cm[0])*itree[partmid].ev[0]) +
@@ -192,6 +217,463 @@ End:
      return ierr;
 }
 
+/****************************************************************************/
+int Zoltan_RB_Point_Assign_Multi(
+ZZ       *zz,                   /* The Zoltan structure */
+int       num_points,           /* number of points */
+double   *coords,               /* coordinates of the points; as many per
+                                   point as the geometric dimension */
+int      *procs,                /* processors that points land in;
+                                   if NULL, processor info is not returned. */
+int      *parts                 /* parts that points land in;
+                                   if NULL, part info is not returned. */
+)
+{
+/* Version of Zoltan_RB_Point_Assign for an array of points. */
+
+     char             *yo = "Zoltan_RB_Point_Assign_Multi";
+     RCB_STRUCT        *rcb;    /* Pointer to data structures for RCB.  */
+     RIB_STRUCT        *rib;    /* Pointer to data structures for RIB. */
+     int ierr = ZOLTAN_OK;
+     int i, b, nblock, num_geom;
+
+     if (zz->LB.Data_Structure == NULL) {
+        ZOLTAN_PRINT_ERROR(-1, yo, 
+                   "No Decomposition Data available; use KEEP_CUTS parameter.");
+        ierr = ZOLTAN_FATAL;
+        goto End;
+     }
+
+     if (zz->LB.Method == RCB) {
+        rcb = (RCB_STRUCT *) (zz->LB.Data_Structure);
+        if (rcb->Tree_Ptr[0].dim < 0) { /* RCB tree was never created. */
+           ZOLTAN_PRINT_ERROR(zz->Proc, yo, "No RCB tree saved; "
+                                        "Must set parameter KEEP_CUTS to 1.");
+           ierr = ZOLTAN_FATAL;
+           goto End;
+        }
+
+        nblock = (num_points + RB_ASSIGN_BLOCK - 1) / RB_ASSIGN_BLOCK;
+#ifdef _OPENMP
+#pragma omp parallel for private(i) schedule(static) if (nblock > 8)
+#endif
+        for (b = 0; b < nblock; b++) {
+           i = b * RB_ASSIGN_BLOCK;
+           rcb_assign_block(zz, rcb, rcb->Num_Dim,
+                  (num_points - i < RB_ASSIGN_BLOCK ? num_points - i
+                                                    : RB_ASSIGN_BLOCK),
+                  coords + i * rcb->Num_Dim, (procs ? procs + i : NULL),
+                  (parts ? parts + i : NULL));
+        }
+     }
+     else if (zz->LB.Method == RIB) {
+        rib = (RIB_STRUCT *) (zz->LB.Data_Structure);
+        num_geom = rib->Num_Geom;
+        if (rib->Locator.Cut != NULL) {
+           nblock = (num_points + RB_ASSIGN_BLOCK - 1) / RB_ASSIGN_BLOCK;
+#ifdef _OPENMP
+#pragma omp parallel for private(i) schedule(static) if (nblock > 8)
+#endif
+           for (b = 0; b < nblock; b++) {
+              i = b * RB_ASSIGN_BLOCK;
+              rib_assign_block(zz, rib,
+                     (num_points - i < RB_ASSIGN_BLOCK ? num_points - i
+                                                       : RB_ASSIGN_BLOCK),
+                     coords + i * num_geom, (procs ? procs + i : NULL),
+                     (parts ? parts + i : NULL));
+           }
+        }
+        else for (i = 0; i < num_points; i++) {
+           /* No locator; assign the points one at a time. */
+           ierr = Zoltan_RB_Point_Assign(zz, coords + i * num_geom,
+                                         (procs ? procs + i : NULL),
+                                         (parts ? parts + i : NULL));
+           if (ierr != ZOLTAN_OK) goto End;
+        }
+     }
+
+End:
+     if (ierr == ZOLTAN_FATAL) {
+        for (i = 0; i < num_points; i++) {
+           if (parts != NULL)
+              parts[i] = -1;
+           if (procs != NULL)
+              procs[i] = -1;
+        }
+     }
+     return ierr;
+}
+
+/****************************************************************************/
+static void rcb_assign_block(
+ZZ         *zz,                 /* The Zoltan structure */
+RCB_STRUCT *rcb,                /* RCB data with a saved tree */
+int         ndim,               /* number of coordinates per point */
+int         num,                /* number of points; <= RB_ASSIGN_BLOCK */
+double     *coords,             /* coordinates of the points */
+int        *procs,              /* processors, or NULL */
+int        *parts               /* parts, or NULL */
+)
+{
+/* Locate a block of points in the RCB tree breadth first:  each sweep moves
+   every point that has not reached a leaf down one level. */
+
+     struct rcb_tree *treept = rcb->Tree_Ptr;
+     struct RB_Locator *loc = &(rcb->Locator);
+     double cnew[RB_ASSIGN_BLOCK][3];
+     double *c[RB_ASSIGN_BLOCK];
+     int node[RB_ASSIGN_BLOCK];     /* current node of each point */
+     int i, n, l, active;
+
+     for (i = 0; i < num; i++) {
+        c[i] = coords + i * ndim;
+        if (rcb->Tran.Target_Dim > 0){  /* degenerate geometry */
+          Zoltan_Transform_Point(c[i], rcb->Tran.Transformation, 
+            rcb->Tran.Permutation, ndim, rcb->Tran.Target_Dim, cnew[i]);
+          c[i] = cnew[i];
+        }
+     }
+
+     if (loc->Cut != NULL) {
+        /* All points take Depth steps in the flattened tree. */
+        for (i = 0; i < num; i++) node[i] = 0;
+        for (l = 0; l < loc->Depth; l++)
+           for (i = 0; i < num; i++) {
+              n = node[i];
+              node[i] = 2 * n + 2 - (c[i][loc->Dim[n]] <= loc->Cut[n]);
+           }
+        n = (1 << loc->Depth) - 1;
+        for (i = 0; i < num; i++) node[i] = loc->Part[node[i] - n];
+     }
+     else {
+        /* node[i] is partmid as in Zoltan_RB_Point_Assign. */
+        for (i = 0; i < num; i++) node[i] = treept[0].right_leaf;
+        do {
+           active = 0;
+           for (i = 0; i < num; i++) {
+              n = node[i];
+              if (n > 0) {
+                 n = (c[i][treept[n].dim] <= treept[n].cut 
+                      ? treept[n].left_leaf : treept[n].right_leaf);
+                 node[i] = n;
+                 active |= (n > 0);
+              }
+           }
+        } while (active);
+        for (i = 0; i < num; i++) node[i] = -node[i];
+     }
+
+     assign_parts(zz, num, node, procs, parts);
+}
+
+/****************************************************************************/
+static void rib_assign_block(
+ZZ         *zz,                 /* The Zoltan structure */
+RIB_STRUCT *rib,                /* RIB data with a locator */
+int         num,                /* number of points; <= RB_ASSIGN_BLOCK */
+double     *coords,             /* coordinates of the points */
+int        *procs,              /* processors, or NULL */
+int        *parts               /* parts, or NULL */
+)
+{
+/* Locate a block of points with the RIB locator. */
+
+     double cnew[3];
+     int part[RB_ASSIGN_BLOCK];
+     int i, ndim = rib->Num_Geom;
+
+     for (i = 0; i < num; i++) {
+        if (rib->Tran.Target_Dim > 0){ /* degenerate geometry */
+          Zoltan_Transform_Point(coords + i * ndim, rib->Tran.Transformation, 
+            rib->Tran.Permutation, ndim, rib->Tran.Target_Dim, cnew);
+          part[i] = rib_locate(&(rib->Locator), cnew);
+        }
+        else
+          part[i] = rib_locate(&(rib->Locator), coords + i * ndim);
+     }
+
+     assign_parts(zz, num, part, procs, parts);
+}
+
+/****************************************************************************/
+static void assign_parts(
+ZZ   *zz,                       /* The Zoltan structure */
+int   num,                      /* number of points */
+int  *part,                     /* parts found in the cut tree */
+int  *procs,                    /* processors, or NULL */
+int  *parts                     /* parts after remapping, or NULL */
+)
+{
+     int i, p;
+
+     for (i = 0; i < num; i++) {
+        p = (zz->LB.Remap ? zz->LB.Remap[part[i]] : part[i]);
+        if (parts != NULL)
+           parts[i] = p;
+        if (procs != NULL)
+           procs[i] = (zz->LB.PartDist ? Zoltan_LB_Part_To_Proc(zz, p, NULL)
+                                       : p);
+     }
+}
+
+/****************************************************************************/
+/* Point location in the flattened trees; return the part (before remapping)
+   containing the point c.  Padding nodes have cut HUGE_VAL, so the
+   comparisons match those of the cut trees. */
+
+static int rcb_locate(struct RB_Locator *loc, double *c)
+{
+     int l, k = 0;
+
+     for (l = 0; l < loc->Depth; l++)
+        k = 2 * k + 2 - (c[loc->Dim[k]] <= loc->Cut[k]);
+     return loc->Part[k - (1 << loc->Depth) + 1];
+}
+
+static int rib_locate(struct RB_Locator *loc, double *c)
+{
+     int l, k = 0;
+     double *cm, *ev;
+     volatile double t;         /* as in Zoltan_RB_Point_Assign */
+
+     switch (loc->Num_Geom) {
+        case 3:
+           for (l = 0; l < loc->Depth; l++) {
+              cm = loc->Cm + 3 * k;
+              ev = loc->Ev + 3 * k;
+              t = ((c[0] - cm[0])*ev[0]) + ((c[1] - cm[1])*ev[1]) +
+                  ((c[2] - cm[2])*ev[2]);
+              k = 2 * k + 2 - (t <= loc->Cut[k]);
+           }
+           break;
+        case 2:
+           for (l = 0; l < loc->Depth; l++) {
+              cm = loc->Cm + 3 * k;
+              ev = loc->Ev + 3 * k;
+              t = ((c[0] - cm[0])*ev[0]) + ((c[1] - cm[1])*ev[1]);
+              k = 2 * k + 2 - (t <= loc->Cut[k]);
+           }
+           break;
+        default:
+           for (l = 0; l < loc->Depth; l++)
+              k = 2 * k + 2 - (c[0] <= loc->Cut[k]);
+           break;
+     }
+     return loc->Part[k - (1 << loc->Depth) + 1];
+}
+
+/****************************************************************************/
+int Zoltan_RCB_Build_Locator(
+ZZ         *zz,                 /* The Zoltan structure */
+RCB_STRUCT *rcb                 /* RCB data with a complete Tree_Ptr */
+)
+{
+/* Build rcb->Locator from rcb->Tree_Ptr.  If the tree is deeper than
+   RB_LOCATOR_MAX_DEPTH, no locator is built and the tree is searched
+   instead. */
+
+     char *yo = "Zoltan_RCB_Build_Locator";
+     struct rcb_tree *treept = rcb->Tree_Ptr;
+     int depth;
+
+     Zoltan_RB_Free_Locator(&(rcb->Locator));
+     if (treept == NULL || treept[0].dim < 0)
+        return ZOLTAN_OK;
+
+     depth = rcb_tree_depth(treept, treept[0].right_leaf, 0);
+     if (depth > RB_LOCATOR_MAX_DEPTH)
+        return ZOLTAN_OK;
+
+     if (Zoltan_RB_Alloc_Locator(&(rcb->Locator), depth, 0) != ZOLTAN_OK) {
+        ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+        return ZOLTAN_MEMERR;
+     }
+     rcb_fill_locator(&(rcb->Locator), treept, treept[0].right_leaf, 0, 0);
+     return ZOLTAN_OK;
+}
+
+/****************************************************************************/
+int Zoltan_RIB_Build_Locator(
+ZZ         *zz,                 /* The Zoltan structure */
+RIB_STRUCT *rib                 /* RIB data with a complete Tree_Ptr */
+)
+{
+/* As Zoltan_RCB_Build_Locator, for RIB. */
+
+     char *yo = "Zoltan_RIB_Build_Locator";
+     struct rib_tree *itree = rib->Tree_Ptr;
+     int depth, num_geom;
+
+     Zoltan_RB_Free_Locator(&(rib->Locator));
+     if (itree == NULL || itree[0].right_leaf < 0)
+        return ZOLTAN_OK;
+
+     depth = rib_tree_depth(itree, itree[0].right_leaf, 0);
+     if (depth > RB_LOCATOR_MAX_DEPTH)
+        return ZOLTAN_OK;
+
+     num_geom = (rib->Tran.Target_Dim > 0 ? rib->Tran.Target_Dim 
+                                          : rib->Num_Geom);
+     if (Zoltan_RB_Alloc_Locator(&(rib->Locator), depth, num_geom) 
+         != ZOLTAN_OK) {
+        ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+        return ZOLTAN_MEMERR;
+     }
+     rib_fill_locator(&(rib->Locator), itree, itree[0].right_leaf, 0, 0);
+     return ZOLTAN_OK;
+}
+
+/****************************************************************************/
+/* Depth of the subtree with root partmid (a part if partmid <= 0) at level
+   level; stops counting beyond RB_LOCATOR_MAX_DEPTH. */
+
+static int rcb_tree_depth(struct rcb_tree *treept, int partmid, int level)
+{
+     int l, r;
+
+     if (partmid <= 0 || level > RB_LOCATOR_MAX_DEPTH)
+        return level;
+     l = rcb_tree_depth(treept, treept[partmid].left_leaf, level + 1);
+     r = rcb_tree_depth(treept, treept[partmid].right_leaf, level + 1);
+     return (l > r ? l : r);
+}
+
+static int rib_tree_depth(struct rib_tree *itree, int partmid, int level)
+{
+     int l, r;
+
+     if (partmid <= 0 || level > RB_LOCATOR_MAX_DEPTH)
+        return level;
+     l = rib_tree_depth(itree, itree[partmid].left_leaf, level + 1);
+     r = rib_tree_depth(itree, itree[partmid].right_leaf, level + 1);
+     return (l > r ? l : r);
+}
+
+/****************************************************************************/
+/* Store the subtree with root partmid in node k (at level level) of the
+   locator; a part above the last level is stored as padding nodes over
+   leaves that all hold the part. */
+
+static void rcb_fill_locator(struct RB_Locator *loc, struct rcb_tree *treept,
+  int partmid, int k, int level)
+{
+     if (level == loc->Depth) {
+        loc->Part[k - (1 << loc->Depth) + 1] = -partmid;
+        return;
+     }
+     if (partmid <= 0) {
+        loc->Cut[k] = HUGE_VAL;
+        loc->Dim[k] = 0;
+        rcb_fill_locator(loc, treept, partmid, 2 * k + 1, level + 1);
+        rcb_fill_locator(loc, treept, partmid, 2 * k + 2, level + 1);
+     }
+     else {
+        loc->Cut[k] = treept[partmid].cut;
+        loc->Dim[k] = treept[partmid].dim;
+        rcb_fill_locator(loc, treept, treept[partmid].left_leaf, 2 * k + 1,
+                         level + 1);
+        rcb_fill_locator(loc, treept, treept[partmid].right_leaf, 2 * k + 2,
+                         level + 1);
+     }
+}
+
+static void rib_fill_locator(struct RB_Locator *loc, struct rib_tree *itree,
+  int partmid, int k, int level)
+{
+     int j;
+
+     if (level == loc->Depth) {
+        loc->Part[k - (1 << loc->Depth) + 1] = -partmid;
+        return;
+     }
+     if (partmid <= 0) {
+        loc->Cut[k] = HUGE_VAL;
+        for (j = 0; j < 3; j++)
+           loc->Cm[3 * k + j] = loc->Ev[3 * k + j] = 0.;
+        rib_fill_locator(loc, itree, partmid, 2 * k + 1, level + 1);
+        rib_fill_locator(loc, itree, partmid, 2 * k + 2, level + 1);
+     }
+     else {
+        loc->Cut[k] = itree[partmid].cut;
+        for (j = 0; j < 3; j++) {
+           loc->Cm[3 * k + j] = itree[partmid].cm[j];
+           loc->Ev[3 * k + j] = itree[partmid].ev[j];
+        }
+        rib_fill_locator(loc, itree, itree[partmid].left_leaf, 2 * k + 1,
+                         level + 1);
+        rib_fill_locator(loc, itree, itree[partmid].right_leaf, 2 * k + 2,
+                         level + 1);
+     }
+}
+
+/****************************************************************************/
+static void locator_set_pointers(struct RB_Locator *loc)
+{
+/* Point the arrays of loc into the allocation starting at loc->Cut. */
+
+     int nnode = (1 << loc->Depth) - 1;
+     char *p = (char *) loc->Cut;
+
+     p += nnode * sizeof(double);
+     if (loc->Num_Geom > 0) {
+        loc->Cm = (double *) p;
+        loc->Ev = loc->Cm + 3 * nnode;
+        p += 6 * nnode * sizeof(double);
+        loc->Dim = NULL;
+     }
+     else {
+        loc->Cm = loc->Ev = NULL;
+        loc->Dim = (int *) p;
+        p += nnode * sizeof(int);
+     }
+     loc->Part = (int *) p;
+}
+
+int Zoltan_RB_Alloc_Locator(
+struct RB_Locator *loc,
+int depth,                      /* levels of cuts */
+int num_geom                    /* RIB:  coordinates in cuts; RCB:  0 */
+)
+{
+     int nnode = (1 << depth) - 1;
+
+     loc->Depth = depth;
+     loc->Num_Geom = num_geom;
+     if (num_geom > 0)          /* Cut, Cm, Ev; Part */
+        loc->Size = 7 * nnode * sizeof(double) + (nnode + 1) * sizeof(int);
+     else                       /* Cut; Dim, Part */
+        loc->Size = nnode * sizeof(double) + (2 * nnode + 1) * sizeof(int);
+     loc->Cut = (double *) ZOLTAN_MALLOC(loc->Size);
+     if (loc->Cut == NULL) {
+        memset(loc, 0, sizeof(struct RB_Locator));
+        return ZOLTAN_MEMERR;
+     }
+     locator_set_pointers(loc);
+     return ZOLTAN_OK;
+}
+
+int Zoltan_RB_Copy_Locator(
+struct RB_Locator *to,
+struct RB_Locator const *from
+)
+{
+/* Copy from to to; to is overwritten without being freed. */
+
+     memset(to, 0, sizeof(struct RB_Locator));
+     if (from->Cut == NULL)
+        return ZOLTAN_OK;
+     if (Zoltan_RB_Alloc_Locator(to, from->Depth, from->Num_Geom) != ZOLTAN_OK)
+        return ZOLTAN_MEMERR;
+     memcpy(to->Cut, from->Cut, from->Size);
+     return ZOLTAN_OK;
+}
+
+void Zoltan_RB_Free_Locator(struct RB_Locator *loc)
+{
+     ZOLTAN_FREE(&(loc->Cut));
+     memset(loc, 0, sizeof(struct RB_Locator));
+}
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
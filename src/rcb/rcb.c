@@ -93,6 +93,10 @@ extern "C" {
 #define RCB_DEFAULT_OUTPUT_LEVEL 0
 #define RCB_DEFAULT_OVERALLOC 1.2
 #define RCB_DEFAULT_REUSE FALSE
+#define RCB_DEFAULT_NUM_THREADS 1
+#define RCB_DEFAULT_HISTOGRAM_BINS 0
+#define RCB_DEFAULT_MEDIAN_COMPACT 0
+#define RCB_DEFAULT_REUSE_TOL 0.0
 
 /* The median of an array of floating point values is found by iterating 
  * through candidates.  We have two methods for choosing candidates:
@@ -127,7 +131,7 @@ extern "C" {
 static int rcb_fn(ZZ *, int *, ZOLTAN_ID_PTR *, ZOLTAN_ID_PTR *, int **, int **,
   int *, ZOLTAN_ID_PTR *,
   double, int, int, int, int, int, int, int, int, int, int, double, int, int,
-  int, float *);
+  int, int, int, int, double, float *);
 static void print_rcb_tree(ZZ *, int, int, struct rcb_tree *);
 static int cut_dimension(int, struct rcb_tree *, int, int, int *, int *, 
   struct rcb_box *);
@@ -136,7 +140,7 @@ static int serial_rcb(ZZ *, struct Dot_Struct *, int *, int *, int, int,
   struct rcb_box *, double *, int, int, int *, int *, int, int, int, int,
   int, int, int, int, int, int, int, int, MPI_Op, MPI_Datatype,
   int, ZOLTAN_GNO_TYPE *, struct rcb_tree *, int *, int, double *, double *,
-  float *, double *, int, int, double, double *);
+  float *, double *, int, int, double, int, int, int, double, double *);
 static void compute_RCB_box(struct rcb_box *, int, struct Dot_Struct *, int *,
   MPI_Op, MPI_Datatype, MPI_Comm, int, int, int, int);
 
@@ -217,6 +221,15 @@ int Zoltan_RCB(
     int average_cuts;         /* Flag forcing median line to be drawn halfway
                                  between two closest objects. */
     int pivot_choice;
+    int num_threads;          /* number of threads to use in the local scans
+                                 of find_median (requires OpenMP) */
+    int histogram_bins;       /* number of histogram bins used to narrow the
+                                 median search; 0 or 1 disables histograms */
+    int median_compact;       /* (1) keep active dots contiguous in
+                                 find_median; (0) use the dot list */
+    double reuse_tol;         /* with reuse, keep a previous cut whose
+                                 imbalance is within this fraction of the
+                                 weight being cut; 0 = always search */
     int idummy;
     int final_output;
     int ierr=ZOLTAN_OK;
@@ -249,6 +262,14 @@ int Zoltan_RCB(
                               (void *) &average_cuts);
     Zoltan_Bind_Param(RCB_params, "RANDOM_PIVOTS",
                               (void *) &pivot_choice);
+    Zoltan_Bind_Param(RCB_params, "RCB_NUM_THREADS",
+                              (void *) &num_threads);
+    Zoltan_Bind_Param(RCB_params, "RCB_HISTOGRAM_BINS",
+                              (void *) &histogram_bins);
+    Zoltan_Bind_Param(RCB_params, "RCB_MEDIAN_COMPACT",
+                              (void *) &median_compact);
+    Zoltan_Bind_Param(RCB_params, "RCB_REUSE_TOL",
+                              (void *) &reuse_tol);
 
     /* Set default values. */
     overalloc = RCB_DEFAULT_OVERALLOC;
@@ -269,10 +290,19 @@ int Zoltan_RCB(
     ddummy = 0.0;
     average_cuts = 0;
     pivot_choice = 0;
+    num_threads = RCB_DEFAULT_NUM_THREADS;
+    histogram_bins = RCB_DEFAULT_HISTOGRAM_BINS;
+    median_compact = RCB_DEFAULT_MEDIAN_COMPACT;
+    reuse_tol = RCB_DEFAULT_REUSE_TOL;
 
     Zoltan_Assign_Param_Vals(zz->Params, RCB_params, zz->Debug_Level, zz->Proc,
                          zz->Debug_Proc);
 
+    /* Incremental repartitioning keeps the directions of the stored cuts,
+       so that each one can serve as a first guess. */
+    if (!reuse || reuse_tol < 0.) reuse_tol = 0.;
+    if (reuse_tol > 0.) reuse_dir = 1;
+
     /* Need to keep the tree if reuse or reuse_dir, so turn gen_tree on. */
     if (reuse || reuse_dir) gen_tree = 1;
 
@@ -287,6 +317,16 @@ int Zoltan_RCB(
       pivot_choice = PIVOT_CHOICE_RANDOM;
     }
 
+    if (num_threads < 1) num_threads = 1;
+#ifndef _OPENMP
+    if (num_threads > 1) {
+      if (zz->Proc == 0)
+        ZOLTAN_PRINT_WARN(zz->Proc, "Zoltan_RCB",
+          "RCB_NUM_THREADS ignored; Zoltan was not compiled with OpenMP");
+      num_threads = 1;
+    }
+#endif
+
     if (final_output && (stats < 1)){
       /* FINAL_OUTPUT is a graph/phg param, corresponds to our OUTPUT_LEVEL 1 */
       stats = 1;
@@ -298,6 +338,7 @@ int Zoltan_RCB(
                  check_geom, stats, gen_tree, reuse_dir, preset_dir,
                  rectilinear_blocks, obj_wgt_comp, mcnorm, 
                  max_aspect_ratio, recompute_box, average_cuts, pivot_choice,
+                 num_threads, histogram_bins, median_compact, reuse_tol,
                  part_sizes);
 
     return(ierr);
@@ -366,6 +407,10 @@ static int rcb_fn(
   int average_cuts,             /* Flag forcing median line to be drawn halfway
                                    between two closest objects. */
   int pivot_choice, 
+  int num_threads,              /* threads per process for find_median scans */
+  int histogram_bins,           /* histogram bins per round in median search */
+  int median_compact,           /* contiguous active dots in find_median */
+  double reuse_tol,             /* keep previous cuts within this imbalance */
   float *part_sizes             /* Input: Array of size 
                                    zz->LB.Num_Global_Parts * wgtflag 
                                    containing the percentage of work 
@@ -909,7 +954,8 @@ static int rcb_fn(
                nprocs, old_nprocs, proclower, old_nparts, 
                wgtflag, rcbbox->lo[dim], rcbbox->hi[dim], 
                weight[0], weightlo, weighthi,
-               dotlist, rectilinear_blocks, average_cuts)) {
+               dotlist, rectilinear_blocks, average_cuts, num_threads,
+               histogram_bins, median_compact, reuse_tol)) {
             ZOLTAN_PRINT_ERROR(proc, yo,"Error returned from Zoltan_RB_find_median.");
             ierr = ZOLTAN_FATAL;
             goto End;
@@ -937,7 +983,7 @@ static int rcb_fn(
                old_nprocs, proclower, old_nparts, 
                rcbbox->lo[dim], rcbbox->hi[dim], 
                weight, weightlo, weighthi, &norm_max,
-               dotlist, rectilinear_blocks, average_cuts)
+               dotlist, rectilinear_blocks, average_cuts, histogram_bins)
           != ZOLTAN_OK) {
           ZOLTAN_PRINT_ERROR(proc, yo,"Error returned from Zoltan_RB_find_bisector.");
           ierr = ZOLTAN_FATAL;
@@ -1140,7 +1186,8 @@ static int rcb_fn(
                box_op, box_type, average_cuts, 
                counters, treept, dim_spec, level,
                coord, wgts, part_sizes, wgtscale, rcb->Num_Dim, pivot_choice, 
-               max_aspect_ratio, timers);
+               max_aspect_ratio, num_threads, histogram_bins, median_compact,
+               reuse_tol, timers);
     if (ierr < 0) {
       ZOLTAN_PRINT_ERROR(proc, yo, "Error returned from serial_rcb");
       goto End;
@@ -1257,6 +1304,13 @@ EndReporting:
         treept[-treept[i].parent - 1].right_leaf = i;
     ZOLTAN_FREE(&displ);
     ZOLTAN_FREE(&treetmp);
+
+    ierr = Zoltan_RCB_Build_Locator(zz, rcb);
+    if (ierr != ZOLTAN_OK) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                         "Error returned from Zoltan_RCB_Build_Locator.");
+      goto End;
+    }
   }
 
   if (treept && zz->Debug_Level >= ZOLTAN_DEBUG_ALL)
@@ -1555,6 +1609,10 @@ static int serial_rcb(
   int ndim,                  /* number of geometric dimensions */
   int pivot_choice, 
   double max_aspect_ratio,
+  int num_threads,           /* threads per process for find_median scans */
+  int histogram_bins,        /* histogram bins per round in median search */
+  int median_compact,        /* contiguous active dots in find_median */
+  double reuse_tol,          /* keep previous cuts within this imbalance */
   double timers[]            /* as in rcb_fn */
 )
 {
@@ -1686,7 +1744,8 @@ static int serial_rcb(
                  first_guess, zz->Num_Proc, 1, zz->Proc, num_parts,
                  wgtflag, rcbbox->lo[dim], rcbbox->hi[dim], 
                  weight[0], weightlo, weighthi,
-                 dotlist, rectilinear_blocks, average_cuts)) {
+                 dotlist, rectilinear_blocks, average_cuts, num_threads,
+                 histogram_bins, median_compact, reuse_tol)) {
             ZOLTAN_PRINT_ERROR(proc, yo,"Error returned from Zoltan_RB_find_median.");
             ierr = ZOLTAN_FATAL;
             goto End;
@@ -1716,7 +1775,7 @@ static int serial_rcb(
              1, zz->Proc, num_parts, 
              rcbbox->lo[dim], rcbbox->hi[dim], 
              weight, weightlo, weighthi, &norm_max,
-             dotlist, rectilinear_blocks, average_cuts)
+             dotlist, rectilinear_blocks, average_cuts, histogram_bins)
           != ZOLTAN_OK) {
           ZOLTAN_PRINT_ERROR(proc, yo,"Error returned from Zoltan_RB_find_bisector.");
           ierr = ZOLTAN_FATAL;
@@ -1820,7 +1879,8 @@ static int serial_rcb(
                         box_op, box_type, average_cuts, 
                         counters, treept, dim_spec, level,
                         coord, wgts, part_sizes, wgtscale, ndim, pivot_choice,
-                        max_aspect_ratio, timers);
+                        max_aspect_ratio, num_threads, histogram_bins,
+                        median_compact, reuse_tol, timers);
       if (ierr < 0) {
         goto End;
       }
@@ -1841,7 +1901,8 @@ static int serial_rcb(
                         box_op, box_type, average_cuts,
                         counters, treept, dim_spec, level,
                         coord, wgts, part_sizes, wgtscale, ndim, pivot_choice,
-                        max_aspect_ratio, timers);
+                        max_aspect_ratio, num_threads, histogram_bins,
+                        median_compact, reuse_tol, timers);
       if (ierr < 0) {
         goto End;
       }
@@ -96,12 +96,14 @@ typedef struct RCB_Struct {
   struct Dot_Struct Dots;       /* coordinates, weights, etc */
   struct rcb_tree *Tree_Ptr;
   struct rcb_box *Box;
+  struct RB_Locator Locator;  /* flattened Tree_Ptr for point location */
   int Num_Dim;    /* Number of dimensions in the input geometry. */
   ZZ_Transform Tran;        /* transformation for degenerate geometry */
 } RCB_STRUCT;
 
 extern int Zoltan_RCB_Build_Structure(ZZ *, int *, int *, int, double, int,int);
 extern void Zoltan_RCB_Print_Structure(ZZ *zz, int howMany);
+extern int Zoltan_RCB_Build_Locator(ZZ *, RCB_STRUCT *);
 
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
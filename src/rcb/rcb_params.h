@@ -76,6 +76,10 @@ static PARAM_VARS RCB_params[] = {
                   { "REDUCE_DIMENSIONS", NULL, "INT", 0 },
                   { "DEGENERATE_RATIO", NULL, "DOUBLE", 0 },
                   {"FINAL_OUTPUT",      NULL,  "INT",    0},
+                  { "RCB_NUM_THREADS", NULL, "INT", 0 },
+                  { "RCB_HISTOGRAM_BINS", NULL, "INT", 0 },
+                  { "RCB_MEDIAN_COMPACT", NULL, "INT", 0 },
+                  { "RCB_REUSE_TOL", NULL, "DOUBLE", 0 },
                   { NULL, NULL, NULL, 0 } };
 
 #ifdef __cplusplus
@@ -81,6 +81,7 @@ int i, ierr = 0;
     rcb->Global_IDs = NULL;
     rcb->Local_IDs = NULL;
     memset(&(rcb->Dots), 0, sizeof(struct Dot_Struct));
+    memset(&(rcb->Locator), 0, sizeof(struct RB_Locator));
 
     Zoltan_Initialize_Transformation(&(rcb->Tran));
 
@@ -145,6 +146,7 @@ RCB_STRUCT *rcb;                      /* Data structure for RCB.             */
   if (rcb != NULL) {
     ZOLTAN_FREE(&(rcb->Tree_Ptr));
     ZOLTAN_FREE(&(rcb->Box));
+    Zoltan_RB_Free_Locator(&(rcb->Locator));
     ZOLTAN_FREE(&(rcb->Global_IDs));
     ZOLTAN_FREE(&(rcb->Local_IDs));
     Zoltan_Free_And_Reset_Dot_Structure(&rcb->Dots);
@@ -196,9 +198,118 @@ int Zoltan_RCB_Copy_Structure(ZZ *toZZ, ZZ const *fromZZ)
 
   COPY_BUFFER(Box, struct rcb_box, 1);
 
+  if (Zoltan_RB_Copy_Locator(&(to->Locator), &(from->Locator)) != ZOLTAN_OK){
+    Zoltan_RCB_Free_Structure(toZZ);
+    ZOLTAN_PRINT_ERROR(fromZZ->Proc, yo, "Insufficient memory.");
+    return(ZOLTAN_MEMERR);
+  }
+
+  return ZOLTAN_OK;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/* Serialization of the RCB structure for Zoltan_LB_Serialize:
+ * Num_Dim and Tran, then Box and Tree_Ptr, each preceded by a flag telling
+ * whether it is present.  Dots and IDs are not saved; the locator is
+ * rebuilt from the tree. */
+
+size_t Zoltan_RCB_Serialize_Structure_Size(ZZ const *zz)
+{
+  RCB_STRUCT const *rcb = (RCB_STRUCT const *)zz->LB.Data_Structure;
+  size_t size = 3 * sizeof(int) + ZOLTAN_SERIAL_TRANSFORM_SIZE;
+
+  if (rcb->Box)
+    size += 6 * sizeof(double);
+  if (rcb->Tree_Ptr)
+    size += zz->LB.Num_Global_Parts * (sizeof(double) + 4 * sizeof(int));
+  return size;
+}
+
+int Zoltan_RCB_Serialize_Structure(ZZ const *zz, char **buf)
+{
+  RCB_STRUCT const *rcb = (RCB_STRUCT const *)zz->LB.Data_Structure;
+  struct rcb_tree const *t;
+  int i, flag;
+
+  Zoltan_Serialize_Int(buf, &(rcb->Num_Dim), 1);
+  Zoltan_Serialize_Transform(buf, &(rcb->Tran));
+  flag = (rcb->Box != NULL);
+  Zoltan_Serialize_Int(buf, &flag, 1);
+  if (flag) {
+    Zoltan_Serialize_Double(buf, rcb->Box->lo, 3);
+    Zoltan_Serialize_Double(buf, rcb->Box->hi, 3);
+  }
+  flag = (rcb->Tree_Ptr != NULL);
+  Zoltan_Serialize_Int(buf, &flag, 1);
+  for (i = 0; flag && i < zz->LB.Num_Global_Parts; i++) {
+    t = &(rcb->Tree_Ptr[i]);
+    Zoltan_Serialize_Double(buf, &(t->cut), 1);
+    Zoltan_Serialize_Int(buf, &(t->dim), 1);
+    Zoltan_Serialize_Int(buf, &(t->parent), 1);
+    Zoltan_Serialize_Int(buf, &(t->left_leaf), 1);
+    Zoltan_Serialize_Int(buf, &(t->right_leaf), 1);
+  }
   return ZOLTAN_OK;
 }
 
+int Zoltan_RCB_Deserialize_Structure(ZZ *zz, char **buf, size_t *avail)
+{
+  char *yo = "Zoltan_RCB_Deserialize_Structure";
+  RCB_STRUCT *rcb;
+  struct rcb_tree *t;
+  size_t len;
+  int i, flag, ierr;
+
+  rcb = (RCB_STRUCT *)ZOLTAN_CALLOC(1, sizeof(RCB_STRUCT));
+  if (rcb == NULL) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+    return(ZOLTAN_MEMERR);
+  }
+  zz->LB.Data_Structure = (void *)rcb;
+
+  ierr = Zoltan_Deserialize_Int(buf, avail, &(rcb->Num_Dim), 1);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Transform(buf, avail, &(rcb->Tran));
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &flag, 1);
+  if (!ierr && flag) {
+    rcb->Box = (struct rcb_box *)ZOLTAN_MALLOC(sizeof(struct rcb_box));
+    ierr = (rcb->Box == NULL ? ZOLTAN_MEMERR 
+            : Zoltan_Deserialize_Double(buf, avail, rcb->Box->lo, 3));
+    if (!ierr)
+      ierr = Zoltan_Deserialize_Double(buf, avail, rcb->Box->hi, 3);
+  }
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &flag, 1);
+  if (!ierr && flag) {
+    len = zz->LB.Num_Global_Parts * sizeof(struct rcb_tree);
+    rcb->Tree_Ptr = (struct rcb_tree *)ZOLTAN_MALLOC(len);
+    if (rcb->Tree_Ptr == NULL)
+      ierr = ZOLTAN_MEMERR;
+    for (i = 0; !ierr && i < zz->LB.Num_Global_Parts; i++) {
+      t = &(rcb->Tree_Ptr[i]);
+      ierr = Zoltan_Deserialize_Double(buf, avail, &(t->cut), 1);
+      if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(t->dim), 1);
+      if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(t->parent), 1);
+      if (!ierr) 
+        ierr = Zoltan_Deserialize_Int(buf, avail, &(t->left_leaf), 1);
+      if (!ierr) 
+        ierr = Zoltan_Deserialize_Int(buf, avail, &(t->right_leaf), 1);
+    }
+  }
+  if (!ierr)
+    ierr = Zoltan_RCB_Build_Locator(zz, rcb);
+
+  if (ierr) {
+    Zoltan_RCB_Free_Structure(zz);
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, (ierr == ZOLTAN_MEMERR 
+                       ? "Insufficient memory." : "Buffer is truncated."));
+  }
+  return ierr;
+}
+
 /*
 ** For debugging purposes, print out the RCB structure
 **   Indicate how many objects you want printed out, -1 for all.
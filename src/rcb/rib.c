@@ -570,7 +570,7 @@ static int rib_fn(
                    fractionlo, local_comm, &valuehalf, first_guess,
                    nprocs, old_nprocs, proclower, old_nparts,
                    wgtflag, valuelo, valuehi, weight[0], weightlo,
-                   weighthi, dotlist, rectilinear_blocks, average_cuts)) {
+                   weighthi, dotlist, rectilinear_blocks, average_cuts, 1, 0, 0, 0.)) {
       ZOLTAN_PRINT_ERROR(proc, yo,
         "Error returned from Zoltan_RB_find_median.");
       ierr = ZOLTAN_FATAL;
@@ -832,6 +832,13 @@ EndReporting:
 
     ZOLTAN_FREE(&displ);
     ZOLTAN_FREE(&treetmp);
+
+    ierr = Zoltan_RIB_Build_Locator(zz, rib);
+    if (ierr != ZOLTAN_OK) {
+      ZOLTAN_PRINT_ERROR(zz->Proc, yo, 
+                         "Error returned from Zoltan_RIB_Build_Locator.");
+      goto End;
+    }
   }
 
   if (treept && zz->Debug_Level >= ZOLTAN_DEBUG_ALL)
@@ -1138,7 +1145,7 @@ double start_time=0., end_time;
                                0, zz->Num_Proc, 1, proc, num_parts,
                                wgtflag, valuelo, valuehi, weight, &weightlo,
                                &weighthi, dotlist, rectilinear_blocks, 
-                               average_cuts)) {
+                               average_cuts, 1, 0, 0, 0.)) {
       ZOLTAN_PRINT_ERROR(proc, yo, 
         "Error returned from Zoltan_RB_find_median.");
       ierr = ZOLTAN_FATAL;
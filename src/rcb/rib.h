@@ -75,12 +75,14 @@ typedef struct RIB_Struct {
                                    FALSE.   */
     struct Dot_Struct Dots;
     struct rib_tree   *Tree_Ptr;
+    struct RB_Locator  Locator;  /* flattened Tree_Ptr for point location */
     int                Num_Geom;
     ZZ_Transform       Tran;     /* transformation for degenerate geometry */
 } RIB_STRUCT;
 
 extern int Zoltan_RIB_Build_Structure(ZZ *, int *, int *, int, double, int,int);
 extern void Zoltan_RIB_Print_Structure(ZZ *zz, int howMany);
+extern int Zoltan_RIB_Build_Locator(ZZ *, RIB_STRUCT *);
 
 
 /* function prototypes */
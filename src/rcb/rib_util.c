@@ -73,6 +73,7 @@ int            i, ierr = 0;
     rib->Tree_Ptr = NULL;
     rib->Global_IDs = NULL;
     rib->Local_IDs = NULL;
+    memset(&(rib->Locator), 0, sizeof(struct RB_Locator));
 
     Zoltan_Initialize_Transformation(&(rib->Tran));
 
@@ -127,6 +128,7 @@ RIB_STRUCT    *rib;                   /* Data structure for RIB. */
 
   if (rib != NULL) {
     ZOLTAN_FREE(&(rib->Tree_Ptr));
+    Zoltan_RB_Free_Locator(&(rib->Locator));
     ZOLTAN_FREE(&(rib->Global_IDs));
     ZOLTAN_FREE(&(rib->Local_IDs));
     Zoltan_Free_And_Reset_Dot_Structure(&rib->Dots);
@@ -177,8 +179,103 @@ int Zoltan_RIB_Copy_Structure(ZZ *toZZ, ZZ const *fromZZ)
 
   COPY_BUFFER(Tree_Ptr, struct rib_tree, fromZZ->LB.Num_Global_Parts);
 
+  if (Zoltan_RB_Copy_Locator(&(to->Locator), &(from->Locator)) != ZOLTAN_OK){
+    Zoltan_RIB_Free_Structure(toZZ);
+    ZOLTAN_PRINT_ERROR(fromZZ->Proc, yo, "Insufficient memory.");
+    return(ZOLTAN_MEMERR);
+  }
+
   return ZOLTAN_OK;
 }
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/* Serialization of the RIB structure for Zoltan_LB_Serialize:
+ * Num_Geom and Tran, then a flag telling whether Tree_Ptr is present and
+ * Tree_Ptr.  Dots and IDs are not saved; the locator is rebuilt from the
+ * tree. */
+
+size_t Zoltan_RIB_Serialize_Structure_Size(ZZ const *zz)
+{
+  RIB_STRUCT const *rib = (RIB_STRUCT const *)zz->LB.Data_Structure;
+  size_t size = 2 * sizeof(int) + ZOLTAN_SERIAL_TRANSFORM_SIZE;
+
+  if (rib->Tree_Ptr)
+    size += zz->LB.Num_Global_Parts * (7 * sizeof(double) + 3 * sizeof(int));
+  return size;
+}
+
+int Zoltan_RIB_Serialize_Structure(ZZ const *zz, char **buf)
+{
+  RIB_STRUCT const *rib = (RIB_STRUCT const *)zz->LB.Data_Structure;
+  struct rib_tree const *t;
+  int i, flag;
+
+  Zoltan_Serialize_Int(buf, &(rib->Num_Geom), 1);
+  Zoltan_Serialize_Transform(buf, &(rib->Tran));
+  flag = (rib->Tree_Ptr != NULL);
+  Zoltan_Serialize_Int(buf, &flag, 1);
+  for (i = 0; flag && i < zz->LB.Num_Global_Parts; i++) {
+    t = &(rib->Tree_Ptr[i]);
+    Zoltan_Serialize_Double(buf, t->cm, 3);
+    Zoltan_Serialize_Double(buf, t->ev, 3);
+    Zoltan_Serialize_Double(buf, &(t->cut), 1);
+    Zoltan_Serialize_Int(buf, &(t->parent), 1);
+    Zoltan_Serialize_Int(buf, &(t->left_leaf), 1);
+    Zoltan_Serialize_Int(buf, &(t->right_leaf), 1);
+  }
+  return ZOLTAN_OK;
+}
+
+int Zoltan_RIB_Deserialize_Structure(ZZ *zz, char **buf, size_t *avail)
+{
+  char *yo = "Zoltan_RIB_Deserialize_Structure";
+  RIB_STRUCT *rib;
+  struct rib_tree *t;
+  size_t len;
+  int i, flag, ierr;
+
+  rib = (RIB_STRUCT *)ZOLTAN_CALLOC(1, sizeof(RIB_STRUCT));
+  if (rib == NULL) {
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+    return(ZOLTAN_MEMERR);
+  }
+  zz->LB.Data_Structure = (void *)rib;
+
+  ierr = Zoltan_Deserialize_Int(buf, avail, &(rib->Num_Geom), 1);
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Transform(buf, avail, &(rib->Tran));
+  if (!ierr)
+    ierr = Zoltan_Deserialize_Int(buf, avail, &flag, 1);
+  if (!ierr && flag) {
+    len = zz->LB.Num_Global_Parts * sizeof(struct rib_tree);
+    rib->Tree_Ptr = (struct rib_tree *)ZOLTAN_MALLOC(len);
+    if (rib->Tree_Ptr == NULL)
+      ierr = ZOLTAN_MEMERR;
+    for (i = 0; !ierr && i < zz->LB.Num_Global_Parts; i++) {
+      t = &(rib->Tree_Ptr[i]);
+      ierr = Zoltan_Deserialize_Double(buf, avail, t->cm, 3);
+      if (!ierr) ierr = Zoltan_Deserialize_Double(buf, avail, t->ev, 3);
+      if (!ierr) ierr = Zoltan_Deserialize_Double(buf, avail, &(t->cut), 1);
+      if (!ierr) ierr = Zoltan_Deserialize_Int(buf, avail, &(t->parent), 1);
+      if (!ierr) 
+        ierr = Zoltan_Deserialize_Int(buf, avail, &(t->left_leaf), 1);
+      if (!ierr) 
+        ierr = Zoltan_Deserialize_Int(buf, avail, &(t->right_leaf), 1);
+    }
+  }
+  if (!ierr)
+    ierr = Zoltan_RIB_Build_Locator(zz, rib);
+
+  if (ierr) {
+    Zoltan_RIB_Free_Structure(zz);
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, (ierr == ZOLTAN_MEMERR 
+                       ? "Insufficient memory." : "Buffer is truncated."));
+  }
+  return ierr;
+}
+
 void Zoltan_RIB_Print_Structure(ZZ *zz, int howMany)
 {
   int num_obj, i, len;
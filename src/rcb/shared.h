@@ -93,6 +93,31 @@ struct Dot_Struct {	        /* dot = point in 3-space */
 };
 #endif
 
+/* Cut tree of RCB or RIB flattened for point location.  Node k of the
+ * flattened tree has children 2k+1 and 2k+2 (breadth-first order).  The
+ * tree is padded so that all leaves are at depth Depth:  a leaf of the cut
+ * tree above that depth becomes a node whose cut sends every point left,
+ * so a point is located in exactly Depth steps without branches.
+ * Leaf j is node 2^Depth-1+j.  All arrays are in one allocation of Size
+ * bytes starting at Cut; Cut is NULL if there is no locator. */
+#define RB_LOCATOR_MAX_DEPTH 20
+
+struct RB_Locator {
+  int    Depth;          /* levels of cuts */
+  int    Num_Geom;       /* RIB:  coordinates used in the cuts; RCB:  0 */
+  size_t Size;           /* bytes allocated */
+  double *Cut;           /* 2^Depth-1 cut positions */
+  double *Cm;            /* RIB:  3 center-of-mass coordinates per node */
+  double *Ev;            /* RIB:  3 direction coordinates per node */
+  int    *Dim;           /* RCB:  dimension of the cut of each node */
+  int    *Part;          /* 2^Depth parts of the leaves */
+};
+
+extern int Zoltan_RB_Alloc_Locator(struct RB_Locator *, int, int);
+extern int Zoltan_RB_Copy_Locator(struct RB_Locator *,
+  struct RB_Locator const *);
+extern void Zoltan_RB_Free_Locator(struct RB_Locator *);
+
 
 extern int Zoltan_RB_Build_Structure(ZZ *, ZOLTAN_ID_PTR *, ZOLTAN_ID_PTR *,
   struct Dot_Struct *, int *, int *, int *, int, double, int, int);
@@ -217,6 +217,22 @@ typedef struct {
 /*****************************************************************************/
 /*****************************************************************************/
 
+/*
+ *  Application-owned hypergraph in compressed edge form, registered with
+ *  Zoltan_Set_HG_CSR.  Zoltan only reads these arrays.
+ */
+
+typedef struct Zoltan_HG_CSR_Struct {
+  int Num_Vtx;                    /* Number of vertices on this process     */
+  ZOLTAN_ID_PTR Vtx_GID;          /* Vertex global IDs                      */
+  int Num_Edges;                  /* Number of (partial) hyperedges         */
+  ZOLTAN_ID_PTR Edge_GID;         /* Hyperedge global IDs                   */
+  int *Edge_Ptr;                  /* Pins of edge i are Pin_GID entries
+                                     Edge_Ptr[i] to Edge_Ptr[i+1]-1         */
+  ZOLTAN_ID_PTR Pin_GID;          /* Pin vertex global IDs                  */
+  float *Edge_Wgts;               /* EDGE_WEIGHT_DIM weights per edge or NULL */
+} ZOLTAN_HG_CSR;
+
 /*
  *  Define a Zoltan structure.  It will contain pointers to the
  *  appropriate functions for interfacing with applications and 
@@ -449,6 +465,14 @@ struct Zoltan_Struct {
   void *Get_HG_CS_Data;                /* Ptr to user defined data
                                         to be passed to Get_HG_CS() */
   /***************************************************************************/
+  ZOLTAN_HG_CS_PAGE_FN *Get_HG_CS_Page;
+                                       /* Fn ptr to get hypergraph pins
+                                          a page at a time.  Used in
+                                          place of Get_HG_CS() if set. */
+  void *Get_HG_CS_Page_Data;           /* Ptr to user defined data
+                                        to be passed to Get_HG_CS_Page() */
+  ZOLTAN_HG_CSR HG_CSR;                /* Arrays set by Zoltan_Set_HG_CSR */
+  /***************************************************************************/
   ZOLTAN_HG_SIZE_EDGE_WTS_FN *Get_HG_Size_Edge_Wts;    
                                        /* Fn ptr to get size of hypergraph
                                           edge weights to be returned.  */
@@ -694,6 +718,9 @@ extern int Zoltan_Print_Obj_List( ZZ *zz, ZOLTAN_ID_PTR Gids, ZOLTAN_ID_PTR Lids
 extern int Zoltan_Get_Coordinates(ZZ *, int, ZOLTAN_ID_PTR, ZOLTAN_ID_PTR,
   int *, double **);
 
+extern int Zoltan_HG_CSR_Active(ZZ *);
+extern void Zoltan_HG_CSR_Copy_To(ZZ *, ZZ const *);
+
 extern void Zoltan_Print_Transformation(ZZ_Transform *tr);
 extern void Zoltan_Initialize_Transformation(ZZ_Transform *tr);
 
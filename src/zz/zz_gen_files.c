@@ -196,7 +196,8 @@ int gen_geom, int gen_graph, int gen_hg)
    * We'll write out one-based IDs.
    */
   if (gen_hg){
-    have_pin_callbacks = zz->Get_HG_Size_CS != NULL && zz->Get_HG_CS != NULL;
+    have_pin_callbacks = zz->Get_HG_Size_CS != NULL &&
+                         (zz->Get_HG_CS != NULL || zz->Get_HG_CS_Page != NULL);
 
     if (!have_pin_callbacks){
       gen_hg = 0;
@@ -49,6 +49,7 @@
 extern "C" {
 #endif
 
+#include <math.h>
 #include "zz_heap.h"
 #include "zz_const.h"
 
@@ -71,11 +72,20 @@ extern "C" {
  * (internal) heap array visible to the application. Both approaches are
  * dangerous because the application developer must take care to ensure
  * the heap is properly updated when values change.
+ *
+ * A heap created with Zoltan_Heap_Init_Buckets instead keeps its elements
+ * in an array of doubly linked gain buckets, one per integer key value,
+ * as in the original FM paper. Insertion, removal and value changes are
+ * then constant time, and finding the max only walks down from the
+ * highest bucket that may be non-empty. It is meant for FM gains when
+ * all edge weights are (small) integers; keys are rounded to integers.
  */
 
 
 /* prototypes */
 static void heapify (HEAP*, int);
+static void bucket_insert (HEAP*, int, float);
+static void bucket_remove (HEAP*, int);
 
 
 /* Inititializes the heap values and allocates space. */
@@ -90,6 +100,8 @@ int i;
 
   h->space = space;
   h->n = 0;
+  h->head = h->prev = NULL;
+  h->offset = h->top = 0;
   if ((space > 0)
    && (!(h->ele   = (int*)   ZOLTAN_CALLOC(space, sizeof(int)))
    ||  !(h->pos   = (int*)   ZOLTAN_CALLOC(space, sizeof(int)))
@@ -104,6 +116,32 @@ int i;
 
 
 
+/* Initializes a bucket "heap" for integer keys in [-maxkey, maxkey]. */
+
+int Zoltan_Heap_Init_Buckets (ZZ *zz, HEAP *h, int space, int maxkey)
+{
+char *yo = "Zoltan_Heap_Init_Buckets";
+int i, ierr;
+
+  if ((ierr = Zoltan_Heap_Init(zz, h, space)) != ZOLTAN_OK)
+     return ierr;
+  if (maxkey < 0)
+     maxkey = 0;
+  if (!(h->head = (int*) ZOLTAN_MALLOC((2*maxkey+1) * sizeof(int)))
+   || !(h->prev = (int*) ZOLTAN_MALLOC((space > 0 ? space : 1) * sizeof(int)))){
+     Zoltan_Heap_Free(h);
+     ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Insufficient memory.");
+     return ZOLTAN_MEMERR;
+     }
+  h->offset = maxkey;
+  h->top = -1;
+  for (i = 0; i <= 2*maxkey; i++)
+     h->head[i] = -1;
+  return ZOLTAN_OK;
+}
+
+
+
 void Zoltan_Heap_Clear (HEAP *h)
 {
 int i;
@@ -114,6 +152,11 @@ int i;
      h->value[i] = 0.0;
      h->pos[i]   = -1;
      }
+  if (h->head) {
+     for (i = 0; i <= 2*h->offset; i++)
+        h->head[i] = -1;
+     h->top = -1;
+     }
 }
 
 
@@ -125,6 +168,7 @@ void Zoltan_Heap_Free (HEAP *h)
      Zoltan_Multifree(__FILE__, __LINE__, 3, &h->ele, &h->pos, &h->value);
      h->space = 0;
      }
+  Zoltan_Multifree(__FILE__, __LINE__, 2, &h->head, &h->prev);
   h->n = 0;
 }
 
@@ -136,6 +180,9 @@ int Zoltan_Heap_Check (HEAP *h)
 int i, left, right;
 static char *yo = "Zoltan_Heap_Check";
 
+  if (h->head)
+     return ZOLTAN_OK;     /* buckets are always in order */
+
   for (i = 0; i < h->n; i++) {
      left  = 2*i + 1;
      right = 2*i + 2;
@@ -166,6 +213,10 @@ static char *yo = "Zoltan_Heap_Input";
      ZOLTAN_PRINT_ERROR(0, yo, "Heap is full!\n");
      return ZOLTAN_FATAL;
      }
+  if (h->head) {
+     bucket_insert(h, element, value);
+     return ZOLTAN_OK;
+     }
   h->value[element] = value;
   h->pos[element]   = h->n;
   h->ele[(h->n)++]  = element;
@@ -178,6 +229,8 @@ static char *yo = "Zoltan_Heap_Input";
 int Zoltan_Heap_Make (HEAP *h)
 { int i;
 
+  if (h->head)
+     return ZOLTAN_OK;     /* already in order */
   for (i = h->n / 2; i >= 0;  i--)
      heapify(h, i);
   return ZOLTAN_OK;
@@ -214,6 +267,14 @@ int position, father;
   if (element < 0 || element >= h->space)
      return ZOLTAN_FATAL;                           /* Error */
 
+  if (h->head) {
+     if (h->pos[element] >= 0) {
+        bucket_remove(h, element);
+        bucket_insert(h, element, value);
+        }
+     return ZOLTAN_OK;
+     }
+
   if ((position = h->pos[element]) >= 0) {
      if (value < h->value[element]) {
         h->value[element] = value;
@@ -245,6 +306,13 @@ int max;
   if (h->n == 0)
      return -1;           /* No elements in heap. */
 
+  if (h->head) {
+     max = Zoltan_Heap_Bucket_Max(h);
+     bucket_remove(h, max);
+     h->value[max] = 0.0;
+     return max;
+     }
+
   max     = h->ele[0];
 
   h->value[max] = 0.0;
@@ -266,6 +334,13 @@ int Zoltan_Heap_Extract (HEAP *h, int element)
   if (h->n == 0)
      return ZOLTAN_FATAL;
 
+  if (h->head) {
+     if (h->pos[element] >= 0)
+        bucket_remove(h, element);
+     h->value[element] = 0.0;
+     return ZOLTAN_OK;
+     }
+
   position = h->pos[element];
 
   h->value[element] = 0.0;
@@ -279,6 +354,59 @@ int Zoltan_Heap_Extract (HEAP *h, int element)
 
 
 
+/* Returns the element in the highest non-empty bucket, -1 if empty. */
+int Zoltan_Heap_Bucket_Max (HEAP *h)
+{
+  if (h->n == 0)
+     return -1;
+  while (h->head[h->top] < 0)
+     h->top--;
+  return h->head[h->top];
+}
+
+
+
+/* Puts an element at the front of the bucket of its (rounded) key. */
+static void bucket_insert (HEAP *h, int element, float value)
+{
+int b;
+
+  b = (int) floor(value + 0.5) + h->offset;
+  if (b < 0)
+     b = 0;
+  else if (b > 2*h->offset)
+     b = 2*h->offset;
+
+  h->value[element] = value;
+  h->pos[element]   = b;
+  h->prev[element]  = -1;
+  h->ele[element]   = h->head[b];
+  if (h->head[b] >= 0)
+     h->prev[h->head[b]] = element;
+  h->head[b] = element;
+  if (b > h->top)
+     h->top = b;
+  h->n++;
+}
+
+
+
+static void bucket_remove (HEAP *h, int element)
+{
+int b = h->pos[element];
+
+  if (h->prev[element] >= 0)
+     h->ele[h->prev[element]] = h->ele[element];
+  else
+     h->head[b] = h->ele[element];
+  if (h->ele[element] >= 0)
+     h->prev[h->ele[element]] = h->prev[element];
+  h->pos[element] = -1;
+  h->n--;
+}
+
+
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
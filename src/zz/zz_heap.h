@@ -61,17 +61,28 @@ typedef struct {
    int   *ele;
    int   *pos;
    float *value;
+   /* Gain buckets; only used if the heap was created with
+      Zoltan_Heap_Init_Buckets (head != NULL). Keys must then be integers
+      in [-offset, offset]; ele[] and prev[] link the elements of a bucket
+      and pos[] holds the bucket of an element. */
+   int   *head;
+   int   *prev;
+   int    offset;
+   int    top;
    } HEAP;
 
 #define Zoltan_Heap_Empty(H)         (((H)->n)==0)
 #define Zoltan_Heap_Not_Empty(H)     (((H)->n)!=0)
 #define Zoltan_Heap_Has_Elem(H,e)    (((H)->pos[e])!=-1)
 #define Zoltan_Heap_Value(H,e)       ((H)->value[e])    
-#define Zoltan_Heap_Max_Value(H)     ((H)->value[(H)->ele[0]])
-#define Zoltan_Heap_Peek_Max(H)      ((H)->ele[0])
+#define Zoltan_Heap_Peek_Max(H)      ((H)->head ? Zoltan_Heap_Bucket_Max(H) \
+                                                : (H)->ele[0])
+#define Zoltan_Heap_Max_Value(H)     ((H)->value[Zoltan_Heap_Peek_Max(H)])
 #define Zoltan_Heap_Count(H)         ((H)->n)
 
 int  Zoltan_Heap_Init         (ZZ*, HEAP*, int);
+int  Zoltan_Heap_Init_Buckets (ZZ*, HEAP*, int, int);
+int  Zoltan_Heap_Bucket_Max   (HEAP*);
 void Zoltan_Heap_Clear        (HEAP*);
 void Zoltan_Heap_Free         (HEAP*);
 int  Zoltan_Heap_Check        (HEAP*);
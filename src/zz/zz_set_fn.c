@@ -242,6 +242,10 @@ int ierr;
     ierr = Zoltan_Set_HG_CS_Fn(zz, 
                   (ZOLTAN_HG_CS_FN *) fn, data);
     break;
+  case ZOLTAN_HG_CS_PAGE_FN_TYPE:
+    ierr = Zoltan_Set_HG_CS_Page_Fn(zz, 
+                  (ZOLTAN_HG_CS_PAGE_FN *) fn, data);
+    break;
   case ZOLTAN_HG_SIZE_EDGE_WTS_FN_TYPE:
     ierr = Zoltan_Set_HG_Size_Edge_Wts_Fn(zz, 
                   (ZOLTAN_HG_SIZE_EDGE_WTS_FN *) fn, data);
@@ -735,6 +739,18 @@ int Zoltan_Set_HG_CS_Fn(
 }
 /*****************************************************************************/
 
+int Zoltan_Set_HG_CS_Page_Fn(
+  ZZ *zz, 
+  ZOLTAN_HG_CS_PAGE_FN *fn, 
+  void *data
+)
+{
+  zz->Get_HG_CS_Page = fn;
+  zz->Get_HG_CS_Page_Data = data;
+  return ZOLTAN_OK;
+}
+/*****************************************************************************/
+
 int Zoltan_Set_HG_Size_Edge_Wts_Fn(
   ZZ *zz, 
   ZOLTAN_HG_SIZE_EDGE_WTS_FN *fn, 
@@ -824,6 +840,226 @@ int Zoltan_Set_Hier_Method_Fn(
   return ZOLTAN_OK;
 }
 
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/*
+ *  Query functions that read a hypergraph registered with Zoltan_Set_HG_CSR
+ *  straight from the application's arrays.  Their data argument is
+ *  &zz->HG_CSR.
+ */
+
+static int csr_num_obj(void *data, int *ierr)
+{
+  ZOLTAN_HG_CSR *csr = (ZOLTAN_HG_CSR *)data;
+
+  *ierr = ZOLTAN_OK;
+  return csr->Num_Vtx;
+}
+
+static void csr_obj_list(void *data, int num_gid_entries, int num_lid_entries,
+  ZOLTAN_ID_PTR global_ids, ZOLTAN_ID_PTR local_ids, int wdim, float *objwgts,
+  int *ierr)
+{
+  ZOLTAN_HG_CSR *csr = (ZOLTAN_HG_CSR *)data;
+  int i;
+
+  memcpy(global_ids, csr->Vtx_GID, 
+         csr->Num_Vtx * num_gid_entries * sizeof(ZOLTAN_ID_TYPE));
+
+  if (num_lid_entries > 0){
+    for (i = 0; i < csr->Num_Vtx; i++){
+      local_ids[i * num_lid_entries] = (ZOLTAN_ID_TYPE)i;
+    }
+  }
+
+  /* The arrays carry no vertex weights; every vertex weighs one.
+   * Zoltan_Set_HG_CSR warns when OBJ_WEIGHT_DIM asks for more. */
+  for (i = 0; i < csr->Num_Vtx * wdim; i++){
+    objwgts[i] = 1.0;
+  }
+
+  *ierr = ZOLTAN_OK;
+}
+
+static void csr_size_cs(void *data, int *num_lists, int *num_pins,
+  int *format, int *ierr)
+{
+  ZOLTAN_HG_CSR *csr = (ZOLTAN_HG_CSR *)data;
+
+  *num_lists = csr->Num_Edges;
+  *num_pins = csr->Edge_Ptr[csr->Num_Edges] - csr->Edge_Ptr[0];
+  *format = ZOLTAN_COMPRESSED_EDGE;
+  *ierr = ZOLTAN_OK;
+}
+
+static void csr_cs_page(void *data, int num_gid_entries, int format,
+  int first_list, int max_lists, int max_pins, int *num_lists,
+  ZOLTAN_ID_PTR vtxedge_GID, int *vtxedge_ptr, ZOLTAN_ID_PTR pin_GID, int *ierr)
+{
+  ZOLTAN_HG_CSR *csr = (ZOLTAN_HG_CSR *)data;
+  int *ptr = csr->Edge_Ptr + first_list;
+  int i, n;
+
+  *ierr = ZOLTAN_OK;
+
+  if (format != ZOLTAN_COMPRESSED_EDGE){
+    *ierr = ZOLTAN_FATAL;
+    return;
+  }
+
+  for (n = 0; (n < max_lists) && (first_list + n < csr->Num_Edges); n++){
+    if (ptr[n + 1] - ptr[0] > max_pins) break;
+  }
+
+  *num_lists = n;
+
+  if (n == 0){
+    vtxedge_ptr[0] = 0;
+    vtxedge_ptr[1] = ptr[1] - ptr[0];
+    return;
+  }
+
+  for (i = 0; i <= n; i++){
+    vtxedge_ptr[i] = ptr[i] - ptr[0];
+  }
+
+  memcpy(vtxedge_GID, csr->Edge_GID + first_list * num_gid_entries,
+         n * num_gid_entries * sizeof(ZOLTAN_ID_TYPE));
+  memcpy(pin_GID, csr->Pin_GID + ptr[0] * num_gid_entries,
+         vtxedge_ptr[n] * num_gid_entries * sizeof(ZOLTAN_ID_TYPE));
+}
+
+static void csr_size_edge_wts(void *data, int *num_edges, int *ierr)
+{
+  ZOLTAN_HG_CSR *csr = (ZOLTAN_HG_CSR *)data;
+
+  *num_edges = csr->Num_Edges;
+  *ierr = ZOLTAN_OK;
+}
+
+static void csr_edge_wts(void *data, int num_gid_entries, int num_lid_entries,
+  int nedges, int edge_weight_dim, ZOLTAN_ID_PTR edge_GID,
+  ZOLTAN_ID_PTR edge_LID, float *edge_weight, int *ierr)
+{
+  ZOLTAN_HG_CSR *csr = (ZOLTAN_HG_CSR *)data;
+  int i;
+
+  memcpy(edge_GID, csr->Edge_GID, 
+         nedges * num_gid_entries * sizeof(ZOLTAN_ID_TYPE));
+
+  if (num_lid_entries > 0){
+    for (i = 0; i < nedges; i++){
+      edge_LID[i * num_lid_entries] = (ZOLTAN_ID_TYPE)i;
+    }
+  }
+
+  memcpy(edge_weight, csr->Edge_Wgts, nedges * edge_weight_dim * sizeof(float));
+
+  *ierr = ZOLTAN_OK;
+}
+
+/*****************************************************************************/
+
+int Zoltan_Set_HG_CSR(
+  ZZ *zz,
+  int num_vtx,
+  ZOLTAN_ID_PTR vtx_GID,
+  int num_edges,
+  ZOLTAN_ID_PTR edge_GID,
+  int *edge_ptr,
+  ZOLTAN_ID_PTR pin_GID,
+  float *edge_wgts
+)
+{
+/*
+ *  Register a hypergraph the application holds in compressed edge form.
+ *  Zoltan keeps only the pointers; the application owns the arrays and
+ *  must keep them valid (and unchanged) for as long as Zoltan may query
+ *  the hypergraph.  Query functions registered afterwards replace the
+ *  corresponding ones set here.
+ */
+char *yo = "Zoltan_Set_HG_CSR";
+ZOLTAN_HG_CSR *csr = &(zz->HG_CSR);
+
+  if ((num_vtx < 0) || (num_edges < 0) || 
+      ((num_vtx > 0) && !vtx_GID) ||
+      ((num_edges > 0) && (!edge_GID || !edge_ptr)) ||
+      (num_edges && (edge_ptr[num_edges] < edge_ptr[0])) ||
+      (num_edges && (edge_ptr[num_edges] > edge_ptr[0]) && !pin_GID)){
+    ZOLTAN_PRINT_ERROR(zz->Proc, yo, "Invalid hypergraph arrays.");
+    return ZOLTAN_FATAL;
+  }
+
+  csr->Num_Vtx = num_vtx;
+  csr->Vtx_GID = vtx_GID;
+  csr->Num_Edges = num_edges;
+  csr->Edge_GID = edge_GID;
+  csr->Edge_Ptr = edge_ptr;
+  csr->Pin_GID = pin_GID;
+  csr->Edge_Wgts = edge_wgts;
+
+  if (num_edges == 0){
+    /* Edge_Ptr[0] is read even when there are no edges. */
+    static int no_edges[1] = {0};
+    csr->Edge_Ptr = no_edges;
+  }
+
+  Zoltan_Set_Num_Obj_Fn(zz, csr_num_obj, csr);
+  Zoltan_Set_Obj_List_Fn(zz, csr_obj_list, csr);
+  Zoltan_Set_HG_Size_CS_Fn(zz, csr_size_cs, csr);
+  Zoltan_Set_HG_CS_Fn(zz, NULL, NULL);
+  Zoltan_Set_HG_CS_Page_Fn(zz, csr_cs_page, csr);
+
+  if (edge_wgts){
+    Zoltan_Set_HG_Size_Edge_Wts_Fn(zz, csr_size_edge_wts, csr);
+    Zoltan_Set_HG_Edge_Wts_Fn(zz, csr_edge_wts, csr);
+  }
+
+  if (zz->Obj_Weight_Dim > 0){
+    ZOLTAN_PRINT_WARN(zz->Proc, yo, 
+      "OBJ_WEIGHT_DIM > 0 but the arrays carry no vertex weights; "
+      "every vertex weighs one unless a ZOLTAN_OBJ_LIST_FN is "
+      "registered afterwards.");
+    return ZOLTAN_WARN;
+  }
+
+  return ZOLTAN_OK;
+}
+
+/*****************************************************************************/
+
+int Zoltan_HG_CSR_Active(ZZ *zz)
+{
+/*
+ *  True if the pins come from arrays registered with Zoltan_Set_HG_CSR,
+ *  so that callers may read zz->HG_CSR directly instead of querying.
+ */
+  return ((zz->Get_HG_CS_Page == csr_cs_page) && 
+          (zz->Get_HG_CS_Page_Data == (void *)&(zz->HG_CSR)) &&
+          (zz->Get_HG_Size_CS == csr_size_cs) &&
+          (zz->Get_HG_Size_CS_Data == (void *)&(zz->HG_CSR)));
+}
+
+/*****************************************************************************/
+
+void Zoltan_HG_CSR_Copy_To(ZZ *to, ZZ const *from)
+{
+/*
+ *  After a structure copy, the query functions set by Zoltan_Set_HG_CSR 
+ *  must read the copy's HG_CSR, not the original's.
+ */
+void *from_csr = (void *)&(from->HG_CSR);
+void *to_csr = (void *)&(to->HG_CSR);
+
+  if (to->Get_Num_Obj_Data == from_csr) to->Get_Num_Obj_Data = to_csr;
+  if (to->Get_Obj_List_Data == from_csr) to->Get_Obj_List_Data = to_csr;
+  if (to->Get_HG_Size_CS_Data == from_csr) to->Get_HG_Size_CS_Data = to_csr;
+  if (to->Get_HG_CS_Page_Data == from_csr) to->Get_HG_CS_Page_Data = to_csr;
+  if (to->Get_HG_Size_Edge_Wts_Data == from_csr) to->Get_HG_Size_Edge_Wts_Data = to_csr;
+  if (to->Get_HG_Edge_Wts_Data == from_csr) to->Get_HG_Edge_Wts_Data = to_csr;
+}
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
@@ -52,6 +52,9 @@ extern "C" {
 #include "zz_sort.h"
 
 #include "zz_const.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 /****************************************************************************/
@@ -565,6 +568,117 @@ int  equal, larger;
 
 
 
+/****************************************************************************/
+
+/* Sorts list[0:n-1] of unsigned 64 bit keys in increasing order, permuting
+ * parlist with it.  LSD radix sort, 8 bits per pass; a pass is skipped when
+ * all keys have the same digit, so keys with few significant bits or
+ * common high bits are cheap.  With OpenMP and num_threads > 1, each thread
+ * counts and scatters a contiguous chunk of the list, and the chunks' slots
+ * for each digit are laid out in thread order, so the result is the same
+ * for any number of threads.  The sort is stable.  Returns ZOLTAN_MEMERR
+ * if the temporary arrays cannot be allocated. */
+
+#define RADIX_MIN_KEYS_PER_THREAD 16384
+
+int Zoltan_radixsort_list_inc_uint64(
+  uint64_t *list, int *parlist, int n, int num_threads
+)
+{
+int i, t, shift, digit, sum, tmp, skip;
+int *count;                /* count[t*256+digit], then its first slot */
+uint64_t *klist, *kbuf, *ktmp;
+int *plist, *pbuf, *ptmp;
+
+  if (n < 2)
+    return ZOLTAN_OK;
+
+#ifdef _OPENMP
+  if (num_threads > n / RADIX_MIN_KEYS_PER_THREAD)
+    num_threads = n / RADIX_MIN_KEYS_PER_THREAD;
+#else
+  num_threads = 1;
+#endif
+  if (num_threads < 1)
+    num_threads = 1;
+
+  kbuf = (uint64_t *) ZOLTAN_MALLOC(n * sizeof(uint64_t));
+  pbuf = (int *) ZOLTAN_MALLOC(n * sizeof(int));
+  count = (int *) ZOLTAN_MALLOC(256 * num_threads * sizeof(int));
+  if (!kbuf || !pbuf || !count) {
+    Zoltan_Multifree(__FILE__, __LINE__, 3, &kbuf, &pbuf, &count);
+    return ZOLTAN_MEMERR;
+  }
+
+  klist = list;
+  plist = parlist;
+  for (shift = 0; shift < 64; shift += 8) {
+    skip = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads) private(i, t, digit)
+#endif
+    {
+      int nt = 1, lo, hi;
+      int *cnt;
+
+      t = 0;
+#ifdef _OPENMP
+      t = omp_get_thread_num();
+      nt = omp_get_num_threads();
+#endif
+      lo = (int) (((double) n * t) / nt);
+      hi = (int) (((double) n * (t + 1)) / nt);
+      cnt = count + 256 * t;
+
+      for (i = 0; i < 256; i++)
+        cnt[i] = 0;
+      for (i = lo; i < hi; i++)
+        cnt[(klist[i] >> shift) & 0xff]++;
+
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+      {
+        digit = (int) ((klist[0] >> shift) & 0xff);
+        for (sum = i = 0; i < nt; i++)
+          sum += count[256 * i + digit];
+        if (sum == n)
+          skip = 1;          /* all keys have the same digit */
+        else
+          for (sum = digit = 0; digit < 256; digit++)
+            for (i = 0; i < nt; i++) {
+              tmp = count[256 * i + digit];
+              count[256 * i + digit] = sum;
+              sum += tmp;
+            }
+      }
+
+      if (!skip)
+        for (i = lo; i < hi; i++) {
+          digit = (int) ((klist[i] >> shift) & 0xff);
+          kbuf[cnt[digit]] = klist[i];
+          pbuf[cnt[digit]++] = plist[i];
+        }
+    }
+    if (skip)
+      continue;
+    ktmp = klist; klist = kbuf; kbuf = ktmp;
+    ptmp = plist; plist = pbuf; pbuf = ptmp;
+  }
+
+  if (klist != list) {     /* odd number of passes */
+    memcpy(list, klist, n * sizeof(uint64_t));
+    memcpy(parlist, plist, n * sizeof(int));
+    kbuf = klist;
+    pbuf = plist;
+  }
+  Zoltan_Multifree(__FILE__, __LINE__, 3, &kbuf, &pbuf, &count);
+  return ZOLTAN_OK;
+}
+
+
+
 /****************************************************************************/
 
 
@@ -73,6 +73,8 @@ void Zoltan_quicksort_list_inc_long         (long*, int*,   int,  int);
 void Zoltan_quicksort_pointer_inc_long_long_int   (int*, long long*, int *, int, int);
 void Zoltan_quicksort_list_inc_long_long          (int64_t*, int*,   int,  int);
 
+int  Zoltan_radixsort_list_inc_uint64           (uint64_t*, int*,  int,  int);
+
 #ifdef __cplusplus
 } /* closing bracket for extern "C" */
 #endif
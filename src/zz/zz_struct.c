@@ -197,6 +197,11 @@ int Zoltan_Copy_To(ZZ *to, ZZ const *from)
   memset(&(to->LB), 0, sizeof(struct Zoltan_LB_Struct));
   Zoltan_LB_Copy_Struct(to, from);
 
+  if (Zoltan_Order_Copy_Struct(&(to->Order), &(from->Order)) != ZOLTAN_OK)
+    return 1;
+
+  Zoltan_HG_CSR_Copy_To(to, from);
+
   return 0;
 }
 
@@ -282,6 +287,7 @@ static void Zoltan_Init(ZZ* zz)
   zz->Get_Edge_List = NULL;
   zz->Get_HG_Size_CS = NULL;
   zz->Get_HG_CS = NULL;
+  zz->Get_HG_CS_Page = NULL;
   zz->Get_HG_Size_Edge_Wts = NULL;
   zz->Get_HG_Edge_Wts = NULL;
   zz->Get_Num_Geom = NULL;
@@ -337,6 +343,8 @@ static void Zoltan_Init(ZZ* zz)
   zz->Get_Edge_List_Data = NULL;
   zz->Get_HG_Size_CS_Data = NULL;
   zz->Get_HG_CS_Data = NULL;
+  zz->Get_HG_CS_Page_Data = NULL;
+  memset(&(zz->HG_CSR), 0, sizeof(ZOLTAN_HG_CSR));
   zz->Get_HG_Size_Edge_Wts_Data = NULL;
   zz->Get_HG_Edge_Wts_Data = NULL;
   zz->Get_Num_Geom_Data = NULL;
@@ -385,6 +393,7 @@ static void Zoltan_Init(ZZ* zz)
   zz->Get_Hier_Method_Data = NULL;
 
   zz->Order.needfree = 0;
+  zz->Order.local_hsfc = NULL;
   zz->TPL_Order.needfree = 0;
 }
 
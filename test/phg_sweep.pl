@@ -0,0 +1,236 @@
+#!/usr/bin/perl -w
+#
+# phg_sweep.pl:  run zdrive over a corpus of hypergraphs for every
+# combination of the given PHG parameter values, and report the partitioning
+# time, connectivity cut (CUTL), hyperedge cut (CUTN) and imbalance of each
+# run, followed by the best and the fastest setting per input.  The best
+# setting is the one with the lowest CUTL among the runs whose imbalance is
+# within their IMBALANCE_TOL.  Runs are labelled by their input as given.
+#
+# Usage:
+#   phg_sweep.pl [options] [--param NAME=v1,v2,...]...
+#
+# Options:
+#   --zdrive PATH      zdrive executable (default: zdrive.exe)
+#   --mpiexec CMD      MPI launcher (default: mpirun)
+#   --np N             number of processes (default: 4)
+#   --parts K1,K2,...  NUM_GLOBAL_PARTS values (default: 4,16)
+#   --input IN         input; may be repeated.  IN is a .mtx (matrixmarket)
+#                      or .hg (hypergraph) file, grid2d:N for an N x N
+#                      5-point grid matrix written by this script, or
+#                      create-a-graph:size=S[,dimension=D] for a graph
+#                      zdrive generates (zdrive did not finish with
+#                      dimension=2 in our runs; use 3).  Files with the
+#                      same contents are run once.  Default: grid2d:64,
+#                      create-a-graph:size=8000,dimension=3 and
+#                      create-a-graph:size=27000,dimension=3.  The inputs
+#                      in the test directories have fewer vertices than
+#                      PHG_COARSENING_LIMIT, so every setting would give
+#                      them the same partition.
+#   --preset P1,P2,... PHG_PRESET values (default: fast,balanced,quality);
+#                      "none" leaves PHG_PRESET unset.
+#   --param N=v1,...   additional PHG parameter to sweep; may be repeated.
+#   --imbalance-tol T  IMBALANCE_TOL the best cut must meet, for runs that
+#                      do not set it with --param (default: 1.1, Zoltan's
+#                      default).
+#   --workdir DIR      scratch directory (default: phg_sweep.work)
+#
+# Example:
+#   phg_sweep.pl --zdrive ../src/driver/zdrive.exe --np 4 --parts 16 \
+#                --param PHG_COARSENING_METHOD=agg,ipm \
+#                --param PHG_REFINEMENT_QUALITY=0.5,1,2
+#
+use strict;
+use Getopt::Long;
+use File::Basename;
+use File::Copy;
+use Cwd qw(abs_path);
+use Digest::MD5;
+
+my $zdrive  = "zdrive.exe";
+my $mpiexec = "mpirun";
+my $np      = 4;
+my $parts   = "4,16";
+my $preset  = "fast,balanced,quality";
+my $workdir = "phg_sweep.work";
+my $imbaltol = 1.1;
+my @inputs;
+my @params;
+
+GetOptions("zdrive=s"  => \$zdrive,
+           "mpiexec=s" => \$mpiexec,
+           "np=i"      => \$np,
+           "parts=s"   => \$parts,
+           "input=s"   => \@inputs,
+           "preset=s"  => \$preset,
+           "param=s"   => \@params,
+           "imbalance-tol=f" => \$imbaltol,
+           "workdir=s" => \$workdir)
+  or die "usage: $0 [--zdrive PATH] [--np N] [--parts K,...] "
+       . "[--input FILE]... [--preset P,...] [--param NAME=v,...]... "
+       . "[--imbalance-tol T]\n";
+
+if (!@inputs) {
+  @inputs = ("grid2d:64",
+             "create-a-graph:size=8000,dimension=3",
+             "create-a-graph:size=27000,dimension=3");
+}
+$zdrive = abs_path($zdrive) if (-e $zdrive);
+
+# Resolve input files before changing to the work directory, and drop files
+# whose contents repeat an earlier input.
+my (@corpus, %seen);
+foreach my $input (@inputs) {
+  my $c = {label => $input};
+  if ($input =~ /^grid2d:(\d+)$/) {
+    $c->{grid} = $1;
+  }
+  elsif ($input =~ /^create-a-graph(:(.*))?$/) {
+    $c->{type} = "create-a-graph";
+    $c->{type} .= ", " . join(", ", split(/,/, $2)) if (defined $2);
+  }
+  else {
+    my ($base, $dir, $ext) = fileparse($input, ".mtx", ".hg");
+    die "input $input must be a .mtx or .hg file\n" if ($ext eq "");
+    open(IN, $input) or die "cannot read $input: $!\n";
+    binmode(IN);
+    my $md5 = Digest::MD5->new->addfile(*IN)->hexdigest;
+    close(IN);
+    if ($seen{$md5}) {
+      print "skipping $input:  same contents as $seen{$md5}\n";
+      next;
+    }
+    $seen{$md5} = $input;
+    $c->{file} = abs_path($input);
+    $c->{ext}  = $ext;
+    $c->{type} = ($ext eq ".hg") ? "hypergraph" : "matrixmarket";
+  }
+  push @corpus, $c;
+}
+my $width = 16;
+foreach my $c (@corpus) {
+  $width = length($c->{label}) if (length($c->{label}) > $width);
+}
+
+# Build the list of parameter settings: the cartesian product of all values.
+my @axes;
+push @axes, ["PHG_PRESET", split(/,/, $preset)];
+foreach my $p (@params) {
+  my ($name, $vals) = split(/=/, $p, 2);
+  die "bad --param $p; expected NAME=v1,v2,...\n" unless defined $vals;
+  push @axes, [uc($name), split(/,/, $vals)];
+}
+my @settings = ([]);
+foreach my $axis (@axes) {
+  my ($name, @vals) = @$axis;
+  my @next;
+  foreach my $s (@settings) {
+    foreach my $v (@vals) {
+      push @next, [@$s, ($v eq "none") ? () : ("$name=$v")];
+    }
+  }
+  @settings = @next;
+}
+
+mkdir $workdir unless (-d $workdir);
+chdir $workdir or die "cannot chdir to $workdir: $!\n";
+
+printf("%-*s %5s %10s %10s %10s %8s  %s\n", $width,
+       "input", "parts", "time", "cutl", "cutn", "imbal", "parameters");
+
+# Write the matrix of the 5-point stencil on an n x n grid, in the format
+# of hg_simple/simple.mtx.
+sub write_grid2d {
+  my ($n, $file) = @_;
+  my @nz;
+  for (my $i = 0; $i < $n; $i++) {
+    for (my $j = 0; $j < $n; $j++) {
+      my $row = $i * $n + $j + 1;
+      push @nz, "$row $row 4.0";
+      push @nz, "$row " . ($row - $n) . " -1.0" if ($i > 0);
+      push @nz, "$row " . ($row - 1) . " -1.0" if ($j > 0);
+      push @nz, "$row " . ($row + 1) . " -1.0" if ($j < $n - 1);
+      push @nz, "$row " . ($row + $n) . " -1.0" if ($i < $n - 1);
+    }
+  }
+  open(MTX, ">$file") or die "cannot write $file: $!\n";
+  print MTX "%%MatrixMarket matrix coordinate real general\n";
+  print MTX "%\n% ${n}x${n} grid, written by phg_sweep.pl.\n%\n";
+  print MTX $n * $n, " ", $n * $n, " ", scalar(@nz), "\n";
+  print MTX "$_\n" foreach (@nz);
+  close(MTX);
+}
+
+my $run = 0;
+for (my $ic = 0; $ic < @corpus; $ic++) {
+  my $c = $corpus[$ic];
+  my $label = $c->{label};
+  my $base = "input$ic";       # inputs may share a file name
+  if (defined $c->{grid}) {
+    write_grid2d($c->{grid}, "$base.mtx");
+    $c->{type} = "matrixmarket";
+  }
+  elsif (defined $c->{file}) {
+    copy($c->{file}, "$base$c->{ext}")
+      or die "cannot copy $c->{file}: $!\n";
+  }
+
+  foreach my $k (split(/,/, $parts)) {
+    my ($best, $fastest);
+    foreach my $s (@settings) {
+      my $inp = "zdrive.inp.sweep" . $run++;
+      open(INP, ">$inp") or die "cannot write $inp: $!\n";
+      print INP "Decomposition Method  = hypergraph\n";
+      print INP "Zoltan Parameters     = num_global_parts=$k\n";
+      print INP "Zoltan Parameters     = $_\n" foreach (@$s);
+      print INP "File Type             = $c->{type}\n";
+      print INP "File Name             = $base\n"
+        unless ($c->{type} =~ /^create-a-graph/);
+      print INP "Parallel Disk Info    = number=0\n";
+      close(INP);
+
+      my $log = `$mpiexec -np $np $zdrive $inp 2>&1`;
+      my $status = $?;
+
+      # zdrive evaluates the partition before and after balancing; keep the
+      # values reported last.
+      my ($time, $cutl, $cutn, $imbal);
+      $time  = $1 while ($log =~ /Total:\s+(\S+) seconds in Partitioning/g);
+      $cutl  = $1 while ($log =~ /Eval_HG\s+CUTL \(.*\):\s+(\S+)/g);
+      $cutn  = $1 while ($log =~ /Eval_HG\s+CUTN \(.*\):\s+(\S+)/g);
+      $imbal = $1 while ($log =~ /Eval_HG\s+Object weight\s+:.*\s(\S+)\s*$/mg);
+
+      my $desc = @$s ? join(",", @$s) : "(defaults)";
+      if ($status || !defined($time) || !defined($cutl)) {
+        printf("%-*s %5d %10s %10s %10s %8s  %s\n", $width,
+               $label, $k, "FAILED", "-", "-", "-", $desc);
+        open(LOG, ">$inp.log"); print LOG $log; close(LOG);
+        next;
+      }
+      printf("%-*s %5d %10.4f %10.1f %10.1f %8.3f  %s\n", $width,
+             $label, $k, $time, $cutl, $cutn, $imbal, $desc);
+
+      # A lower cut that misses the imbalance tolerance is not "best".
+      my $tol = $imbaltol;
+      foreach (@$s) { $tol = $1 if (/^IMBALANCE_TOL=(\S+)$/); }
+
+      my $r = {time => $time, cutl => $cutl, imbal => $imbal, desc => $desc};
+      $best = $r if ($imbal <= $tol &&
+                     (!$best || $cutl < $best->{cutl} ||
+                      ($cutl == $best->{cutl} && $time < $best->{time})));
+      $fastest = $r if (!$fastest || $time < $fastest->{time});
+      unlink $inp;
+    }
+    if ($fastest) {
+      if ($best) {
+        printf("  %s k=%d best cut:  %s (imbal %.3f)\n",
+               $label, $k, $best->{desc}, $best->{imbal});
+      }
+      else {
+        print "  $label k=$k best cut:  none within IMBALANCE_TOL\n";
+      }
+      printf("  %s k=%d fastest:   %s (imbal %.3f)\n",
+             $label, $k, $fastest->{desc}, $fastest->{imbal});
+    }
+  }
+}